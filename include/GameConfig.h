@@ -80,12 +80,35 @@ struct TargetZone {
         };
         return names[static_cast<int>(pos)];
     }
+
+    // Standard goal mouth (meters), centre of the crossbar span at x = 0
+    static constexpr float GOAL_WIDTH = 7.32f;
+    static constexpr float GOAL_HEIGHT = 2.44f;
+
+    // Map a point on the goal plane (x toward the kicker's left, y up from
+    // the ground; see BallPhysics.h) to the 3x3 grid, left and right as the
+    // kicker sees them. Points outside the frame clamp to the nearest edge zone.
+    static Position positionForGoalPoint(float x, float y) {
+        float relX = x / (GOAL_WIDTH / 2.0f);
+        float relY = (y - GOAL_HEIGHT / 2.0f) / (GOAL_HEIGHT / 2.0f);
+
+        int gridX = relX > 0.33f ? 0 : (relX < -0.33f ? 2 : 1);
+        int gridY = relY > 0.33f ? 0 : (relY < -0.33f ? 2 : 1);
+
+        return static_cast<Position>(gridY * 3 + gridX);
+    }
+
+    static bool isInsideGoal(float x, float y) {
+        return x >= -GOAL_WIDTH / 2.0f && x <= GOAL_WIDTH / 2.0f &&
+               y >= 0.0f && y <= GOAL_HEIGHT;
+    }
 };
 
 // Accuracy Challenge configuration
 struct AccuracyChallengeConfig {
     float timeLimitSeconds = 60.0f;
     int32_t maxAttempts = 15;  // Optional attempt limit
+    float goalDistance = 5.0f; // meters from the kicker to the goal plane
 
     // 3x3 grid setup
     std::vector<TargetZone> targetZones;
@@ -138,6 +161,7 @@ struct PowerChallengeConfig {
 struct PenaltyShootoutConfig {
     int32_t kicksPerPlayer = 5;
     bool enableSuddenDeath = true;
+    float goalDistance = 11.0f;  // Penalty spot to goal line (meters)
 
     // Goalkeeper AI
     float goalkeeperReactionTime = 0.3f;  // seconds
@@ -151,6 +175,20 @@ struct PenaltyShootoutConfig {
     ScoringConfig scoring;
 };
 
+// How an achievement's unlock conditions are evaluated
+enum class AchievementRule {
+    RESULT,              // One result meets every non-zero threshold
+    ZONES,               // Every zone in requiredZones hit in one result
+    SUDDEN_DEATH_WIN,    // Penalty shootout won in sudden death
+    LIFETIME_SUCCESSES,  // Successes over all results reach requiredAttempts
+    RESULT_STREAK        // requiredAttempts results in a row reach requiredVelocity
+};
+
+// Bit for a target zone in AchievementConfig::requiredZones
+constexpr uint32_t zoneBit(TargetZone::Position position) {
+    return 1u << static_cast<uint32_t>(position);
+}
+
 // Achievement thresholds
 struct AchievementConfig {
     std::string id;
@@ -164,6 +202,8 @@ struct AchievementConfig {
     int32_t requiredAttempts = 0;
     float requiredAccuracy = 0.0f;
     float requiredVelocity = 0.0f;
+    AchievementRule rule = AchievementRule::RESULT;
+    uint32_t requiredZones = 0;  // ZONES: zoneBit() mask
 
     bool isUnlocked = false;
 };
@@ -180,7 +220,8 @@ public:
                 "Hit all 9 target zones in one session",
                 "assets/achievements/bullseye.png",
                 ChallengeType::ACCURACY,
-                0, 0, 1.0f, 0.0f
+                0, 0, 0.0f, 0.0f,
+                AchievementRule::ZONES, 0x1FF
             },
             {
                 "corner_specialist",
@@ -188,7 +229,10 @@ public:
                 "Hit all 4 corners in accuracy challenge",
                 "assets/achievements/corner_specialist.png",
                 ChallengeType::ACCURACY,
-                0, 0, 0.0f, 0.0f
+                0, 0, 0.0f, 0.0f,
+                AchievementRule::ZONES,
+                zoneBit(TargetZone::Position::TOP_LEFT) | zoneBit(TargetZone::Position::TOP_RIGHT) |
+                zoneBit(TargetZone::Position::BOTTOM_LEFT) | zoneBit(TargetZone::Position::BOTTOM_RIGHT)
             },
             {
                 "sharpshooter",
@@ -222,7 +266,8 @@ public:
                 "Three consecutive 80+ km/h kicks",
                 "assets/achievements/consistent_power.png",
                 ChallengeType::POWER,
-                0, 3, 0.0f, 80.0f
+                0, 3, 0.0f, 80.0f,
+                AchievementRule::RESULT_STREAK
             },
 
             // Penalty achievements
@@ -240,7 +285,8 @@ public:
                 "Win penalty shootout in sudden death",
                 "assets/achievements/ice_cold.png",
                 ChallengeType::PENALTY_SHOOTOUT,
-                0, 0, 0.0f, 0.0f
+                0, 0, 0.0f, 0.0f,
+                AchievementRule::SUDDEN_DEATH_WIN
             },
             {
                 "penalty_master",
@@ -248,13 +294,21 @@ public:
                 "Score 20+ penalties total",
                 "assets/achievements/penalty_master.png",
                 ChallengeType::PENALTY_SHOOTOUT,
-                0, 20, 0.0f, 0.0f
+                0, 20, 0.0f, 0.0f,
+                AchievementRule::LIFETIME_SUCCESSES
             }
         };
     }
 };
 
 // Global game configuration
+// Fixed-step game simulation (GameManager::pushFrame / advance)
+struct SimulationConfig {
+    float stepHz = 120.0f;              // Challenge rule updates per second
+    int32_t maxStepsPerAdvance = 12;    // After a stall, drop the time beyond this
+    float interpolationDelay = 0.05f;   // Seconds the stepped skeleton trails the tracker
+};
+
 struct GameConfig {
     // Display settings
     int32_t screenWidth = 1920;
@@ -265,6 +319,7 @@ struct GameConfig {
     float countdownDuration = 3.0f;  // seconds
     float instructionsDuration = 5.0f;
     float resultsDuration = 10.0f;
+    SimulationConfig simulation;
 
     // Challenge configs
     AccuracyChallengeConfig accuracyConfig;
@@ -37,7 +37,7 @@ enum class DominantFoot {
 // Comprehensive kick quality metrics
 struct KickQuality {
     // Power metrics
-    float footVelocity;         // m/s at contact
+    float footVelocity;         // mm/s at contact (tracker units)
     float estimatedBallSpeed;   // km/h
     float powerScore;           // 0-100
 
@@ -22,6 +22,7 @@ constexpr int NUM_JOINTS = static_cast<int>(K4ABT_JOINT_COUNT);
 constexpr float KICK_DETECTION_THRESHOLD = 2.0f; // m/s
 constexpr float SESSION_TIMEOUT_SECONDS = 60.0f;
 constexpr float ATTRACT_MODE_IDLE_TIME = 30.0f;
+constexpr float ATTRACT_SCREEN_TARGET_SECONDS = 2.0f; // Launch to first attract frame
 
 // Game State Machine
 enum class GameState {
@@ -272,33 +273,27 @@ struct FrameData {
     }
 };
 
-// Health monitoring
+// Health monitoring. Pipeline stages count into core::MetricsRegistry
+// under these family names; KioskManager reads them back into a snapshot.
 struct HealthMetrics {
-    std::atomic<uint64_t> framesProcessed{0};
-    std::atomic<uint64_t> framesDropped{0};
-    std::atomic<uint64_t> kicksDetected{0};
-    std::atomic<uint64_t> sessionsCompleted{0};
-    std::atomic<float> avgFps{0.0f};
-    std::atomic<bool> kinectHealthy{false};
-    std::atomic<bool> trackerHealthy{false};
+    static constexpr const char* FRAMES_PROCESSED = "kinect_frames_processed_total";
+    static constexpr const char* FRAMES_DROPPED = "kinect_frames_dropped_total";
+    static constexpr const char* KICKS_DETECTED = "kinect_kicks_detected_total";
+    static constexpr const char* SESSIONS_COMPLETED = "kinect_sessions_completed_total";
+    static constexpr const char* DEVICE_UP = "kinect_device_up";
+    static constexpr const char* TRACKER_UP = "kinect_tracker_up";
+    static constexpr const char* LAST_FRAME_TIME = "kinect_last_frame_timestamp_seconds";
+
+    uint64_t framesProcessed = 0;
+    uint64_t framesDropped = 0;
+    uint64_t kicksDetected = 0;
+    uint64_t sessionsCompleted = 0;
+    float avgFps = 0.0f;          // Processed frames over the last health interval
+    bool kinectHealthy = false;
+    bool trackerHealthy = false;
 
     std::chrono::system_clock::time_point lastFrameTime;
     std::chrono::system_clock::time_point startTime;
-
-    HealthMetrics() {
-        startTime = std::chrono::system_clock::now();
-        lastFrameTime = startTime;
-    }
-
-    void reset() {
-        framesProcessed = 0;
-        framesDropped = 0;
-        kicksDetected = 0;
-        // Don't reset sessionsCompleted
-        avgFps = 0.0f;
-        startTime = std::chrono::system_clock::now();
-        lastFrameTime = startTime;
-    }
 };
 
 // Utility functions
@@ -0,0 +1,195 @@
+#pragma once
+
+#include "Crc32.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace kinect {
+namespace core {
+
+/**
+ * @brief Append a trivially copyable value in host byte order
+ */
+template<typename T>
+void put(std::string& out, const T& value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+/**
+ * @brief Read a value written by put() and advance the cursor
+ *
+ * The caller checks bounds; the read is unaligned-safe.
+ */
+template<typename T>
+T get(const uint8_t*& p) {
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+    p += sizeof(T);
+    return value;
+}
+
+/**
+ * @brief Wall-clock time as microseconds since the epoch, for on-disk fields
+ */
+inline int64_t toMicroseconds(std::chrono::system_clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(time.time_since_epoch()).count();
+}
+
+/**
+ * @brief Inverse of toMicroseconds()
+ */
+inline std::chrono::system_clock::time_point fromMicroseconds(int64_t us) {
+    return std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::microseconds(us)));
+}
+
+/// Record framing: [u32 payload length][u32 CRC-32 of payload][payload]
+constexpr size_t RECORD_HEADER_SIZE = 8;
+
+/**
+ * @brief Start a framed record at the end of @p out
+ * @return Position of the record header, to pass to endRecord()
+ */
+inline size_t beginRecord(std::string& out) {
+    size_t headerAt = out.size();
+    put(out, uint32_t(0));  // Length, filled by endRecord
+    put(out, uint32_t(0));  // CRC, filled by endRecord
+    return headerAt;
+}
+
+/**
+ * @brief Fill in the length and CRC of the record started at @p headerAt
+ *
+ * Everything appended since beginRecord() is the payload.
+ */
+inline void endRecord(std::string& out, size_t headerAt) {
+    size_t payloadAt = headerAt + RECORD_HEADER_SIZE;
+    uint32_t payloadLength = static_cast<uint32_t>(out.size() - payloadAt);
+    uint32_t checksum = crc32(reinterpret_cast<const uint8_t*>(out.data()) + payloadAt, payloadLength);
+    std::memcpy(&out[headerAt], &payloadLength, sizeof(payloadLength));
+    std::memcpy(&out[headerAt + 4], &checksum, sizeof(checksum));
+}
+
+/**
+ * @brief Validate the framed record at data[offset]
+ *
+ * Checks that the header and a payload of @p minPayload to @p maxPayload
+ * bytes fit before @p size and that the CRC matches. Does not advance
+ * @p offset: the caller does so once the payload has decoded, so a torn or
+ * damaged record ends the valid prefix.
+ *
+ * @param payload Set to the first payload byte on success
+ * @param payloadLength Set to the payload size on success
+ */
+inline bool readRecord(const uint8_t* data, size_t size, size_t offset,
+                       size_t minPayload, size_t maxPayload,
+                       const uint8_t*& payload, uint32_t& payloadLength) {
+    if (size - offset < RECORD_HEADER_SIZE) {
+        return false;
+    }
+
+    const uint8_t* p = data + offset;
+    uint32_t length = get<uint32_t>(p);
+    uint32_t checksum = get<uint32_t>(p);
+    if (length < minPayload || length > maxPayload ||
+        size - offset - RECORD_HEADER_SIZE < length ||
+        crc32(p, length) != checksum) {
+        return false;
+    }
+
+    payload = p;
+    payloadLength = length;
+    return true;
+}
+
+/**
+ * @brief Cut a file back to its last intact record
+ *
+ * A no-op when the file already ends there.
+ * @return False if the file could not be resized
+ */
+inline bool truncateTail(const std::string& path, size_t validBytes) {
+    std::error_code ec;
+    if (std::filesystem::file_size(path, ec) != validBytes) {
+        std::filesystem::resize_file(path, validBytes, ec);
+        if (ec) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Flush stdio buffers and push the file to stable storage
+ * @return False if either step failed
+ */
+inline bool syncFile(std::FILE* file) {
+    bool flushed = std::fflush(file) == 0;
+#ifdef _WIN32
+    return _commit(_fileno(file)) == 0 && flushed;
+#else
+    return fsync(fileno(file)) == 0 && flushed;
+#endif
+}
+
+/**
+ * @brief Make a rename in @p directory durable
+ *
+ * NTFS journals its metadata, so Windows has nothing to do here.
+ */
+inline void syncDirectory(const std::string& directory) {
+#ifndef _WIN32
+    int fd = ::open(directory.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        fsync(fd);
+        ::close(fd);
+    }
+#else
+    (void)directory;
+#endif
+}
+
+/**
+ * @brief Numbers of the files named <prefix><digits><suffix> in a directory
+ * @return Sorted ascending; empty if the directory cannot be read
+ */
+inline std::vector<uint64_t> listNumberedFiles(const std::string& directory,
+                                               const char* prefix, const char* suffix) {
+    const size_t prefixLength = std::strlen(prefix);
+    const size_t suffixLength = std::strlen(suffix);
+
+    std::vector<uint64_t> numbers;
+    std::error_code ec;
+    for (const auto& item : std::filesystem::directory_iterator(directory, ec)) {
+        std::string name = item.path().filename().string();
+        if (name.size() <= prefixLength + suffixLength ||
+            name.compare(0, prefixLength, prefix) != 0 ||
+            name.compare(name.size() - suffixLength, std::string::npos, suffix) != 0) {
+            continue;
+        }
+        std::string digits = name.substr(prefixLength, name.size() - prefixLength - suffixLength);
+        if (std::all_of(digits.begin(), digits.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+            numbers.push_back(std::stoull(digits));
+        }
+    }
+    std::sort(numbers.begin(), numbers.end());
+    return numbers;
+}
+
+} // namespace core
+} // namespace kinect
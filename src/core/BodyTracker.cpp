@@ -1,10 +1,23 @@
 #include "BodyTracker.h"
+#include "../../include/common.h"
+#include <cstring>
 #include <iostream>
 
 namespace kinect {
 namespace core {
 
-BodyTracker::BodyTracker() {
+BodyTracker::BodyTracker()
+    : processedCounter_(MetricsRegistry::global().counter(HealthMetrics::FRAMES_PROCESSED, "Body frames produced by the tracker"))
+    , droppedCounter_(MetricsRegistry::global().counter(HealthMetrics::FRAMES_DROPPED, "Frames lost before body tracking",
+                                                        {{"stage", "tracker"}}))
+    , upGauge_(MetricsRegistry::global().gauge(HealthMetrics::TRACKER_UP, "1 while the body tracker is running"))
+    , waitHistogram_(MetricsRegistry::global().histogram("kinect_tracker_wait_seconds", "Time spent waiting for a body frame",
+                                                         Histogram::latencyBounds(), 1e-6))
+    , resumesCounter_(MetricsRegistry::global().counter("kinect_tracker_resumes_total",
+                                                        "Device reconnects that kept the loaded tracker"))
+    , swapsCounter_(MetricsRegistry::global().counter("kinect_tracker_standby_swaps_total",
+                                                      "Failed trackers replaced by the warm standby"))
+{
     // Default configuration: GPU processing
     config_.sensor_orientation = K4ABT_SENSOR_ORIENTATION_DEFAULT;
     config_.processing_mode = K4ABT_TRACKER_PROCESSING_MODE_GPU;
@@ -35,31 +48,161 @@ bool BodyTracker::initialize(KinectDevice& device) {
         return false;
     }
 
+    upGauge_.set(1.0);
     logInfo("Body tracker initialized (GPU mode)");
     return true;
 }
 
 void BodyTracker::shutdown() {
+    standbyEnabled_ = false;
+    releaseStandby();
+
     if (tracker_) {
-        k4abt_tracker_shutdown(tracker_);
-        k4abt_tracker_destroy(tracker_);
+        destroyTracker(tracker_);
         tracker_ = nullptr;
+        hasFrame_ = false;
+        upGauge_.set(0.0);
         logInfo("Body tracker shut down");
     }
 }
 
+bool BodyTracker::resume(KinectDevice& device) {
+    k4a_calibration_t calibration = device.getCalibration();
+
+    if (tracker_ && sameCalibration(calibration, calibration_)) {
+        drainResults();
+        resumesCounter_.inc();
+        logInfo("Body tracker kept across device reconnect");
+        return true;
+    }
+
+    // A different device or depth mode: the loaded model cannot be reused
+    bool standby = standbyEnabled_;
+    releaseStandby();
+    if (tracker_) {
+        destroyTracker(tracker_);
+        tracker_ = nullptr;
+        hasFrame_ = false;
+        upGauge_.set(0.0);
+    }
+    logWarning("Calibration changed, reloading body tracker");
+    if (!initialize(device)) {
+        return false;
+    }
+    if (standby) {
+        startStandby();
+    }
+    return true;
+}
+
+void BodyTracker::startStandby() {
+    if (!tracker_) {
+        logWarning("Cannot load standby before the tracker is initialized");
+        return;
+    }
+    if (standbyThread_.joinable()) {
+        standbyThread_.join();
+    }
+    standbyEnabled_ = true;
+
+    // Built from a copy, so the pipeline thread keeps using calibration_
+    k4a_calibration_t calibration = calibration_;
+    k4abt_tracker_configuration_t config = config_;
+    standbyThread_ = std::thread([this, calibration, config]() {
+        k4abt_tracker_t tracker = nullptr;
+        if (k4abt_tracker_create(&calibration, config, &tracker) != K4A_RESULT_SUCCEEDED) {
+            logError("Failed to create standby tracker");
+            return;
+        }
+        std::lock_guard<std::mutex> lock(standbyMutex_);
+        if (standby_) {
+            destroyTracker(standby_);
+        }
+        standby_ = tracker;
+        standbyCalibration_ = calibration;
+    });
+}
+
+bool BodyTracker::hasStandby() const {
+    std::lock_guard<std::mutex> lock(standbyMutex_);
+    return standby_ != nullptr;
+}
+
+bool BodyTracker::swapToStandby() {
+    k4abt_tracker_t standby = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(standbyMutex_);
+        if (!standby_ || !sameCalibration(standbyCalibration_, calibration_)) {
+            return false;
+        }
+        standby = standby_;
+        standby_ = nullptr;
+    }
+
+    destroyTracker(tracker_);
+    tracker_ = standby;
+    hasFrame_ = false;
+    swapsCounter_.inc();
+    logWarning("Body tracker failed, switched to warm standby");
+
+    // Load the next spare behind it
+    startStandby();
+    return true;
+}
+
+void BodyTracker::drainResults() {
+    k4abt_frame_t frame = nullptr;
+    while (k4abt_tracker_pop_result(tracker_, &frame, 0) == K4A_WAIT_RESULT_SUCCEEDED) {
+        k4abt_frame_release(frame);
+    }
+    hasFrame_ = false;
+}
+
+void BodyTracker::destroyTracker(k4abt_tracker_t tracker) {
+    k4abt_tracker_shutdown(tracker);
+    k4abt_tracker_destroy(tracker);
+}
+
+void BodyTracker::releaseStandby() {
+    if (standbyThread_.joinable()) {
+        standbyThread_.join();
+    }
+    std::lock_guard<std::mutex> lock(standbyMutex_);
+    if (standby_) {
+        destroyTracker(standby_);
+        standby_ = nullptr;
+    }
+}
+
+bool BodyTracker::sameCalibration(const k4a_calibration_t& a, const k4a_calibration_t& b) {
+    // The tracker only reads the depth camera, so color changes keep it
+    return a.depth_mode == b.depth_mode &&
+           std::memcmp(&a.depth_camera_calibration, &b.depth_camera_calibration,
+                       sizeof(k4a_calibration_camera_t)) == 0;
+}
+
 bool BodyTracker::processCapture(k4a_capture_t capture, int32_t timeoutMs) {
     if (!tracker_ || !capture) {
         return false;
     }
 
+    // Reduced tracker rate: no result will come for this capture
+    lastCaptureSkipped_ = captureCount_++ % frameStride_.load(std::memory_order_relaxed) != 0;
+    if (lastCaptureSkipped_) {
+        return true;
+    }
+
     // Enqueue capture for processing (non-blocking)
     k4a_wait_result_t enqueueResult = k4abt_tracker_enqueue_capture(
         tracker_, capture, K4A_WAIT_RESULT_TIMEOUT);
 
     if (enqueueResult == K4A_WAIT_RESULT_FAILED) {
         logError("Failed to enqueue capture");
+        swapToStandby();
         return false;
+    } else if (enqueueResult == K4A_WAIT_RESULT_TIMEOUT) {
+        // Queue full: the GPU is behind and this capture is lost
+        droppedCounter_.inc();
     }
 
     hasFrame_ = true;
@@ -72,16 +215,22 @@ bool BodyTracker::getBodyFrame(k4abt_frame_t& frame) {
     }
 
     // Wait for GPU processing to complete
-    // Use 33ms timeout (one frame at 30fps) to avoid blocking too long
-    k4a_wait_result_t result = k4abt_tracker_pop_result(tracker_, &frame, 33);
+    // Use 33ms timeout (one frame at 30fps) to avoid blocking too long;
+    // after a skipped capture only collect a result that is already there
+    auto waitStart = std::chrono::steady_clock::now();
+    k4a_wait_result_t result = k4abt_tracker_pop_result(tracker_, &frame, lastCaptureSkipped_ ? 0 : 33);
+    waitHistogram_.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - waitStart).count()));
 
     if (result == K4A_WAIT_RESULT_SUCCEEDED) {
+        processedCounter_.inc();
         return true;
     } else if (result == K4A_WAIT_RESULT_TIMEOUT) {
         // GPU still processing, not an error
         return false;
     } else {
         logError("Failed to get body frame");
+        swapToStandby();
         return false;
     }
 }
@@ -1,9 +1,13 @@
 #pragma once
 
 #include "KinectDevice.h"
+#include "Metrics.h"
 #include <k4abt.h>
+#include <atomic>
 #include <vector>
 #include <chrono>
+#include <mutex>
+#include <thread>
 
 namespace kinect {
 namespace core {
@@ -37,7 +41,12 @@ struct BodyData {
  * @brief Azure Kinect Body Tracking wrapper
  *
  * Processes depth frames through the body tracking SDK
- * to produce skeleton data for up to 6 bodies.
+ * to produce skeleton data for up to 6 bodies. Captures refused by a
+ * full tracker queue are counted as dropped frames.
+ *
+ * Creating a tracker loads the ONNX model, which takes seconds, so
+ * recovery avoids it: resume() keeps the loaded tracker across a device
+ * reconnect, and an optional warm standby replaces a tracker that fails.
  */
 class BodyTracker {
 public:
@@ -60,6 +69,25 @@ public:
      */
     void shutdown();
 
+    /**
+     * @brief Continue after KinectDevice::reconnect()
+     *
+     * Same calibration: keeps the loaded tracker and discards results of
+     * captures queued before the disconnect. Otherwise swaps in a standby
+     * built for the new calibration, or recreates the tracker (slow).
+     * @return true if the tracker is ready
+     */
+    bool resume(KinectDevice& device);
+
+    /**
+     * @brief Load a second tracker in the background for hot swap
+     *
+     * Costs a second model in GPU memory. When the active tracker fails the
+     * standby takes over within one frame and another is loaded behind it.
+     */
+    void startStandby();
+    bool hasStandby() const;
+
     /**
      * @brief Process a single capture through body tracking
      * @param capture The capture to process
@@ -68,6 +96,12 @@ public:
      */
     bool processCapture(k4a_capture_t capture, int32_t timeoutMs = 33);
 
+    /**
+     * @brief Track only every nth capture (1 = all); the others are
+     *        skipped without counting as dropped. Any thread.
+     */
+    void setFrameStride(uint32_t stride) { frameStride_.store(stride > 0 ? stride : 1, std::memory_order_relaxed); }
+
     /**
      * @brief Get the current body frame
      * @param frame Output body frame handle
@@ -98,6 +132,32 @@ private:
     k4a_calibration_t calibration_;
     bool hasFrame_ = false;
 
+    // Frame stride (quality governor)
+    std::atomic<uint32_t> frameStride_{1};
+    uint32_t captureCount_ = 0;
+    bool lastCaptureSkipped_ = false;
+
+    // Warm standby, created on standbyThread_
+    k4abt_tracker_t standby_ = nullptr;
+    k4a_calibration_t standbyCalibration_;
+    bool standbyEnabled_ = false;
+    std::thread standbyThread_;
+    mutable std::mutex standbyMutex_;
+
+    // Metrics
+    Counter& processedCounter_;
+    Counter& droppedCounter_;
+    Gauge& upGauge_;
+    Histogram& waitHistogram_;
+    Counter& resumesCounter_;
+    Counter& swapsCounter_;
+
+    bool swapToStandby();
+    void drainResults();
+    void destroyTracker(k4abt_tracker_t tracker);
+    void releaseStandby();
+    static bool sameCalibration(const k4a_calibration_t& a, const k4a_calibration_t& b);
+
     void extractBodyData(k4abt_frame_t frame, std::vector<BodyData>& bodies);
 
     void logInfo(const std::string& msg);
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace kinect {
+namespace core {
+
+/**
+ * @brief CRC-32 (IEEE 802.3) of a byte range
+ *
+ * Slicing-by-8, so checksum verification keeps up with memory-mapped
+ * loads. Used to detect torn or damaged records in on-disk journals.
+ */
+inline uint32_t crc32(const uint8_t* data, size_t length) {
+    struct Table {
+        uint32_t values[8][256];
+
+        Table() {
+            for (uint32_t i = 0; i < 256; ++i) {
+                uint32_t c = i;
+                for (int k = 0; k < 8; ++k) {
+                    c = (c & 1u) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                }
+                values[0][i] = c;
+            }
+            for (uint32_t i = 0; i < 256; ++i) {
+                for (int t = 1; t < 8; ++t) {
+                    values[t][i] = (values[t - 1][i] >> 8) ^ values[0][values[t - 1][i] & 0xFFu];
+                }
+            }
+        }
+    };
+    static const Table table;
+    const auto& t = table.values;
+
+    uint32_t c = 0xFFFFFFFFu;
+    while (length >= 8) {
+        uint32_t low;
+        uint32_t high;
+        std::memcpy(&low, data, 4);
+        std::memcpy(&high, data + 4, 4);
+        low ^= c;
+        c = t[7][low & 0xFFu] ^ t[6][(low >> 8) & 0xFFu] ^
+            t[5][(low >> 16) & 0xFFu] ^ t[4][low >> 24] ^
+            t[3][high & 0xFFu] ^ t[2][(high >> 8) & 0xFFu] ^
+            t[1][(high >> 16) & 0xFFu] ^ t[0][high >> 24];
+        data += 8;
+        length -= 8;
+    }
+    while (length-- > 0) {
+        c = t[0][(c ^ *data++) & 0xFFu] ^ (c >> 8);
+    }
+    return c ^ 0xFFFFFFFFu;
+}
+
+} // namespace core
+} // namespace kinect
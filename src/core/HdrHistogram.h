@@ -0,0 +1,186 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace kinect {
+namespace core {
+
+namespace detail {
+
+inline uint64_t load(const uint64_t& counter) { return counter; }
+inline uint64_t load(const std::atomic<uint64_t>& counter) { return counter.load(std::memory_order_relaxed); }
+
+inline void store(uint64_t& counter, uint64_t value) { counter = value; }
+inline void store(std::atomic<uint64_t>& counter, uint64_t value) { counter.store(value, std::memory_order_relaxed); }
+
+inline void add(uint64_t& counter, uint64_t value) { counter += value; }
+inline void add(std::atomic<uint64_t>& counter, uint64_t value) { counter.fetch_add(value, std::memory_order_relaxed); }
+
+inline void lowerTo(uint64_t& counter, uint64_t value) { counter = std::min(counter, value); }
+inline void lowerTo(std::atomic<uint64_t>& counter, uint64_t value) {
+    uint64_t current = counter.load(std::memory_order_relaxed);
+    while (value < current && !counter.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+inline void raiseTo(uint64_t& counter, uint64_t value) { counter = std::max(counter, value); }
+inline void raiseTo(std::atomic<uint64_t>& counter, uint64_t value) {
+    uint64_t current = counter.load(std::memory_order_relaxed);
+    while (value > current && !counter.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+// Index of the highest set bit; value must be non-zero
+inline unsigned highestBit(uint64_t value) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return static_cast<unsigned>(index);
+#else
+    return 63u - static_cast<unsigned>(__builtin_clzll(value));
+#endif
+}
+
+} // namespace detail
+
+/**
+ * @brief Log-linear histogram of non-negative integers (HdrHistogram-style)
+ *
+ * Values below SUB_BUCKET_COUNT are counted exactly; above that, every
+ * power of two is split into SUB_BUCKET_COUNT / 2 equal buckets, so any
+ * recorded value is reported within 1/32 (about 3%) of itself. Values past
+ * MAX_VALUE are clamped. Histograms of the same layout merge by adding
+ * bucket counts, so per-thread or per-kiosk histograms combine exactly.
+ *
+ * Counter is uint64_t for a plain value (snapshots, merging, queries) or
+ * std::atomic<uint64_t> for live recording, where record() costs relaxed
+ * atomic adds and may run concurrently with readers.
+ */
+template<typename Counter>
+class BasicHdrHistogram {
+public:
+    static constexpr unsigned SUB_BUCKET_BITS = 5;
+    static constexpr unsigned MAX_VALUE_BITS = 36;
+    static constexpr size_t SUB_BUCKET_COUNT = size_t(1) << SUB_BUCKET_BITS;
+    static constexpr size_t BUCKET_COUNT = (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+    static constexpr uint64_t MAX_VALUE = (uint64_t(1) << MAX_VALUE_BITS) - 1;
+
+    BasicHdrHistogram() { reset(); }
+
+    void reset() {
+        for (auto& count : counts_) {
+            detail::store(count, 0);
+        }
+        detail::store(total_, 0);
+        detail::store(sum_, 0);
+        detail::store(min_, std::numeric_limits<uint64_t>::max());
+        detail::store(max_, 0);
+    }
+
+    void record(uint64_t value, uint64_t count = 1) {
+        value = std::min(value, MAX_VALUE);
+        detail::add(counts_[bucketIndex(value)], count);
+        detail::add(total_, count);
+        detail::add(sum_, value * count);
+        detail::lowerTo(min_, value);
+        detail::raiseTo(max_, value);
+    }
+
+    template<typename OtherCounter>
+    void merge(const BasicHdrHistogram<OtherCounter>& other) {
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            uint64_t count = detail::load(other.counts_[i]);
+            if (count > 0) {
+                detail::add(counts_[i], count);
+            }
+        }
+        detail::add(total_, detail::load(other.total_));
+        detail::add(sum_, detail::load(other.sum_));
+        detail::lowerTo(min_, detail::load(other.min_));
+        detail::raiseTo(max_, detail::load(other.max_));
+    }
+
+    uint64_t getTotalCount() const { return detail::load(total_); }
+    uint64_t getSum() const { return detail::load(sum_); }
+    uint64_t getMin() const { return getTotalCount() > 0 ? detail::load(min_) : 0; }
+    uint64_t getMax() const { return detail::load(max_); }
+
+    double getMean() const {
+        uint64_t total = getTotalCount();
+        return total > 0 ? static_cast<double>(getSum()) / static_cast<double>(total) : 0.0;
+    }
+
+    /**
+     * @brief Value at or below which percentile% of recorded values fall
+     * @param percentile 0-100
+     * @return Midpoint of the bucket holding that value, within [min, max]
+     */
+    uint64_t getValueAtPercentile(double percentile) const {
+        uint64_t total = getTotalCount();
+        if (total == 0) {
+            return 0;
+        }
+
+        double fraction = std::min(100.0, std::max(0.0, percentile)) / 100.0;
+        uint64_t target = std::max<uint64_t>(1, static_cast<uint64_t>(fraction * static_cast<double>(total) + 0.5));
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            seen += detail::load(counts_[i]);
+            if (seen >= target) {
+                uint64_t lowest = bucketLowest(i);
+                uint64_t middle = lowest + (bucketHighest(i) - lowest) / 2;
+                return std::min(getMax(), std::max(getMin(), middle));
+            }
+        }
+        return getMax();
+    }
+
+    static size_t bucketIndex(uint64_t value) {
+        if (value < SUB_BUCKET_COUNT) {
+            return static_cast<size_t>(value);
+        }
+        unsigned shift = detail::highestBit(value) - SUB_BUCKET_BITS;
+        return shift * SUB_BUCKET_COUNT + static_cast<size_t>(value >> shift);
+    }
+
+    static uint64_t bucketLowest(size_t index) {
+        if (index < 2 * SUB_BUCKET_COUNT) {
+            return index;
+        }
+        unsigned shift = static_cast<unsigned>(index / SUB_BUCKET_COUNT - 1);
+        return static_cast<uint64_t>(index - shift * SUB_BUCKET_COUNT) << shift;
+    }
+
+    static uint64_t bucketHighest(size_t index) {
+        if (index < 2 * SUB_BUCKET_COUNT) {
+            return index;
+        }
+        unsigned shift = static_cast<unsigned>(index / SUB_BUCKET_COUNT - 1);
+        return bucketLowest(index) + (uint64_t(1) << shift) - 1;
+    }
+
+private:
+    template<typename OtherCounter>
+    friend class BasicHdrHistogram;
+
+    std::array<Counter, BUCKET_COUNT> counts_;
+    Counter total_;
+    Counter sum_;
+    Counter min_;
+    Counter max_;
+};
+
+using HdrHistogram = BasicHdrHistogram<uint64_t>;
+using AtomicHdrHistogram = BasicHdrHistogram<std::atomic<uint64_t>>;
+
+} // namespace core
+} // namespace kinect
@@ -1,11 +1,25 @@
 #include "KinectDevice.h"
+#include "../../include/common.h"
+#include <algorithm>
 #include <iostream>
 #include <cstring>
+#include <thread>
 
 namespace kinect {
 namespace core {
 
-KinectDevice::KinectDevice() {
+KinectDevice::KinectDevice()
+    : capturesCounter_(MetricsRegistry::global().counter("kinect_captures_total", "Captures read from the device"))
+    , timeoutsCounter_(MetricsRegistry::global().counter("kinect_capture_timeouts_total", "Capture reads that timed out"))
+    , errorsCounter_(MetricsRegistry::global().counter("kinect_capture_errors_total", "Capture reads that failed"))
+    , droppedCounter_(MetricsRegistry::global().counter(HealthMetrics::FRAMES_DROPPED, "Frames lost before body tracking",
+                                                        {{"stage", "capture"}}))
+    , upGauge_(MetricsRegistry::global().gauge(HealthMetrics::DEVICE_UP, "1 while the device is streaming"))
+    , lastFrameGauge_(MetricsRegistry::global().gauge(HealthMetrics::LAST_FRAME_TIME, "Unix time of the last capture"))
+    , reconnectsCounter_(MetricsRegistry::global().counter("kinect_device_reconnects_total", "Successful device reconnects"))
+    , reconnectHistogram_(MetricsRegistry::global().histogram("kinect_device_reconnect_seconds", "Time from reconnect() to streaming again",
+                                                              Histogram::latencyBounds(), 1e-6))
+{
     // Default configuration for soccer kiosk
     config_ = K4A_DEVICE_CONFIG_INIT_DISABLE_ALL;
     config_.depth_mode = K4A_DEPTH_MODE_NFOV_UNBINNED;
@@ -40,6 +54,19 @@ bool KinectDevice::initialize(uint32_t deviceIndex) {
         return false;
     }
 
+    if (!openDevice(deviceIndex)) {
+        return false;
+    }
+    deviceIndex_ = deviceIndex;
+
+    logInfo("Kinect device initialized successfully");
+    logInfo("  Serial: " + getSerialNumber());
+    logInfo("  Firmware: " + getFirmwareVersion());
+
+    return true;
+}
+
+bool KinectDevice::openDevice(uint32_t deviceIndex) {
     if (k4a_device_open(deviceIndex, &device_) != K4A_RESULT_SUCCEEDED) {
         logError("Failed to open device " + std::to_string(deviceIndex));
         device_ = nullptr;
@@ -54,11 +81,6 @@ bool KinectDevice::initialize(uint32_t deviceIndex) {
         device_ = nullptr;
         return false;
     }
-
-    logInfo("Kinect device initialized successfully");
-    logInfo("  Serial: " + getSerialNumber());
-    logInfo("  Firmware: " + getFirmwareVersion());
-
     return true;
 }
 
@@ -86,6 +108,31 @@ void KinectDevice::setFps(k4a_fps_t fps) {
     config_.camera_fps = fps;
 }
 
+bool KinectDevice::reconfigure(k4a_depth_mode_t depthMode, k4a_color_resolution_t colorResolution) {
+    if (!device_) {
+        logError("Device not initialized");
+        return false;
+    }
+    if (config_.depth_mode == depthMode && config_.color_resolution == colorResolution) {
+        return true;
+    }
+
+    bool wasCapturing = capturing_;
+    stopCapture();
+
+    config_.depth_mode = depthMode;
+    config_.color_resolution = colorResolution;
+    if (k4a_device_get_calibration(device_, config_.depth_mode,
+                                    config_.color_resolution, &calibration_) != K4A_RESULT_SUCCEEDED) {
+        logError("Failed to get device calibration");
+        return false;
+    }
+
+    logInfo("Reconfigured: depth mode " + std::to_string(depthMode) +
+            ", color resolution " + std::to_string(colorResolution));
+    return !wasCapturing || startCapture();
+}
+
 bool KinectDevice::startCapture() {
     if (!device_) {
         logError("Device not initialized");
@@ -103,6 +150,8 @@ bool KinectDevice::startCapture() {
     }
 
     capturing_ = true;
+    lastDepthTimestampUsec_ = 0;
+    upGauge_.set(1.0);
     logInfo("Camera capture started");
     return true;
 }
@@ -114,6 +163,7 @@ void KinectDevice::stopCapture() {
 
     k4a_device_stop_cameras(device_);
     capturing_ = false;
+    upGauge_.set(0.0);
 
     if (capture_) {
         k4a_capture_release(capture_);
@@ -139,16 +189,97 @@ bool KinectDevice::captureFrame() {
     k4a_wait_result_t result = k4a_device_get_capture(device_, &capture_, timeout_ms);
 
     if (result == K4A_WAIT_RESULT_SUCCEEDED) {
+        capturesCounter_.inc();
+        lastFrameGauge_.set(std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count());
+        countDroppedFrames();
         return true;
     } else if (result == K4A_WAIT_RESULT_TIMEOUT) {
         // Normal timeout, not an error
+        timeoutsCounter_.inc();
         return false;
     } else {
-        logError("Failed to capture frame");
+        errorsCounter_.inc();
+        if (!streamLost_) {
+            logError("Failed to capture frame, device lost");
+        }
+        streamLost_ = true;
         return false;
     }
 }
 
+bool KinectDevice::reconnect(const ReconnectPolicy& policy) {
+    auto start = std::chrono::steady_clock::now();
+    bool restartCameras = capturing_;
+
+    // Tear down only the device; the handle is useless after a USB reset
+    if (capture_) {
+        k4a_capture_release(capture_);
+        capture_ = nullptr;
+    }
+    if (device_) {
+        if (capturing_) {
+            k4a_device_stop_cameras(device_);
+        }
+        k4a_device_close(device_);
+        device_ = nullptr;
+    }
+    capturing_ = false;
+    upGauge_.set(0.0);
+
+    uint32_t backoffMs = policy.initialBackoffMs;
+    for (int attempt = 1;; attempt++) {
+        if (openDevice(deviceIndex_)) {
+            if (!restartCameras || startCapture()) {
+                break;
+            }
+            k4a_device_close(device_);
+            device_ = nullptr;
+        }
+
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        if (elapsed + std::chrono::milliseconds(backoffMs) > std::chrono::milliseconds(policy.timeoutMs)) {
+            logError("Reconnect gave up after " + std::to_string(attempt) + " attempts");
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(backoffMs));
+        backoffMs = std::min(backoffMs * 2, policy.maxBackoffMs);
+    }
+
+    streamLost_ = false;
+    auto elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    reconnectsCounter_.inc();
+    reconnectHistogram_.record(static_cast<uint64_t>(elapsedUs));
+    logInfo("Device reconnected in " + std::to_string(elapsedUs / 1000) + " ms");
+    return true;
+}
+
+void KinectDevice::countDroppedFrames() {
+    k4a_image_t depthImage = k4a_capture_get_depth_image(capture_);
+    if (!depthImage) {
+        return;
+    }
+    uint64_t timestampUsec = k4a_image_get_device_timestamp_usec(depthImage);
+    k4a_image_release(depthImage);
+
+    // The device stamps every frame, so a gap of n periods lost n - 1 frames
+    uint64_t period = getFramePeriodUsec();
+    if (lastDepthTimestampUsec_ != 0 && timestampUsec > lastDepthTimestampUsec_) {
+        uint64_t periods = (timestampUsec - lastDepthTimestampUsec_ + period / 2) / period;
+        if (periods > 1) {
+            droppedCounter_.inc(periods - 1);
+        }
+    }
+    lastDepthTimestampUsec_ = timestampUsec;
+}
+
+uint64_t KinectDevice::getFramePeriodUsec() const {
+    switch (config_.camera_fps) {
+        case K4A_FRAMES_PER_SECOND_5: return 200000;
+        case K4A_FRAMES_PER_SECOND_15: return 66667;
+        default: return 33333;
+    }
+}
+
 void KinectDevice::shutdown() {
     stopCapture();
 
@@ -2,10 +2,12 @@
 
 #include <k4a/k4a.h>
 #include <k4abt.h>
+#include "Metrics.h"
 #include <memory>
 #include <string>
 #include <vector>
 #include <chrono>
+#include <cstdint>
 
 namespace kinect {
 namespace core {
@@ -21,11 +23,25 @@ struct ImageFrame {
     std::chrono::steady_clock::time_point timestamp;
 };
 
+/**
+ * @brief Retry schedule for KinectDevice::reconnect()
+ *
+ * The first attempt is immediate; each failure doubles the wait up to
+ * maxBackoffMs. A USB glitch usually re-enumerates in a few hundred ms.
+ */
+struct ReconnectPolicy {
+    uint32_t initialBackoffMs = 20;
+    uint32_t maxBackoffMs = 1000;
+    uint32_t timeoutMs = 30000;     // Give up after this long
+};
+
 /**
  * @brief Azure Kinect device wrapper
  *
  * Handles device lifecycle, configuration, and frame capture.
- * Thread-safe for capture operations.
+ * Thread-safe for capture operations. Counts captures, timeouts and
+ * frames the device skipped (gaps in the depth timestamps) into the
+ * global metrics registry.
  */
 class KinectDevice {
 public:
@@ -50,6 +66,19 @@ public:
     void setColorResolution(k4a_color_resolution_t resolution);
     void setFps(k4a_fps_t fps);
 
+    /**
+     * @brief Switch depth mode and color resolution, restarting the cameras
+     *        if they were running (K4A_COLOR_RESOLUTION_OFF turns color off)
+     *
+     * The calibration is fetched again for the new modes; a new depth mode
+     * means the body tracker must be resumed (see BodyTracker::resume).
+     * @return true once the device runs in the new modes
+     */
+    bool reconfigure(k4a_depth_mode_t depthMode, k4a_color_resolution_t colorResolution);
+
+    k4a_depth_mode_t getDepthMode() const { return config_.depth_mode; }
+    k4a_color_resolution_t getColorResolution() const { return config_.color_resolution; }
+
     /**
      * @brief Start capturing frames
      * @return true if successful
@@ -72,6 +101,23 @@ public:
      */
     void shutdown();
 
+    /**
+     * @brief Close and reopen the same device index, restarting the cameras
+     *        if they were running
+     *
+     * Only the device is reopened; the body tracker depends on the
+     * calibration, not the device handle, so it can be kept (see
+     * BodyTracker::resume). Blocks for at most policy.timeoutMs.
+     * @return true once the device streams again
+     */
+    bool reconnect(const ReconnectPolicy& policy = ReconnectPolicy());
+
+    /**
+     * @brief True after a capture read failed, which the SDK reports when
+     *        the device is gone (USB reset, unplug); cleared by reconnect()
+     */
+    bool isStreamLost() const { return streamLost_; }
+
     // Image extraction (thread-safe)
     bool extractColorFrame(ImageFrame& outFrame);
     bool extractDepthFrame(ImageFrame& outFrame);
@@ -96,6 +142,23 @@ private:
 
     k4a_device_configuration_t config_;
     bool capturing_ = false;
+    uint32_t deviceIndex_ = 0;
+    bool streamLost_ = false;
+
+    // Metrics
+    Counter& capturesCounter_;
+    Counter& timeoutsCounter_;
+    Counter& errorsCounter_;
+    Counter& droppedCounter_;
+    Gauge& upGauge_;
+    Gauge& lastFrameGauge_;
+    Counter& reconnectsCounter_;
+    Histogram& reconnectHistogram_;
+    uint64_t lastDepthTimestampUsec_ = 0;
+
+    bool openDevice(uint32_t deviceIndex);
+    void countDroppedFrames();
+    uint64_t getFramePeriodUsec() const;
 
     void logInfo(const std::string& msg);
     void logError(const std::string& msg);
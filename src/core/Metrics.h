@@ -0,0 +1,365 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace kinect {
+namespace core {
+
+// Constant labels of one series, e.g. {{"stage", "capture"}}
+using MetricLabels = std::vector<std::pair<std::string, std::string>>;
+
+namespace detail {
+
+constexpr size_t METRIC_STRIPES = 16;
+
+// Stripe owned by the calling thread, assigned round-robin on first use
+inline size_t metricStripe() {
+    static std::atomic<size_t> nextStripe{0};
+    thread_local size_t stripe = nextStripe.fetch_add(1, std::memory_order_relaxed) % METRIC_STRIPES;
+    return stripe;
+}
+
+struct alignas(64) PaddedCounter {
+    std::atomic<uint64_t> value{0};
+};
+
+} // namespace detail
+
+/**
+ * @brief Monotonic counter, striped per thread
+ *
+ * inc() is one relaxed atomic add on the calling thread's own cache line,
+ * so stages on different threads never contend. get() sums the stripes.
+ */
+class Counter {
+public:
+    void inc(uint64_t count = 1) {
+        stripes_[detail::metricStripe()].value.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    uint64_t get() const {
+        uint64_t total = 0;
+        for (const auto& stripe : stripes_) {
+            total += stripe.value.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+private:
+    std::array<detail::PaddedCounter, detail::METRIC_STRIPES> stripes_;
+};
+
+/**
+ * @brief Value that can go up and down (queue depth, FPS, up/down state)
+ *
+ * A gauge has a single current value, so it is not striped; set() is a
+ * relaxed store on its own cache line.
+ */
+class alignas(64) Gauge {
+public:
+    void set(double value) { value_.store(value, std::memory_order_relaxed); }
+
+    void add(double delta) {
+        double current = value_.load(std::memory_order_relaxed);
+        while (!value_.compare_exchange_weak(current, current + delta, std::memory_order_relaxed)) {
+        }
+    }
+
+    double get() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<double> value_{0.0};
+};
+
+/**
+ * @brief Fixed-bucket histogram of non-negative integers, striped per thread
+ *
+ * Values are recorded in integer units (e.g. microseconds) and exported
+ * multiplied by scale (e.g. 1e-6 for seconds). record() finds the bucket
+ * among at most MAX_BUCKETS bounds and does two relaxed adds.
+ */
+class Histogram {
+public:
+    static constexpr size_t MAX_BUCKETS = 20;
+
+    struct Snapshot {
+        std::vector<uint64_t> counts;   // Per bucket, the last one is +Inf
+        uint64_t count = 0;
+        uint64_t sum = 0;
+    };
+
+    // bounds: ascending bucket upper bounds (inclusive), in recorded units
+    Histogram(const std::vector<uint64_t>& bounds, double scale)
+        : bounds_(bounds)
+        , scale_(scale)
+    {
+        if (bounds_.size() > MAX_BUCKETS) {
+            bounds_.resize(MAX_BUCKETS);
+        }
+    }
+
+    void record(uint64_t value) {
+        size_t bucket = 0;
+        while (bucket < bounds_.size() && value > bounds_[bucket]) {
+            bucket++;
+        }
+        Stripe& stripe = stripes_[detail::metricStripe()];
+        stripe.counts[bucket].fetch_add(1, std::memory_order_relaxed);
+        stripe.sum.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    Snapshot snapshot() const {
+        Snapshot result;
+        result.counts.assign(bounds_.size() + 1, 0);
+        for (const Stripe& stripe : stripes_) {
+            for (size_t i = 0; i <= bounds_.size(); ++i) {
+                uint64_t count = stripe.counts[i].load(std::memory_order_relaxed);
+                result.counts[i] += count;
+                result.count += count;
+            }
+            result.sum += stripe.sum.load(std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+    const std::vector<uint64_t>& getBounds() const { return bounds_; }
+    double getScale() const { return scale_; }
+
+    // count bounds from first, each factor times the previous
+    static std::vector<uint64_t> exponentialBounds(uint64_t first, double factor, size_t count) {
+        std::vector<uint64_t> bounds;
+        double bound = static_cast<double>(first);
+        for (size_t i = 0; i < count; ++i) {
+            bounds.push_back(static_cast<uint64_t>(bound));
+            bound *= factor;
+        }
+        return bounds;
+    }
+
+    // 100 us to about 1.6 s in microseconds, for Histogram(latencyBounds(), 1e-6)
+    static std::vector<uint64_t> latencyBounds() { return exponentialBounds(100, 2.0, 15); }
+
+private:
+    struct alignas(64) Stripe {
+        std::array<std::atomic<uint64_t>, MAX_BUCKETS + 1> counts{};
+        std::atomic<uint64_t> sum{0};
+    };
+
+    std::vector<uint64_t> bounds_;
+    double scale_;
+    std::array<Stripe, detail::METRIC_STRIPES> stripes_;
+};
+
+/**
+ * @brief Named metrics of the whole process, exposed in Prometheus text format
+ *
+ * Each pipeline stage registers its own series, usually once in its
+ * constructor, and keeps the returned reference for the hot path.
+ * Registering the same name and labels again returns the same metric, so
+ * a stage that is torn down and rebuilt keeps counting where it left off.
+ * Metrics live as long as the registry.
+ */
+class MetricsRegistry {
+public:
+    MetricsRegistry() = default;
+
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    // Registry shared by every stage and the exporter
+    static MetricsRegistry& global() {
+        static MetricsRegistry registry;
+        return registry;
+    }
+
+    Counter& counter(const std::string& name, const std::string& help, const MetricLabels& labels = {}) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Series& series = findSeries(name, help, Type::COUNTER, labels);
+        if (!series.counter) {
+            series.counter = std::make_unique<Counter>();
+        }
+        return *series.counter;
+    }
+
+    Gauge& gauge(const std::string& name, const std::string& help, const MetricLabels& labels = {}) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Series& series = findSeries(name, help, Type::GAUGE, labels);
+        if (!series.gauge) {
+            series.gauge = std::make_unique<Gauge>();
+        }
+        return *series.gauge;
+    }
+
+    // Bounds and scale are fixed by the first registration of a series
+    Histogram& histogram(const std::string& name, const std::string& help,
+                         const std::vector<uint64_t>& bounds, double scale,
+                         const MetricLabels& labels = {}) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Series& series = findSeries(name, help, Type::HISTOGRAM, labels);
+        if (!series.histogram) {
+            series.histogram = std::make_unique<Histogram>(bounds, scale);
+        }
+        return *series.histogram;
+    }
+
+    /**
+     * @brief Sum of every series of a counter or gauge family
+     * @return 0 if the family is not registered
+     */
+    double getValue(const std::string& name) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = families_.find(name);
+        if (it == families_.end()) {
+            return 0.0;
+        }
+        double total = 0.0;
+        for (const auto& pair : it->second.series) {
+            if (pair.second.counter) {
+                total += static_cast<double>(pair.second.counter->get());
+            } else if (pair.second.gauge) {
+                total += pair.second.gauge->get();
+            }
+        }
+        return total;
+    }
+
+    /**
+     * @brief Append every metric in Prometheus text exposition format 0.0.4
+     */
+    void writePrometheusText(std::string& out) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& familyPair : families_) {
+            const std::string& name = familyPair.first;
+            const Family& family = familyPair.second;
+
+            out += "# HELP " + name + " " + family.help + "\n";
+            out += "# TYPE " + name + " " + typeName(family.type) + "\n";
+            for (const auto& seriesPair : family.series) {
+                const std::string& labels = seriesPair.first;
+                const Series& series = seriesPair.second;
+                if (series.counter) {
+                    writeSample(out, name, labels, static_cast<double>(series.counter->get()));
+                } else if (series.gauge) {
+                    writeSample(out, name, labels, series.gauge->get());
+                } else if (series.histogram) {
+                    writeHistogram(out, name, labels, *series.histogram);
+                }
+            }
+        }
+    }
+
+private:
+    enum class Type { COUNTER, GAUGE, HISTOGRAM };
+
+    struct Series {
+        std::unique_ptr<Counter> counter;
+        std::unique_ptr<Gauge> gauge;
+        std::unique_ptr<Histogram> histogram;
+    };
+
+    struct Family {
+        std::string help;
+        Type type;
+        std::map<std::string, Series> series;   // By rendered labels
+    };
+
+    std::map<std::string, Family> families_;
+    std::vector<Series> mismatched_;            // Wrong-type registrations, not exported
+    mutable std::mutex mutex_;
+
+    Series& findSeries(const std::string& name, const std::string& help, Type type, const MetricLabels& labels) {
+        auto it = families_.find(name);
+        if (it == families_.end()) {
+            it = families_.emplace(name, Family{help, type, {}}).first;
+        }
+        if (it->second.type != type) {
+            assert(!"metric registered again with a different type");
+            mismatched_.emplace_back();
+            return mismatched_.back();
+        }
+        return it->second.series[renderLabels(labels)];
+    }
+
+    static const char* typeName(Type type) {
+        switch (type) {
+            case Type::COUNTER: return "counter";
+            case Type::GAUGE: return "gauge";
+            default: return "histogram";
+        }
+    }
+
+    // a="x",b="y" with \, " and newline escaped
+    static std::string renderLabels(const MetricLabels& labels) {
+        std::string text;
+        for (const auto& label : labels) {
+            if (!text.empty()) {
+                text += ',';
+            }
+            text += label.first + "=\"";
+            for (char c : label.second) {
+                if (c == '\\' || c == '"') {
+                    text += '\\';
+                    text += c;
+                } else if (c == '\n') {
+                    text += "\\n";
+                } else {
+                    text += c;
+                }
+            }
+            text += '"';
+        }
+        return text;
+    }
+
+    static void appendValue(std::string& out, double value) {
+        char text[32];
+        int length = std::snprintf(text, sizeof(text), "%.15g", value);
+        out.append(text, length > 0 ? static_cast<size_t>(length) : 0);
+    }
+
+    static void writeSample(std::string& out, const std::string& name, const std::string& labels, double value) {
+        out += name;
+        if (!labels.empty()) {
+            out += "{" + labels + "}";
+        }
+        out += ' ';
+        appendValue(out, value);
+        out += '\n';
+    }
+
+    static void writeHistogram(std::string& out, const std::string& name, const std::string& labels,
+                               const Histogram& histogram) {
+        Histogram::Snapshot snapshot = histogram.snapshot();
+        const std::vector<uint64_t>& bounds = histogram.getBounds();
+        std::string prefix = labels.empty() ? std::string() : labels + ",";
+
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < snapshot.counts.size(); ++i) {
+            cumulative += snapshot.counts[i];
+            out += name + "_bucket{" + prefix + "le=\"";
+            if (i < bounds.size()) {
+                appendValue(out, static_cast<double>(bounds[i]) * histogram.getScale());
+            } else {
+                out += "+Inf";
+            }
+            out += "\"} ";
+            appendValue(out, static_cast<double>(cumulative));
+            out += '\n';
+        }
+        writeSample(out, name + "_sum", labels, static_cast<double>(snapshot.sum) * histogram.getScale());
+        writeSample(out, name + "_count", labels, static_cast<double>(cumulative));
+    }
+};
+
+} // namespace core
+} // namespace kinect
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace kinect {
+namespace core {
+
+/**
+ * @brief Bounded lock-free single-producer/single-consumer queue
+ *
+ * Unlike RingBuffer, push never blocks and never overwrites: when the
+ * consumer falls behind, push fails and the caller decides what to drop.
+ * Exactly one thread may push and exactly one thread may pop.
+ *
+ * @tparam T Element type (copy-assignable)
+ * @tparam Size Buffer capacity, must be a power of two
+ */
+template<typename T, size_t Size>
+class SpscQueue {
+    static_assert(Size >= 2 && (Size & (Size - 1)) == 0, "SpscQueue size must be a power of two");
+
+public:
+    SpscQueue() = default;
+
+    // Non-copyable
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /**
+     * @brief Push item (producer thread only)
+     * @return false if the queue is full
+     */
+    bool push(const T& item) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) >= Size) {
+            return false;
+        }
+
+        buffer_[tail & (Size - 1)] = item;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Pop item (consumer thread only)
+     * @return false if the queue is empty
+     */
+    bool pop(T& item) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        item = buffer_[head & (Size - 1)];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Approximate number of queued items (any thread)
+     */
+    size_t size() const {
+        // Read head first so tail can only be ahead of it
+        const size_t head = head_.load(std::memory_order_acquire);
+        const size_t tail = tail_.load(std::memory_order_acquire);
+        return tail - head;
+    }
+
+    bool empty() const { return size() == 0; }
+
+    constexpr size_t capacity() const { return Size; }
+
+private:
+    std::array<T, Size> buffer_;
+    alignas(64) std::atomic<size_t> head_{0};   // Consumer index
+    alignas(64) std::atomic<size_t> tail_{0};   // Producer index
+};
+
+} // namespace core
+} // namespace kinect
@@ -0,0 +1,329 @@
+#include "StartupGraph.h"
+#include "Metrics.h"
+#include <algorithm>
+#include <cstdio>
+#include <exception>
+#include <iostream>
+#include <sstream>
+
+namespace kinect {
+namespace core {
+
+namespace {
+constexpr size_t NOT_FOUND = static_cast<size_t>(-1);
+constexpr int TIMELINE_BAR_WIDTH = 40;
+}
+
+StartupGraph::StartupGraph()
+    : createdAt_(std::chrono::steady_clock::now())
+{
+}
+
+StartupGraph::~StartupGraph() {
+    bool started;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        started = started_;
+    }
+    // Steps capture their owner's members; none may outlive the graph
+    if (started) {
+        wait();
+    }
+}
+
+bool StartupGraph::add(const std::string& name, Affinity affinity, const std::vector<std::string>& dependsOn, Step step) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (started_) {
+        logError("Cannot add step '" + name + "' after startup has begun");
+        return false;
+    }
+    if (find(name) != NOT_FOUND) {
+        logError("Duplicate step '" + name + "'");
+        return false;
+    }
+
+    Node node;
+    node.name = name;
+    node.affinity = affinity;
+    node.step = std::move(step);
+    for (const auto& dependency : dependsOn) {
+        size_t index = find(dependency);
+        if (index == NOT_FOUND) {
+            logError("Step '" + name + "' depends on unknown step '" + dependency + "'");
+            return false;
+        }
+        node.dependsOn.push_back(index);
+    }
+    nodes_.push_back(std::move(node));
+    return true;
+}
+
+bool StartupGraph::runUntil(const std::string& milestone) {
+    size_t target;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        target = find(milestone);
+    }
+    if (target == NOT_FOUND) {
+        logError("Unknown milestone '" + milestone + "'");
+        return false;
+    }
+
+    drive([this, target]() { return isTerminal(target); }, true);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    return nodes_[target].status == Status::DONE;
+}
+
+void StartupGraph::pump() {
+    drive([]() { return false; }, false);
+}
+
+bool StartupGraph::wait() {
+    drive([this]() { return allTerminal(); }, true);
+    joinWorkers();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    return std::all_of(nodes_.begin(), nodes_.end(),
+                       [](const Node& node) { return node.status == Status::DONE; });
+}
+
+bool StartupGraph::isFinished() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return started_ && allTerminal();
+}
+
+StartupGraph::Status StartupGraph::getStatus(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t index = find(name);
+    return index == NOT_FOUND ? Status::SKIPPED : nodes_[index].status;
+}
+
+std::vector<StartupGraph::StepTiming> StartupGraph::getTimeline() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<StepTiming> timeline;
+    timeline.reserve(nodes_.size());
+    for (const auto& node : nodes_) {
+        timeline.push_back({node.name, node.affinity, node.status, node.startMs, node.endMs});
+    }
+    return timeline;
+}
+
+std::string StartupGraph::formatTimeline() const {
+    std::vector<StepTiming> timeline = getTimeline();
+
+    double totalMs = 0.0;
+    size_t nameWidth = 4;
+    for (const auto& step : timeline) {
+        totalMs = std::max(totalMs, step.endMs);
+        nameWidth = std::max(nameWidth, step.name.size());
+    }
+
+    std::ostringstream out;
+    char line[256];
+    std::snprintf(line, sizeof(line), "Startup timeline (%.0f ms)\n  %-*s  %-6s %8s %8s  %-7s\n", totalMs,
+                  static_cast<int>(nameWidth), "step", "thread", "start", "end", "status");
+    out << line;
+
+    for (const auto& step : timeline) {
+        std::string bar(TIMELINE_BAR_WIDTH, ' ');
+        if (totalMs > 0.0 && step.endMs > 0.0) {
+            int from = static_cast<int>(step.startMs / totalMs * TIMELINE_BAR_WIDTH);
+            int to = std::max(from + 1, static_cast<int>(step.endMs / totalMs * TIMELINE_BAR_WIDTH + 0.5));
+            for (int i = from; i < std::min(to, TIMELINE_BAR_WIDTH); ++i) {
+                bar[static_cast<size_t>(i)] = '#';
+            }
+        }
+        std::snprintf(line, sizeof(line), "  %-*s  %-6s %8.1f %8.1f  %-7s |%s|\n", static_cast<int>(nameWidth),
+                      step.name.c_str(), step.affinity == Affinity::MAIN ? "main" : "worker", step.startMs,
+                      step.endMs, statusName(step.status), bar.c_str());
+        out << line;
+    }
+    return out.str();
+}
+
+const char* StartupGraph::statusName(Status status) {
+    switch (status) {
+        case Status::PENDING: return "pending";
+        case Status::RUNNING: return "running";
+        case Status::DONE: return "ok";
+        case Status::FAILED: return "failed";
+        case Status::SKIPPED: return "skipped";
+        default: return "unknown";
+    }
+}
+
+size_t StartupGraph::find(const std::string& name) const {
+    for (size_t i = 0; i < nodes_.size(); ++i) {
+        if (nodes_[i].name == name) {
+            return i;
+        }
+    }
+    return NOT_FOUND;
+}
+
+bool StartupGraph::isTerminal(size_t index) const {
+    Status status = nodes_[index].status;
+    return status == Status::DONE || status == Status::FAILED || status == Status::SKIPPED;
+}
+
+bool StartupGraph::allTerminal() const {
+    for (size_t i = 0; i < nodes_.size(); ++i) {
+        if (!isTerminal(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool StartupGraph::isReady(size_t index) const {
+    if (nodes_[index].status != Status::PENDING) {
+        return false;
+    }
+    for (size_t dependency : nodes_[index].dependsOn) {
+        if (nodes_[dependency].status != Status::DONE) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void StartupGraph::skipUnreachable() {
+    // Dependencies always come earlier, so one forward pass reaches every
+    // transitive dependent
+    for (auto& node : nodes_) {
+        if (node.status != Status::PENDING) {
+            continue;
+        }
+        for (size_t dependency : node.dependsOn) {
+            Status status = nodes_[dependency].status;
+            if (status == Status::FAILED || status == Status::SKIPPED) {
+                node.status = Status::SKIPPED;
+                break;
+            }
+        }
+    }
+}
+
+void StartupGraph::launchReadyWorkers() {
+    for (size_t i = 0; i < nodes_.size(); ++i) {
+        if (nodes_[i].affinity == Affinity::WORKER && isReady(i)) {
+            nodes_[i].status = Status::RUNNING;
+            nodes_[i].startMs = elapsedMs();
+            ++running_;
+            workers_.emplace_back(&StartupGraph::workerFunc, this, i);
+        }
+    }
+}
+
+void StartupGraph::runMainStep(size_t index, std::unique_lock<std::mutex>& lock) {
+    nodes_[index].status = Status::RUNNING;
+    nodes_[index].startMs = elapsedMs();
+    ++running_;
+
+    lock.unlock();
+    bool ok = runStep(nodes_[index]);
+    lock.lock();
+
+    finish(index, ok);
+}
+
+void StartupGraph::finish(size_t index, bool ok) {
+    Node& node = nodes_[index];
+    node.status = ok ? Status::DONE : Status::FAILED;
+    node.endMs = elapsedMs();
+    --running_;
+
+    if (!ok) {
+        logError("Step '" + node.name + "' failed; skipping the steps that depend on it");
+    }
+
+    auto& registry = MetricsRegistry::global();
+    registry.gauge("kinect_startup_step_seconds", "Time each startup step took", {{"step", node.name}})
+        .set((node.endMs - node.startMs) / 1000.0);
+    registry.gauge("kinect_startup_step_ready_seconds", "Time from launch until each startup step finished",
+                   {{"step", node.name}})
+        .set(node.endMs / 1000.0);
+
+    skipUnreachable();
+    launchReadyWorkers();
+    cv_.notify_all();
+}
+
+double StartupGraph::elapsedMs() const {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - createdAt_).count();
+}
+
+template <typename Done>
+void StartupGraph::drive(Done done, bool block) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!started_) {
+        started_ = true;
+        skipUnreachable();
+        launchReadyWorkers();
+    }
+
+    for (;;) {
+        if (done()) {
+            return;
+        }
+
+        size_t next = NOT_FOUND;
+        for (size_t i = 0; i < nodes_.size(); ++i) {
+            if (nodes_[i].affinity == Affinity::MAIN && isReady(i)) {
+                next = i;
+                break;
+            }
+        }
+        if (next != NOT_FOUND) {
+            runMainStep(next, lock);
+            continue;
+        }
+
+        // Nothing in flight means nothing left can become ready
+        if (!block || running_ == 0) {
+            return;
+        }
+        cv_.wait(lock);
+    }
+}
+
+void StartupGraph::workerFunc(size_t index) {
+    bool ok = runStep(nodes_[index]);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    finish(index, ok);
+}
+
+void StartupGraph::joinWorkers() {
+    std::vector<std::thread> workers;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        workers.swap(workers_);
+    }
+    for (auto& worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+bool StartupGraph::runStep(const Node& node) {
+    try {
+        return node.step ? node.step() : true;
+    } catch (const std::exception& e) {
+        std::cerr << "[StartupGraph ERROR] Step '" << node.name << "' threw: " << e.what() << std::endl;
+        return false;
+    } catch (...) {
+        // Not std::exception; escaping a worker thread would terminate
+        std::cerr << "[StartupGraph ERROR] Step '" << node.name << "' threw an unknown exception" << std::endl;
+        return false;
+    }
+}
+
+void StartupGraph::logError(const std::string& msg) const {
+    std::cerr << "[StartupGraph ERROR] " << msg << std::endl;
+}
+
+} // namespace core
+} // namespace kinect
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace kinect {
+namespace core {
+
+/**
+ * @brief Application startup expressed as a dependency graph
+ *
+ * Each step names the steps it needs. Worker steps start on their own
+ * thread as soon as their dependencies have finished, so independent work
+ * (tracker model load, UI setup) overlaps. Main-thread steps (D3D, ImGui,
+ * anything tied to the window's thread) only run inside runUntil(), pump()
+ * or wait(), on the calling thread.
+ *
+ * A step that fails, or throws, skips every step that depends on it; the
+ * rest of the graph still runs. Start and end of every step are kept for
+ * the timeline report and exported as kinect_startup_step_seconds{step}
+ * (duration) and kinect_startup_step_ready_seconds{step} (finished, from
+ * graph creation).
+ */
+class StartupGraph {
+public:
+    using Step = std::function<bool()>;
+
+    enum class Affinity { MAIN, WORKER };
+    enum class Status { PENDING, RUNNING, DONE, FAILED, SKIPPED };
+
+    struct StepTiming {
+        std::string name;
+        Affinity affinity;
+        Status status;
+        double startMs;   // From graph creation; 0 if the step never ran
+        double endMs;
+    };
+
+    StartupGraph();
+    ~StartupGraph();   // Finishes a started graph (see wait)
+
+    // Non-copyable
+    StartupGraph(const StartupGraph&) = delete;
+    StartupGraph& operator=(const StartupGraph&) = delete;
+
+    /**
+     * @brief Add a step; its dependencies must already have been added
+     * @return false (and the step is not added) on a duplicate name or an
+     *         unknown dependency
+     */
+    bool add(const std::string& name, Affinity affinity, const std::vector<std::string>& dependsOn, Step step);
+
+    /**
+     * @brief Start the graph and run main-thread steps on this thread until
+     *        milestone has finished; worker steps keep running afterwards
+     * @return true if milestone succeeded
+     */
+    bool runUntil(const std::string& milestone);
+
+    /**
+     * @brief Run main-thread steps whose dependencies have finished, without
+     *        waiting for anything (call once per frame after runUntil)
+     */
+    void pump();
+
+    /**
+     * @brief Run the graph to the end and join the worker threads
+     * @return true if every step succeeded
+     */
+    bool wait();
+
+    bool isFinished() const;
+    Status getStatus(const std::string& name) const;
+
+    /**
+     * @brief Per-step timeline, in the order steps were added
+     */
+    std::vector<StepTiming> getTimeline() const;
+
+    /**
+     * @brief Timeline as a text table with one bar per step
+     */
+    std::string formatTimeline() const;
+
+    static const char* statusName(Status status);
+
+private:
+    struct Node {
+        std::string name;
+        Affinity affinity;
+        std::vector<size_t> dependsOn;
+        Step step;
+        Status status = Status::PENDING;
+        double startMs = 0.0;
+        double endMs = 0.0;
+    };
+
+    std::vector<Node> nodes_;
+    std::vector<std::thread> workers_;
+    std::chrono::steady_clock::time_point createdAt_;
+    bool started_ = false;
+    size_t running_ = 0;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+
+    // All called with mutex_ held
+    size_t find(const std::string& name) const;
+    bool isTerminal(size_t index) const;
+    bool allTerminal() const;
+    bool isReady(size_t index) const;
+    void skipUnreachable();
+    void launchReadyWorkers();
+    void runMainStep(size_t index, std::unique_lock<std::mutex>& lock);
+    void finish(size_t index, bool ok);
+    double elapsedMs() const;
+
+    // Start the graph if needed, then run ready main-thread steps until
+    // done() holds; without block, return as soon as none is ready
+    template <typename Done>
+    void drive(Done done, bool block);
+
+    void workerFunc(size_t index);
+    void joinWorkers();
+
+    static bool runStep(const Node& node);
+    void logError(const std::string& msg) const;
+};
+
+} // namespace core
+} // namespace kinect
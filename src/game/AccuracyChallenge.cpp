@@ -12,8 +12,6 @@ AccuracyChallenge::AccuracyChallenge(const AccuracyChallengeConfig& config)
     , activeTarget_(TargetZone::Position::TOP_LEFT)
     , consecutiveHits_(0)
     , lastKickTime_(0.0f)
-    , kickState_(KickState::IDLE)
-    , kickPhaseTimer_(0.0f)
 {
     targetZones_ = config_.targetZones;
 }
@@ -22,22 +20,11 @@ void AccuracyChallenge::start() {
     ChallengeBase::start();
 
     // Randomize first target
-    std::random_device rd;
-    std::mt19937 gen(rd());
     std::uniform_int_distribution<> dis(0, 8);
-    activeTarget_ = static_cast<TargetZone::Position>(dis(gen));
+    activeTarget_ = static_cast<TargetZone::Position>(dis(rng_));
 }
 
-void AccuracyChallenge::processFrame(const k4abt_skeleton_t& skeleton,
-                                     const k4a_image_t& depthImage,
-                                     float deltaTime)
-{
-    ChallengeBase::processFrame(skeleton, depthImage, deltaTime);
-
-    if (state_ != ChallengeState::ACTIVE) {
-        return;
-    }
-
+void AccuracyChallenge::update(const ChallengeFrame&) {
     // Check time limit
     float remaining = getRemainingTime(config_.timeLimitSeconds);
     if (remaining <= 0.0f) {
@@ -50,9 +37,6 @@ void AccuracyChallenge::processFrame(const k4abt_skeleton_t& skeleton,
         finish();
         return;
     }
-
-    // Detect kicks
-    detectKick(skeleton, deltaTime);
 }
 
 void AccuracyChallenge::finish() {
@@ -84,7 +68,6 @@ void AccuracyChallenge::reset() {
     kickHistory_.clear();
     consecutiveHits_ = 0;
     lastKickTime_ = 0.0f;
-    kickState_ = KickState::IDLE;
 
     // Reset all target zones
     for (auto& zone : targetZones_) {
@@ -92,129 +75,42 @@ void AccuracyChallenge::reset() {
     }
 }
 
-void AccuracyChallenge::detectKick(const k4abt_skeleton_t& skeleton, float deltaTime) {
-    // Get foot position (prefer right foot)
-    k4a_float3_t footPos = skeleton.joints[K4ABT_JOINT_FOOT_RIGHT].position;
-
-    // Simple kick detection based on foot velocity
-    if (kickState_ == KickState::IDLE) {
-        // Check for wind-up (foot moving back)
-        float deltaZ = footPos.v[2] - lastFootPosition_.v[2];
-        if (deltaZ > 0.1f) {  // Moving away from camera
-            kickState_ = KickState::WINDING_UP;
-            kickPhaseTimer_ = 0.0f;
-        }
-    }
-    else if (kickState_ == KickState::WINDING_UP) {
-        kickPhaseTimer_ += deltaTime;
-
-        // Check for forward kick motion
-        float deltaZ = footPos.v[2] - lastFootPosition_.v[2];
-        if (deltaZ < -0.15f) {  // Moving toward camera fast
-            kickState_ = KickState::KICKING;
-
-            // Estimate trajectory and record kick
-            k4a_float3_t trajectory = estimateBallTrajectory(skeleton);
-            TargetZone::Position hitZone = determineHitZone(trajectory);
-
-            KickData kick;
-            kick.impactPoint = trajectory;
-            kick.targetZone = hitZone;
-            kick.velocity = std::sqrt(
-                deltaZ * deltaZ +
-                std::pow(footPos.v[0] - lastFootPosition_.v[0], 2) +
-                std::pow(footPos.v[1] - lastFootPosition_.v[1], 2)
-            ) / deltaTime;
-            kick.onTarget = (hitZone == activeTarget_);
-            kick.accuracy = kick.onTarget ? 1.0f : 0.0f;
-            kick.timestamp = std::chrono::steady_clock::now().time_since_epoch().count();
-
-            recordKick(kick);
-        }
-        else if (kickPhaseTimer_ > 1.0f) {
-            // Reset if wind-up took too long
-            kickState_ = KickState::IDLE;
-        }
-    }
-    else if (kickState_ == KickState::KICKING) {
-        kickPhaseTimer_ += deltaTime;
-        if (kickPhaseTimer_ > 0.3f) {
-            kickState_ = KickState::FOLLOW_THROUGH;
-        }
-    }
-    else if (kickState_ == KickState::FOLLOW_THROUGH) {
-        kickPhaseTimer_ += deltaTime;
-        if (kickPhaseTimer_ > 0.5f) {
-            kickState_ = KickState::IDLE;
-        }
-    }
+void AccuracyChallenge::onKick(const KickResult& kick, const ChallengeFrame& frame) {
+    // Fly the ball to the goal plane and record the kick
+    BallFlightResult flight = estimateBallFlight(kick, frame.pose);
+    TargetZone::Position hitZone = determineHitZone(flight.impactPoint);
 
-    lastFootPosition_ = footPos;
-}
-
-bool AccuracyChallenge::isKickingPose(const k4abt_skeleton_t& skeleton) {
-    // Check if foot is behind and elevated (wind-up)
-    auto foot = skeleton.joints[K4ABT_JOINT_FOOT_RIGHT].position;
-    auto knee = skeleton.joints[K4ABT_JOINT_KNEE_RIGHT].position;
+    KickData data;
+    data.impactPoint = flight.impactPoint;
+    data.targetZone = hitZone;
+    data.velocity = kick.quality.footVelocity / 1000.0f;  // mm/s to m/s
+    data.onTarget = flight.reachedGoal && (hitZone == activeTarget_);
+    data.accuracy = data.onTarget ? 1.0f : 0.0f;
+    data.timestamp = clock_->nowNs();
 
-    return foot.v[2] > knee.v[2] && foot.v[1] > knee.v[1] - 0.1f;
+    recordKick(data);
 }
 
-k4a_float3_t AccuracyChallenge::estimateBallTrajectory(const k4abt_skeleton_t& skeleton) {
-    // Simple trajectory estimation based on foot direction
-    auto foot = skeleton.joints[K4ABT_JOINT_FOOT_RIGHT].position;
-    auto knee = skeleton.joints[K4ABT_JOINT_KNEE_RIGHT].position;
-
-    k4a_float3_t direction;
-    direction.v[0] = foot.v[0] - knee.v[0];
-    direction.v[1] = foot.v[1] - knee.v[1];
-    direction.v[2] = foot.v[2] - knee.v[2];
-
-    // Normalize
-    float length = std::sqrt(
-        direction.v[0] * direction.v[0] +
-        direction.v[1] * direction.v[1] +
-        direction.v[2] * direction.v[2]
-    );
-
-    if (length > 0.001f) {
-        direction.v[0] /= length;
-        direction.v[1] /= length;
-        direction.v[2] /= length;
-    }
-
-    // Project to goal plane (assume 5m away)
-    float distanceToGoal = 5.0f;
-    k4a_float3_t impact;
-    impact.v[0] = foot.v[0] + direction.v[0] * distanceToGoal;
-    impact.v[1] = foot.v[1] + direction.v[1] * distanceToGoal;
-    impact.v[2] = foot.v[2] + direction.v[2] * distanceToGoal;
-
-    return impact;
+BallFlightResult AccuracyChallenge::estimateBallFlight(const KickResult& kick,
+                                                       const motion::PoseFeatures& pose)
+{
+    // Foot velocity at contact from the shared detector's direction and speed
+    k4a_float3_t footVelocity = {
+        kick.kickDirection.v[0] * kick.quality.footVelocity,
+        kick.kickDirection.v[1] * kick.quality.footVelocity,
+        kick.kickDirection.v[2] * kick.quality.footVelocity
+    };
+    k4abt_joint_id_t footJoint = kick.foot == DominantFoot::Left
+        ? K4ABT_JOINT_FOOT_LEFT : K4ABT_JOINT_FOOT_RIGHT;
+
+    BallLaunch launch = ballPhysics_.launchFromKick(pose.getJoint(footJoint), footVelocity,
+                                                    kick.type, kick.foot);
+    return ballPhysics_.simulate(launch, config_.goalDistance);
 }
 
 TargetZone::Position AccuracyChallenge::determineHitZone(const k4a_float3_t& impactPoint) {
-    // Map impact point to 3x3 grid
-    // Assume goal is 2.44m high, 7.32m wide (standard soccer goal)
-    // Center of goal is at x=0, y=1.22m
-
-    float goalWidth = 7.32f;
-    float goalHeight = 2.44f;
-    float goalCenterY = 1.22f;
-
-    // Relative position in goal (-1 to 1)
-    float relX = (impactPoint.v[0]) / (goalWidth / 2.0f);
-    float relY = (impactPoint.v[1] - goalCenterY) / (goalHeight / 2.0f);
-
-    // Clamp to goal bounds
-    relX = std::max(-1.0f, std::min(1.0f, relX));
-    relY = std::max(-1.0f, std::min(1.0f, relY));
-
-    // Map to grid position
-    int gridX = relX < -0.33f ? 0 : (relX > 0.33f ? 2 : 1);
-    int gridY = relY > 0.33f ? 0 : (relY < -0.33f ? 2 : 1);
-
-    return static_cast<TargetZone::Position>(gridY * 3 + gridX);
+    // Impact point is in the ball flight frame: x across the goal, y up
+    return TargetZone::positionForGoalPoint(impactPoint.v[0], impactPoint.v[1]);
 }
 
 void AccuracyChallenge::recordKick(const KickData& kick) {
@@ -242,10 +138,8 @@ void AccuracyChallenge::recordKick(const KickData& kick) {
     }
 
     if (!unhitZones.empty()) {
-        std::random_device rd;
-        std::mt19937 gen(rd());
         std::uniform_int_distribution<> dis(0, unhitZones.size() - 1);
-        activeTarget_ = static_cast<TargetZone::Position>(unhitZones[dis(gen)]);
+        activeTarget_ = static_cast<TargetZone::Position>(unhitZones[dis(rng_)]);
     }
 }
 
@@ -287,65 +181,75 @@ void AccuracyChallenge::setActiveTarget(TargetZone::Position target) {
     activeTarget_ = target;
 }
 
-void AccuracyChallenge::render(cv::Mat& frame) {
+void AccuracyChallenge::draw(DrawList& list) {
     switch (state_) {
         case ChallengeState::INSTRUCTIONS:
-            renderInstructions(frame);
+            drawInstructions(list);
             break;
         case ChallengeState::COUNTDOWN:
-            renderCountdown(frame);
+            drawCountdown(list);
             break;
         case ChallengeState::ACTIVE:
-            renderTargetGrid(frame);
-            renderActiveTarget(frame);
-            renderStats(frame);
-            renderKickTrajectory(frame);
+            drawTargetGrid(list);
+            drawActiveTarget(list);
+            drawStats(list);
+            drawKickTrajectory(list);
             break;
         case ChallengeState::COMPLETE:
-            renderResults(frame);
+            drawResults(list);
             break;
         default:
             break;
     }
 }
 
-void AccuracyChallenge::renderTargetGrid(cv::Mat& frame) {
+void AccuracyChallenge::drawTargetGrid(DrawList& list) {
     // Draw 3x3 grid overlay on goal
     int gridWidth = 300;
     int gridHeight = 200;
-    int startX = frame.cols - gridWidth - 50;
+    int startX = list.getWidth() - gridWidth - 50;
     int startY = 50;
 
-    for (int row = 0; row < 3; row++) {
-        for (int col = 0; col < 3; col++) {
-            int x = startX + col * (gridWidth / 3);
-            int y = startY + row * (gridHeight / 3);
-            int w = gridWidth / 3;
-            int h = gridHeight / 3;
-
-            auto position = static_cast<TargetZone::Position>(row * 3 + col);
-            const auto& zone = targetZones_[row * 3 + col];
-
-            cv::Scalar color = zone.isHit
-                ? cv::Scalar(0, 255, 0)  // Green if hit
-                : cv::Scalar(100, 100, 100);  // Gray if not hit
-
-            cv::rectangle(frame, cv::Point(x, y), cv::Point(x + w, y + h),
-                         color, zone.isHit ? -1 : 2);
+    // Rebuilt only when a zone is hit
+    uint64_t hitMask = 0;
+    for (size_t i = 0; i < targetZones_.size(); i++) {
+        hitMask |= targetZones_[i].isHit ? (1ull << i) : 0;
+    }
 
-            // Show multiplier
-            std::string mult = std::to_string(static_cast<int>(zone.scoreMultiplier)) + "x";
-            cv::putText(frame, mult, cv::Point(x + 10, y + h - 10),
-                       cv::FONT_HERSHEY_SIMPLEX, 0.7, cv::Scalar(255, 255, 255), 2);
+    int originX = startX - 5;
+    int originY = startY - 5;
+    gridLayer_.update(originX, originY, gridWidth + 10, gridHeight + 10,
+                      layerKey(hitMask, targetZones_.size()), [&](DrawList& layer) {
+        for (int row = 0; row < 3; row++) {
+            for (int col = 0; col < 3; col++) {
+                int x = startX - originX + col * (gridWidth / 3);
+                int y = startY - originY + row * (gridHeight / 3);
+                int w = gridWidth / 3;
+                int h = gridHeight / 3;
+
+                const auto& zone = targetZones_[row * 3 + col];
+
+                DrawColor color = zone.isHit
+                    ? DrawColor(0, 255, 0)  // Green if hit
+                    : DrawColor(100, 100, 100);  // Gray if not hit
+
+                layer.rect(x, y, x + w, y + h, color, zone.isHit ? DrawList::FILLED : 2);
+
+                // Show multiplier
+                std::string mult = std::to_string(static_cast<int>(zone.scoreMultiplier)) + "x";
+                layer.text(mult, x + 10, y + h - 10, DrawFont::Regular, 0.7f,
+                           DrawColor(255, 255, 255), 2);
+            }
         }
-    }
+    });
+    list.layer(gridLayer_);
 }
 
-void AccuracyChallenge::renderActiveTarget(cv::Mat& frame) {
+void AccuracyChallenge::drawActiveTarget(DrawList& list) {
     // Highlight active target
     int gridWidth = 300;
     int gridHeight = 200;
-    int startX = frame.cols - gridWidth - 50;
+    int startX = list.getWidth() - gridWidth - 50;
     int startY = 50;
 
     int row = static_cast<int>(activeTarget_) / 3;
@@ -358,70 +262,69 @@ void AccuracyChallenge::renderActiveTarget(cv::Mat& frame) {
 
     // Pulsing highlight
     float pulse = 0.5f + 0.5f * std::sin(getElapsedTime() * 4.0f);
-    cv::Scalar highlightColor(0, 255 * pulse, 255);
+    DrawColor highlightColor(0, static_cast<int>(255 * pulse), 255);
 
-    cv::rectangle(frame, cv::Point(x - 5, y - 5),
-                 cv::Point(x + w + 5, y + h + 5),
-                 highlightColor, 4);
+    list.rect(x - 5, y - 5, x + w + 5, y + h + 5, highlightColor, 4);
 }
 
-void AccuracyChallenge::renderStats(cv::Mat& frame) {
-    int yPos = 50;
-
-    // Time remaining
-    float remaining = getRemainingTime(config_.timeLimitSeconds);
-    std::string timeText = "Time: " + std::to_string(static_cast<int>(remaining)) + "s";
-    cv::putText(frame, timeText, cv::Point(50, yPos),
-               cv::FONT_HERSHEY_SIMPLEX, 1.2, cv::Scalar(255, 255, 255), 2);
-    yPos += 50;
-
-    // Score
-    std::string scoreText = "Score: " + std::to_string(currentScore_);
-    cv::putText(frame, scoreText, cv::Point(50, yPos),
-               cv::FONT_HERSHEY_SIMPLEX, 1.2, cv::Scalar(0, 255, 255), 2);
-    yPos += 50;
-
-    // Accuracy
+void AccuracyChallenge::drawStats(DrawList& list) {
+    int remaining = static_cast<int>(getRemainingTime(config_.timeLimitSeconds));
     float accuracy = totalAttempts_ > 0
         ? static_cast<float>(successfulAttempts_) / totalAttempts_
         : 0.0f;
-    std::string accText = "Accuracy: " + std::to_string(static_cast<int>(accuracy * 100)) + "%";
-    cv::putText(frame, accText, cv::Point(50, yPos),
-               cv::FONT_HERSHEY_SIMPLEX, 1.2, cv::Scalar(0, 255, 0), 2);
-    yPos += 50;
-
-    // Zones hit
     int zonesHit = 0;
     for (const auto& zone : targetZones_) {
         if (zone.isHit) zonesHit++;
     }
-    std::string zonesText = "Zones: " + std::to_string(zonesHit) + "/9";
-    cv::putText(frame, zonesText, cv::Point(50, yPos),
-               cv::FONT_HERSHEY_SIMPLEX, 1.2, cv::Scalar(255, 255, 0), 2);
+
+    // Rebuilt when a displayed value changes (at most once a second
+    // while idle, for the timer)
+    uint64_t key = layerKey(remaining, currentScore_, static_cast<int>(accuracy * 100), zonesHit);
+    statsLayer_.update(0, 0, std::min(list.getWidth(), 600), 240, key, [&](DrawList& layer) {
+        int yPos = 50;
+
+        // Time remaining
+        layer.text("Time: " + std::to_string(remaining) + "s", 50, yPos,
+                   DrawFont::Regular, 1.2f, DrawColor(255, 255, 255), 2);
+        yPos += 50;
+
+        // Score
+        layer.text("Score: " + std::to_string(currentScore_), 50, yPos,
+                   DrawFont::Regular, 1.2f, DrawColor(0, 255, 255), 2);
+        yPos += 50;
+
+        // Accuracy
+        layer.text("Accuracy: " + std::to_string(static_cast<int>(accuracy * 100)) + "%", 50, yPos,
+                   DrawFont::Regular, 1.2f, DrawColor(0, 255, 0), 2);
+        yPos += 50;
+
+        // Zones hit
+        layer.text("Zones: " + std::to_string(zonesHit) + "/9", 50, yPos,
+                   DrawFont::Regular, 1.2f, DrawColor(255, 255, 0), 2);
+    });
+    list.layer(statsLayer_);
 }
 
-void AccuracyChallenge::renderKickTrajectory(cv::Mat& frame) {
+void AccuracyChallenge::drawKickTrajectory(DrawList& list) {
     // Draw recent kick trajectory if available
     if (!kickHistory_.empty() && kickHistory_.back().timestamp > 0) {
         auto lastKick = kickHistory_.back();
-        uint64_t now = std::chrono::steady_clock::now().time_since_epoch().count();
+        uint64_t now = clock_->nowNs();
         uint64_t age = now - lastKick.timestamp;
 
         // Only show for 1 second after kick
         if (age < 1000000000) {  // 1 billion nanoseconds = 1 second
-            cv::Scalar color = lastKick.onTarget
-                ? cv::Scalar(0, 255, 0)
-                : cv::Scalar(0, 0, 255);
+            DrawColor color = lastKick.onTarget
+                ? DrawColor(0, 255, 0)
+                : DrawColor(0, 0, 255);
 
             // Show trajectory line (simplified)
-            cv::line(frame,
-                    cv::Point(frame.cols / 2, frame.rows - 100),
-                    cv::Point(frame.cols - 200, 300),
-                    color, 3);
+            list.line(list.getWidth() / 2, list.getHeight() - 100,
+                      list.getWidth() - 200, 300, color, 3);
 
             std::string result = lastKick.onTarget ? "HIT!" : "MISS";
-            cv::putText(frame, result, cv::Point(frame.cols / 2 - 50, frame.rows - 150),
-                       cv::FONT_HERSHEY_BOLD, 2.0, color, 3);
+            list.text(result, list.getWidth() / 2 - 50, list.getHeight() - 150,
+                      DrawFont::Bold, 2.0f, color, 3);
         }
     }
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ChallengeBase.h"
+#include "BallPhysics.h"
 #include "../../include/GameConfig.h"
 
 namespace kinect {
@@ -23,13 +24,10 @@ public:
 
     // Override base methods
     void start() override;
-    void processFrame(const k4abt_skeleton_t& skeleton,
-                     const k4a_image_t& depthImage,
-                     float deltaTime) override;
     void finish() override;
     void reset() override;
 
-    void render(cv::Mat& frame) override;
+    void draw(DrawList& list) override;
 
     std::string getName() const override { return "Accuracy Challenge"; }
     std::string getDescription() const override {
@@ -42,11 +40,14 @@ public:
     const std::vector<TargetZone>& getTargetZones() const { return targetZones_; }
     const std::vector<KickData>& getKickHistory() const { return kickHistory_; }
 
+protected:
+    // Game rules
+    void update(const ChallengeFrame& frame) override;
+    void onKick(const KickResult& kick, const ChallengeFrame& frame) override;
+
 private:
-    // Kick detection
-    void detectKick(const k4abt_skeleton_t& skeleton, float deltaTime);
-    bool isKickingPose(const k4abt_skeleton_t& skeleton);
-    k4a_float3_t estimateBallTrajectory(const k4abt_skeleton_t& skeleton);
+    // Ball flight from the detected kick
+    BallFlightResult estimateBallFlight(const KickResult& kick, const motion::PoseFeatures& pose);
     TargetZone::Position determineHitZone(const k4a_float3_t& impactPoint);
 
     // Scoring
@@ -55,13 +56,14 @@ private:
     void checkComboBonus();
 
     // Rendering helpers
-    void renderTargetGrid(cv::Mat& frame);
-    void renderActiveTarget(cv::Mat& frame);
-    void renderStats(cv::Mat& frame);
-    void renderKickTrajectory(cv::Mat& frame);
+    void drawTargetGrid(DrawList& list);
+    void drawActiveTarget(DrawList& list);
+    void drawStats(DrawList& list);
+    void drawKickTrajectory(DrawList& list);
 
     // Configuration
     AccuracyChallengeConfig config_;
+    BallPhysics ballPhysics_;
 
     // Target zones
     std::vector<TargetZone> targetZones_;
@@ -72,16 +74,9 @@ private:
     int32_t consecutiveHits_;
     float lastKickTime_;
 
-    // Kick detection state
-    enum class KickState {
-        IDLE,
-        WINDING_UP,
-        KICKING,
-        FOLLOW_THROUGH
-    };
-    KickState kickState_;
-    k4a_float3_t lastFootPosition_;
-    float kickPhaseTimer_;
+    // Cached overlay layers
+    RenderLayer gridLayer_;
+    RenderLayer statsLayer_;
 };
 
 } // namespace game
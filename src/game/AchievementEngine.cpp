@@ -0,0 +1,217 @@
+#include "AchievementEngine.h"
+#include <algorithm>
+#include <unordered_set>
+
+namespace kinect {
+namespace game {
+
+AchievementEngine::AchievementEngine()
+    : unlockedCount_(0)
+{
+}
+
+void AchievementEngine::compile(const std::vector<AchievementConfig>& achievements) {
+    // Unlocks survive a recompile under the same id
+    std::unordered_set<std::string> previouslyUnlocked;
+    for (size_t i = 0; i < achievements_.size(); ++i) {
+        if (isUnlocked(i)) {
+            previouslyUnlocked.insert(achievements_[i].id);
+        }
+    }
+
+    achievements_ = achievements;
+    unlockedBits_.assign((achievements_.size() + 63) / 64, 0);
+    unlockedCount_ = 0;
+    indexById_.clear();
+    for (ChallengeTables& tables : tables_) {
+        for (auto& table : tables.results) {
+            table.clear();
+        }
+        for (auto& table : tables.rules) {
+            table.clear();
+        }
+    }
+
+    for (size_t i = 0; i < achievements_.size(); ++i) {
+        AchievementConfig& achievement = achievements_[i];
+        indexById_.emplace(achievement.id, static_cast<uint32_t>(i));
+
+        if (achievement.isUnlocked || previouslyUnlocked.count(achievement.id) > 0) {
+            unlockedBits_[i / 64] |= uint64_t(1) << (i % 64);
+            unlockedCount_++;
+            achievement.isUnlocked = true;
+            continue;
+        }
+
+        size_t type = static_cast<size_t>(achievement.challengeType);
+        if (type >= CHALLENGE_TYPES) {
+            continue;
+        }
+        ChallengeTables& tables = tables_[type];
+        CompiledRule rule{0.0f, static_cast<uint32_t>(i), Metric::NONE};
+
+        switch (achievement.rule) {
+            case AchievementRule::RESULT:
+                // Search on the threshold fewest results reach
+                if (achievement.requiredVelocity > 0.0f) {
+                    rule.metric = Metric::VELOCITY;
+                    rule.key = achievement.requiredVelocity;
+                } else if (achievement.requiredAccuracy > 0.0f) {
+                    rule.metric = Metric::ACCURACY;
+                    rule.key = achievement.requiredAccuracy;
+                } else if (achievement.requiredScore > 0) {
+                    rule.metric = Metric::SCORE;
+                    rule.key = static_cast<float>(achievement.requiredScore);
+                } else if (achievement.requiredAttempts > 0) {
+                    rule.metric = Metric::ATTEMPTS;
+                    rule.key = static_cast<float>(achievement.requiredAttempts);
+                }
+                tables.results[static_cast<size_t>(rule.metric)].push_back(rule);
+                break;
+
+            case AchievementRule::LIFETIME_SUCCESSES:
+                rule.key = static_cast<float>(achievement.requiredAttempts);
+                tables.rules[static_cast<size_t>(achievement.rule)].push_back(rule);
+                break;
+
+            case AchievementRule::RESULT_STREAK:
+                rule.key = achievement.requiredVelocity;
+                tables.rules[static_cast<size_t>(achievement.rule)].push_back(rule);
+                break;
+
+            case AchievementRule::ZONES:
+            case AchievementRule::SUDDEN_DEATH_WIN:
+                tables.rules[static_cast<size_t>(achievement.rule)].push_back(rule);
+                break;
+        }
+    }
+
+    auto byKey = [](const CompiledRule& a, const CompiledRule& b) {
+        return a.key < b.key || (a.key == b.key && a.index < b.index);
+    };
+    for (ChallengeTables& tables : tables_) {
+        for (auto& table : tables.results) {
+            std::sort(table.begin(), table.end(), byKey);
+        }
+        for (auto& table : tables.rules) {
+            std::sort(table.begin(), table.end(), byKey);
+        }
+    }
+}
+
+void AchievementEngine::evaluate(const AchievementEvent& event, std::vector<size_t>& unlocked) {
+    const ChallengeResult& result = event.result;
+    size_t type = static_cast<size_t>(result.type);
+    if (type >= CHALLENGE_TYPES) {
+        return;
+    }
+
+    // Counters first, so rules see this result
+    ChallengeHistory& history = history_[type];
+    history.lifetimeSuccesses += result.successes;
+    while (!history.velocityStack.empty() && history.velocityStack.back().second >= result.maxVelocity) {
+        history.velocityStack.pop_back();
+    }
+    history.velocityStack.emplace_back(history.results++, result.maxVelocity);
+
+    ChallengeTables& tables = tables_[type];
+    auto thresholds = [&](const CompiledRule& rule) {
+        return meetsThresholds(achievements_[rule.index], result);
+    };
+    auto always = [](const CompiledRule&) { return true; };
+
+    // Single-result thresholds
+    auto& results = tables.results;
+    firePrefix(results[static_cast<size_t>(Metric::VELOCITY)], result.maxVelocity, unlocked, thresholds);
+    firePrefix(results[static_cast<size_t>(Metric::ACCURACY)], result.accuracy, unlocked, thresholds);
+    firePrefix(results[static_cast<size_t>(Metric::SCORE)],
+               static_cast<float>(result.finalScore), unlocked, thresholds);
+    firePrefix(results[static_cast<size_t>(Metric::ATTEMPTS)],
+               static_cast<float>(result.attempts), unlocked, thresholds);
+    firePrefix(results[static_cast<size_t>(Metric::NONE)], 0.0f, unlocked, always);
+
+    auto& rules = tables.rules;
+    firePrefix(rules[static_cast<size_t>(AchievementRule::ZONES)], 0.0f, unlocked,
+               [&](const CompiledRule& rule) {
+        uint32_t required = achievements_[rule.index].requiredZones;
+        return (event.zonesHit & required) == required;
+    });
+
+    if (event.suddenDeathWon) {
+        firePrefix(rules[static_cast<size_t>(AchievementRule::SUDDEN_DEATH_WIN)], 0.0f, unlocked, always);
+    }
+
+    firePrefix(rules[static_cast<size_t>(AchievementRule::LIFETIME_SUCCESSES)],
+               static_cast<float>(history.lifetimeSuccesses), unlocked, always);
+
+    // A streak can only complete on a result that reaches its velocity
+    firePrefix(rules[static_cast<size_t>(AchievementRule::RESULT_STREAK)], result.maxVelocity, unlocked,
+               [&](const CompiledRule& rule) {
+        int32_t required = std::max(1, achievements_[rule.index].requiredAttempts);
+        return streakAt(history, rule.key) >= required;
+    });
+}
+
+bool AchievementEngine::isUnlocked(const std::string& id) const {
+    auto it = indexById_.find(id);
+    return it != indexById_.end() && isUnlocked(it->second);
+}
+
+int32_t AchievementEngine::getLifetimeSuccesses(ChallengeType type) const {
+    size_t index = static_cast<size_t>(type);
+    return index < CHALLENGE_TYPES ? history_[index].lifetimeSuccesses : 0;
+}
+
+int32_t AchievementEngine::getStreak(ChallengeType type, float minVelocity) const {
+    size_t index = static_cast<size_t>(type);
+    return index < CHALLENGE_TYPES ? streakAt(history_[index], minVelocity) : 0;
+}
+
+void AchievementEngine::unlock(uint32_t index, std::vector<size_t>& unlocked) {
+    unlockedBits_[index / 64] |= uint64_t(1) << (index % 64);
+    unlockedCount_++;
+    achievements_[index].isUnlocked = true;
+    unlocked.push_back(index);
+}
+
+bool AchievementEngine::meetsThresholds(const AchievementConfig& achievement,
+                                        const ChallengeResult& result) const {
+    return (achievement.requiredScore <= 0 || result.finalScore >= achievement.requiredScore) &&
+           (achievement.requiredAttempts <= 0 || result.attempts >= achievement.requiredAttempts) &&
+           (achievement.requiredAccuracy <= 0.0f || result.accuracy >= achievement.requiredAccuracy) &&
+           (achievement.requiredVelocity <= 0.0f || result.maxVelocity >= achievement.requiredVelocity);
+}
+
+int32_t AchievementEngine::streakAt(const ChallengeHistory& history, float minVelocity) const {
+    if (history.results == 0) {
+        return 0;
+    }
+
+    // Velocities rise towards the top, so everything below minVelocity is
+    // a prefix; its last entry is the most recent result that broke the streak
+    const auto& stack = history.velocityStack;
+    auto firstReaching = std::lower_bound(stack.begin(), stack.end(), minVelocity,
+        [](const std::pair<int32_t, float>& entry, float velocity) { return entry.second < velocity; });
+    int32_t lastBelow = firstReaching == stack.begin() ? -1 : std::prev(firstReaching)->first;
+    return history.results - 1 - lastBelow;
+}
+
+template<typename Predicate>
+void AchievementEngine::firePrefix(std::vector<CompiledRule>& table, float value,
+                                   std::vector<size_t>& unlocked, Predicate&& predicate) {
+    size_t reachable = static_cast<size_t>(std::upper_bound(table.begin(), table.end(), value,
+        [](float v, const CompiledRule& rule) { return v < rule.key; }) - table.begin());
+
+    for (size_t i = 0; i < reachable;) {
+        if (predicate(table[i])) {
+            unlock(table[i].index, unlocked);
+            table.erase(table.begin() + static_cast<std::ptrdiff_t>(i));
+            reachable--;
+        } else {
+            ++i;
+        }
+    }
+}
+
+} // namespace game
+} // namespace kinect
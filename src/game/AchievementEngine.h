@@ -0,0 +1,103 @@
+#pragma once
+
+#include "ChallengeBase.h"
+#include "../../include/GameConfig.h"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace kinect {
+namespace game {
+
+// Everything a finished challenge can unlock achievements with
+struct AchievementEvent {
+    const ChallengeResult& result;
+    uint32_t zonesHit = 0;        // Accuracy: zoneBit() of every zone hit
+    bool suddenDeathWon = false;  // Penalty shootout
+};
+
+// Achievement rules compiled into per-challenge, per-rule tables.
+//
+// compile() sorts each table by the threshold that decides whether a rule
+// can fire, so evaluate() binary-searches to the rules the event reaches
+// and never looks at the rest. Unlocked rules are dropped from the tables
+// and recorded in a bitset, so every rule is checked only until it fires.
+// Lifetime counters and result streaks are kept incrementally per
+// challenge type. Cost per result grows with the rules that fire, not with
+// the number of achievements, and nothing runs per kick.
+class AchievementEngine {
+public:
+    AchievementEngine();
+
+    // Build the tables. Achievements flagged isUnlocked, or unlocked
+    // before under the same id, stay unlocked; counters carry over.
+    void compile(const std::vector<AchievementConfig>& achievements);
+
+    // Apply a finished challenge; appends the index of every achievement
+    // it unlocks to unlocked
+    void evaluate(const AchievementEvent& event, std::vector<size_t>& unlocked);
+
+    // Queries
+    size_t size() const { return achievements_.size(); }
+    const AchievementConfig& get(size_t index) const { return achievements_[index]; }
+    const std::vector<AchievementConfig>& getAll() const { return achievements_; }
+    bool isUnlocked(size_t index) const {
+        return (unlockedBits_[index / 64] >> (index % 64)) & 1u;
+    }
+    bool isUnlocked(const std::string& id) const;
+    size_t getUnlockedCount() const { return unlockedCount_; }
+
+    // Lifetime counters for a challenge type
+    int32_t getLifetimeSuccesses(ChallengeType type) const;
+    int32_t getStreak(ChallengeType type, float minVelocity) const;
+
+private:
+    static constexpr size_t CHALLENGE_TYPES = static_cast<size_t>(ChallengeType::SKILL_MOVE) + 1;
+    static constexpr size_t RULES = static_cast<size_t>(AchievementRule::RESULT_STREAK) + 1;
+
+    // RESULT rules are keyed on their most selective threshold
+    enum class Metric : uint8_t { VELOCITY, ACCURACY, SCORE, ATTEMPTS, NONE };
+    static constexpr size_t METRICS = static_cast<size_t>(Metric::NONE) + 1;
+
+    struct CompiledRule {
+        float key;              // Sort key: the threshold the table is searched on
+        uint32_t index;         // Into achievements_
+        Metric metric;          // RESULT: which value key applies to
+    };
+
+    // One table per (challenge type, rule), plus one per metric for RESULT
+    struct ChallengeTables {
+        std::array<std::vector<CompiledRule>, METRICS> results;
+        std::array<std::vector<CompiledRule>, RULES> rules;
+    };
+
+    // Results of one challenge type, for streaks: a stack of (result index,
+    // max velocity) with velocities rising towards the top. The most recent
+    // result below a threshold is found by binary search.
+    struct ChallengeHistory {
+        int32_t lifetimeSuccesses = 0;
+        int32_t results = 0;
+        std::vector<std::pair<int32_t, float>> velocityStack;
+    };
+
+    std::vector<AchievementConfig> achievements_;
+    std::vector<uint64_t> unlockedBits_;
+    size_t unlockedCount_;
+    std::unordered_map<std::string, uint32_t> indexById_;
+    std::array<ChallengeTables, CHALLENGE_TYPES> tables_;
+    std::array<ChallengeHistory, CHALLENGE_TYPES> history_;
+
+    void unlock(uint32_t index, std::vector<size_t>& unlocked);
+    bool meetsThresholds(const AchievementConfig& achievement, const ChallengeResult& result) const;
+    int32_t streakAt(const ChallengeHistory& history, float minVelocity) const;
+
+    // Unlock every rule in a table sorted by key whose key is <= value
+    template<typename Predicate>
+    void firePrefix(std::vector<CompiledRule>& table, float value,
+                    std::vector<size_t>& unlocked, Predicate&& predicate);
+};
+
+} // namespace game
+} // namespace kinect
@@ -0,0 +1,346 @@
+#include "BallPhysics.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define KINECT_FOOTBALL_BALL_SIMD 1
+#include <emmintrin.h>
+#endif
+
+namespace kinect {
+namespace game {
+
+namespace {
+
+constexpr float TWO_PI = 6.28318530718f;
+
+// Ball speed at which the per-type spin table below applies (m/s)
+constexpr float REFERENCE_SPIN_SPEED = 25.0f;
+
+// Body tracking reports joints in millimeters
+constexpr float MM_TO_M = 0.001f;
+
+// Lane layout of the integrator state and results
+enum StateIndex { PX, PY, PZ, VX, VY, VZ, WX, WY, WZ, STATE_SIZE };
+enum ResultIndex { REACHED, IX, IY, IZ, IVX, IVY, IVZ, TIME, MAX_HEIGHT, RESULT_SIZE };
+
+// Coefficients shared by every lane of one integration
+struct FlightCoefficients {
+    float dt;
+    float goalDistance;
+    float drag;
+    float magnus;
+    float spinDecay;
+    float gravity;
+    float radius;
+    float restitution;
+    float friction;
+    float minBounceSpeed;
+    float rollingDecay;
+    int maxSteps;
+};
+
+// One ball per call
+struct ScalarOps {
+    using Vec = float;
+    using Mask = bool;
+
+    static Vec sqrt(Vec a) { return std::sqrt(a); }
+    static Vec max(Vec a, Vec b) { return a > b ? a : b; }
+    static Mask ge(Vec a, Vec b) { return a >= b; }
+    static Mask lt(Vec a, Vec b) { return a < b; }
+    static Mask le(Vec a, Vec b) { return a <= b; }
+    static Mask both(Mask a, Mask b) { return a && b; }
+    static Mask either(Mask a, Mask b) { return a || b; }
+    static Mask without(Mask a, Mask b) { return a && !b; }
+    static Mask none() { return false; }
+    static Vec select(Mask m, Vec a, Vec b) { return m ? a : b; }
+    static bool all(Mask m) { return m; }
+};
+
+#ifdef KINECT_FOOTBALL_BALL_SIMD
+// Four balls per call in SSE registers
+struct Float4 {
+    __m128 v;
+    Float4() : v(_mm_setzero_ps()) {}
+    Float4(float f) : v(_mm_set1_ps(f)) {}
+    explicit Float4(__m128 m) : v(m) {}
+};
+
+inline Float4 operator+(Float4 a, Float4 b) { return Float4(_mm_add_ps(a.v, b.v)); }
+inline Float4 operator-(Float4 a, Float4 b) { return Float4(_mm_sub_ps(a.v, b.v)); }
+inline Float4 operator*(Float4 a, Float4 b) { return Float4(_mm_mul_ps(a.v, b.v)); }
+inline Float4 operator/(Float4 a, Float4 b) { return Float4(_mm_div_ps(a.v, b.v)); }
+inline Float4& operator+=(Float4& a, Float4 b) { a.v = _mm_add_ps(a.v, b.v); return a; }
+inline Float4& operator*=(Float4& a, Float4 b) { a.v = _mm_mul_ps(a.v, b.v); return a; }
+
+struct SimdOps {
+    using Vec = Float4;
+    using Mask = Float4;
+
+    static Vec sqrt(Vec a) { return Float4(_mm_sqrt_ps(a.v)); }
+    static Vec max(Vec a, Vec b) { return Float4(_mm_max_ps(a.v, b.v)); }
+    static Mask ge(Vec a, Vec b) { return Float4(_mm_cmpge_ps(a.v, b.v)); }
+    static Mask lt(Vec a, Vec b) { return Float4(_mm_cmplt_ps(a.v, b.v)); }
+    static Mask le(Vec a, Vec b) { return Float4(_mm_cmple_ps(a.v, b.v)); }
+    static Mask both(Mask a, Mask b) { return Float4(_mm_and_ps(a.v, b.v)); }
+    static Mask either(Mask a, Mask b) { return Float4(_mm_or_ps(a.v, b.v)); }
+    static Mask without(Mask a, Mask b) { return Float4(_mm_andnot_ps(b.v, a.v)); }
+    static Mask none() { return Float4(); }
+    static Vec select(Mask m, Vec a, Vec b) {
+        return Float4(_mm_or_ps(_mm_and_ps(m.v, a.v), _mm_andnot_ps(m.v, b.v)));
+    }
+    static bool all(Mask m) { return _mm_movemask_ps(m.v) == 0xF; }
+};
+#endif
+
+// Semi-implicit Euler integration of gravity, quadratic drag and Magnus
+// lift until every lane crosses the goal plane, stalls or times out.
+// Written once against Ops so the scalar and SIMD paths give the same
+// answer for the same launch.
+template <typename Ops>
+void integrateFlight(const FlightCoefficients& c,
+                     const typename Ops::Vec* state,
+                     typename Ops::Vec* result)
+{
+    using Vec = typename Ops::Vec;
+    using Mask = typename Ops::Mask;
+
+    Vec px = state[PX], py = state[PY], pz = state[PZ];
+    Vec vx = state[VX], vy = state[VY], vz = state[VZ];
+    Vec wx = state[WX], wy = state[WY], wz = state[WZ];
+
+    const Vec goal = c.goalDistance;
+    const Vec zero = 0.0f;
+    const Vec one = 1.0f;
+
+    Vec ix = zero, iy = zero, iz = zero;
+    Vec ivx = zero, ivy = zero, ivz = zero;
+    Vec timeToGoal = zero;
+    Vec maxHeight = py;
+    Vec t = zero;
+
+    Mask reached = Ops::none();
+    Mask done = Ops::none();
+
+    for (int step = 0; step < c.maxSteps; ++step) {
+        // Forces
+        Vec speed = Ops::sqrt(vx * vx + vy * vy + vz * vz);
+        Vec drag = speed * -c.drag;
+        Vec ax = drag * vx + (wy * vz - wz * vy) * c.magnus;
+        Vec ay = drag * vy + (wz * vx - wx * vz) * c.magnus - c.gravity;
+        Vec az = drag * vz + (wx * vy - wy * vx) * c.magnus;
+
+        // Velocity first, then position with the new velocity
+        vx += ax * c.dt;
+        vy += ay * c.dt;
+        vz += az * c.dt;
+
+        Vec prevX = px, prevY = py, prevZ = pz;
+        px += vx * c.dt;
+        py += vy * c.dt;
+        pz += vz * c.dt;
+        t += c.dt;
+
+        wx *= c.spinDecay;
+        wy *= c.spinDecay;
+        wz *= c.spinDecay;
+
+        maxHeight = Ops::select(done, maxHeight, Ops::max(maxHeight, py));
+
+        // Goal plane crossing, interpolated inside the step
+        Mask crossed = Ops::without(Ops::ge(pz, goal), done);
+        Vec frac = (goal - prevZ) / (pz - prevZ);
+        ix = Ops::select(crossed, prevX + (px - prevX) * frac, ix);
+        iy = Ops::select(crossed, prevY + (py - prevY) * frac, iy);
+        iz = Ops::select(crossed, goal, iz);
+        ivx = Ops::select(crossed, vx, ivx);
+        ivy = Ops::select(crossed, vy, ivy);
+        ivz = Ops::select(crossed, vz, ivz);
+        timeToGoal = Ops::select(crossed, t - (one - frac) * c.dt, timeToGoal);
+        reached = Ops::either(reached, crossed);
+
+        // Ground contact: bounce off a hard landing, otherwise roll
+        Mask ground = Ops::both(Ops::lt(py, c.radius), Ops::lt(vy, zero));
+        Mask bounce = Ops::both(ground, Ops::lt(vy, Vec(-c.minBounceSpeed)));
+        Vec keep = Ops::select(bounce, Vec(c.friction), Vec(c.rollingDecay));
+        vy = Ops::select(bounce, vy * -c.restitution, Ops::select(ground, zero, vy));
+        vx = Ops::select(ground, vx * keep, vx);
+        vz = Ops::select(ground, vz * keep, vz);
+        py = Ops::select(ground, Vec(c.radius), py);
+
+        // Ball no longer travelling toward the goal
+        Mask stalled = Ops::le(vz, zero);
+        done = Ops::either(done, Ops::either(crossed, stalled));
+        if (Ops::all(done)) {
+            break;
+        }
+    }
+
+    result[REACHED] = Ops::select(reached, one, zero);
+    result[IX] = ix;
+    result[IY] = iy;
+    result[IZ] = iz;
+    result[IVX] = ivx;
+    result[IVY] = ivy;
+    result[IVZ] = ivz;
+    result[TIME] = timeToGoal;
+    result[MAX_HEIGHT] = maxHeight;
+}
+
+void loadState(const BallLaunch& launch, float* state) {
+    state[PX] = launch.position.xyz.x;
+    state[PY] = launch.position.xyz.y;
+    state[PZ] = launch.position.xyz.z;
+    state[VX] = launch.velocity.xyz.x;
+    state[VY] = launch.velocity.xyz.y;
+    state[VZ] = launch.velocity.xyz.z;
+    state[WX] = launch.spin.xyz.x;
+    state[WY] = launch.spin.xyz.y;
+    state[WZ] = launch.spin.xyz.z;
+}
+
+BallFlightResult storeResult(const float* result) {
+    BallFlightResult flight;
+    flight.reachedGoal = result[REACHED] > 0.5f;
+    flight.impactPoint = {result[IX], result[IY], result[IZ]};
+    flight.impactVelocity = {result[IVX], result[IVY], result[IVZ]};
+    flight.timeToGoal = result[TIME];
+    flight.maxHeight = result[MAX_HEIGHT];
+    return flight;
+}
+
+} // namespace
+
+BallPhysics::BallPhysics(const BallPhysicsConfig& config)
+    : config_(config)
+{
+    float area = 3.14159265359f * config_.radius * config_.radius;
+    dragFactor_ = 0.5f * config_.airDensity * config_.dragCoefficient * area / config_.mass;
+    magnusFactor_ = 0.5f * config_.airDensity * config_.magnusCoefficient * area * config_.radius / config_.mass;
+    spinDecay_ = std::exp(-config_.spinDecayRate * TIMESTEP);
+    rollingDecay_ = std::exp(-config_.rollingDecayRate * TIMESTEP);
+    maxSteps_ = static_cast<int>(std::ceil(config_.maxFlightTime * STEP_HZ));
+}
+
+BallFlightResult BallPhysics::simulate(const BallLaunch& launch, float goalDistance) const {
+    FlightCoefficients c{TIMESTEP, goalDistance, dragFactor_, magnusFactor_, spinDecay_,
+                         config_.gravity, config_.radius, config_.restitution,
+                         config_.groundFriction, config_.minBounceSpeed, rollingDecay_, maxSteps_};
+
+    float state[STATE_SIZE];
+    float result[RESULT_SIZE];
+    loadState(launch, state);
+    integrateFlight<ScalarOps>(c, state, result);
+    return storeResult(result);
+}
+
+void BallPhysics::simulateBatch(const BallLaunch* launches,
+                                BallFlightResult* results,
+                                size_t count,
+                                float goalDistance) const
+{
+#ifdef KINECT_FOOTBALL_BALL_SIMD
+    FlightCoefficients c{TIMESTEP, goalDistance, dragFactor_, magnusFactor_, spinDecay_,
+                         config_.gravity, config_.radius, config_.restitution,
+                         config_.groundFriction, config_.minBounceSpeed, rollingDecay_, maxSteps_};
+
+    for (size_t base = 0; base < count; base += BATCH_LANES) {
+        // Transpose up to four launches into lanes; a short final group
+        // repeats its last launch so the idle lanes finish with it
+        alignas(16) float lanes[STATE_SIZE][BATCH_LANES];
+        for (size_t lane = 0; lane < BATCH_LANES; ++lane) {
+            float state[STATE_SIZE];
+            loadState(launches[std::min(base + lane, count - 1)], state);
+            for (int i = 0; i < STATE_SIZE; ++i) {
+                lanes[i][lane] = state[i];
+            }
+        }
+
+        Float4 state[STATE_SIZE];
+        Float4 result[RESULT_SIZE];
+        for (int i = 0; i < STATE_SIZE; ++i) {
+            state[i] = Float4(_mm_load_ps(lanes[i]));
+        }
+
+        integrateFlight<SimdOps>(c, state, result);
+
+        alignas(16) float out[RESULT_SIZE][BATCH_LANES];
+        for (int i = 0; i < RESULT_SIZE; ++i) {
+            _mm_store_ps(out[i], result[i].v);
+        }
+        for (size_t lane = 0; lane < BATCH_LANES && base + lane < count; ++lane) {
+            float flight[RESULT_SIZE];
+            for (int i = 0; i < RESULT_SIZE; ++i) {
+                flight[i] = out[i][lane];
+            }
+            results[base + lane] = storeResult(flight);
+        }
+    }
+#else
+    for (size_t i = 0; i < count; ++i) {
+        results[i] = simulate(launches[i], goalDistance);
+    }
+#endif
+}
+
+BallLaunch BallPhysics::launchFromKick(const k4a_float3_t& footPosition,
+                                       const k4a_float3_t& footVelocity,
+                                       KickType type,
+                                       DominantFoot foot) const
+{
+    k4a_float3_t velocity = cameraToWorld(footVelocity);
+    velocity.xyz.x *= FOOT_TO_BALL_SPEED;
+    velocity.xyz.y *= FOOT_TO_BALL_SPEED;
+    velocity.xyz.z *= FOOT_TO_BALL_SPEED;
+
+    // Ball starts on the ground in line with the kicking foot
+    BallLaunch launch;
+    launch.position = {cameraToWorld(footPosition).xyz.x, config_.radius, 0.0f};
+    launch.velocity = velocity;
+
+    // Spin in revolutions per second at the reference speed.
+    // Sidespin is about +y and bends the ball toward the kicker's left
+    // (+x); topspin is about +x and makes the ball dip.
+    float sideSpin = 0.0f;
+    float topSpin = 0.0f;
+    switch (type) {
+        case KickType::Instep:
+            sideSpin = 6.0f;   // Curled with the inside of the laces
+            topSpin = 1.0f;
+            break;
+        case KickType::Outside:
+            sideSpin = -6.0f;  // Trivela bends the other way
+            break;
+        case KickType::SideFootPass:
+            sideSpin = 2.0f;
+            break;
+        case KickType::Volley:
+            topSpin = 4.0f;
+            break;
+        default:
+            break;
+    }
+
+    // A left-footed strike curls the opposite way
+    if (foot == DominantFoot::Left) {
+        sideSpin = -sideSpin;
+    }
+
+    float speed = std::sqrt(velocity.xyz.x * velocity.xyz.x +
+                            velocity.xyz.y * velocity.xyz.y +
+                            velocity.xyz.z * velocity.xyz.z);
+    float scale = std::min(speed / REFERENCE_SPIN_SPEED, 1.5f) * TWO_PI;
+    launch.spin = {topSpin * scale, sideSpin * scale, 0.0f};
+
+    return launch;
+}
+
+k4a_float3_t BallPhysics::cameraToWorld(const k4a_float3_t& v) {
+    // Camera: millimeters, X to the right of the image, Y down, Z away from
+    // the sensor. Seen from behind, the kicker's left is camera -X.
+    return {-v.xyz.x * MM_TO_M, -v.xyz.y * MM_TO_M, v.xyz.z * MM_TO_M};
+}
+
+} // namespace game
+} // namespace kinect
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "../../include/KickTypes.h"
+#include <k4a/k4a.h>
+#include <cstddef>
+
+namespace kinect {
+namespace game {
+
+// Ball flight model.
+//
+// World frame used by the simulation (meters, right-handed):
+//   x - toward the kicker's left
+//   y - up, ground at y = 0
+//   z - from the kicker toward the goal
+// The goal mouth is the plane z = goalDistance, centred on x = 0.
+//
+// The sensor is assumed to stand behind the kicker, looking past them at
+// the screen, so a kick toward the goal moves along camera +Z as
+// motion::KickDetector expects. The world frame is then the camera frame
+// turned half a turn about its Z axis.
+
+// Physical constants and integration settings
+struct BallPhysicsConfig {
+    float mass = 0.43f;              // kg (FIFA size 5)
+    float radius = 0.11f;            // m
+    float airDensity = 1.225f;       // kg/m^3
+    float dragCoefficient = 0.25f;   // Post drag-crisis value at shot speeds
+    float magnusCoefficient = 1.0f;  // Lift per unit spin ratio
+    float spinDecayRate = 0.05f;     // 1/s, exponential decay of spin
+    float gravity = 9.81f;           // m/s^2
+    float restitution = 0.6f;        // Vertical bounce coefficient
+    float groundFriction = 0.85f;    // Horizontal speed kept per bounce
+    float minBounceSpeed = 1.0f;     // m/s, slower landings settle into a roll
+    float rollingDecayRate = 0.3f;   // 1/s, exponential decay of rolling speed
+    float maxFlightTime = 3.0f;      // s, give up after this
+};
+
+// Initial ball state at contact
+struct BallLaunch {
+    k4a_float3_t position;  // m, world frame
+    k4a_float3_t velocity;  // m/s, world frame
+    k4a_float3_t spin;      // rad/s, world frame (angular velocity vector)
+};
+
+// Outcome of a simulated flight at the goal plane
+struct BallFlightResult {
+    bool reachedGoal = false;        // Crossed the goal plane before stopping
+    k4a_float3_t impactPoint{};      // Position when crossing the goal plane
+    k4a_float3_t impactVelocity{};   // Velocity when crossing the goal plane
+    float timeToGoal = 0.0f;         // s from contact
+    float maxHeight = 0.0f;          // m, apex of the flight
+};
+
+class BallPhysics {
+public:
+    // Fixed integration rate, independent of the tracker frame rate
+    static constexpr float STEP_HZ = 240.0f;
+    static constexpr float TIMESTEP = 1.0f / STEP_HZ;
+
+    // Width of the SIMD batch kernel
+    static constexpr size_t BATCH_LANES = 4;
+
+    // Ball speed relative to foot speed at contact (matches KickAnalyzer)
+    static constexpr float FOOT_TO_BALL_SPEED = 1.25f;
+
+    explicit BallPhysics(const BallPhysicsConfig& config = BallPhysicsConfig());
+
+    // Simulate one ball until it crosses z = goalDistance or stops
+    BallFlightResult simulate(const BallLaunch& launch, float goalDistance) const;
+
+    // Simulate many candidate launches against the same goal plane.
+    // Candidates are integrated BATCH_LANES at a time in SIMD registers.
+    void simulateBatch(const BallLaunch* launches,
+                       BallFlightResult* results,
+                       size_t count,
+                       float goalDistance) const;
+
+    // Build a launch from tracked foot motion at contact. Inputs are in
+    // camera space as the tracker reports them (mm and mm/s); spin is estimated from the kick type and kicking foot
+    // so instep and outside-of-the-foot strikes curve.
+    BallLaunch launchFromKick(const k4a_float3_t& footPosition,
+                              const k4a_float3_t& footVelocity,
+                              KickType type,
+                              DominantFoot foot) const;
+
+    // Camera space point or vector (mm) -> world frame (m)
+    static k4a_float3_t cameraToWorld(const k4a_float3_t& v);
+
+    const BallPhysicsConfig& getConfig() const { return config_; }
+
+private:
+    BallPhysicsConfig config_;
+
+    // Derived per-step coefficients
+    float dragFactor_;     // 0.5 * rho * Cd * A / m
+    float magnusFactor_;   // 0.5 * rho * Cl * A * r / m
+    float spinDecay_;      // exp(-spinDecayRate * dt)
+    float rollingDecay_;   // exp(-rollingDecayRate * dt)
+    int maxSteps_;
+};
+
+} // namespace game
+} // namespace kinect
@@ -1,5 +1,6 @@
 #include "ChallengeBase.h"
 #include <algorithm>
+#include <cmath>
 
 namespace kinect {
 namespace game {
@@ -7,39 +8,76 @@ namespace game {
 ChallengeBase::ChallengeBase(ChallengeType type)
     : type_(type)
     , state_(ChallengeState::IDLE)
+    , clock_(&GameClock::wall())
     , timerRunning_(false)
     , countdownRemaining_(3.0f)
+    , drawLag_(0.0f)
     , currentScore_(0)
     , totalAttempts_(0)
     , successfulAttempts_(0)
+    , rng_(std::random_device{}())
 {
     result_.type = type;
 }
 
 void ChallengeBase::start() {
-    setState(ChallengeState::INSTRUCTIONS);
+    // reset() returns to IDLE, so it has to come first
     reset();
+    setState(ChallengeState::INSTRUCTIONS);
 }
 
-void ChallengeBase::processFrame(const k4abt_skeleton_t& skeleton,
-                                 const k4a_image_t& depthImage,
-                                 float deltaTime)
-{
-    currentTime_ = std::chrono::steady_clock::now();
+void ChallengeBase::beginCountdown() {
+    if (state_ == ChallengeState::INSTRUCTIONS) {
+        setState(ChallengeState::COUNTDOWN);
+    }
+}
+
+void ChallengeBase::pause() {
+    if (state_ == ChallengeState::ACTIVE) {
+        setState(ChallengeState::PAUSED);
+    }
+}
+
+void ChallengeBase::resume() {
+    if (state_ == ChallengeState::PAUSED) {
+        setState(ChallengeState::ACTIVE);
+    }
+}
+
+void ChallengeBase::processFrame(const ChallengeFrame& frame) {
+    currentTime_ = clock_->now();
 
     // Handle countdown
     if (state_ == ChallengeState::COUNTDOWN) {
-        countdownRemaining_ -= deltaTime;
+        countdownRemaining_ -= frame.deltaTime;
         if (countdownRemaining_ <= 0.0f) {
             setState(ChallengeState::ACTIVE);
             startTimer();
         }
     }
+
+    if (state_ != ChallengeState::ACTIVE) {
+        return;
+    }
+
+    // Game rules (time and attempt limits, animations)
+    update(frame);
+
+    // Kicks from the shared detector
+    for (const motion::MotionEvent& event : frame.events) {
+        if (state_ != ChallengeState::ACTIVE) {
+            break;
+        }
+        if (event.type == motion::MotionEventType::Kick) {
+            onKick(event.kick, frame);
+        }
+    }
 }
 
 void ChallengeBase::finish() {
-    stopTimer();
+    // Result first: the duration comes from the running timer
     updateResult();
+    stopTimer();
     setState(ChallengeState::COMPLETE);
 }
 
@@ -60,7 +98,7 @@ void ChallengeBase::setState(ChallengeState newState) {
 }
 
 void ChallengeBase::startTimer() {
-    startTime_ = std::chrono::steady_clock::now();
+    startTime_ = clock_->now();
     timerRunning_ = true;
 }
 
@@ -118,109 +156,91 @@ std::string ChallengeBase::calculateGrade(int32_t score, int32_t maxScore) const
     return "F";
 }
 
-void ChallengeBase::renderInstructions(cv::Mat& frame) {
-    // Draw semi-transparent overlay
-    cv::Mat overlay = frame.clone();
-    cv::rectangle(overlay, cv::Point(0, 0),
-                 cv::Point(frame.cols, frame.rows),
-                 cv::Scalar(0, 0, 0), -1);
-    cv::addWeighted(overlay, 0.7, frame, 0.3, 0, frame);
-
-    // Title
-    std::string title = getName();
-    cv::Size textSize = cv::getTextSize(title, cv::FONT_HERSHEY_BOLD,
-                                       2.5, 4, nullptr);
-    cv::Point titlePos(frame.cols / 2 - textSize.width / 2, 200);
-    cv::putText(frame, title, titlePos, cv::FONT_HERSHEY_BOLD,
-               2.5, cv::Scalar(0, 255, 255), 4);
-
-    // Description
-    std::string desc = getDescription();
-    textSize = cv::getTextSize(desc, cv::FONT_HERSHEY_SIMPLEX,
-                              1.2, 2, nullptr);
-    cv::Point descPos(frame.cols / 2 - textSize.width / 2, 300);
-    cv::putText(frame, desc, descPos, cv::FONT_HERSHEY_SIMPLEX,
-               1.2, cv::Scalar(255, 255, 255), 2);
-
-    // Ready prompt
-    std::string ready = "Wave to start!";
-    textSize = cv::getTextSize(ready, cv::FONT_HERSHEY_BOLD,
-                              1.5, 3, nullptr);
-    cv::Point readyPos(frame.cols / 2 - textSize.width / 2,
-                      frame.rows - 150);
-    cv::putText(frame, ready, readyPos, cv::FONT_HERSHEY_BOLD,
-               1.5, cv::Scalar(0, 255, 0), 3);
-}
-
-void ChallengeBase::renderCountdown(cv::Mat& frame) {
-    int countdown = static_cast<int>(std::ceil(countdownRemaining_));
-    if (countdown < 1) countdown = 1;
+void ChallengeBase::drawInstructions(DrawList& list) {
+    // Darken the camera image
+    list.fade(DrawColor(0, 0, 0, 179));
 
-    std::string countText = std::to_string(countdown);
-    cv::Size textSize = cv::getTextSize(countText, cv::FONT_HERSHEY_BOLD,
-                                       10.0, 15, nullptr);
-    cv::Point pos(frame.cols / 2 - textSize.width / 2,
-                 frame.rows / 2 + textSize.height / 2);
+    // The text only changes with the challenge
+    instructionsLayer_.update(0, 0, list.getWidth(), list.getHeight(),
+                              layerKey(getName(), getDescription()), [this](DrawList& layer) {
+        int centerX = layer.getWidth() / 2;
 
-    // Pulsing effect
-    float pulse = 1.0f + (1.0f - (countdownRemaining_ - countdown)) * 0.3f;
-    cv::Scalar color = countdown <= 1
-        ? cv::Scalar(0, 255, 0)  // Green for GO
-        : cv::Scalar(0, 255, 255);  // Yellow for countdown
+        // Title
+        layer.text(getName(), centerX, 200, DrawFont::Bold, 2.5f,
+                   DrawColor(0, 255, 255), 4, TextAnchor::BaselineCenter);
 
-    cv::putText(frame, countText, pos, cv::FONT_HERSHEY_BOLD,
-               10.0 * pulse, color, static_cast<int>(15 * pulse));
+        // Description
+        layer.text(getDescription(), centerX, 300, DrawFont::Regular, 1.2f,
+                   DrawColor(255, 255, 255), 2, TextAnchor::BaselineCenter);
+
+        // Ready prompt
+        layer.text("Wave to start!", centerX, layer.getHeight() - 150, DrawFont::Bold, 1.5f,
+                   DrawColor(0, 255, 0), 3, TextAnchor::BaselineCenter);
+    });
+    list.layer(instructionsLayer_);
 }
 
-void ChallengeBase::renderResults(cv::Mat& frame) {
-    // Background
-    cv::Mat overlay = frame.clone();
-    cv::rectangle(overlay, cv::Point(0, 0),
-                 cv::Point(frame.cols, frame.rows),
-                 cv::Scalar(20, 20, 20), -1);
-    cv::addWeighted(overlay, 0.85, frame, 0.15, 0, frame);
+void ChallengeBase::drawCountdown(DrawList& list) {
+    float remaining = countdownRemaining_ + drawLag_;
+    int countdown = static_cast<int>(std::ceil(remaining));
+    if (countdown < 1) countdown = 1;
 
-    int yPos = 150;
+    // Pulsing effect
+    float pulse = 1.0f + (1.0f - (remaining - countdown)) * 0.3f;
+    DrawColor color = countdown <= 1
+        ? DrawColor(0, 255, 0)  // Green for GO
+        : DrawColor(0, 255, 255);  // Yellow for countdown
 
-    // Title
-    std::string title = "Challenge Complete!";
-    cv::Size textSize = cv::getTextSize(title, cv::FONT_HERSHEY_BOLD,
-                                       2.0, 3, nullptr);
-    cv::Point titlePos(frame.cols / 2 - textSize.width / 2, yPos);
-    cv::putText(frame, title, titlePos, cv::FONT_HERSHEY_BOLD,
-               2.0, cv::Scalar(0, 255, 255), 3);
+    list.text(std::to_string(countdown), list.getWidth() / 2, list.getHeight() / 2,
+              DrawFont::Bold, 10.0f * pulse, color, static_cast<int>(15 * pulse),
+              TextAnchor::Center);
+}
 
-    yPos += 100;
+void ChallengeBase::drawResults(DrawList& list) {
+    // Background
+    list.fade(DrawColor(20, 20, 20, 217));
 
-    // Grade
     result_.grade = calculateGrade(result_.finalScore, 1000);  // Subclass should override
-    textSize = cv::getTextSize(result_.grade, cv::FONT_HERSHEY_BOLD,
-                              8.0, 12, nullptr);
-    cv::Point gradePos(frame.cols / 2 - textSize.width / 2, yPos + textSize.height);
-
-    cv::Scalar gradeColor = result_.grade == "S" || result_.grade == "A"
-        ? cv::Scalar(0, 255, 0)  // Green
-        : result_.grade == "B" || result_.grade == "C"
-        ? cv::Scalar(0, 255, 255)  // Yellow
-        : cv::Scalar(0, 0, 255);  // Red
-
-    cv::putText(frame, result_.grade, gradePos, cv::FONT_HERSHEY_BOLD,
-               8.0, gradeColor, 12);
-
-    yPos += 250;
-
-    // Stats
-    auto drawStat = [&](const std::string& label, const std::string& value) {
-        std::string stat = label + ": " + value;
-        cv::putText(frame, stat, cv::Point(frame.cols / 2 - 300, yPos),
-                   cv::FONT_HERSHEY_SIMPLEX, 1.3, cv::Scalar(255, 255, 255), 2);
-        yPos += 60;
-    };
-
-    drawStat("Score", std::to_string(result_.finalScore));
-    drawStat("Accuracy", std::to_string(static_cast<int>(result_.accuracy * 100)) + "%");
-    drawStat("Attempts", std::to_string(result_.attempts));
-    drawStat("Time", std::to_string(static_cast<int>(result_.duration)) + "s");
+
+    // Results are fixed once the challenge is complete
+    uint64_t key = layerKey(result_.grade, result_.finalScore,
+                            static_cast<int>(result_.accuracy * 100), result_.attempts,
+                            static_cast<int>(result_.duration));
+    resultsLayer_.update(0, 0, list.getWidth(), list.getHeight(), key, [this](DrawList& layer) {
+        int centerX = layer.getWidth() / 2;
+        int yPos = 150;
+
+        // Title
+        layer.text("Challenge Complete!", centerX, yPos, DrawFont::Bold, 2.0f,
+                   DrawColor(0, 255, 255), 3, TextAnchor::BaselineCenter);
+
+        yPos += 100;
+
+        // Grade
+        DrawColor gradeColor = result_.grade == "S" || result_.grade == "A"
+            ? DrawColor(0, 255, 0)  // Green
+            : result_.grade == "B" || result_.grade == "C"
+            ? DrawColor(0, 255, 255)  // Yellow
+            : DrawColor(0, 0, 255);  // Red
+
+        layer.text(result_.grade, centerX, yPos, DrawFont::Bold, 8.0f,
+                   gradeColor, 12, TextAnchor::TopCenter);
+
+        yPos += 250;
+
+        // Stats
+        auto drawStat = [&](const std::string& label, const std::string& value) {
+            layer.text(label + ": " + value, centerX - 300, yPos, DrawFont::Regular, 1.3f,
+                       DrawColor(255, 255, 255), 2);
+            yPos += 60;
+        };
+
+        drawStat("Score", std::to_string(result_.finalScore));
+        drawStat("Accuracy", std::to_string(static_cast<int>(result_.accuracy * 100)) + "%");
+        drawStat("Attempts", std::to_string(result_.attempts));
+        drawStat("Time", std::to_string(static_cast<int>(result_.duration)) + "s");
+    });
+    list.layer(resultsLayer_);
 }
 
 } // namespace game
@@ -1,18 +1,18 @@
 #pragma once
 
 #include "../../include/GameConfig.h"
+#include "../motion/PoseFeatures.h"
+#include "../motion/MotionEventBus.h"
+#include "DrawList.h"
+#include "GameClock.h"
+#include "RenderLayer.h"
 #include <k4a/k4a.h>
 #include <k4abt.h>
 #include <cstdint>
 #include <chrono>
+#include <random>
 #include <string>
-
-#ifdef HAVE_OPENCV
-#include <opencv2/opencv.hpp>
-#else
-// Forward declare cv::Mat for compilation without OpenCV
-namespace cv { class Mat; }
-#endif
+#include <vector>
 
 namespace kinect {
 namespace game {
@@ -32,6 +32,17 @@ struct ChallengeResult {
     std::string grade;  // S, A, B, C, D, F
 };
 
+// One frame from the shared motion pipeline. Every challenge sees the same
+// kick recognition and only applies its own game rules on top of it.
+struct ChallengeFrame {
+    const motion::PoseFeatures& pose;
+    const std::vector<motion::MotionEvent>& events;  // Published since the last frame
+    KickPhase kickPhase;                             // Shared KickDetector phase
+    float footSpeed;                                 // Kicking foot speed (mm/s)
+    const k4a_image_t& depthImage;
+    float deltaTime;
+};
+
 // Base class for all challenges
 class ChallengeBase {
 public:
@@ -40,11 +51,22 @@ public:
 
     // Challenge lifecycle
     virtual void start();
-    virtual void processFrame(const k4abt_skeleton_t& skeleton,
-                             const k4a_image_t& depthImage,
-                             float deltaTime);
+    void beginCountdown();  // Player is ready: INSTRUCTIONS -> COUNTDOWN
+    void processFrame(const ChallengeFrame& frame);
     virtual void finish();
     virtual void reset();
+    void pause();
+    void resume();
+
+    // Determinism. Game time is read from the clock (wall time unless
+    // set) and all randomness comes from the seeded generator. Both must
+    // be set before start() for a run to be reproducible.
+    void setClock(const GameClock& clock) { clock_ = &clock; }
+    virtual void seed(uint32_t seed) { rng_.seed(seed); }
+
+    // Fixed-step rendering: draw() shows animations this many seconds
+    // before the latest step, between it and the previous one
+    void setDrawLag(float seconds) { drawLag_ = seconds; }
 
     // State management
     ChallengeState getState() const { return state_; }
@@ -54,11 +76,12 @@ public:
     // Results
     ChallengeResult getResult() const { return result_; }
 
-    // Rendering
-    virtual void render(cv::Mat& frame) = 0;
-    virtual void renderInstructions(cv::Mat& frame);
-    virtual void renderCountdown(cv::Mat& frame);
-    virtual void renderResults(cv::Mat& frame);
+    // Rendering: append this frame's draw commands to a list already reset
+    // to the output size. Backends turn the list into pixels.
+    virtual void draw(DrawList& list) = 0;
+    virtual void drawInstructions(DrawList& list);
+    virtual void drawCountdown(DrawList& list);
+    virtual void drawResults(DrawList& list);
 
     // Configuration
     ChallengeType getType() const { return type_; }
@@ -66,6 +89,11 @@ public:
     virtual std::string getDescription() const = 0;
 
 protected:
+    // Game-rule hooks, called by processFrame() only while ACTIVE.
+    // update() runs first each frame, then onKick() for each completed kick.
+    virtual void update(const ChallengeFrame&) {}
+    virtual void onKick(const KickResult&, const ChallengeFrame&) {}
+
     // State transitions
     void setState(ChallengeState newState);
 
@@ -89,7 +117,8 @@ protected:
     ChallengeResult result_;
 
     // Timing
-    using TimePoint = std::chrono::steady_clock::time_point;
+    using TimePoint = GameClock::TimePoint;
+    const GameClock* clock_;
     TimePoint startTime_;
     TimePoint currentTime_;
     bool timerRunning_;
@@ -97,12 +126,22 @@ protected:
     // Countdown
     float countdownRemaining_;
 
+    // Seconds to rewind animation timers by when drawing (setDrawLag)
+    float drawLag_;
+
     // Stats
     int32_t currentScore_;
     int32_t totalAttempts_;
     int32_t successfulAttempts_;
 
+    // Randomness (target selection, goalkeeper)
+    std::mt19937 rng_;
+
 private:
+    // Cached instruction and result screens
+    RenderLayer instructionsLayer_;
+    RenderLayer resultsLayer_;
+
     // Non-copyable
     ChallengeBase(const ChallengeBase&) = delete;
     ChallengeBase& operator=(const ChallengeBase&) = delete;
@@ -0,0 +1,88 @@
+#include "DrawList.h"
+#include "RenderLayer.h"
+
+namespace kinect {
+namespace game {
+
+DrawList::DrawList()
+    : width_(0)
+    , height_(0)
+{
+}
+
+void DrawList::reset(int width, int height) {
+    commands_.clear();
+    text_.clear();
+    layers_.clear();
+    width_ = width;
+    height_ = height;
+}
+
+DrawCommand& DrawList::push(DrawOp op, DrawColor color, int thickness) {
+    commands_.emplace_back();
+    DrawCommand& command = commands_.back();
+    command.op = op;
+    command.font = DrawFont::Regular;
+    command.anchor = TextAnchor::BaselineLeft;
+    command.thickness = static_cast<int16_t>(thickness);
+    command.color = color;
+    command.x0 = command.y0 = command.x1 = command.y1 = 0.0f;
+    command.payload = 0;
+    command.length = 0;
+    return command;
+}
+
+void DrawList::rect(int x0, int y0, int x1, int y1, DrawColor color, int thickness) {
+    DrawCommand& command = push(DrawOp::Rect, color, thickness);
+    command.x0 = static_cast<float>(x0);
+    command.y0 = static_cast<float>(y0);
+    command.x1 = static_cast<float>(x1);
+    command.y1 = static_cast<float>(y1);
+}
+
+void DrawList::line(int x0, int y0, int x1, int y1, DrawColor color, int thickness) {
+    DrawCommand& command = push(DrawOp::Line, color, thickness);
+    command.x0 = static_cast<float>(x0);
+    command.y0 = static_cast<float>(y0);
+    command.x1 = static_cast<float>(x1);
+    command.y1 = static_cast<float>(y1);
+}
+
+void DrawList::circle(int x, int y, int radius, DrawColor color, int thickness) {
+    DrawCommand& command = push(DrawOp::Circle, color, thickness);
+    command.x0 = static_cast<float>(x);
+    command.y0 = static_cast<float>(y);
+    command.x1 = static_cast<float>(radius);
+}
+
+void DrawList::text(const std::string& text, int x, int y, DrawFont font, float scale,
+                    DrawColor color, int thickness, TextAnchor anchor) {
+    DrawCommand& command = push(DrawOp::Text, color, thickness);
+    command.font = font;
+    command.anchor = anchor;
+    command.x0 = static_cast<float>(x);
+    command.y0 = static_cast<float>(y);
+    command.x1 = scale;
+    command.payload = static_cast<uint32_t>(text_.size());
+    command.length = static_cast<uint32_t>(text.size());
+    text_.append(text);
+    text_.push_back('\0');  // Backends may need C strings
+}
+
+void DrawList::sprite(uint32_t id, int x0, int y0, int x1, int y1) {
+    DrawCommand& command = push(DrawOp::Sprite, DrawColor(255, 255, 255), 0);
+    command.x0 = static_cast<float>(x0);
+    command.y0 = static_cast<float>(y0);
+    command.x1 = static_cast<float>(x1);
+    command.y1 = static_cast<float>(y1);
+    command.payload = id;
+}
+
+void DrawList::layer(const RenderLayer& layer) {
+    DrawCommand& command = push(DrawOp::Layer, DrawColor(), 0);
+    command.payload = static_cast<uint32_t>(layers_.size());
+    layers_.push_back(&layer);
+}
+
+} // namespace game
+} // namespace kinect
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace kinect {
+namespace game {
+
+class RenderLayer;
+
+// 8-bit colour in OpenCV channel order, so cv::Scalar(b, g, r) maps 1:1
+struct DrawColor {
+    uint8_t b = 0;
+    uint8_t g = 0;
+    uint8_t r = 0;
+    uint8_t a = 255;
+
+    DrawColor() = default;
+    DrawColor(int blue, int green, int red, int alpha = 255)
+        : b(clamp(blue)), g(clamp(green)), r(clamp(red)), a(clamp(alpha)) {}
+
+private:
+    static uint8_t clamp(int v) { return static_cast<uint8_t>(v < 0 ? 0 : v > 255 ? 255 : v); }
+};
+
+enum class DrawFont : uint8_t {
+    Regular,
+    Bold
+};
+
+// Which point of the text (x, y) refers to
+enum class TextAnchor : uint8_t {
+    BaselineLeft,     // x = left edge, y = baseline
+    BaselineCenter,   // x = centre, y = baseline
+    TopCenter,        // x = centre, y = top of the glyphs
+    Center            // x = centre, y = middle of the glyphs
+};
+
+enum class DrawOp : uint8_t {
+    Rect,
+    Line,
+    Circle,
+    Text,
+    Sprite,
+    Layer
+};
+
+// One draw command. Coordinates are in list pixels; the meaning of the
+// fields depends on op:
+//   Rect    (x0, y0)-(x1, y1)
+//   Line    (x0, y0)-(x1, y1)
+//   Circle  centre (x0, y0), radius x1
+//   Text    position (x0, y0), scale x1; text in [payload, payload + length)
+//   Sprite  (x0, y0)-(x1, y1), sprite id in payload
+//   Layer   layer index in payload
+struct DrawCommand {
+    DrawOp op;
+    DrawFont font;
+    TextAnchor anchor;
+    int16_t thickness;    // FILLED (-1) fills rects and circles
+    DrawColor color;
+    float x0, y0, x1, y1;
+    uint32_t payload;
+    uint32_t length;
+};
+
+// A frame's worth of backend-agnostic draw commands.
+//
+// Challenges describe what to draw into a DrawList; a DrawBackend turns it
+// into pixels (OpenCvDrawBackend), GPU draw calls (gui::ImGuiDrawBackend) or
+// nothing (NullDrawBackend). Commands are plain structs in one vector and
+// text goes into one shared buffer, so after the first frame building a list
+// allocates nothing.
+class DrawList {
+public:
+    static constexpr int FILLED = -1;
+
+    DrawList();
+
+    // Start a new frame of the given size; keeps the allocated capacity
+    void reset(int width, int height);
+
+    int getWidth() const { return width_; }
+    int getHeight() const { return height_; }
+
+    // Primitives. thickness FILLED fills; alpha < 255 blends over what is below.
+    void rect(int x0, int y0, int x1, int y1, DrawColor color, int thickness = 1);
+    void line(int x0, int y0, int x1, int y1, DrawColor color, int thickness = 1);
+    void circle(int x, int y, int radius, DrawColor color, int thickness = 1);
+    void text(const std::string& text, int x, int y, DrawFont font, float scale,
+              DrawColor color, int thickness = 1, TextAnchor anchor = TextAnchor::BaselineLeft);
+    void sprite(uint32_t id, int x0, int y0, int x1, int y1);
+
+    // Blend the whole frame towards a colour (alpha = strength)
+    void fade(DrawColor color) { rect(0, 0, width_, height_, color, FILLED); }
+
+    // Reference a retained layer; it must outlive the submit of this list
+    void layer(const RenderLayer& layer);
+
+    // Access for backends
+    const std::vector<DrawCommand>& getCommands() const { return commands_; }
+    const char* getText(const DrawCommand& command) const { return text_.data() + command.payload; }
+    const RenderLayer& getLayer(const DrawCommand& command) const { return *layers_[command.payload]; }
+    size_t size() const { return commands_.size(); }
+    bool empty() const { return commands_.empty(); }
+
+private:
+    std::vector<DrawCommand> commands_;
+    std::string text_;
+    std::vector<const RenderLayer*> layers_;
+    int width_;
+    int height_;
+
+    DrawCommand& push(DrawOp op, DrawColor color, int thickness);
+};
+
+// Consumes draw lists
+class DrawBackend {
+public:
+    virtual ~DrawBackend() = default;
+    virtual void submit(const DrawList& list) = 0;
+};
+
+// Discards everything; for measuring game logic and list building alone
+class NullDrawBackend : public DrawBackend {
+public:
+    void submit(const DrawList& list) override { commandCount_ += list.size(); }
+    uint64_t getCommandCount() const { return commandCount_; }
+
+private:
+    uint64_t commandCount_ = 0;
+};
+
+} // namespace game
+} // namespace kinect
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace kinect {
+namespace game {
+
+// Time source for game logic.
+//
+// By default it reads steady_clock. In manual mode it only moves when
+// advanced, so game time is a pure function of the frame deltas fed in and
+// a recorded run replays to the same results at any speed.
+class GameClock {
+public:
+    using TimePoint = std::chrono::steady_clock::time_point;
+
+    GameClock()
+        : manual_(false)
+        , manualTime_()
+    {
+    }
+
+    // Switch to manual time, starting at the given point
+    void setManual(TimePoint start = TimePoint()) {
+        manual_ = true;
+        manualTime_ = start;
+    }
+    void setWall() { manual_ = false; }
+    bool isManual() const { return manual_; }
+
+    // Move manual time forward (no-op on the wall clock). Uses the same
+    // microsecond rounding as GameManager's synthesized pose timestamps.
+    void advance(float seconds) {
+        if (manual_) {
+            manualTime_ += std::chrono::microseconds(static_cast<uint64_t>(seconds * 1000000.0f));
+        }
+    }
+
+    TimePoint now() const {
+        return manual_ ? manualTime_ : std::chrono::steady_clock::now();
+    }
+
+    // Nanoseconds since the clock's epoch, the unit of kick timestamps
+    uint64_t nowNs() const {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            now().time_since_epoch()).count());
+    }
+
+    // Shared wall clock for challenges that are not given one
+    static const GameClock& wall() {
+        static const GameClock clock;
+        return clock;
+    }
+
+private:
+    bool manual_;
+    TimePoint manualTime_;
+};
+
+} // namespace game
+} // namespace kinect
@@ -2,15 +2,53 @@
 #include "AccuracyChallenge.h"
 #include "PowerChallenge.h"
 #include "PenaltyShootout.h"
-#include "ScoringEngine.h"
+#include "InputRecording.h"
+#include <algorithm>
+#include <cmath>
+#ifdef HAVE_OPENCV
+#include <opencv2/opencv.hpp>
+#endif
 
 namespace kinect {
 namespace game {
 
+namespace {
+
+// Past this gap between the stepped input and the tracker, jump to it
+constexpr uint64_t REANCHOR_US = 250000;
+
+uint64_t stepMicroseconds(const SimulationConfig& simulation) {
+    float hz = simulation.stepHz > 0.0f ? simulation.stepHz : 120.0f;
+    return std::max<uint64_t>(1000, static_cast<uint64_t>(std::llround(1000000.0 / hz)));
+}
+
+} // namespace
+
 GameManager::GameManager(const GameConfig& config)
     : config_(config)
+    , gameEvents_(nullptr)
+    , frameClockUs_(0)
+    , stepSkeleton_()
+    , stepUs_(stepMicroseconds(config.simulation))
+    , stepAccumulatorUs_(0)
+    , stepTimeUs_(0)
+    , stepAnchored_(false)
+    , fixedStep_(false)
+    , noDepth_(nullptr)
     , sessionActive_(false)
+    , deterministic_(false)
+    , seed_(0)
+    , challengesStarted_(0)
+    , recording_(nullptr)
 {
+    achievements_.compile(config_.achievements);
+
+    // Completed kicks go out on the bus; the game's own subscription is
+    // drained into the current frame right after detection
+    frameEvents_.reserve(4);
+    stepEvents_.reserve(4);
+    eventBus_.attach(kickDetector_);
+    gameEvents_ = eventBus_.subscribe("game", motion::motionEventBit(motion::MotionEventType::Kick));
 }
 
 GameManager::~GameManager() {
@@ -31,9 +69,13 @@ void GameManager::shutdown() {
 }
 
 bool GameManager::startChallenge(ChallengeType type) {
+    if (recording_) {
+        recording_->addControl(InputEventType::START_CHALLENGE, type);
+    }
+
     // End current challenge if any
     if (currentChallenge_) {
-        stopCurrentChallenge();
+        completeCurrentChallenge();
     }
 
     // Create new challenge
@@ -42,7 +84,18 @@ bool GameManager::startChallenge(ChallengeType type) {
         return false;
     }
 
-    // Start challenge
+    // Game time and randomness
+    currentChallenge_->setClock(clock_);
+    if (deterministic_) {
+        std::seed_seq sequence{seed_, ++challengesStarted_};
+        uint32_t challengeSeed;
+        sequence.generate(&challengeSeed, &challengeSeed + 1);
+        currentChallenge_->seed(challengeSeed);
+    }
+
+    // Start challenge with no half-finished kick carried over
+    kickDetector_.reset();
+    frameEvents_.clear();
     currentChallenge_->start();
 
     // Callback
@@ -53,7 +106,24 @@ bool GameManager::startChallenge(ChallengeType type) {
     return true;
 }
 
+void GameManager::startCountdown() {
+    if (recording_) {
+        recording_->addControl(InputEventType::START_COUNTDOWN);
+    }
+
+    if (currentChallenge_) {
+        currentChallenge_->beginCountdown();
+    }
+}
+
 void GameManager::stopCurrentChallenge() {
+    if (recording_) {
+        recording_->addControl(InputEventType::STOP_CHALLENGE);
+    }
+    completeCurrentChallenge();
+}
+
+void GameManager::completeCurrentChallenge() {
     if (!currentChallenge_) {
         return;
     }
@@ -72,6 +142,10 @@ void GameManager::stopCurrentChallenge() {
     // Check achievements
     checkAchievements(result);
 
+    if (recording_) {
+        recording_->addResult(result);
+    }
+
     // Callback
     if (onChallengeComplete_) {
         onChallengeComplete_(result);
@@ -82,40 +156,168 @@ void GameManager::stopCurrentChallenge() {
 }
 
 void GameManager::pauseCurrentChallenge() {
-    if (currentChallenge_ && currentChallenge_->isActive()) {
-        currentChallenge_->setState(ChallengeState::PAUSED);
+    if (recording_) {
+        recording_->addControl(InputEventType::PAUSE);
+    }
+
+    if (currentChallenge_) {
+        currentChallenge_->pause();
     }
 }
 
 void GameManager::resumeCurrentChallenge() {
-    if (currentChallenge_ && currentChallenge_->getState() == ChallengeState::PAUSED) {
-        currentChallenge_->setState(ChallengeState::ACTIVE);
+    if (recording_) {
+        recording_->addControl(InputEventType::RESUME);
+    }
+
+    if (currentChallenge_) {
+        currentChallenge_->resume();
     }
 }
 
 void GameManager::processFrame(const k4abt_skeleton_t& skeleton,
                                const k4a_image_t& depthImage,
                                float deltaTime)
+{
+    frameClockUs_ += static_cast<uint64_t>(deltaTime * 1000000.0f);
+    motion::PoseFeatures pose(skeleton, frameClockUs_);
+    processFrame(pose, depthImage, deltaTime);
+}
+
+void GameManager::processFrame(const motion::PoseFeatures& pose,
+                               const k4a_image_t& depthImage,
+                               float deltaTime)
+{
+    if (recording_) {
+        recording_->addFrame(pose.getSkeleton(), pose.getTimestamp(), deltaTime);
+    }
+    clock_.advance(deltaTime);
+
+    // One detection pass per frame, shared by every challenge mode
+    frameEvents_.clear();
+    kickDetector_.processFrame(pose);
+    collectEvents();
+
+    stepChallenge(pose, depthImage, frameEvents_, deltaTime);
+}
+
+void GameManager::pushFrame(const motion::PoseFeatures& pose) {
+    if (recording_) {
+        recording_->addTrackerFrame(pose.getSkeleton(), pose.getTimestamp());
+    }
+
+    // Tracker time went backwards (restart): start the input timeline over
+    if (!inputFrames_.empty() && pose.getTimestamp() <= inputFrames_.getNewestTimestamp()) {
+        inputFrames_.clear();
+        frameEvents_.clear();
+        stepAnchored_ = false;
+    }
+    inputFrames_.push(pose.getSkeleton(), pose.getTimestamp());
+
+    // Detection runs at tracker rate; kicks queue in frameEvents_
+    kickDetector_.processFrame(pose);
+    collectEvents();
+}
+
+void GameManager::collectEvents() {
+    motion::MotionEvent event;
+    while (gameEvents_->poll(event)) {
+        frameEvents_.push_back(event);
+    }
+}
+
+int GameManager::advance(float deltaTime) {
+    if (recording_) {
+        recording_->addAdvance(deltaTime);
+    }
+    fixedStep_ = true;
+
+    stepAccumulatorUs_ += static_cast<uint64_t>(std::llround(std::max(0.0f, deltaTime) * 1000000.0));
+
+    int steps = 0;
+    while (stepAccumulatorUs_ >= stepUs_) {
+        if (steps == config_.simulation.maxStepsPerAdvance) {
+            // Too far behind (debugger, stall): drop the backlog
+            stepAccumulatorUs_ %= stepUs_;
+            break;
+        }
+        stepAccumulatorUs_ -= stepUs_;
+        runFixedStep();
+        steps++;
+    }
+    return steps;
+}
+
+float GameManager::getInterpolationAlpha() const {
+    return static_cast<float>(stepAccumulatorUs_) / static_cast<float>(stepUs_);
+}
+
+void GameManager::runFixedStep() {
+    float stepSeconds = static_cast<float>(stepUs_) / 1000000.0f;
+    clock_.advance(stepSeconds);
+
+    // Input time trails the newest tracker frame, so each step normally has
+    // a frame on either side to interpolate between
+    stepTimeUs_ += stepUs_;
+    if (!inputFrames_.empty()) {
+        uint64_t delayUs = static_cast<uint64_t>(
+            std::llround(std::max(0.0f, config_.simulation.interpolationDelay) * 1000000.0));
+        uint64_t newest = inputFrames_.getNewestTimestamp();
+        uint64_t target = newest > delayUs ? newest - delayUs : 0;
+        if (!stepAnchored_ || stepTimeUs_ + REANCHOR_US < target) {
+            stepTimeUs_ = target;
+            stepAnchored_ = true;
+        }
+        inputFrames_.sample(stepTimeUs_, stepSkeleton_);
+    }
+    stepPose_.reset(stepSkeleton_, stepTimeUs_);
+
+    // Kicks reach the challenge on the step that reaches their frame
+    stepEvents_.clear();
+    auto due = std::find_if(frameEvents_.begin(), frameEvents_.end(),
+        [this](const motion::MotionEvent& event) { return event.deviceTimestamp > stepTimeUs_; });
+    stepEvents_.assign(frameEvents_.begin(), due);
+    frameEvents_.erase(frameEvents_.begin(), due);
+
+    stepChallenge(stepPose_, noDepth_, stepEvents_, stepSeconds);
+}
+
+void GameManager::stepChallenge(const motion::PoseFeatures& pose, const k4a_image_t& depthImage,
+                                const std::vector<motion::MotionEvent>& events, float deltaTime)
 {
     if (!currentChallenge_) {
         return;
     }
 
     // Process frame
-    currentChallenge_->processFrame(skeleton, depthImage, deltaTime);
+    ChallengeFrame frame{pose, events, kickDetector_.getCurrentPhase(),
+                         kickDetector_.getFootSpeed(), depthImage, deltaTime};
+    currentChallenge_->processFrame(frame);
 
     // Check if challenge completed
     if (currentChallenge_->isComplete()) {
-        stopCurrentChallenge();
+        completeCurrentChallenge();
     }
 }
 
-void GameManager::render(cv::Mat& frame) {
+void GameManager::draw(DrawList& list) {
     if (currentChallenge_) {
-        currentChallenge_->render(frame);
+        // Between steps, show the state part way from the previous step
+        float lag = fixedStep_ ? (1.0f - getInterpolationAlpha()) * stepUs_ / 1000000.0f : 0.0f;
+        currentChallenge_->setDrawLag(lag);
+        currentChallenge_->draw(list);
     }
 }
 
+#ifdef HAVE_OPENCV
+void GameManager::render(cv::Mat& frame) {
+    drawList_.reset(frame.cols, frame.rows);
+    draw(drawList_);
+    rasterizer_.setTarget(frame);
+    rasterizer_.submit(drawList_);
+}
+#endif
+
 bool GameManager::hasActiveChallenge() const {
     return currentChallenge_ != nullptr;
 }
@@ -129,18 +331,26 @@ ChallengeState GameManager::getCurrentChallengeState() const {
 }
 
 void GameManager::startSession() {
+    if (recording_) {
+        recording_->addControl(InputEventType::START_SESSION);
+    }
+
     sessionActive_ = true;
     sessionStats_ = SessionStats();
-    sessionStartTime_ = std::chrono::steady_clock::now();
+    sessionStartTime_ = clock_.now();
 }
 
 void GameManager::endSession() {
+    if (recording_) {
+        recording_->addControl(InputEventType::END_SESSION);
+    }
+
     if (!sessionActive_) {
         return;
     }
 
     // Calculate session duration
-    auto now = std::chrono::steady_clock::now();
+    auto now = clock_.now();
     auto duration = std::chrono::duration_cast<std::chrono::seconds>(
         now - sessionStartTime_
     );
@@ -149,6 +359,33 @@ void GameManager::endSession() {
     sessionActive_ = false;
 }
 
+void GameManager::setDeterministic(uint32_t seed) {
+    deterministic_ = true;
+    seed_ = seed;
+    challengesStarted_ = 0;
+    clock_.setManual();
+    frameClockUs_ = 0;
+    kickDetector_.reset();
+    frameEvents_.clear();
+
+    inputFrames_.clear();
+    stepSkeleton_ = k4abt_skeleton_t();
+    stepAccumulatorUs_ = 0;
+    stepTimeUs_ = 0;
+    stepAnchored_ = false;
+}
+
+bool GameManager::startRecording(InputRecording& recording) {
+    if (!deterministic_ || currentChallenge_ || sessionActive_) {
+        return false;
+    }
+
+    setDeterministic(seed_);
+    recording.clear(seed_);
+    recording_ = &recording;
+    return true;
+}
+
 std::unique_ptr<ChallengeBase> GameManager::createChallenge(ChallengeType type) {
     switch (type) {
         case ChallengeType::ACCURACY:
@@ -188,126 +425,53 @@ void GameManager::updateSessionStats(const ChallengeResult& result) {
     }
 }
 
-void GameManager::checkAchievements(const ChallengeResult& result) {
-    switch (result.type) {
-        case ChallengeType::ACCURACY:
-            checkAccuracyAchievements(result);
-            break;
-
-        case ChallengeType::POWER:
-            checkPowerAchievements(result);
-            break;
-
-        case ChallengeType::PENALTY_SHOOTOUT:
-            checkPenaltyAchievements(result);
-            break;
-
-        default:
-            break;
-    }
+void GameManager::updateConfig(const GameConfig& config) {
+    config_ = config;
+    stepUs_ = stepMicroseconds(config_.simulation);
+    stepAccumulatorUs_ = std::min(stepAccumulatorUs_, stepUs_ - 1);
+    achievements_.compile(config_.achievements);
 }
 
-void GameManager::checkAccuracyAchievements(const ChallengeResult& result) {
-    // Get accuracy challenge for zone data
-    auto* accuracyChallenge = dynamic_cast<AccuracyChallenge*>(currentChallenge_.get());
-    if (!accuracyChallenge) {
-        return;
-    }
-
-    const auto& zones = accuracyChallenge->getTargetZones();
-
-    // Bullseye - all zones hit
-    if (AchievementChecker::checkBullseye(result, zones)) {
-        unlockAchievement("bullseye");
-    }
-
-    // Corner Specialist
-    if (AchievementChecker::checkCornerSpecialist(zones)) {
-        unlockAchievement("corner_specialist");
-    }
-
-    // Sharpshooter
-    if (AchievementChecker::checkSharpshooter(result)) {
-        unlockAchievement("sharpshooter");
-    }
-}
-
-void GameManager::checkPowerAchievements(const ChallengeResult& result) {
-    // Thunderstrike - 100+ km/h
-    if (AchievementChecker::checkThunderstrike(result.maxVelocity)) {
-        unlockAchievement("thunderstrike");
-    }
-
-    // Rocket Shot - 120+ km/h
-    if (AchievementChecker::checkRocketShot(result.maxVelocity)) {
-        unlockAchievement("rocket_shot");
-    }
-
-    // Consistent Power - track recent kicks
-    lifetimeStats_.recentPowerKicks.push_back(result.maxVelocity);
-    if (lifetimeStats_.recentPowerKicks.size() > 3) {
-        lifetimeStats_.recentPowerKicks.erase(lifetimeStats_.recentPowerKicks.begin());
-    }
-
-    if (AchievementChecker::checkConsistentPower(lifetimeStats_.recentPowerKicks)) {
-        unlockAchievement("consistent_power");
-    }
-}
-
-void GameManager::checkPenaltyAchievements(const ChallengeResult& result) {
-    // Track lifetime penalty goals
-    lifetimeStats_.totalPenaltiesScored += result.successes;
-
-    // Perfect Five
-    if (AchievementChecker::checkPerfectFive(result.successes, result.attempts)) {
-        unlockAchievement("perfect_five");
-    }
+void GameManager::checkAchievements(const ChallengeResult& result) {
+    AchievementEvent event{result};
 
-    // Ice Cold - sudden death win
-    auto* penaltyChallenge = dynamic_cast<PenaltyShootout*>(currentChallenge_.get());
-    if (penaltyChallenge && penaltyChallenge->isSuddenDeath() && result.passed) {
-        lifetimeStats_.suddenDeathWon = true;
-        unlockAchievement("ice_cold");
+    // Zone and sudden-death data the result doesn't carry
+    if (auto* accuracyChallenge = dynamic_cast<AccuracyChallenge*>(currentChallenge_.get())) {
+        for (const auto& zone : accuracyChallenge->getTargetZones()) {
+            if (zone.isHit) {
+                event.zonesHit |= zoneBit(zone.position);
+            }
+        }
     }
-
-    // Penalty Master
-    if (AchievementChecker::checkPenaltyMaster(lifetimeStats_.totalPenaltiesScored)) {
-        unlockAchievement("penalty_master");
+    if (auto* penaltyChallenge = dynamic_cast<PenaltyShootout*>(currentChallenge_.get())) {
+        event.suddenDeathWon = penaltyChallenge->isSuddenDeath() && result.passed;
     }
-}
 
-void GameManager::unlockAchievement(const std::string& achievementId) {
-    // Find achievement
-    for (auto& achievement : config_.achievements) {
-        if (achievement.id == achievementId && !achievement.isUnlocked) {
-            achievement.isUnlocked = true;
-            sessionStats_.achievementsUnlocked.push_back(achievementId);
+    unlockedScratch_.clear();
+    achievements_.evaluate(event, unlockedScratch_);
 
-            // Callback
-            if (onAchievementUnlocked_) {
-                onAchievementUnlocked_(achievement);
-            }
+    for (size_t index : unlockedScratch_) {
+        const AchievementConfig& achievement = achievements_.get(index);
+        sessionStats_.achievementsUnlocked.push_back(achievement.id);
 
-            break;
+        // Callback
+        if (onAchievementUnlocked_) {
+            onAchievementUnlocked_(achievement);
         }
     }
 }
 
 bool GameManager::isAchievementUnlocked(const std::string& achievementId) const {
-    for (const auto& achievement : config_.achievements) {
-        if (achievement.id == achievementId) {
-            return achievement.isUnlocked;
-        }
-    }
-    return false;
+    return achievements_.isUnlocked(achievementId);
 }
 
 std::vector<AchievementConfig> GameManager::getUnlockedAchievements() const {
     std::vector<AchievementConfig> unlocked;
+    unlocked.reserve(achievements_.getUnlockedCount());
 
-    for (const auto& achievement : config_.achievements) {
-        if (achievement.isUnlocked) {
-            unlocked.push_back(achievement);
+    for (size_t i = 0; i < achievements_.size(); ++i) {
+        if (achievements_.isUnlocked(i)) {
+            unlocked.push_back(achievements_.get(i));
         }
     }
 
@@ -315,7 +479,7 @@ std::vector<AchievementConfig> GameManager::getUnlockedAchievements() const {
 }
 
 std::vector<AchievementConfig> GameManager::getAllAchievements() const {
-    return config_.achievements;
+    return achievements_.getAll();
 }
 
 } // namespace game
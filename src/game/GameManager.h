@@ -1,7 +1,14 @@
 #pragma once
 
 #include "ChallengeBase.h"
+#include "AchievementEngine.h"
+#include "GameClock.h"
+#include "SkeletonInterpolator.h"
+#ifdef HAVE_OPENCV
+#include "OpenCvDrawBackend.h"
+#endif
 #include "../../include/GameConfig.h"
+#include "../motion/KickDetector.h"
 #include <memory>
 #include <vector>
 #include <map>
@@ -14,6 +21,7 @@ namespace game {
 class AccuracyChallenge;
 class PowerChallenge;
 class PenaltyShootout;
+class InputRecording;
 
 // Session stats
 struct SessionStats {
@@ -43,23 +51,52 @@ public:
 
     // Challenge management
     bool startChallenge(ChallengeType type);
+    void startCountdown();  // Player is ready: leave the instructions screen
     void stopCurrentChallenge();
     void pauseCurrentChallenge();
     void resumeCurrentChallenge();
 
-    // Frame processing
+    // Frame processing (timestamps are synthesized from deltaTime)
     void processFrame(const k4abt_skeleton_t& skeleton,
                      const k4a_image_t& depthImage,
                      float deltaTime);
 
-    // Rendering
+    // Frame processing with pose features shared with the motion detectors.
+    // Runs the single kick detector every challenge consumes.
+    void processFrame(const motion::PoseFeatures& pose,
+                     const k4a_image_t& depthImage,
+                     float deltaTime);
+
+    // Fixed-step simulation (config.simulation). Tracker frames go to
+    // pushFrame() as they arrive and only feed kick detection. advance() is
+    // called once per loop iteration with real elapsed time and runs the
+    // challenge rules in fixed steps, each with the skeleton interpolated at
+    // that step's time and the kicks detected up to it. Game timing never
+    // depends on the tracker rate; a tracker stall holds the last pose.
+    // Use this or processFrame(), not both. Steps carry no depth image.
+    void pushFrame(const motion::PoseFeatures& pose);
+    int advance(float deltaTime);           // Returns the steps run
+    float getInterpolationAlpha() const;    // 0-1, from the last step to the next
+
+    // Rendering. draw() appends the current challenge's commands to a list
+    // already reset to the output size, for any DrawBackend; render()
+    // rasterises them onto an OpenCV frame (OpenCV builds only).
+    void draw(DrawList& list);
+#ifdef HAVE_OPENCV
     void render(cv::Mat& frame);
+#endif
 
     // State queries
     bool hasActiveChallenge() const;
     ChallengeType getCurrentChallengeType() const;
     ChallengeState getCurrentChallengeState() const;
     ChallengeBase* getCurrentChallenge() const { return currentChallenge_.get(); }
+    KickPhase getKickPhase() const { return kickDetector_.getCurrentPhase(); }
+
+    // Every kick the shared detector completes is published here, on the
+    // thread calling processFrame()/pushFrame(). Session tracking and other
+    // consumers subscribe instead of hooking the detector.
+    motion::MotionEventBus& getEventBus() { return eventBus_; }
 
     // Session management
     void startSession();
@@ -67,15 +104,33 @@ public:
     bool isSessionActive() const { return sessionActive_; }
     const SessionStats& getSessionStats() const { return sessionStats_; }
 
-    // Configuration
+    // Configuration. Recompiles the achievement rules; unlocks carry over.
     const GameConfig& getConfig() const { return config_; }
-    void updateConfig(const GameConfig& config) { config_ = config; }
+    void updateConfig(const GameConfig& config);
+
+    // Deterministic mode: game time advances only by the deltaTime passed
+    // to processFrame() and each challenge is seeded from the given seed,
+    // so the same inputs always give the same results. Restarts the game
+    // clock; call before the session.
+    void setDeterministic(uint32_t seed);
+    bool isDeterministic() const { return deterministic_; }
+    uint32_t getSeed() const { return seed_; }
+    const GameClock& getClock() const { return clock_; }
+
+    // Input recording for InputReplayer. Needs deterministic mode and no
+    // session or challenge in progress; restarts deterministic mode with
+    // the current seed so the replay starts from the same state. The
+    // recording must outlive stopRecording().
+    bool startRecording(InputRecording& recording);
+    void stopRecording() { recording_ = nullptr; }
+    bool isRecording() const { return recording_ != nullptr; }
 
     // Achievements
     void checkAchievements(const ChallengeResult& result);
     bool isAchievementUnlocked(const std::string& achievementId) const;
     std::vector<AchievementConfig> getUnlockedAchievements() const;
     std::vector<AchievementConfig> getAllAchievements() const;
+    const AchievementEngine& getAchievementEngine() const { return achievements_; }
 
     // Event callbacks
     void setOnChallengeStart(ChallengeStartCallback callback) {
@@ -92,23 +147,60 @@ private:
     // Challenge factory
     std::unique_ptr<ChallengeBase> createChallenge(ChallengeType type);
 
+    // Finish, score and drop the current challenge
+    void completeCurrentChallenge();
+
+    // Run the current challenge's rules for one frame or step
+    void stepChallenge(const motion::PoseFeatures& pose, const k4a_image_t& depthImage,
+                       const std::vector<motion::MotionEvent>& events, float deltaTime);
+    void runFixedStep();
+    void collectEvents();   // Game subscription -> frameEvents_
+
     // Session tracking
     void updateSessionStats(const ChallengeResult& result);
 
-    // Achievement checking
-    void checkAccuracyAchievements(const ChallengeResult& result);
-    void checkPowerAchievements(const ChallengeResult& result);
-    void checkPenaltyAchievements(const ChallengeResult& result);
-    void unlockAchievement(const std::string& achievementId);
-
     // Members
     GameConfig config_;
     std::unique_ptr<ChallengeBase> currentChallenge_;
+
+    // Shared kick detection for all challenges
+    motion::KickDetector kickDetector_;
+    motion::MotionEventBus eventBus_;
+    motion::MotionSubscription* gameEvents_;
+    std::vector<motion::MotionEvent> frameEvents_;
+    uint64_t frameClockUs_;
+
+    // Fixed-step simulation. frameEvents_ holds kicks until the step that
+    // reaches their timestamp.
+    SkeletonInterpolator inputFrames_;
+    std::vector<motion::MotionEvent> stepEvents_;
+    k4abt_skeleton_t stepSkeleton_;
+    motion::PoseFeatures stepPose_;
+    uint64_t stepUs_;
+    uint64_t stepAccumulatorUs_;
+    uint64_t stepTimeUs_;       // Tracker time of the last step's input
+    bool stepAnchored_;
+    bool fixedStep_;            // advance() in use
+    k4a_image_t noDepth_;
+
+#ifdef HAVE_OPENCV
+    // OpenCV rendering path
+    DrawList drawList_;
+    OpenCvDrawBackend rasterizer_;
+#endif
+
     bool sessionActive_;
     SessionStats sessionStats_;
 
+    // Game time, and determinism
+    GameClock clock_;
+    bool deterministic_;
+    uint32_t seed_;
+    uint32_t challengesStarted_;
+    InputRecording* recording_;
+
     // Session timing
-    using TimePoint = std::chrono::steady_clock::time_point;
+    using TimePoint = GameClock::TimePoint;
     TimePoint sessionStartTime_;
 
     // Event callbacks
@@ -116,12 +208,9 @@ private:
     ChallengeCompleteCallback onChallengeComplete_;
     AchievementUnlockedCallback onAchievementUnlocked_;
 
-    // Achievement tracking (lifetime stats)
-    struct LifetimeStats {
-        int32_t totalPenaltiesScored = 0;
-        std::vector<float> recentPowerKicks;  // Last 3 kicks
-        bool suddenDeathWon = false;
-    } lifetimeStats_;
+    // Compiled achievement rules, unlock state and lifetime counters
+    AchievementEngine achievements_;
+    std::vector<size_t> unlockedScratch_;
 };
 
 } // namespace game
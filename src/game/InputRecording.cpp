@@ -0,0 +1,318 @@
+#include "InputRecording.h"
+#include "GameManager.h"
+#include "../core/BinaryRecord.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+namespace kinect {
+namespace game {
+
+namespace {
+
+constexpr uint32_t FILE_MAGIC = 0x5249464B;  // "KFIR"
+constexpr uint32_t FILE_VERSION = 1;
+constexpr size_t HEADER_SIZE = 5 * sizeof(uint32_t) + sizeof(uint64_t);
+constexpr size_t EVENT_SIZE = 2 + sizeof(float) + sizeof(uint64_t) + sizeof(uint32_t) + sizeof(uint64_t);
+
+constexpr uint64_t FNV_OFFSET = 14695981039346656037ull;
+constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+uint64_t fnv1a(uint64_t hash, const void* data, size_t length) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < length; ++i) {
+        hash = (hash ^ p[i]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+template<typename T>
+uint64_t hashValue(uint64_t hash, const T& value) {
+    return fnv1a(hash, &value, sizeof(T));
+}
+
+using core::get;
+using core::put;
+
+} // namespace
+
+uint64_t resultDigest(const ChallengeResult& result) {
+    uint64_t hash = FNV_OFFSET;
+    hash = hashValue(hash, static_cast<uint8_t>(result.type));
+    hash = hashValue(hash, result.finalScore);
+    hash = hashValue(hash, result.attempts);
+    hash = hashValue(hash, result.successes);
+    hash = hashValue(hash, result.accuracy);
+    hash = hashValue(hash, result.maxVelocity);
+    hash = hashValue(hash, result.avgVelocity);
+    hash = hashValue(hash, result.duration);
+    hash = hashValue(hash, static_cast<uint8_t>(result.passed));
+    hash = fnv1a(hash, result.grade.data(), result.grade.size());
+    for (const std::string& achievement : result.achievementsUnlocked) {
+        hash = fnv1a(hash, achievement.data(), achievement.size() + 1);
+    }
+    return hash;
+}
+
+// InputRecording implementation
+InputRecording::InputRecording()
+    : seed_(0)
+    , resultCount_(0)
+{
+}
+
+void InputRecording::clear(uint32_t seed) {
+    seed_ = seed;
+    events_.clear();
+    skeletons_.clear();
+    resultCount_ = 0;
+}
+
+void InputRecording::addFrame(const k4abt_skeleton_t& skeleton, uint64_t timestamp, float deltaTime) {
+    InputEvent event;
+    event.type = InputEventType::FRAME;
+    event.deltaTime = deltaTime;
+    event.timestamp = timestamp;
+    event.skeleton = static_cast<uint32_t>(skeletons_.size());
+    skeletons_.push_back(skeleton);
+    events_.push_back(event);
+}
+
+void InputRecording::addTrackerFrame(const k4abt_skeleton_t& skeleton, uint64_t timestamp) {
+    addFrame(skeleton, timestamp, 0.0f);
+    events_.back().type = InputEventType::TRACKER_FRAME;
+}
+
+void InputRecording::addAdvance(float deltaTime) {
+    InputEvent event;
+    event.type = InputEventType::ADVANCE;
+    event.deltaTime = deltaTime;
+    events_.push_back(event);
+}
+
+void InputRecording::addControl(InputEventType type, ChallengeType challengeType) {
+    InputEvent event;
+    event.type = type;
+    event.challengeType = challengeType;
+    events_.push_back(event);
+}
+
+void InputRecording::addResult(const ChallengeResult& result) {
+    InputEvent event;
+    event.type = InputEventType::RESULT;
+    event.challengeType = result.type;
+    event.digest = resultDigest(result);
+    events_.push_back(event);
+    resultCount_++;
+}
+
+bool InputRecording::save(const std::string& path) const {
+    std::string body;
+    body.reserve(events_.size() * EVENT_SIZE + skeletons_.size() * sizeof(k4abt_skeleton_t));
+    for (const InputEvent& event : events_) {
+        put(body, static_cast<uint8_t>(event.type));
+        put(body, static_cast<uint8_t>(event.challengeType));
+        put(body, event.deltaTime);
+        put(body, event.timestamp);
+        put(body, event.skeleton);
+        put(body, event.digest);
+    }
+    if (!skeletons_.empty()) {
+        body.append(reinterpret_cast<const char*>(skeletons_.data()),
+                    skeletons_.size() * sizeof(k4abt_skeleton_t));
+    }
+
+    std::string header;
+    put(header, FILE_MAGIC);
+    put(header, FILE_VERSION);
+    put(header, seed_);
+    put(header, static_cast<uint32_t>(events_.size()));
+    put(header, static_cast<uint32_t>(skeletons_.size()));
+    put(header, fnv1a(FNV_OFFSET, body.data(), body.size()));
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    bool ok = std::fwrite(header.data(), 1, header.size(), file) == header.size() &&
+              std::fwrite(body.data(), 1, body.size(), file) == body.size();
+    return std::fclose(file) == 0 && ok;
+}
+
+bool InputRecording::load(const std::string& path) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+    std::vector<uint8_t> data;
+    uint8_t chunk[64 * 1024];
+    size_t read;
+    while ((read = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        data.insert(data.end(), chunk, chunk + read);
+    }
+    std::fclose(file);
+
+    if (data.size() < HEADER_SIZE) {
+        return false;
+    }
+    const uint8_t* p = data.data();
+    uint32_t magic = get<uint32_t>(p);
+    uint32_t version = get<uint32_t>(p);
+    uint32_t seed = get<uint32_t>(p);
+    uint32_t eventCount = get<uint32_t>(p);
+    uint32_t skeletonCount = get<uint32_t>(p);
+    uint64_t checksum = get<uint64_t>(p);
+    if (magic != FILE_MAGIC || version != FILE_VERSION ||
+        data.size() - HEADER_SIZE != static_cast<uint64_t>(eventCount) * EVENT_SIZE +
+                                      static_cast<uint64_t>(skeletonCount) * sizeof(k4abt_skeleton_t) ||
+        fnv1a(FNV_OFFSET, p, data.size() - HEADER_SIZE) != checksum) {
+        return false;
+    }
+
+    std::vector<InputEvent> events(eventCount);
+    size_t resultCount = 0;
+    for (InputEvent& event : events) {
+        uint8_t type = get<uint8_t>(p);
+        uint8_t challengeType = get<uint8_t>(p);
+        event.deltaTime = get<float>(p);
+        event.timestamp = get<uint64_t>(p);
+        event.skeleton = get<uint32_t>(p);
+        event.digest = get<uint64_t>(p);
+        bool hasSkeleton = type == static_cast<uint8_t>(InputEventType::FRAME) ||
+                           type == static_cast<uint8_t>(InputEventType::TRACKER_FRAME);
+        if (type > static_cast<uint8_t>(InputEventType::ADVANCE) ||
+            challengeType > static_cast<uint8_t>(ChallengeType::SKILL_MOVE) ||
+            (hasSkeleton && event.skeleton >= skeletonCount)) {
+            return false;
+        }
+        event.type = static_cast<InputEventType>(type);
+        event.challengeType = static_cast<ChallengeType>(challengeType);
+        if (event.type == InputEventType::RESULT) {
+            resultCount++;
+        }
+    }
+
+    std::vector<k4abt_skeleton_t> skeletons(skeletonCount);
+    if (skeletonCount > 0) {
+        std::memcpy(skeletons.data(), p, skeletonCount * sizeof(k4abt_skeleton_t));
+    }
+
+    seed_ = seed;
+    events_ = std::move(events);
+    skeletons_ = std::move(skeletons);
+    resultCount_ = resultCount;
+    return true;
+}
+
+// InputReplayer implementation
+InputReplayer::InputReplayer(const GameConfig& config)
+    : config_(config)
+{
+}
+
+ReplayReport InputReplayer::replay(const InputRecording& recording) const {
+    ReplayReport report;
+    report.expectedResults = recording.getResultCount();
+
+    std::vector<uint64_t> results;
+    results.reserve(report.expectedResults);
+
+    auto begin = std::chrono::steady_clock::now();
+
+    GameManager manager(config_);
+    manager.initialize();
+    manager.setDeterministic(recording.getSeed());
+    manager.setOnChallengeComplete([&results, &report](const ChallengeResult& result) {
+        results.push_back(resultDigest(result));
+
+        switch (result.type) {
+            case ChallengeType::PENALTY_SHOOTOUT:
+                report.goals += result.successes;
+                break;
+            case ChallengeType::ACCURACY:
+                report.accuracyHits += result.successes;
+                break;
+            case ChallengeType::POWER:
+                if (result.attempts > 0) {
+                    bool first = report.powerResults++ == 0;
+                    report.minBallSpeedKmh = first ? result.maxVelocity
+                                                   : std::min(report.minBallSpeedKmh, result.maxVelocity);
+                    report.maxBallSpeedKmh = std::max(report.maxBallSpeedKmh, result.maxVelocity);
+                }
+                break;
+            default:
+                break;
+        }
+    });
+
+    k4a_image_t noDepth = nullptr;
+    motion::PoseFeatures pose;
+    for (const InputEvent& event : recording.getEvents()) {
+        switch (event.type) {
+            case InputEventType::FRAME:
+                pose.reset(recording.getSkeleton(event), event.timestamp);
+                manager.processFrame(pose, noDepth, event.deltaTime);
+                report.frames++;
+                break;
+            case InputEventType::TRACKER_FRAME:
+                pose.reset(recording.getSkeleton(event), event.timestamp);
+                manager.pushFrame(pose);
+                report.frames++;
+                break;
+            case InputEventType::ADVANCE:
+                manager.advance(event.deltaTime);
+                break;
+            case InputEventType::START_SESSION:
+                manager.startSession();
+                break;
+            case InputEventType::END_SESSION:
+                manager.endSession();
+                break;
+            case InputEventType::START_CHALLENGE:
+                manager.startChallenge(event.challengeType);
+                break;
+            case InputEventType::START_COUNTDOWN:
+                manager.startCountdown();
+                break;
+            case InputEventType::STOP_CHALLENGE:
+                manager.stopCurrentChallenge();
+                break;
+            case InputEventType::PAUSE:
+                manager.pauseCurrentChallenge();
+                break;
+            case InputEventType::RESUME:
+                manager.resumeCurrentChallenge();
+                break;
+            case InputEventType::RESULT:
+                break;
+        }
+    }
+    manager.shutdown();
+
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    report.results = results.size();
+
+    // Compare in order against the recorded results
+    report.digest = FNV_OFFSET;
+    size_t index = 0;
+    for (const InputEvent& event : recording.getEvents()) {
+        if (event.type != InputEventType::RESULT) {
+            continue;
+        }
+        if (index >= results.size() || results[index] != event.digest) {
+            report.mismatches++;
+        }
+        index++;
+    }
+    if (results.size() > index) {
+        report.mismatches += results.size() - index;
+    }
+    for (uint64_t digest : results) {
+        report.digest = hashValue(report.digest, digest);
+    }
+    return report;
+}
+
+} // namespace game
+} // namespace kinect
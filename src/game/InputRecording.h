@@ -0,0 +1,119 @@
+#pragma once
+
+#include "ChallengeBase.h"
+#include "../../include/GameConfig.h"
+#include <k4abt.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace kinect {
+namespace game {
+
+// GameManager inputs, in call order
+enum class InputEventType : uint8_t {
+    FRAME,              // processFrame()
+    START_SESSION,
+    END_SESSION,
+    START_CHALLENGE,
+    START_COUNTDOWN,
+    STOP_CHALLENGE,
+    PAUSE,
+    RESUME,
+    RESULT,             // Not an input: a challenge finished with this result
+    TRACKER_FRAME,      // pushFrame()
+    ADVANCE             // advance()
+};
+
+struct InputEvent {
+    InputEventType type = InputEventType::FRAME;
+    ChallengeType challengeType = ChallengeType::ACCURACY;  // START_CHALLENGE
+    float deltaTime = 0.0f;     // FRAME, ADVANCE
+    uint64_t timestamp = 0;     // FRAME, TRACKER_FRAME: pose timestamp (microseconds)
+    uint32_t skeleton = 0;      // FRAME, TRACKER_FRAME: index into the recording's skeletons
+    uint64_t digest = 0;        // RESULT: resultDigest() of the recorded result
+};
+
+// Stable hash of everything a challenge scored. Floats are hashed by bit
+// pattern, so two runs match only if they are bit-identical.
+uint64_t resultDigest(const ChallengeResult& result);
+
+// Every input a deterministic GameManager received, plus the seed it ran
+// with and the digest of each result it produced. Filled by
+// GameManager::startRecording() and re-driven by InputReplayer.
+//
+// The depth image is not recorded: no challenge reads it, and replays pass
+// a null image. Replays are bit-identical on the build that recorded them;
+// <random> distributions differ between standard libraries.
+class InputRecording {
+public:
+    InputRecording();
+
+    // Drop all events and start over with a new seed
+    void clear(uint32_t seed);
+
+    // Appending (GameManager)
+    void addFrame(const k4abt_skeleton_t& skeleton, uint64_t timestamp, float deltaTime);
+    void addTrackerFrame(const k4abt_skeleton_t& skeleton, uint64_t timestamp);
+    void addAdvance(float deltaTime);
+    void addControl(InputEventType type, ChallengeType challengeType = ChallengeType::ACCURACY);
+    void addResult(const ChallengeResult& result);
+
+    // Access
+    uint32_t getSeed() const { return seed_; }
+    const std::vector<InputEvent>& getEvents() const { return events_; }
+    const k4abt_skeleton_t& getSkeleton(const InputEvent& frame) const {
+        return skeletons_[frame.skeleton];
+    }
+    size_t getFrameCount() const { return skeletons_.size(); }
+    size_t getResultCount() const { return resultCount_; }
+    bool empty() const { return events_.empty(); }
+
+    // Binary file: header, events, then raw skeletons, with an FNV-1a
+    // checksum over everything after the header. load() leaves the
+    // recording unchanged on failure.
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+
+private:
+    uint32_t seed_;
+    std::vector<InputEvent> events_;
+    std::vector<k4abt_skeleton_t> skeletons_;
+    size_t resultCount_;
+};
+
+// Outcome of one replay
+struct ReplayReport {
+    size_t frames = 0;
+    size_t expectedResults = 0;   // In the recording
+    size_t results = 0;           // Produced by the replay
+    size_t mismatches = 0;        // Results that differ, including missing or extra ones
+    uint64_t digest = 0;          // Combined digest of the replayed results
+    double seconds = 0.0;         // Wall time spent replaying
+
+    // What the replayed results scored, for sanity checks on fixtures
+    int32_t goals = 0;            // Penalty Shootout goals
+    int32_t accuracyHits = 0;     // Accuracy Challenge targets hit
+    size_t powerResults = 0;      // Power Challenge results with a kick
+    float minBallSpeedKmh = 0.0f; // Slowest and fastest best Power kick
+    float maxBallSpeedKmh = 0.0f;
+
+    bool identical() const { return mismatches == 0 && results == expectedResults; }
+};
+
+// Re-drives a fresh deterministic GameManager through a recording as fast
+// as the game logic runs, and checks every result against the recorded one.
+// Nothing is drawn.
+class InputReplayer {
+public:
+    // Must match the config the recording was made with
+    explicit InputReplayer(const GameConfig& config = GameConfig());
+
+    ReplayReport replay(const InputRecording& recording) const;
+
+private:
+    GameConfig config_;
+};
+
+} // namespace game
+} // namespace kinect
@@ -0,0 +1,229 @@
+#include "Leaderboard.h"
+#include <algorithm>
+
+namespace kinect {
+namespace game {
+
+Leaderboard::Leaderboard(size_t maxEntries)
+    : maxEntries_(maxEntries)
+{
+}
+
+bool Leaderboard::addEntry(const LeaderboardEntry& entry) {
+    bool placed = insertEntry(entry);
+    bool windowed = insertIntoWindows(entry);
+
+    // Journal anything a board kept so windows survive a restart too
+    if (store_ && (placed || windowed)) {
+        store_->append(entry);
+    }
+    return placed;
+}
+
+bool Leaderboard::insertEntry(const LeaderboardEntry& entry) {
+    LeaderboardIndex& board = boards_[entry.challengeType];
+
+    // A full board only admits entries that beat the current last place
+    if (maxEntries_ > 0 && board.size() >= maxEntries_) {
+        if (!(entry < *board.last())) {
+            return false;
+        }
+        board.eraseLast();
+    }
+
+    board.insert(entry);
+    return true;
+}
+
+bool Leaderboard::insertIntoWindows(const LeaderboardEntry& entry) {
+    bool placed = false;
+    for (auto& window : windowsFor(entry.challengeType)) {
+        placed = window.add(entry) || placed;
+    }
+    return placed;
+}
+
+std::vector<LeaderboardWindow>& Leaderboard::windowsFor(ChallengeType type) {
+    auto& windows = windows_[type];
+    while (windows.size() < windowConfigs_.size()) {
+        windows.emplace_back(windowConfigs_[windows.size()]);
+    }
+    return windows;
+}
+
+size_t Leaderboard::addWindow(const LeaderboardWindowConfig& config) {
+    windowConfigs_.push_back(config);
+    for (auto& pair : windows_) {
+        windowsFor(pair.first);
+    }
+    return windowConfigs_.size() - 1;
+}
+
+const LeaderboardWindow* Leaderboard::getWindow(ChallengeType type, size_t window) const {
+    auto it = windows_.find(type);
+    if (it == windows_.end() || window >= it->second.size()) {
+        return nullptr;
+    }
+    return &it->second[window];
+}
+
+int32_t Leaderboard::getRank(ChallengeType type, int32_t score, size_t window) const {
+    const LeaderboardWindow* view = getWindow(type, window);
+    return view ? static_cast<int32_t>(view->rankOfScore(score)) : 1;
+}
+
+void Leaderboard::advanceTime(uint64_t now) {
+    for (auto& pair : windows_) {
+        for (auto& window : pair.second) {
+            window.advance(now);
+        }
+    }
+}
+
+void Leaderboard::clear() {
+    boards_.clear();
+    windows_.clear();
+}
+
+const LeaderboardIndex& Leaderboard::getBoard(ChallengeType type) const {
+    auto it = boards_.find(type);
+    return it != boards_.end() ? it->second : emptyBoard_;
+}
+
+std::vector<LeaderboardEntry> Leaderboard::getTopEntries(ChallengeType type, size_t count) const {
+    const LeaderboardIndex& board = getBoard(type);
+
+    std::vector<LeaderboardEntry> top;
+    top.reserve(std::min(count, board.size()));
+    for (auto it = board.begin(); it != board.end() && top.size() < count; ++it) {
+        top.push_back(*it);
+    }
+    return top;
+}
+
+std::vector<LeaderboardEntry> Leaderboard::getTopEntries(size_t count) const {
+    // Merge the heads of the per-challenge boards
+    std::vector<LeaderboardIndex::ConstIterator> heads;
+    std::vector<LeaderboardIndex::ConstIterator> ends;
+    for (const auto& pair : boards_) {
+        heads.push_back(pair.second.begin());
+        ends.push_back(pair.second.end());
+    }
+
+    std::vector<LeaderboardEntry> top;
+    while (top.size() < count) {
+        size_t best = heads.size();
+        for (size_t i = 0; i < heads.size(); ++i) {
+            if (heads[i] != ends[i] && (best == heads.size() || *heads[i] < *heads[best])) {
+                best = i;
+            }
+        }
+        if (best == heads.size()) {
+            break;
+        }
+        top.push_back(*heads[best]);
+        ++heads[best];
+    }
+
+    return top;
+}
+
+std::vector<LeaderboardEntry> Leaderboard::getEntriesForChallenge(ChallengeType type) const {
+    const LeaderboardIndex& board = getBoard(type);
+    return std::vector<LeaderboardEntry>(board.begin(), board.end());
+}
+
+int32_t Leaderboard::getRank(ChallengeType type, int32_t score) const {
+    return static_cast<int32_t>(getBoard(type).rankOfScore(score));
+}
+
+bool Leaderboard::isHighScore(ChallengeType type, int32_t score, size_t topCount) const {
+    return getBoard(type).rankOfScore(score) <= topCount;
+}
+
+size_t Leaderboard::getEntryCount() const {
+    size_t count = 0;
+    for (const auto& pair : boards_) {
+        count += pair.second.size();
+    }
+    return count;
+}
+
+bool Leaderboard::open(const std::string& directory, const LeaderboardStoreConfig& config) {
+    close();
+
+    LeaderboardStoreConfig storeConfig = config;
+    if (storeConfig.maxEntriesPerChallenge == 0) {
+        storeConfig.maxEntriesPerChallenge = maxEntries_;
+    }
+    // Windows rank entries that fell off the all-time top N; the snapshot
+    // keeps them for as long as the longest window covers
+    for (const auto& windowConfig : windowConfigs_) {
+        storeConfig.retainRecentSeconds = std::max(storeConfig.retainRecentSeconds, windowConfig.duration);
+    }
+
+    auto store = std::make_unique<LeaderboardStore>(storeConfig);
+    std::vector<LeaderboardSegment> segments;
+    std::vector<LeaderboardEntry> journal;
+    if (!store->open(directory, segments, journal)) {
+        return false;
+    }
+
+    // Windows only need recent entries; scan the loaded arrays in storage
+    // order once, before they are handed to the boards
+    clear();
+    if (!windowConfigs_.empty()) {
+        uint64_t newest = 0;
+        for (const auto& segment : segments) {
+            for (const auto& entry : segment.entries) {
+                newest = std::max(newest, entry.timestamp);
+            }
+        }
+        for (const auto& entry : journal) {
+            newest = std::max(newest, entry.timestamp);
+        }
+
+        uint64_t longest = 0;
+        for (const auto& windowConfig : windowConfigs_) {
+            longest = std::max(longest, windowConfig.duration);
+        }
+        uint64_t oldest = newest > longest ? newest - longest : 0;
+
+        for (const auto& segment : segments) {
+            for (auto& window : windowsFor(segment.challengeType)) {
+                window.advance(newest);
+            }
+            for (const auto& entry : segment.entries) {
+                if (entry.timestamp >= oldest) {
+                    insertIntoWindows(entry);
+                }
+            }
+        }
+    }
+
+    // Snapshot segments are already in rank order: build each board in one
+    // pass. Past the top N they only hold window history
+    for (auto& segment : segments) {
+        if (maxEntries_ > 0 && segment.entries.size() > maxEntries_) {
+            segment.entries.resize(maxEntries_);
+        }
+        boards_[segment.challengeType].assignSorted(std::move(segment.entries));
+    }
+    for (const auto& entry : journal) {
+        insertEntry(entry);
+        insertIntoWindows(entry);
+    }
+
+    store_ = std::move(store);
+    return true;
+}
+
+void Leaderboard::close() {
+    if (store_) {
+        store_->close();
+        store_.reset();
+    }
+}
+
+} // namespace game
+} // namespace kinect
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "LeaderboardIndex.h"
+#include "LeaderboardStore.h"
+#include "LeaderboardWindow.h"
+#include "../../include/GameConfig.h"
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace kinect {
+namespace game {
+
+// Per-challenge high score boards.
+// Each challenge has its own order-statistic index, so adding an entry and
+// looking up a rank are O(log n) even with millions of entries.
+class Leaderboard {
+public:
+    // maxEntries caps each challenge's board (0 keeps every entry)
+    explicit Leaderboard(size_t maxEntries = 0);
+
+    // Entry management; entries are filed under entry.challengeType and
+    // into every time window. Returns false if the all-time board is full
+    // and the entry did not place.
+    bool addEntry(const LeaderboardEntry& entry);
+
+    // Top entries of one challenge, or of all challenges merged
+    std::vector<LeaderboardEntry> getTopEntries(ChallengeType type, size_t count = 10) const;
+    std::vector<LeaderboardEntry> getTopEntries(size_t count = 10) const;
+    std::vector<LeaderboardEntry> getEntriesForChallenge(ChallengeType type) const;
+
+    // Rank-ordered view of one challenge; iterate it for top-k without copying
+    const LeaderboardIndex& getBoard(ChallengeType type) const;
+
+    // Ranking
+    int32_t getRank(ChallengeType type, int32_t score) const;
+    bool isHighScore(ChallengeType type, int32_t score, size_t topCount = 10) const;
+
+    // Rolling time windows ("today", "this week") kept for every challenge.
+    // Add them before open() so persisted entries are replayed into them.
+    size_t addWindow(const LeaderboardWindowConfig& config);
+    size_t getWindowCount() const { return windowConfigs_.size(); }
+    const LeaderboardWindow* getWindow(ChallengeType type, size_t window) const;
+    int32_t getRank(ChallengeType type, int32_t score, size_t window) const;
+
+    // Expire window buckets up to now (Unix seconds); arrivals also advance
+    void advanceTime(uint64_t now);
+
+    // Persistence. open() loads the boards from a store directory and then
+    // journals every accepted entry in the background.
+    bool open(const std::string& directory,
+              const LeaderboardStoreConfig& config = LeaderboardStoreConfig());
+    void close();
+    bool isPersistent() const { return store_ && store_->isOpen(); }
+    LeaderboardStore* getStore() const { return store_.get(); }
+
+    // Clears the in-memory boards only
+    void clear();
+    size_t getEntryCount() const;
+    size_t getEntryCount(ChallengeType type) const { return getBoard(type).size(); }
+
+private:
+    std::map<ChallengeType, LeaderboardIndex> boards_;
+    LeaderboardIndex emptyBoard_;
+    size_t maxEntries_;
+    std::unique_ptr<LeaderboardStore> store_;
+
+    std::vector<LeaderboardWindowConfig> windowConfigs_;
+    std::map<ChallengeType, std::vector<LeaderboardWindow>> windows_;
+
+    std::vector<LeaderboardWindow>& windowsFor(ChallengeType type);
+
+    // Insert without journaling (used when replaying the store)
+    bool insertEntry(const LeaderboardEntry& entry);
+    bool insertIntoWindows(const LeaderboardEntry& entry);
+};
+
+} // namespace game
+} // namespace kinect
@@ -0,0 +1,251 @@
+#include "LeaderboardIndex.h"
+#include <algorithm>
+
+namespace kinect {
+namespace game {
+
+LeaderboardIndex::LeaderboardIndex(uint32_t seed)
+    : size_(0)
+    , level_(1)
+    , tail_(HEAD)
+    , rngState_(seed != 0 ? seed : 1)
+    , seed_(rngState_)
+{
+    resetHead();
+}
+
+void LeaderboardIndex::resetHead() {
+    nodes_.push_back(Node{0, 0, 0, MAX_LEVEL});
+    links_.assign(MAX_LEVEL, Link{NIL, 0, 0, NIL});
+}
+
+void LeaderboardIndex::clear() {
+    nodes_.clear();
+    entries_.clear();
+    links_.clear();
+    for (auto& slots : freeNodes_) {
+        slots.clear();
+    }
+    resetHead();
+
+    size_ = 0;
+    level_ = 1;
+    tail_ = HEAD;
+    rngState_ = seed_;
+}
+
+void LeaderboardIndex::reserve(size_t count) {
+    // Expected links per node is 1 / (1 - p) = 4/3
+    nodes_.reserve(count + 1);
+    entries_.reserve(count);
+    links_.reserve(MAX_LEVEL + count + count / 3 + 1);
+}
+
+int LeaderboardIndex::randomLevel() {
+    // xorshift32; each pair of bits promotes with p = 1/4
+    rngState_ ^= rngState_ << 13;
+    rngState_ ^= rngState_ >> 17;
+    rngState_ ^= rngState_ << 5;
+
+    uint32_t bits = rngState_;
+    int level = 1;
+    while (level < MAX_LEVEL && (bits & 3u) == 0) {
+        level++;
+        bits >>= 2;
+    }
+    return level;
+}
+
+uint32_t LeaderboardIndex::allocateNode(LeaderboardEntry entry, int level) {
+    auto& slots = freeNodes_[level - 1];
+    if (!slots.empty()) {
+        uint32_t node = slots.back();
+        slots.pop_back();
+        nodes_[node].score = entry.score;
+        nodes_[node].timestamp = entry.timestamp;
+        entries_[node - 1] = std::move(entry);
+        return node;
+    }
+
+    nodes_.push_back(Node{entry.score, static_cast<uint32_t>(links_.size()),
+                          entry.timestamp, static_cast<uint32_t>(level)});
+    entries_.push_back(std::move(entry));
+    links_.resize(links_.size() + level);
+    return static_cast<uint32_t>(nodes_.size() - 1);
+}
+
+size_t LeaderboardIndex::insert(const LeaderboardEntry& entry) {
+    // Link offsets of the last node ahead of the new entry on every level
+    uint32_t update[MAX_LEVEL];
+    size_t rank[MAX_LEVEL];
+
+    uint32_t x = HEAD;
+    for (int i = level_ - 1; i >= 0; --i) {
+        rank[i] = (i == level_ - 1) ? 0 : rank[i + 1];
+        while (links_[x + i].next != NIL && ranksAhead(links_[x + i], entry)) {
+            rank[i] += links_[x + i].span;
+            x = links_[x + i].next;
+        }
+        update[i] = x;
+    }
+
+    int level = randomLevel();
+    if (level > level_) {
+        for (int i = level_; i < level; ++i) {
+            rank[i] = 0;
+            update[i] = HEAD;
+            links_[HEAD + i].span = static_cast<uint32_t>(size_);
+        }
+        level_ = level;
+    }
+
+    // allocateNode may grow links_, so take references only afterwards
+    uint32_t node = allocateNode(entry, level);
+    uint32_t base = nodes_[node].linkOffset;
+    for (int i = 0; i < level; ++i) {
+        Link& before = links_[update[i] + i];
+        Link& added = links_[base + i];
+        uint32_t skipped = static_cast<uint32_t>(rank[0] - rank[i]);
+
+        added.next = before.next;
+        added.span = before.span - skipped;
+        added.nextScore = before.nextScore;
+        added.nextNode = before.nextNode;
+
+        before.next = base;
+        before.span = skipped + 1;
+        before.nextScore = entry.score;
+        before.nextNode = node;
+    }
+    for (int i = level; i < level_; ++i) {
+        links_[update[i] + i].span++;
+    }
+
+    if (links_[base].next == NIL) {
+        tail_ = node;
+    }
+    size_++;
+
+    return rank[0] + 1;
+}
+
+void LeaderboardIndex::assignSorted(std::vector<LeaderboardEntry>&& entries) {
+    clear();
+
+    // Adopt the payload as-is; node i + 1 holds entries[i]
+    entries_ = std::move(entries);
+    nodes_.reserve(entries_.size() + 1);
+    links_.reserve(MAX_LEVEL + entries_.size() + entries_.size() / 3 + 1);
+
+    // Last link offset and rank seen on every level
+    uint32_t last[MAX_LEVEL] = {};
+    size_t lastRank[MAX_LEVEL] = {};
+
+    for (const auto& entry : entries_) {
+        size_t rank = size_ + 1;
+        int level = randomLevel();
+        level_ = std::max(level_, level);
+
+        uint32_t node = static_cast<uint32_t>(nodes_.size());
+        uint32_t base = static_cast<uint32_t>(links_.size());
+        nodes_.push_back(Node{entry.score, base, entry.timestamp, static_cast<uint32_t>(level)});
+        links_.resize(links_.size() + level, Link{NIL, 0, 0, NIL});
+
+        for (int i = 0; i < level; ++i) {
+            Link& before = links_[last[i] + i];
+            before.next = base;
+            before.span = static_cast<uint32_t>(rank - lastRank[i]);
+            before.nextScore = entry.score;
+            before.nextNode = node;
+
+            last[i] = base;
+            lastRank[i] = rank;
+        }
+
+        tail_ = node;
+        size_++;
+    }
+}
+
+bool LeaderboardIndex::eraseAt(size_t rank) {
+    if (rank == 0 || rank > size_) {
+        return false;
+    }
+
+    uint32_t update[MAX_LEVEL] = {};
+    size_t traversed = 0;
+    uint32_t x = HEAD;
+    uint32_t previous = HEAD;  // Node index of update[0]
+    for (int i = level_ - 1; i >= 0; --i) {
+        while (links_[x + i].next != NIL && traversed + links_[x + i].span < rank) {
+            traversed += links_[x + i].span;
+            previous = links_[x + i].nextNode;
+            x = links_[x + i].next;
+        }
+        update[i] = x;
+    }
+
+    uint32_t target = links_[update[0]].nextNode;
+    uint32_t base = links_[update[0]].next;
+    for (int i = 0; i < level_; ++i) {
+        Link& before = links_[update[i] + i];
+        if (before.next == base) {
+            const Link& removed = links_[base + i];
+            before.span += removed.span - 1;
+            before.next = removed.next;
+            before.nextScore = removed.nextScore;
+            before.nextNode = removed.nextNode;
+        } else {
+            before.span--;
+        }
+    }
+
+    if (tail_ == target) {
+        tail_ = previous;
+    }
+    while (level_ > 1 && links_[HEAD + level_ - 1].next == NIL) {
+        level_--;
+    }
+
+    freeNodes_[nodes_[target].level - 1].push_back(target);
+    size_--;
+    return true;
+}
+
+size_t LeaderboardIndex::rankOfScore(int32_t score) const {
+    size_t ahead = 0;
+    uint32_t x = HEAD;
+    for (int i = level_ - 1; i >= 0; --i) {
+        while (links_[x + i].next != NIL && links_[x + i].nextScore >= score) {
+            ahead += links_[x + i].span;
+            x = links_[x + i].next;
+        }
+    }
+    return ahead + 1;
+}
+
+LeaderboardIndex::ConstIterator LeaderboardIndex::fromRank(size_t rank) const {
+    if (rank == 0 || rank > size_) {
+        return end();
+    }
+
+    size_t traversed = 0;
+    uint32_t x = HEAD;
+    uint32_t node = HEAD;
+    for (int i = level_ - 1; i >= 0 && traversed < rank; --i) {
+        while (links_[x + i].next != NIL && traversed + links_[x + i].span <= rank) {
+            traversed += links_[x + i].span;
+            node = links_[x + i].nextNode;
+            x = links_[x + i].next;
+        }
+    }
+    return ConstIterator(this, node);
+}
+
+const LeaderboardEntry* LeaderboardIndex::at(size_t rank) const {
+    ConstIterator it = fromRank(rank);
+    return it != end() ? &*it : nullptr;
+}
+
+} // namespace game
+} // namespace kinect
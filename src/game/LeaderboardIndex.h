@@ -0,0 +1,161 @@
+#pragma once
+
+#include "../../include/GameConfig.h"
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace kinect {
+namespace game {
+
+// Leaderboard entry
+struct LeaderboardEntry {
+    std::string playerName;
+    int32_t score = 0;
+    float accuracy = 0.0f;
+    float maxVelocity = 0.0f;
+    uint64_t timestamp = 0;   // Unix time, seconds
+    std::string grade;
+    ChallengeType challengeType = ChallengeType::ACCURACY;
+
+    // Higher scores first; on a tie the earlier entry ranks higher
+    bool operator<(const LeaderboardEntry& other) const {
+        if (score != other.score) {
+            return score > other.score;
+        }
+        return timestamp < other.timestamp;
+    }
+};
+
+// Order-statistic index over the entries of one board.
+//
+// An indexable skiplist: every forward link also stores how many entries it
+// skips, so insert, rank-of-score and rank -> entry are all O(log n).
+// Entries are kept in rank order on level 0, so top-k is a walk from the
+// front with no copying or sorting. Nodes and links live in flat arrays
+// addressed by index; erased slots are recycled per level. Each link caches
+// the score and link offset of its successor, so a search step reads only
+// the link array and jumps straight to the next node's links.
+class LeaderboardIndex {
+public:
+    static constexpr int MAX_LEVEL = 16;  // 4^16 entries at p = 1/4
+
+    class ConstIterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = LeaderboardEntry;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const LeaderboardEntry*;
+        using reference = const LeaderboardEntry&;
+
+        ConstIterator() : index_(nullptr), node_(NIL) {}
+
+        reference operator*() const { return index_->entries_[node_ - 1]; }
+        pointer operator->() const { return &index_->entries_[node_ - 1]; }
+
+        ConstIterator& operator++() {
+            node_ = index_->links_[index_->nodes_[node_].linkOffset].nextNode;
+            return *this;
+        }
+        ConstIterator operator++(int) {
+            ConstIterator previous = *this;
+            ++(*this);
+            return previous;
+        }
+
+        bool operator==(const ConstIterator& other) const { return node_ == other.node_; }
+        bool operator!=(const ConstIterator& other) const { return node_ != other.node_; }
+
+    private:
+        friend class LeaderboardIndex;
+        ConstIterator(const LeaderboardIndex* index, uint32_t node) : index_(index), node_(node) {}
+
+        const LeaderboardIndex* index_;
+        uint32_t node_;
+    };
+
+    explicit LeaderboardIndex(uint32_t seed = 0x9E3779B9u);
+
+    // Insert an entry; returns its 1-based rank
+    size_t insert(const LeaderboardEntry& entry);
+
+    // Replace the contents with entries already in rank order. Links are
+    // built in one pass (O(n)), which is how snapshots are loaded.
+    void assignSorted(std::vector<LeaderboardEntry>&& entries);
+
+    // Remove the entry at a 1-based rank; false if out of range
+    bool eraseAt(size_t rank);
+
+    // Remove the lowest-ranked entry
+    bool eraseLast() { return eraseAt(size_); }
+
+    // Rank a new entry with this score would take (ties rank below
+    // existing entries, which were set first)
+    size_t rankOfScore(int32_t score) const;
+
+    // Entry at a 1-based rank, nullptr if out of range
+    const LeaderboardEntry* at(size_t rank) const;
+
+    // Iteration in rank order, starting at the top or at a given rank
+    ConstIterator begin() const { return ConstIterator(this, links_[HEAD].nextNode); }
+    ConstIterator end() const { return ConstIterator(this, NIL); }
+    ConstIterator fromRank(size_t rank) const;
+
+    const LeaderboardEntry* last() const { return size_ > 0 ? &entries_[tail_ - 1] : nullptr; }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    void clear();
+
+    // Pre-size storage for a known number of entries
+    void reserve(size_t count);
+
+private:
+    static constexpr uint32_t NIL = 0xFFFFFFFFu;
+    static constexpr uint32_t HEAD = 0;
+
+    struct Link {
+        uint32_t next;       // Link offset of the next node, NIL at the end
+        uint32_t span;       // Level-0 steps to the next node
+        int32_t nextScore;   // Cached score of the next node
+        uint32_t nextNode;   // Node index of the next node
+    };
+
+    // Sort key and link location of a node, kept apart from the entry payload
+    struct Node {
+        int32_t score;
+        uint32_t linkOffset;
+        uint64_t timestamp;
+        uint32_t level;
+    };
+
+    std::vector<Node> nodes_;
+    std::vector<LeaderboardEntry> entries_;  // Payload of node i at i - 1 (no head entry)
+    std::vector<Link> links_;
+    std::vector<uint32_t> freeNodes_[MAX_LEVEL];  // Recycled slots by level - 1
+
+    size_t size_;
+    int level_;
+    uint32_t tail_;
+    uint32_t rngState_;
+    uint32_t seed_;
+
+
+    int randomLevel();
+    uint32_t allocateNode(LeaderboardEntry entry, int level);
+    void resetHead();
+
+    // True if the node behind link ranks strictly ahead of entry
+    // (stable: equal keys keep insertion order)
+    bool ranksAhead(const Link& link, const LeaderboardEntry& entry) const {
+        if (link.nextScore != entry.score) {
+            return link.nextScore > entry.score;
+        }
+        return nodes_[link.nextNode].timestamp <= entry.timestamp;
+    }
+};
+
+} // namespace game
+} // namespace kinect
@@ -0,0 +1,562 @@
+#include "LeaderboardStore.h"
+#include "../core/BinaryRecord.h"
+#include "../core/MappedFile.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <map>
+
+namespace fs = std::filesystem;
+
+namespace kinect {
+namespace game {
+
+namespace {
+
+// File format. Fields are stored in host byte order (little-endian on every
+// kiosk target).
+//
+// Journal:  [JournalHeader][record]...
+// Snapshot: [SnapshotHeader][SegmentHeader][record]... per challenge
+// Record:   [u32 payload length][u32 CRC-32 of payload][payload]
+// Payload:  u8 type, i32 score, f32 accuracy, f32 maxVelocity,
+//           u64 timestamp, u16 name length, u16 grade length, name, grade
+
+constexpr uint32_t JOURNAL_MAGIC = 0x4A4C464Bu;   // "KFLJ"
+constexpr uint32_t SNAPSHOT_MAGIC = 0x534C464Bu;  // "KFLS"
+constexpr uint32_t FORMAT_VERSION = 1;
+
+constexpr size_t PAYLOAD_FIXED_SIZE = 1 + 4 + 4 + 4 + 8 + 2 + 2;
+constexpr size_t MAX_PAYLOAD_SIZE = PAYLOAD_FIXED_SIZE + 0xFFFF + 0xFFFF;
+
+struct JournalHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t generation;
+};
+
+struct SnapshotHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t coveredGeneration;
+    uint32_t segmentCount;
+    uint32_t reserved;
+};
+
+struct SegmentHeader {
+    uint32_t challengeType;
+    uint32_t entryCount;
+    uint64_t byteLength;
+};
+
+const char* const SNAPSHOT_NAME = "leaderboard.snapshot";
+const char* const JOURNAL_PREFIX = "journal-";
+const char* const JOURNAL_SUFFIX = ".log";
+const char* const CORRUPT_SUFFIX = ".corrupt";
+
+using core::get;
+using core::MappedFile;
+using core::put;
+using core::RECORD_HEADER_SIZE;
+using core::syncDirectory;
+using core::syncFile;
+
+void encodeRecord(const LeaderboardEntry& entry, std::string& out) {
+    uint16_t nameLength = static_cast<uint16_t>(std::min<size_t>(entry.playerName.size(), 0xFFFF));
+    uint16_t gradeLength = static_cast<uint16_t>(std::min<size_t>(entry.grade.size(), 0xFFFF));
+
+    size_t headerAt = core::beginRecord(out);
+    put(out, static_cast<uint8_t>(entry.challengeType));
+    put(out, entry.score);
+    put(out, entry.accuracy);
+    put(out, entry.maxVelocity);
+    put(out, entry.timestamp);
+    put(out, nameLength);
+    put(out, gradeLength);
+    out.append(entry.playerName.data(), nameLength);
+    out.append(entry.grade.data(), gradeLength);
+    core::endRecord(out, headerAt);
+}
+
+// Decode one record at data[offset]; advances offset on success
+bool decodeRecord(const uint8_t* data, size_t size, size_t& offset, LeaderboardEntry& entry) {
+    const uint8_t* p = nullptr;
+    uint32_t payloadLength = 0;
+    if (!core::readRecord(data, size, offset, PAYLOAD_FIXED_SIZE, MAX_PAYLOAD_SIZE, p, payloadLength)) {
+        return false;
+    }
+
+    entry.challengeType = static_cast<ChallengeType>(get<uint8_t>(p));
+    entry.score = get<int32_t>(p);
+    entry.accuracy = get<float>(p);
+    entry.maxVelocity = get<float>(p);
+    entry.timestamp = get<uint64_t>(p);
+    uint16_t nameLength = get<uint16_t>(p);
+    uint16_t gradeLength = get<uint16_t>(p);
+    if (PAYLOAD_FIXED_SIZE + nameLength + gradeLength != payloadLength) {
+        return false;
+    }
+    entry.playerName.assign(reinterpret_cast<const char*>(p), nameLength);
+    entry.grade.assign(reinterpret_cast<const char*>(p) + nameLength, gradeLength);
+
+    offset += RECORD_HEADER_SIZE + payloadLength;
+    return true;
+}
+
+// Snapshot -> sorted segments. Stops at the first damaged segment.
+bool readSnapshot(const std::string& path, std::vector<LeaderboardSegment>& segments,
+                  uint64_t& coveredGeneration) {
+    coveredGeneration = 0;
+    MappedFile file(path);
+    if (!file.isOpen() || file.size() < sizeof(SnapshotHeader)) {
+        return false;
+    }
+
+    const uint8_t* p = file.data();
+    SnapshotHeader header = get<SnapshotHeader>(p);
+    if (header.magic != SNAPSHOT_MAGIC || header.version != FORMAT_VERSION) {
+        return false;
+    }
+    coveredGeneration = header.coveredGeneration;
+
+    size_t offset = sizeof(SnapshotHeader);
+    for (uint32_t s = 0; s < header.segmentCount; ++s) {
+        if (file.size() - offset < sizeof(SegmentHeader)) {
+            return false;
+        }
+        const uint8_t* h = file.data() + offset;
+        SegmentHeader segmentHeader = get<SegmentHeader>(h);
+        offset += sizeof(SegmentHeader);
+        if (file.size() - offset < segmentHeader.byteLength) {
+            return false;
+        }
+
+        LeaderboardSegment segment;
+        segment.challengeType = static_cast<ChallengeType>(segmentHeader.challengeType);
+        segment.entries.resize(segmentHeader.entryCount);
+
+        size_t end = offset + static_cast<size_t>(segmentHeader.byteLength);
+        for (auto& entry : segment.entries) {
+            if (!decodeRecord(file.data(), end, offset, entry)) {
+                return false;
+            }
+        }
+        if (offset != end) {
+            return false;
+        }
+        segments.push_back(std::move(segment));
+    }
+
+    return true;
+}
+
+// Journal -> entries in arrival order. validBytes ends at the last intact record.
+bool readJournal(const std::string& path, std::vector<LeaderboardEntry>& entries,
+                 size_t& validBytes, size_t& fileBytes) {
+    validBytes = 0;
+    fileBytes = 0;
+    MappedFile file(path);
+    if (!file.isOpen()) {
+        return false;
+    }
+    fileBytes = file.size();
+    if (file.size() < sizeof(JournalHeader)) {
+        return false;
+    }
+
+    const uint8_t* p = file.data();
+    JournalHeader header = get<JournalHeader>(p);
+    if (header.magic != JOURNAL_MAGIC || header.version != FORMAT_VERSION) {
+        return false;
+    }
+
+    size_t offset = sizeof(JournalHeader);
+    LeaderboardEntry entry;
+    while (offset < file.size() && decodeRecord(file.data(), file.size(), offset, entry)) {
+        entries.push_back(entry);
+    }
+    validBytes = offset;
+    return true;
+}
+
+} // namespace
+
+LeaderboardStore::LeaderboardStore(const LeaderboardStoreConfig& config)
+    : config_(config)
+    , running_(false)
+    , compactRequested_(false)
+    , queued_(0)
+    , written_(0)
+    , dropped_(0)
+    , failed_(0)
+    , compactions_(0)
+    , corruptSnapshots_(0)
+    , recoveredTornBytes_(0)
+    , lastLoadTimeMs_(0.0f)
+    , snapshotGeneration_(0)
+    , journalGeneration_(0)
+    , journal_(nullptr)
+    , journalBytes_(0)
+    , snapshotBytes_(0)
+{
+}
+
+LeaderboardStore::~LeaderboardStore() {
+    close();
+}
+
+std::string LeaderboardStore::snapshotPath() const {
+    return (fs::path(directory_) / SNAPSHOT_NAME).string();
+}
+
+std::string LeaderboardStore::journalPath(uint64_t generation) const {
+    return (fs::path(directory_) / (JOURNAL_PREFIX + std::to_string(generation) + JOURNAL_SUFFIX)).string();
+}
+
+std::vector<uint64_t> LeaderboardStore::listJournals() const {
+    return core::listNumberedFiles(directory_, JOURNAL_PREFIX, JOURNAL_SUFFIX);
+}
+
+bool LeaderboardStore::open(const std::string& directory,
+                            std::vector<LeaderboardSegment>& segments,
+                            std::vector<LeaderboardEntry>& journal) {
+    if (isOpen()) {
+        return false;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    directory_ = directory;
+    std::error_code ec;
+    fs::create_directories(directory_, ec);
+    if (!fs::is_directory(directory_, ec)) {
+        return false;
+    }
+
+    segments.clear();
+    journal.clear();
+    recoveredTornBytes_ = 0;
+
+    snapshotGeneration_ = 0;
+    if (fs::exists(snapshotPath(), ec) &&
+        !readSnapshot(snapshotPath(), segments, snapshotGeneration_)) {
+        // Start from the journals alone; none of them may be dropped on the
+        // word of a snapshot that does not read back
+        segments.clear();
+        snapshotGeneration_ = 0;
+        setAsideSnapshot();
+    }
+    snapshotBytes_ = static_cast<size_t>(fs::file_size(snapshotPath(), ec));
+    if (ec) {
+        snapshotBytes_ = 0;
+    }
+
+    // Replay journals the snapshot does not cover; drop the ones it does
+    // (left behind if the process stopped right after a compaction)
+    uint64_t lastGeneration = 0;
+    size_t lastValidBytes = 0;
+    for (uint64_t generation : listJournals()) {
+        if (generation <= snapshotGeneration_) {
+            fs::remove(journalPath(generation), ec);
+            continue;
+        }
+
+        size_t validBytes = 0;
+        size_t fileBytes = 0;
+        readJournal(journalPath(generation), journal, validBytes, fileBytes);
+        recoveredTornBytes_ += fileBytes - validBytes;
+        lastGeneration = generation;
+        lastValidBytes = validBytes;
+    }
+
+    // Keep appending to the newest journal, cut back to its last good record
+    if (lastGeneration == 0) {
+        lastGeneration = snapshotGeneration_ + 1;
+        lastValidBytes = 0;
+    }
+    if (!openJournal(lastGeneration, lastValidBytes)) {
+        return false;
+    }
+
+    lastLoadTimeMs_ = std::chrono::duration<float, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+
+    running_.store(true, std::memory_order_release);
+    writerThread_ = std::thread(&LeaderboardStore::writerThreadFunc, this);
+    return true;
+}
+
+void LeaderboardStore::close() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+
+    if (writerThread_.joinable()) {
+        writerThread_.join();
+    }
+
+    if (journal_) {
+        syncFile(journal_);
+        std::fclose(journal_);
+        journal_ = nullptr;
+    }
+}
+
+bool LeaderboardStore::append(const LeaderboardEntry& entry) {
+    if (!isOpen() || !queue_.push(entry)) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    queued_.fetch_add(1, std::memory_order_release);
+    return true;
+}
+
+void LeaderboardStore::flush() {
+    uint64_t target = queued_.load(std::memory_order_acquire);
+    while (isOpen() && written_.load(std::memory_order_acquire) +
+                       failed_.load(std::memory_order_acquire) < target) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+bool LeaderboardStore::openJournal(uint64_t generation, size_t validBytes) {
+    std::string path = journalPath(generation);
+
+    if (validBytes >= sizeof(JournalHeader)) {
+        // Existing journal: drop any torn tail and append after it
+        if (!core::truncateTail(path, validBytes)) {
+            return false;
+        }
+        journal_ = std::fopen(path.c_str(), "ab");
+        journalBytes_ = validBytes;
+    } else {
+        journal_ = std::fopen(path.c_str(), "wb");
+        if (journal_) {
+            JournalHeader header{JOURNAL_MAGIC, FORMAT_VERSION, generation};
+            std::fwrite(&header, sizeof(header), 1, journal_);
+            syncFile(journal_);
+        }
+        journalBytes_ = sizeof(JournalHeader);
+    }
+
+    journalGeneration_ = generation;
+    return journal_ != nullptr;
+}
+
+void LeaderboardStore::writerThreadFunc() {
+    std::vector<LeaderboardEntry> batch;
+    batch.reserve(QUEUE_SIZE);
+
+    for (;;) {
+        // Read the flag first so entries queued before close() are drained
+        bool stopping = !running_.load(std::memory_order_acquire);
+
+        LeaderboardEntry entry;
+        while (queue_.pop(entry)) {
+            batch.push_back(std::move(entry));
+        }
+
+        bool wrote = !batch.empty();
+        if (wrote) {
+            writeBatch(batch);
+            batch.clear();
+        }
+
+        if (compactRequested_.exchange(false, std::memory_order_acq_rel) || shouldCompact()) {
+            compact();
+        }
+
+        if (stopping) {
+            break;
+        }
+        if (!wrote) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    }
+}
+
+bool LeaderboardStore::shouldCompact() const {
+    size_t threshold = std::max(config_.compactThresholdBytes,
+                                static_cast<size_t>(snapshotBytes_ * config_.compactSnapshotRatio));
+    return journalBytes_ >= threshold;
+}
+
+bool LeaderboardStore::writeBatch(std::vector<LeaderboardEntry>& batch) {
+    std::string buffer;
+    buffer.reserve(batch.size() * 64);
+    for (const auto& entry : batch) {
+        encodeRecord(entry, buffer);
+    }
+
+    bool ok = journal_ && std::fwrite(buffer.data(), 1, buffer.size(), journal_) == buffer.size() &&
+              (config_.syncWrites ? syncFile(journal_) : std::fflush(journal_) == 0);
+    if (ok) {
+        journalBytes_ += buffer.size();
+        written_.fetch_add(batch.size(), std::memory_order_release);
+    } else {
+        failed_.fetch_add(batch.size(), std::memory_order_release);
+        rewindJournal();
+    }
+    return ok;
+}
+
+bool LeaderboardStore::rewindJournal() {
+    // Part of the failed batch may be on disk. The next open would cut the
+    // journal at that torn record, and every append after it with it, so
+    // cut it back to the last whole batch now
+    if (journal_) {
+        std::fclose(journal_);
+        journal_ = nullptr;
+    }
+    if (openJournal(journalGeneration_, journalBytes_)) {
+        return true;
+    }
+
+    // Cannot cut it: seal the journal there and append to a new generation.
+    // Journals are read one by one, so only this journal's tail is lost
+    return openJournal(journalGeneration_ + 1, 0);
+}
+
+bool LeaderboardStore::compact() {
+    if (journalBytes_ <= sizeof(JournalHeader)) {
+        return true;  // Nothing new since the last snapshot
+    }
+
+    // Seal the current journal; new entries go to the next generation
+    uint64_t sealedGeneration = journalGeneration_;
+    syncFile(journal_);
+    std::fclose(journal_);
+    journal_ = nullptr;
+    if (!openJournal(sealedGeneration + 1, 0)) {
+        return false;
+    }
+
+    // Old snapshot + sealed journals -> one sorted segment per challenge.
+    // A damaged old snapshot would be rewritten without the entries past
+    // the damage, so give up instead; the journals stay until a snapshot
+    // covers them.
+    std::vector<LeaderboardSegment> previous;
+    uint64_t coveredGeneration = 0;
+    std::error_code ec;
+    if (fs::exists(snapshotPath(), ec) &&
+        !readSnapshot(snapshotPath(), previous, coveredGeneration)) {
+        setAsideSnapshot();
+        return false;
+    }
+
+    std::map<ChallengeType, std::vector<LeaderboardEntry>> added;
+    std::vector<uint64_t> sealed;
+    for (uint64_t generation : listJournals()) {
+        if (generation <= snapshotGeneration_ || generation > sealedGeneration) {
+            continue;
+        }
+        std::vector<LeaderboardEntry> entries;
+        size_t validBytes = 0;
+        size_t fileBytes = 0;
+        readJournal(journalPath(generation), entries, validBytes, fileBytes);
+        for (auto& entry : entries) {
+            added[entry.challengeType].push_back(std::move(entry));
+        }
+        sealed.push_back(generation);
+    }
+
+    std::map<ChallengeType, std::vector<LeaderboardEntry>> merged;
+    for (auto& segment : previous) {
+        merged[segment.challengeType] = std::move(segment.entries);
+    }
+    for (auto& pair : added) {
+        // Stable, so equal keys keep arrival order after older snapshot entries
+        std::stable_sort(pair.second.begin(), pair.second.end());
+        auto& board = merged[pair.first];
+        std::vector<LeaderboardEntry> combined;
+        combined.reserve(board.size() + pair.second.size());
+        std::merge(std::make_move_iterator(board.begin()), std::make_move_iterator(board.end()),
+                   std::make_move_iterator(pair.second.begin()), std::make_move_iterator(pair.second.end()),
+                   std::back_inserter(combined));
+        board = std::move(combined);
+    }
+
+    // Write the new snapshot beside the old one, then swap it in
+    std::string buffer;
+    SnapshotHeader header{SNAPSHOT_MAGIC, FORMAT_VERSION, sealedGeneration,
+                          static_cast<uint32_t>(merged.size()), 0};
+    put(buffer, header);
+
+    // Entries below the top N stay while a time window can still rank them
+    uint64_t retainFrom = UINT64_MAX;
+    if (config_.retainRecentSeconds > 0) {
+        uint64_t newest = 0;
+        for (const auto& pair : merged) {
+            for (const auto& entry : pair.second) {
+                newest = std::max(newest, entry.timestamp);
+            }
+        }
+        retainFrom = newest > config_.retainRecentSeconds ? newest - config_.retainRecentSeconds : 0;
+    }
+
+    for (auto& pair : merged) {
+        auto& entries = pair.second;
+        if (config_.maxEntriesPerChallenge > 0 && entries.size() > config_.maxEntriesPerChallenge) {
+            size_t rank = 0;
+            entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                         [&](const LeaderboardEntry& entry) {
+                                             return rank++ >= config_.maxEntriesPerChallenge &&
+                                                    entry.timestamp < retainFrom;
+                                         }),
+                          entries.end());
+        }
+
+        size_t segmentAt = buffer.size();
+        put(buffer, SegmentHeader{static_cast<uint32_t>(pair.first),
+                                  static_cast<uint32_t>(entries.size()), 0});
+        size_t recordsAt = buffer.size();
+        for (const auto& entry : entries) {
+            encodeRecord(entry, buffer);
+        }
+        uint64_t byteLength = buffer.size() - recordsAt;
+        std::memcpy(&buffer[segmentAt + offsetof(SegmentHeader, byteLength)], &byteLength, sizeof(byteLength));
+    }
+
+    std::string tempPath = snapshotPath() + ".tmp";
+    std::FILE* file = std::fopen(tempPath.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    bool ok = std::fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+    syncFile(file);
+    std::fclose(file);
+
+    if (ok) {
+        fs::rename(tempPath, snapshotPath(), ec);
+        ok = !ec;
+    }
+    if (!ok) {
+        fs::remove(tempPath, ec);
+        return false;
+    }
+    syncDirectory(directory_);
+
+    // The snapshot now covers the sealed journals
+    snapshotGeneration_ = sealedGeneration;
+    snapshotBytes_ = buffer.size();
+    for (uint64_t generation : sealed) {
+        fs::remove(journalPath(generation), ec);
+    }
+
+    compactions_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void LeaderboardStore::setAsideSnapshot() {
+    std::error_code ec;
+    fs::rename(snapshotPath(), snapshotPath() + CORRUPT_SUFFIX, ec);
+    syncDirectory(directory_);
+    snapshotBytes_ = 0;
+    corruptSnapshots_.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace game
+} // namespace kinect
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "LeaderboardIndex.h"
+#include "../core/SpscQueue.h"
+#include "../../include/GameConfig.h"
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace kinect {
+namespace game {
+
+// Store tuning
+struct LeaderboardStoreConfig {
+    size_t compactThresholdBytes = 4 * 1024 * 1024;  // Journal size that triggers compaction
+    float compactSnapshotRatio = 0.5f;               // ...or this fraction of the snapshot, if larger
+    size_t maxEntriesPerChallenge = 0;               // Trim snapshots to top N (0 = keep all)
+    uint64_t retainRecentSeconds = 0;                // ...but keep entries this recent (window history)
+    bool syncWrites = true;                          // Flush the journal to disk after each batch
+};
+
+// Entries of one challenge, in rank order
+struct LeaderboardSegment {
+    ChallengeType challengeType;
+    std::vector<LeaderboardEntry> entries;
+};
+
+// Crash-safe binary persistence for Leaderboard.
+//
+// Directory layout:
+//   leaderboard.snapshot       Compacted entries, one sorted segment per challenge
+//   journal-<generation>.log   Entries appended since that snapshot
+//
+// Every record, in journals and snapshots alike, carries a CRC-32. A torn record
+// at the end of a journal (power loss mid-write) is detected and cut off on
+// open. Compaction writes a new snapshot next to the old one and renames it
+// into place, so a crash at any point leaves either the old or the new
+// snapshot plus the journals it does not yet cover. Journals are only
+// deleted once a snapshot covering them has been read back in full (on
+// open) or renamed into place and the directory synced (on compaction).
+// A snapshot that fails its checks is never folded into a new one: it is
+// renamed to leaderboard.snapshot.corrupt and left for inspection.
+//
+// append() only pushes onto a lock-free queue; a writer thread owns the
+// files and runs compaction, so the game thread never waits on disk I/O.
+class LeaderboardStore {
+public:
+    static constexpr size_t QUEUE_SIZE = 1024;
+
+    explicit LeaderboardStore(const LeaderboardStoreConfig& config = LeaderboardStoreConfig());
+    ~LeaderboardStore();
+
+    LeaderboardStore(const LeaderboardStore&) = delete;
+    LeaderboardStore& operator=(const LeaderboardStore&) = delete;
+
+    // Load persisted entries and start the writer thread. Snapshot segments
+    // come back already sorted; journal entries follow in arrival order.
+    bool open(const std::string& directory,
+              std::vector<LeaderboardSegment>& segments,
+              std::vector<LeaderboardEntry>& journal);
+
+    // Drain the queue and stop the writer thread
+    void close();
+
+    // Queue an entry for the writer thread (game thread only). Never
+    // blocks; returns false and counts a drop if the queue is full.
+    bool append(const LeaderboardEntry& entry);
+
+    // Ask the writer thread to fold the journal into a new snapshot
+    void requestCompaction() { compactRequested_.store(true, std::memory_order_release); }
+
+    // Wait until every queued entry has been written
+    void flush();
+
+    bool isOpen() const { return running_.load(std::memory_order_acquire); }
+
+    // Stats
+    uint64_t getWrittenCount() const { return written_.load(std::memory_order_relaxed); }
+    uint64_t getDroppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+    uint64_t getFailedCount() const { return failed_.load(std::memory_order_relaxed); }
+    uint64_t getCompactionCount() const { return compactions_.load(std::memory_order_relaxed); }
+    uint64_t getCorruptSnapshotCount() const { return corruptSnapshots_.load(std::memory_order_relaxed); }
+    size_t getRecoveredTornBytes() const { return recoveredTornBytes_; }
+    float getLastLoadTimeMs() const { return lastLoadTimeMs_; }
+
+private:
+    LeaderboardStoreConfig config_;
+    std::string directory_;
+
+    core::SpscQueue<LeaderboardEntry, QUEUE_SIZE> queue_;
+    std::thread writerThread_;
+    std::atomic<bool> running_;
+    std::atomic<bool> compactRequested_;
+
+    std::atomic<uint64_t> queued_;
+    std::atomic<uint64_t> written_;
+    std::atomic<uint64_t> dropped_;     // Queue full
+    std::atomic<uint64_t> failed_;      // Write errors
+    std::atomic<uint64_t> compactions_;
+    std::atomic<uint64_t> corruptSnapshots_;  // Set aside as .corrupt
+    size_t recoveredTornBytes_;
+    float lastLoadTimeMs_;
+
+    // Writer thread state
+    uint64_t snapshotGeneration_;   // Newest journal generation folded into the snapshot
+    uint64_t journalGeneration_;    // Journal currently appended to
+    std::FILE* journal_;
+    size_t journalBytes_;
+    size_t snapshotBytes_;
+
+    // Compaction rewrites the whole snapshot, so the trigger grows with it
+    // to keep the rewrite cost per appended entry bounded
+    bool shouldCompact() const;
+
+    void writerThreadFunc();
+    bool writeBatch(std::vector<LeaderboardEntry>& batch);
+    bool openJournal(uint64_t generation, size_t validBytes);
+    bool rewindJournal();
+    bool compact();
+    void setAsideSnapshot();
+
+    std::string snapshotPath() const;
+    std::string journalPath(uint64_t generation) const;
+    std::vector<uint64_t> listJournals() const;
+};
+
+} // namespace game
+} // namespace kinect
@@ -0,0 +1,164 @@
+#include "LeaderboardWindow.h"
+#include <algorithm>
+
+namespace kinect {
+namespace game {
+
+LeaderboardWindow::LeaderboardWindow(const LeaderboardWindowConfig& config)
+    : config_(config)
+    , bucketWidth_(std::max<uint64_t>(1, config.duration / std::max<uint32_t>(1, config.bucketCount)))
+    , currentEpoch_(0)
+    , buckets_(std::max<uint32_t>(1, config.bucketCount))
+    , size_(0)
+{
+}
+
+void LeaderboardWindow::clear() {
+    for (auto& bucket : buckets_) {
+        expireBucket(bucket);
+    }
+    currentEpoch_ = 0;
+}
+
+uint64_t LeaderboardWindow::getWindowStart() const {
+    uint64_t oldest = currentEpoch_ >= buckets_.size() - 1 ? currentEpoch_ - (buckets_.size() - 1) : 0;
+    return oldest * bucketWidth_;
+}
+
+void LeaderboardWindow::expireBucket(Bucket& bucket) {
+    if (bucket.live) {
+        size_ -= bucket.index.size();
+        bucket.index.clear();
+        bucket.scores.clear();
+        bucket.trimmed = 0;
+        bucket.floorScore = 0;
+        bucket.live = false;
+        bucket.frozen = false;
+    }
+}
+
+void LeaderboardWindow::freezeBucket(Bucket& bucket) {
+    if (!bucket.live || bucket.frozen) {
+        return;
+    }
+    bucket.scores.clear();
+    bucket.scores.reserve(bucket.index.size());
+    for (const auto& entry : bucket.index) {
+        bucket.scores.push_back(entry.score);
+    }
+    bucket.frozen = true;
+}
+
+void LeaderboardWindow::advance(uint64_t now) {
+    uint64_t epoch = now / bucketWidth_;
+    if (epoch <= currentEpoch_) {
+        return;
+    }
+
+    // The bucket that was open is closed from now on
+    Bucket& previous = bucketFor(currentEpoch_);
+    if (previous.epoch == currentEpoch_) {
+        freezeBucket(previous);
+    }
+
+    // Only the buckets between the old and new epoch change hands
+    uint64_t steps = std::min<uint64_t>(epoch - currentEpoch_, buckets_.size());
+    for (uint64_t i = 1; i <= steps; ++i) {
+        Bucket& bucket = bucketFor(epoch - steps + i);
+        if (bucket.epoch != epoch - steps + i) {
+            expireBucket(bucket);
+        }
+    }
+    currentEpoch_ = epoch;
+}
+
+bool LeaderboardWindow::add(const LeaderboardEntry& entry) {
+    uint64_t epoch = entry.timestamp / bucketWidth_;
+    advance(entry.timestamp);
+    if (epoch + buckets_.size() <= currentEpoch_) {
+        return false;  // Older than the window
+    }
+
+    Bucket& bucket = bucketFor(epoch);
+    if (!bucket.live || bucket.epoch != epoch) {
+        expireBucket(bucket);
+        bucket.epoch = epoch;
+        bucket.live = true;
+    }
+
+    // A full bucket keeps its best entries and remembers what it dropped
+    if (config_.maxEntriesPerBucket > 0 && bucket.index.size() >= config_.maxEntriesPerBucket) {
+        const LeaderboardEntry* last = bucket.index.last();
+        const LeaderboardEntry& dropped = (entry < *last) ? *last : entry;
+        bucket.floorScore = bucket.trimmed > 0 ? std::max(bucket.floorScore, dropped.score) : dropped.score;
+        bucket.trimmed++;
+        if (&dropped == &entry) {
+            return false;
+        }
+        bucket.index.eraseLast();
+        if (bucket.frozen) {
+            bucket.scores.pop_back();
+        }
+        size_--;
+    }
+
+    bucket.index.insert(entry);
+    if (bucket.frozen) {
+        // Late arrival for a closed bucket; keep its scores sorted
+        auto position = std::upper_bound(bucket.scores.begin(), bucket.scores.end(), entry.score,
+                                         [](int32_t a, int32_t b) { return a > b; });
+        bucket.scores.insert(position, entry.score);
+    }
+    size_++;
+    return true;
+}
+
+size_t LeaderboardWindow::rankOfScore(int32_t score) const {
+    size_t ahead = 0;
+    for (const auto& bucket : buckets_) {
+        if (!bucket.live) {
+            continue;
+        }
+        if (bucket.frozen) {
+            // Scores are best first: count those >= score
+            auto end = std::partition_point(bucket.scores.begin(), bucket.scores.end(),
+                                            [score](int32_t s) { return s >= score; });
+            ahead += static_cast<size_t>(end - bucket.scores.begin());
+        } else if (!bucket.index.empty()) {
+            ahead += bucket.index.rankOfScore(score) - 1;
+        }
+    }
+    return ahead + 1;
+}
+
+std::vector<const LeaderboardEntry*> LeaderboardWindow::top(size_t count) const {
+    std::vector<LeaderboardIndex::ConstIterator> heads;
+    std::vector<LeaderboardIndex::ConstIterator> ends;
+    for (const auto& bucket : buckets_) {
+        if (bucket.live && !bucket.index.empty()) {
+            heads.push_back(bucket.index.begin());
+            ends.push_back(bucket.index.end());
+        }
+    }
+
+    std::vector<const LeaderboardEntry*> result;
+    result.reserve(std::min(count, size_));
+    while (result.size() < count) {
+        size_t best = heads.size();
+        for (size_t i = 0; i < heads.size(); ++i) {
+            if (heads[i] != ends[i] && (best == heads.size() || *heads[i] < *heads[best])) {
+                best = i;
+            }
+        }
+        if (best == heads.size()) {
+            break;
+        }
+        result.push_back(&*heads[best]);
+        ++heads[best];
+    }
+
+    return result;
+}
+
+} // namespace game
+} // namespace kinect
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "LeaderboardIndex.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace kinect {
+namespace game {
+
+// Rolling window settings. Times are in LeaderboardEntry::timestamp units
+// (Unix seconds).
+struct LeaderboardWindowConfig {
+    // Far above what one kiosk plays in a bucket, so ranks stay exact in
+    // normal use while a flood of entries cannot grow a window without bound
+    static constexpr size_t DEFAULT_MAX_ENTRIES_PER_BUCKET = 1000;
+
+    std::string name;
+    uint64_t duration = 24 * 60 * 60;   // Span covered by the window
+    uint32_t bucketCount = 24;          // Expiry granularity = duration / bucketCount
+    size_t maxEntriesPerBucket = DEFAULT_MAX_ENTRIES_PER_BUCKET;   // Best N per bucket (0 = all)
+
+    static LeaderboardWindowConfig today() {
+        return {"today", 24ull * 60 * 60, 24, DEFAULT_MAX_ENTRIES_PER_BUCKET};
+    }
+    static LeaderboardWindowConfig thisWeek() {
+        return {"this_week", 7ull * 24 * 60 * 60, 28, DEFAULT_MAX_ENTRIES_PER_BUCKET};
+    }
+};
+
+// One rolling time window over a challenge's entries.
+//
+// Entries are filed into a ring of time buckets, each with its own
+// order-statistic index. Arrivals insert into one bucket in O(log n);
+// expiry drops whole buckets as time advances, so nothing is ever rescanned.
+// Once time moves past a bucket its scores are also frozen into a flat
+// sorted array, so a rank query is one binary search per closed bucket
+// plus one index lookup for the open one. Top-k merges the bucket heads.
+//
+// The window is bucket-aligned: it covers the current bucket plus the
+// previous bucketCount - 1, i.e. between duration - bucket width and
+// duration of history.
+class LeaderboardWindow {
+public:
+    explicit LeaderboardWindow(const LeaderboardWindowConfig& config);
+
+    // Add an entry; ignored if it is older than the window
+    bool add(const LeaderboardEntry& entry);
+
+    // Expire buckets that fall out of the window at time now
+    void advance(uint64_t now);
+
+    // Rank a new entry with this score would take within the window.
+    // Exact unless a trimmed bucket's floor is at or above the score.
+    size_t rankOfScore(int32_t score) const;
+
+    // Best entries in the window, best first (pointers into the buckets,
+    // valid until the next add/advance)
+    std::vector<const LeaderboardEntry*> top(size_t count) const;
+
+    size_t size() const { return size_; }
+    uint64_t getWindowStart() const;
+    const LeaderboardWindowConfig& getConfig() const { return config_; }
+
+    void clear();
+
+private:
+    struct Bucket {
+        uint64_t epoch = 0;            // timestamp / bucketWidth
+        LeaderboardIndex index;
+        std::vector<int32_t> scores;   // Closed buckets: scores, best first
+        size_t trimmed = 0;            // Entries dropped by maxEntriesPerBucket
+        int32_t floorScore = 0;        // Best score among the trimmed entries
+        bool live = false;
+        bool frozen = false;
+    };
+
+    LeaderboardWindowConfig config_;
+    uint64_t bucketWidth_;
+    uint64_t currentEpoch_;
+    std::vector<Bucket> buckets_;
+    size_t size_;
+
+    Bucket& bucketFor(uint64_t epoch) { return buckets_[epoch % buckets_.size()]; }
+    void expireBucket(Bucket& bucket);
+    void freezeBucket(Bucket& bucket);
+};
+
+} // namespace game
+} // namespace kinect
@@ -0,0 +1,234 @@
+#include "OpenCvDrawBackend.h"
+#include "RenderLayer.h"
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <cstring>
+
+namespace kinect {
+namespace game {
+
+namespace {
+
+cv::Scalar toScalar(DrawColor color) {
+    return cv::Scalar(color.b, color.g, color.r);
+}
+
+int toFont(DrawFont font) {
+    return font == DrawFont::Bold ? cv::FONT_HERSHEY_DUPLEX : cv::FONT_HERSHEY_SIMPLEX;
+}
+
+// Blend a filled rectangle over the canvas
+void blendRect(cv::Mat& canvas, cv::Rect area, DrawColor color) {
+    area &= cv::Rect(0, 0, canvas.cols, canvas.rows);
+    if (area.empty()) {
+        return;
+    }
+    cv::Mat roi = canvas(area);
+    double alpha = color.a / 255.0;
+    if (color.b == color.g && color.g == color.r) {
+        // Grey: one in-place pass
+        roi.convertTo(roi, -1, 1.0 - alpha, color.b * alpha);
+    } else {
+        roi.convertTo(roi, -1, 1.0 - alpha);
+        roi += cv::Scalar(color.b * alpha, color.g * alpha, color.r * alpha);
+    }
+}
+
+} // namespace
+
+OpenCvDrawBackend::OpenCvDrawBackend()
+    : target_(nullptr)
+    , frame_(0)
+    , layerRasters_(0)
+{
+}
+
+OpenCvDrawBackend::~OpenCvDrawBackend() = default;
+
+void OpenCvDrawBackend::setSprite(uint32_t id, const cv::Mat& image) {
+    sprites_[id] = std::make_shared<cv::Mat>(image.clone());
+}
+
+void OpenCvDrawBackend::submit(const DrawList& list) {
+    if (!target_ || target_->empty()) {
+        return;
+    }
+    frame_++;
+
+    for (const DrawCommand& command : list.getCommands()) {
+        if (command.op == DrawOp::Layer) {
+            drawLayer(*target_, list.getLayer(command));
+        } else {
+            draw(*target_, list, command);
+        }
+    }
+
+    // Drop rasters of layers that are no longer drawn
+    for (auto it = layers_.begin(); it != layers_.end();) {
+        if (frame_ - it->second.lastUsed > LAYER_EVICT_FRAMES) {
+            it = layers_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void OpenCvDrawBackend::draw(cv::Mat& canvas, const DrawList& list, const DrawCommand& command) {
+    cv::Point p0(static_cast<int>(command.x0), static_cast<int>(command.y0));
+    cv::Point p1(static_cast<int>(command.x1), static_cast<int>(command.y1));
+    cv::Scalar color = toScalar(command.color);
+
+    switch (command.op) {
+        case DrawOp::Rect:
+            if (command.color.a < 255 && command.thickness < 0) {
+                blendRect(canvas, cv::Rect(p0, p1), command.color);
+            } else {
+                cv::rectangle(canvas, p0, p1, color, command.thickness);
+            }
+            break;
+
+        case DrawOp::Line:
+            cv::line(canvas, p0, p1, color, command.thickness);
+            break;
+
+        case DrawOp::Circle:
+            cv::circle(canvas, p0, static_cast<int>(command.x1), color, command.thickness);
+            break;
+
+        case DrawOp::Text: {
+            std::string text(list.getText(command), command.length);
+            int font = toFont(command.font);
+            int thickness = std::max<int>(1, command.thickness);
+            cv::Point origin = p0;
+            if (command.anchor != TextAnchor::BaselineLeft) {
+                cv::Size size = cv::getTextSize(text, font, command.x1, thickness, nullptr);
+                origin.x -= size.width / 2;
+                if (command.anchor == TextAnchor::TopCenter) {
+                    origin.y += size.height;
+                } else if (command.anchor == TextAnchor::Center) {
+                    origin.y += size.height / 2;
+                }
+            }
+            cv::putText(canvas, text, origin, font, command.x1, color, thickness);
+            break;
+        }
+
+        case DrawOp::Sprite: {
+            auto it = sprites_.find(command.payload);
+            cv::Rect area(p0, p1);
+            cv::Rect clipped = area & cv::Rect(0, 0, canvas.cols, canvas.rows);
+            if (it == sprites_.end() || clipped.empty()) {
+                break;
+            }
+            cv::Mat scaled;
+            cv::resize(*it->second, scaled, area.size());
+            cv::Mat source = scaled(clipped - area.tl());
+            cv::Mat destination = canvas(clipped);
+            if (source.channels() == 4 && destination.channels() == 3) {
+                std::vector<cv::Mat> planes;
+                cv::split(source, planes);
+                cv::Mat bgr;
+                cv::merge(std::vector<cv::Mat>(planes.begin(), planes.begin() + 3), bgr);
+                bgr.copyTo(destination, planes[3]);
+            } else if (source.channels() == destination.channels()) {
+                source.copyTo(destination);
+            }
+            break;
+        }
+
+        case DrawOp::Layer:
+            break;  // Handled by submit(); layers do not nest
+    }
+}
+
+void OpenCvDrawBackend::drawLayer(cv::Mat& target, const RenderLayer& layer) {
+    if (!layer.isValid()) {
+        return;
+    }
+
+    LayerRaster& raster = layers_[layer.getId()];
+    if (raster.version != layer.getVersion()) {
+        rasterise(layer, raster);
+    }
+    raster.lastUsed = frame_;
+
+    if (raster.runs.empty() || target.depth() != CV_8U) {
+        return;
+    }
+    int channels = target.channels();
+    if (channels != 3 && channels != 4) {
+        return;
+    }
+
+    int layerX = layer.getX();
+    int layerY = layer.getY();
+    for (const Run& run : raster.runs) {
+        int row = layerY + run.y;
+        if (row < 0 || row >= target.rows) {
+            continue;
+        }
+        int begin = std::max(layerX + run.x, 0);
+        int end = std::min(layerX + run.x + run.length, target.cols);
+        if (begin >= end) {
+            continue;
+        }
+
+        const uint8_t* src = raster.pixels.data() + (run.offset + (begin - layerX - run.x)) * 3;
+        uint8_t* dst = target.ptr<uint8_t>(row) + begin * channels;
+        if (channels == 3) {
+            std::memcpy(dst, src, static_cast<size_t>(end - begin) * 3);
+        } else {
+            for (int i = 0; i < end - begin; ++i, src += 3, dst += 4) {
+                dst[0] = src[0];
+                dst[1] = src[1];
+                dst[2] = src[2];
+                dst[3] = 255;
+            }
+        }
+    }
+}
+
+void OpenCvDrawBackend::rasterise(const RenderLayer& layer, LayerRaster& raster) {
+    raster.version = layer.getVersion();
+    raster.runs.clear();
+    raster.pixels.clear();
+    layerRasters_++;
+
+    int width = layer.getWidth();
+    int height = layer.getHeight();
+    if (width == 0 || height == 0) {
+        return;
+    }
+
+    // One scratch canvas per thread, reused across layers
+    static thread_local cv::Mat canvas;
+    canvas.create(height, width, CV_8UC3);
+    canvas.setTo(cv::Scalar(0, 0, 0));
+    const DrawList& commands = layer.getCommands();
+    for (const DrawCommand& command : commands.getCommands()) {
+        draw(canvas, commands, command);
+    }
+
+    // Keep only the inked pixels, as horizontal runs
+    for (int row = 0; row < height; ++row) {
+        const uint8_t* src = canvas.ptr<uint8_t>(row);
+        int col = 0;
+        while (col < width) {
+            while (col < width && (src[col * 3] | src[col * 3 + 1] | src[col * 3 + 2]) == 0) {
+                col++;
+            }
+            int start = col;
+            while (col < width && (src[col * 3] | src[col * 3 + 1] | src[col * 3 + 2]) != 0) {
+                col++;
+            }
+            if (col > start) {
+                raster.runs.push_back({row, start, col - start,
+                                       static_cast<uint32_t>(raster.pixels.size() / 3)});
+                raster.pixels.insert(raster.pixels.end(), src + start * 3, src + col * 3);
+            }
+        }
+    }
+}
+
+} // namespace game
+} // namespace kinect
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "DrawList.h"
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace cv { class Mat; }
+
+namespace kinect {
+namespace game {
+
+// Rasterises draw lists onto a BGR (or BGRA) cv::Mat, for the OpenCV
+// preview path and offline tools.
+//
+// Retained layers are rasterised once per layer version onto a black
+// scratch canvas and kept as runs of inked pixels (pure black is
+// transparent). Later frames only copy those runs into the target;
+// nothing else in the frame is touched. Layers not seen for a while are
+// evicted.
+class OpenCvDrawBackend : public DrawBackend {
+public:
+    static constexpr uint64_t LAYER_EVICT_FRAMES = 300;
+
+    OpenCvDrawBackend();
+    ~OpenCvDrawBackend() override;
+
+    // Target for the following submits; must stay valid while submitting
+    void setTarget(cv::Mat& target) { target_ = &target; }
+
+    void submit(const DrawList& list) override;
+
+    // Images for DrawList::sprite(); BGRA sprites use alpha as a mask
+    void setSprite(uint32_t id, const cv::Mat& image);
+
+    // Stats
+    uint64_t getLayerRasterCount() const { return layerRasters_; }
+    size_t getCachedLayerCount() const { return layers_.size(); }
+
+private:
+    struct Run {
+        int32_t y;          // Layer-local row
+        int32_t x;          // Layer-local first column
+        int32_t length;     // Pixels
+        uint32_t offset;    // Into pixels, in pixels
+    };
+
+    struct LayerRaster {
+        uint64_t version = 0;
+        uint64_t lastUsed = 0;
+        std::vector<Run> runs;
+        std::vector<uint8_t> pixels;   // Packed BGR for every run
+    };
+
+    cv::Mat* target_;
+    uint64_t frame_;
+    uint64_t layerRasters_;
+    std::unordered_map<uint64_t, LayerRaster> layers_;
+    std::map<uint32_t, std::shared_ptr<cv::Mat>> sprites_;
+
+    void draw(cv::Mat& canvas, const DrawList& list, const DrawCommand& command);
+    void drawLayer(cv::Mat& target, const RenderLayer& layer);
+    void rasterise(const RenderLayer& layer, LayerRaster& raster);
+};
+
+} // namespace game
+} // namespace kinect
@@ -16,8 +16,9 @@ GoalkeeperAI::GoalkeeperAI(float reactionTime, float coverage, float randomness)
     rng_.seed(rd());
 }
 
-TargetZone::Position GoalkeeperAI::predictDive(const k4abt_skeleton_t& skeleton,
-                                                const k4a_float3_t& kickDirection)
+TargetZone::Position GoalkeeperAI::predictDive(const BallLaunch& observed,
+                                                const BallPhysics& physics,
+                                                float goalDistance)
 {
     // Add randomness to prediction
     std::uniform_real_distribution<float> randomDist(0.0f, 1.0f);
@@ -28,22 +29,65 @@ TargetZone::Position GoalkeeperAI::predictDive(const k4abt_skeleton_t& skeleton,
         return static_cast<TargetZone::Position>(zoneDist(rng_));
     }
 
-    // Predict based on kick direction
-    // Simplified: map kick direction to zone
-    float angleX = std::atan2(kickDirection.v[0], -kickDirection.v[2]);
-    float angleY = std::atan2(kickDirection.v[1], -kickDirection.v[2]);
+    // The keeper only reads the shot approximately: perturb aim, pace and
+    // spin around what was observed and evaluate all candidates in one batch
+    std::normal_distribution<float> aimError(0.0f, 0.05f);
+    std::normal_distribution<float> paceError(1.0f, 0.1f);
+    std::normal_distribution<float> spinError(1.0f, 0.5f);
+
+    BallLaunch candidates[CANDIDATE_COUNT];
+    BallFlightResult flights[CANDIDATE_COUNT];
+    for (size_t i = 0; i < CANDIDATE_COUNT; ++i) {
+        BallLaunch& candidate = candidates[i];
+        candidate = observed;
+
+        float forward = observed.velocity.xyz.z;
+        float pace = paceError(rng_);
+        candidate.velocity.xyz.x = (observed.velocity.xyz.x + aimError(rng_) * forward) * pace;
+        candidate.velocity.xyz.y = (observed.velocity.xyz.y + aimError(rng_) * forward) * pace;
+        candidate.velocity.xyz.z = forward * pace;
+
+        float spin = spinError(rng_);
+        candidate.spin.xyz.x *= spin;
+        candidate.spin.xyz.y *= spin;
+        candidate.spin.xyz.z *= spin;
+    }
+
+    physics.simulateBatch(candidates, flights, CANDIDATE_COUNT, goalDistance);
+
+    int votes[9] = {0};
+    for (const BallFlightResult& flight : flights) {
+        if (flight.reachedGoal) {
+            votes[static_cast<int>(TargetZone::positionForGoalPoint(
+                flight.impactPoint.xyz.x, flight.impactPoint.xyz.y))]++;
+        }
+    }
 
-    int gridX = angleX < -0.3f ? 0 : (angleX > 0.3f ? 2 : 1);
-    int gridY = angleY > 0.3f ? 0 : (angleY < -0.3f ? 2 : 1);
+    // Stay central if no candidate reaches the goal
+    int best = static_cast<int>(TargetZone::Position::MID_CENTER);
+    for (int zone = 0; zone < 9; ++zone) {
+        if (votes[zone] > votes[best]) {
+            best = zone;
+        }
+    }
 
-    lastDive_ = static_cast<TargetZone::Position>(gridY * 3 + gridX);
+    lastDive_ = static_cast<TargetZone::Position>(best);
     return lastDive_;
 }
 
 bool GoalkeeperAI::willSave(const TargetZone::Position& kickZone,
                             const TargetZone::Position& diveZone,
-                            float velocity)
+                            float velocity,
+                            float timeToGoal)
 {
+    // Ball arrives before the keeper can react: only a shot straight at
+    // the keeper can be stopped
+    if (timeToGoal < reactionTime_) {
+        if (kickZone != TargetZone::Position::MID_CENTER) {
+            return false;
+        }
+    }
+
     // If goalkeeper dives to correct zone
     if (kickZone == diveZone) {
         // Higher velocity reduces save chance
@@ -99,22 +143,20 @@ PenaltyShootout::PenaltyShootout(const PenaltyShootoutConfig& config)
     );
 }
 
+void PenaltyShootout::seed(uint32_t seed) {
+    // The keeper draws from its own stream, seeded from ours
+    ChallengeBase::seed(seed);
+    goalkeeper_->seed(static_cast<uint32_t>(rng_()));
+}
+
 void PenaltyShootout::start() {
     ChallengeBase::start();
     goalkeeper_->reset();
     penaltyState_ = PenaltyState::POSITIONING;
 }
 
-void PenaltyShootout::processFrame(const k4abt_skeleton_t& skeleton,
-                                   const k4a_image_t& depthImage,
-                                   float deltaTime)
-{
-    ChallengeBase::processFrame(skeleton, depthImage, deltaTime);
-
-    if (state_ != ChallengeState::ACTIVE) {
-        return;
-    }
-
+void PenaltyShootout::update(const ChallengeFrame& frame) {
+    float deltaTime = frame.deltaTime;
     stateTimer_ += deltaTime;
 
     switch (penaltyState_) {
@@ -127,13 +169,18 @@ void PenaltyShootout::processFrame(const k4abt_skeleton_t& skeleton,
             break;
 
         case PenaltyState::AIMING:
-            // Show aiming guide, wait for kick
-            detectPenaltyKick(skeleton, deltaTime);
+            // Show aiming guide until the detector sees a wind-up
+            if (frame.kickPhase != KickPhase::Idle) {
+                penaltyState_ = PenaltyState::WINDUP;
+                stateTimer_ = 0.0f;
+            }
             break;
 
         case PenaltyState::WINDUP:
-            // Detecting kick motion
-            detectPenaltyKick(skeleton, deltaTime);
+            // Detector abandoned the kick
+            if (frame.kickPhase == KickPhase::Idle) {
+                penaltyState_ = PenaltyState::AIMING;
+            }
             break;
 
         case PenaltyState::KICKED:
@@ -205,111 +252,61 @@ void PenaltyShootout::reset() {
     penaltyState_ = PenaltyState::POSITIONING;
     stateTimer_ = 0.0f;
     goalkeeper_->reset();
-    footTrajectory_.clear();
 }
 
-void PenaltyShootout::detectPenaltyKick(const k4abt_skeleton_t& skeleton, float deltaTime) {
-    k4a_float3_t footPos = skeleton.joints[K4ABT_JOINT_FOOT_RIGHT].position;
-
-    footTrajectory_.push_back(footPos);
-    if (footTrajectory_.size() > 10) {
-        footTrajectory_.erase(footTrajectory_.begin());
-    }
-
-    if (penaltyState_ == PenaltyState::AIMING) {
-        // Look for wind-up
-        if (footTrajectory_.size() >= 3) {
-            auto current = footTrajectory_.back();
-            auto prev = footTrajectory_[footTrajectory_.size() - 3];
-
-            float deltaZ = current.v[2] - prev.v[2];
-            if (deltaZ > 0.15f) {
-                penaltyState_ = PenaltyState::WINDUP;
-                stateTimer_ = 0.0f;
-            }
-        }
-    }
-    else if (penaltyState_ == PenaltyState::WINDUP) {
-        // Look for forward kick
-        if (footTrajectory_.size() >= 5) {
-            auto current = footTrajectory_.back();
-            auto prev = footTrajectory_[footTrajectory_.size() - 5];
-
-            float deltaZ = current.v[2] - prev.v[2];
-
-            if (deltaZ < -0.2f) {  // Fast forward motion
-                executePenalty(skeleton);
-                penaltyState_ = PenaltyState::KICKED;
-                stateTimer_ = 0.0f;
-            }
-        }
-    }
-
-    lastFootPosition_ = footPos;
-}
-
-k4a_float3_t PenaltyShootout::estimateKickDirection(const k4abt_skeleton_t& skeleton) {
-    auto foot = skeleton.joints[K4ABT_JOINT_FOOT_RIGHT].position;
-    auto knee = skeleton.joints[K4ABT_JOINT_KNEE_RIGHT].position;
-
-    k4a_float3_t direction;
-    direction.v[0] = foot.v[0] - knee.v[0];
-    direction.v[1] = foot.v[1] - knee.v[1];
-    direction.v[2] = -(foot.v[2] - knee.v[2]);  // Toward goal
-
-    // Normalize
-    float length = std::sqrt(
-        direction.v[0] * direction.v[0] +
-        direction.v[1] * direction.v[1] +
-        direction.v[2] * direction.v[2]
-    );
-
-    if (length > 0.001f) {
-        direction.v[0] /= length;
-        direction.v[1] /= length;
-        direction.v[2] /= length;
+void PenaltyShootout::onKick(const KickResult& kick, const ChallengeFrame& frame) {
+    // Only one kick per round, and only once the player has been set
+    if (penaltyState_ != PenaltyState::AIMING && penaltyState_ != PenaltyState::WINDUP) {
+        return;
     }
 
-    return direction;
-}
-
-TargetZone::Position PenaltyShootout::determineTargetZone(const k4a_float3_t& direction) {
-    float angleX = std::atan2(direction.v[0], direction.v[2]);
-    float angleY = std::atan2(direction.v[1], direction.v[2]);
-
-    int gridX = angleX < -0.3f ? 0 : (angleX > 0.3f ? 2 : 1);
-    int gridY = angleY > 0.3f ? 0 : (angleY < -0.3f ? 2 : 1);
-
-    return static_cast<TargetZone::Position>(gridY * 3 + gridX);
+    executePenalty(kick, frame.pose);
+    penaltyState_ = PenaltyState::KICKED;
+    stateTimer_ = 0.0f;
 }
 
-void PenaltyShootout::executePenalty(const k4abt_skeleton_t& skeleton) {
+void PenaltyShootout::executePenalty(const KickResult& kickResult, const motion::PoseFeatures& pose) {
     PenaltyKick kick;
-    kick.kickDirection = estimateKickDirection(skeleton);
-    kick.targetZone = determineTargetZone(kick.kickDirection);
-
-    // Calculate velocity from foot trajectory
-    if (footTrajectory_.size() >= 5) {
-        auto current = footTrajectory_.back();
-        auto prev = footTrajectory_[footTrajectory_.size() - 5];
-
-        float dx = current.v[0] - prev.v[0];
-        float dy = current.v[1] - prev.v[1];
-        float dz = current.v[2] - prev.v[2];
 
-        kick.velocity = std::sqrt(dx * dx + dy * dy + dz * dz) / 0.16f;  // Approx 5 frames at 30fps
-    } else {
-        kick.velocity = 10.0f;  // Default
+    // Foot velocity at contact from the shared detector's direction and speed
+    k4a_float3_t footVelocity = {
+        kickResult.kickDirection.v[0] * kickResult.quality.footVelocity,
+        kickResult.kickDirection.v[1] * kickResult.quality.footVelocity,
+        kickResult.kickDirection.v[2] * kickResult.quality.footVelocity
+    };
+    k4abt_joint_id_t footJoint = kickResult.foot == DominantFoot::Left
+        ? K4ABT_JOINT_FOOT_LEFT : K4ABT_JOINT_FOOT_RIGHT;
+
+    // Fly the ball to the goal line
+    BallLaunch launch = ballPhysics_.launchFromKick(
+        pose.getJoint(footJoint), footVelocity, kickResult.type, kickResult.foot);
+    BallFlightResult flight = ballPhysics_.simulate(launch, config_.goalDistance);
+
+    kick.velocity = std::sqrt(launch.velocity.v[0] * launch.velocity.v[0] +
+                              launch.velocity.v[1] * launch.velocity.v[1] +
+                              launch.velocity.v[2] * launch.velocity.v[2]);
+    kick.kickDirection = launch.velocity;
+    if (kick.velocity > 0.001f) {
+        kick.kickDirection.v[0] /= kick.velocity;
+        kick.kickDirection.v[1] /= kick.velocity;
+        kick.kickDirection.v[2] /= kick.velocity;
     }
+    kick.targetPoint = flight.impactPoint;
+    kick.timeToGoal = flight.timeToGoal;
+    kick.targetZone = TargetZone::positionForGoalPoint(flight.impactPoint.v[0], flight.impactPoint.v[1]);
 
     // Goalkeeper predicts and dives
-    goalkeeperDive_ = goalkeeper_->predictDive(skeleton, kick.kickDirection);
+    goalkeeperDive_ = goalkeeper_->predictDive(launch, ballPhysics_, config_.goalDistance);
     goalkeeperAnimationTime_ = 0.0f;
 
-    // Determine if saved
-    bool saved = checkSave(kick);
+    // Off target, otherwise determine if saved
+    bool onTarget = flight.reachedGoal &&
+                    TargetZone::isInsideGoal(flight.impactPoint.v[0], flight.impactPoint.v[1]);
 
-    if (saved) {
+    if (!onTarget) {
+        kick.result = PenaltyKick::Result::MISSED;
+        goalsMissed_++;
+    } else if (checkSave(kick)) {
         kick.result = PenaltyKick::Result::SAVED;
         goalsMissed_++;
     } else {
@@ -321,14 +318,14 @@ void PenaltyShootout::executePenalty(const k4abt_skeleton_t& skeleton) {
         ? config_.pointsPerGoal
         : 0;
 
-    kick.timestamp = std::chrono::steady_clock::now().time_since_epoch().count();
+    kick.timestamp = clock_->nowNs();
 
     recordPenalty(kick);
     lastResult_ = kick.result;
 }
 
 bool PenaltyShootout::checkSave(const PenaltyKick& kick) {
-    return goalkeeper_->willSave(kick.targetZone, goalkeeperDive_, kick.velocity);
+    return goalkeeper_->willSave(kick.targetZone, goalkeeperDive_, kick.velocity, kick.timeToGoal);
 }
 
 void PenaltyShootout::recordPenalty(PenaltyKick kick) {
@@ -341,49 +338,50 @@ void PenaltyShootout::advanceRound() {
     currentRound_++;
     penaltyState_ = PenaltyState::NEXT_ROUND;
     stateTimer_ = 0.0f;
-    footTrajectory_.clear();
 }
 
 void PenaltyShootout::updateGoalkeeper(float deltaTime) {
     goalkeeperAnimationTime_ += deltaTime;
 }
 
-void PenaltyShootout::render(cv::Mat& frame) {
+void PenaltyShootout::draw(DrawList& list) {
     switch (state_) {
         case ChallengeState::INSTRUCTIONS:
-            renderInstructions(frame);
+            drawInstructions(list);
             break;
         case ChallengeState::COUNTDOWN:
-            renderCountdown(frame);
+            drawCountdown(list);
             break;
         case ChallengeState::ACTIVE:
-            renderGoalkeeper(frame);
-            renderScoreboard(frame);
+            drawGoalkeeper(list);
+            drawScoreboard(list);
             if (penaltyState_ == PenaltyState::AIMING) {
-                renderAimingGuide(frame);
+                drawAimingGuide(list);
             }
             if (penaltyState_ == PenaltyState::RESULT_SHOW) {
-                renderKickResult(frame);
+                drawKickResult(list);
             }
             break;
         case ChallengeState::COMPLETE:
-            renderResults(frame);
+            drawResults(list);
             break;
         default:
             break;
     }
 }
 
-void PenaltyShootout::renderGoalkeeper(cv::Mat& frame) {
+void PenaltyShootout::drawGoalkeeper(DrawList& list) {
     // Draw goal
     int goalWidth = 600;
     int goalHeight = 400;
-    int goalX = frame.cols - goalWidth - 100;
-    int goalY = frame.rows / 2 - goalHeight / 2;
+    int goalX = list.getWidth() - goalWidth - 100;
+    int goalY = list.getHeight() / 2 - goalHeight / 2;
 
-    cv::rectangle(frame, cv::Point(goalX, goalY),
-                 cv::Point(goalX + goalWidth, goalY + goalHeight),
-                 cv::Scalar(255, 255, 255), 3);
+    goalLayer_.update(goalX - 5, goalY - 5, goalWidth + 10, goalHeight + 10,
+                      0, [&](DrawList& layer) {
+        layer.rect(5, 5, 5 + goalWidth, 5 + goalHeight, DrawColor(255, 255, 255), 3);
+    });
+    list.layer(goalLayer_);
 
     // Draw goalkeeper
     int gkSize = 80;
@@ -391,14 +389,15 @@ void PenaltyShootout::renderGoalkeeper(cv::Mat& frame) {
     int gkY = goalY + goalHeight / 2;
 
     // Animate dive during kicked state
-    if (penaltyState_ == PenaltyState::KICKED && goalkeeperAnimationTime_ < 1.0f) {
+    float diveTime = std::max(0.0f, goalkeeperAnimationTime_ - drawLag_);
+    if (penaltyState_ == PenaltyState::KICKED && diveTime < 1.0f) {
         int diveRow = static_cast<int>(goalkeeperDive_) / 3;
         int diveCol = static_cast<int>(goalkeeperDive_) % 3;
 
         int targetX = goalX + (goalWidth / 3) * diveCol + (goalWidth / 6);
         int targetY = goalY + (goalHeight / 3) * diveRow + (goalHeight / 6);
 
-        float progress = goalkeeperAnimationTime_ / 0.8f;
+        float progress = diveTime / 0.8f;
         progress = std::min(1.0f, progress);
 
         gkX = static_cast<int>(gkX + (targetX - gkX) * progress);
@@ -406,97 +405,100 @@ void PenaltyShootout::renderGoalkeeper(cv::Mat& frame) {
     }
 
     // Draw goalkeeper as circle
-    cv::circle(frame, cv::Point(gkX, gkY), gkSize / 2,
-              cv::Scalar(255, 200, 0), -1);
-    cv::circle(frame, cv::Point(gkX, gkY), gkSize / 2,
-              cv::Scalar(0, 0, 0), 2);
+    list.circle(gkX, gkY, gkSize / 2, DrawColor(255, 200, 0), DrawList::FILLED);
+    list.circle(gkX, gkY, gkSize / 2, DrawColor(0, 0, 0), 2);
 }
 
-void PenaltyShootout::renderScoreboard(cv::Mat& frame) {
-    int yPos = 50;
-
-    // Round counter
-    std::string roundText = suddenDeath_ ? "SUDDEN DEATH" :
-                           "Round " + std::to_string(currentRound_ + 1) +
-                           "/" + std::to_string(config_.kicksPerPlayer);
-    cv::putText(frame, roundText, cv::Point(50, yPos),
-               cv::FONT_HERSHEY_BOLD, 1.5,
-               suddenDeath_ ? cv::Scalar(255, 0, 0) : cv::Scalar(255, 255, 255), 3);
-    yPos += 70;
-
-    // Score
-    std::string scoreText = "Goals: " + std::to_string(goalsScored_) +
-                           " / " + std::to_string(currentRound_);
-    cv::putText(frame, scoreText, cv::Point(50, yPos),
-               cv::FONT_HERSHEY_SIMPLEX, 1.3, cv::Scalar(0, 255, 0), 2);
-    yPos += 60;
-
-    // Points
-    std::string pointsText = "Points: " + std::to_string(currentScore_);
-    cv::putText(frame, pointsText, cv::Point(50, yPos),
-               cv::FONT_HERSHEY_SIMPLEX, 1.3, cv::Scalar(0, 255, 255), 2);
-    yPos += 80;
-
-    // Kick history
+void PenaltyShootout::drawScoreboard(DrawList& list) {
+    // Rebuilt only when a penalty is taken or the round changes
+    uint64_t recent = 0;
     int historyCount = std::min(5, static_cast<int>(kicks_.size()));
     for (int i = 0; i < historyCount; i++) {
-        size_t idx = kicks_.size() - historyCount + i;
-        const auto& kick = kicks_[idx];
-
-        std::string symbol = kick.result == PenaltyKick::Result::GOAL ? "O" : "X";
-        cv::Scalar color = kick.result == PenaltyKick::Result::GOAL
-            ? cv::Scalar(0, 255, 0)
-            : cv::Scalar(0, 0, 255);
-
-        cv::circle(frame, cv::Point(70 + i * 50, yPos + 20), 15, color, -1);
-        cv::putText(frame, symbol, cv::Point(63 + i * 50, yPos + 30),
-                   cv::FONT_HERSHEY_BOLD, 0.8, cv::Scalar(255, 255, 255), 2);
+        const auto& kick = kicks_[kicks_.size() - historyCount + i];
+        recent |= (kick.result == PenaltyKick::Result::GOAL ? 1ull : 0ull) << i;
     }
+    uint64_t key = layerKey(suddenDeath_, currentRound_, config_.kicksPerPlayer, goalsScored_,
+                            currentScore_, kicks_.size(), recent);
+
+    scoreboardLayer_.update(0, 0, std::min(list.getWidth(), 700), 340, key, [&](DrawList& layer) {
+        int yPos = 50;
+
+        // Round counter
+        std::string roundText = suddenDeath_ ? "SUDDEN DEATH" :
+                               "Round " + std::to_string(currentRound_ + 1) +
+                               "/" + std::to_string(config_.kicksPerPlayer);
+        layer.text(roundText, 50, yPos, DrawFont::Bold, 1.5f,
+                   suddenDeath_ ? DrawColor(255, 0, 0) : DrawColor(255, 255, 255), 3);
+        yPos += 70;
+
+        // Score
+        std::string scoreText = "Goals: " + std::to_string(goalsScored_) +
+                               " / " + std::to_string(currentRound_);
+        layer.text(scoreText, 50, yPos, DrawFont::Regular, 1.3f, DrawColor(0, 255, 0), 2);
+        yPos += 60;
+
+        // Points
+        std::string pointsText = "Points: " + std::to_string(currentScore_);
+        layer.text(pointsText, 50, yPos, DrawFont::Regular, 1.3f, DrawColor(0, 255, 255), 2);
+        yPos += 80;
+
+        // Kick history
+        for (int i = 0; i < historyCount; i++) {
+            size_t idx = kicks_.size() - historyCount + i;
+            const auto& kick = kicks_[idx];
+
+            std::string symbol = kick.result == PenaltyKick::Result::GOAL ? "O" : "X";
+            DrawColor color = kick.result == PenaltyKick::Result::GOAL
+                ? DrawColor(0, 255, 0)
+                : DrawColor(0, 0, 255);
+
+            layer.circle(70 + i * 50, yPos + 20, 15, color, DrawList::FILLED);
+            layer.text(symbol, 63 + i * 50, yPos + 30, DrawFont::Bold, 0.8f,
+                       DrawColor(255, 255, 255), 2);
+        }
+    });
+    list.layer(scoreboardLayer_);
 }
 
-void PenaltyShootout::renderKickResult(cv::Mat& frame) {
+void PenaltyShootout::drawKickResult(DrawList& list) {
     std::string resultText = lastResult_ == PenaltyKick::Result::GOAL
         ? "GOAL!"
+        : lastResult_ == PenaltyKick::Result::MISSED
+        ? "MISSED!"
         : "SAVED!";
 
-    cv::Scalar color = lastResult_ == PenaltyKick::Result::GOAL
-        ? cv::Scalar(0, 255, 0)
-        : cv::Scalar(0, 0, 255);
+    DrawColor color = lastResult_ == PenaltyKick::Result::GOAL
+        ? DrawColor(0, 255, 0)
+        : DrawColor(0, 0, 255);
 
     // Animate
-    float scale = 1.0f + resultAnimationTime_ * 0.5f;
-    float alpha = std::max(0.0f, 1.0f - resultAnimationTime_ * 0.5f);
-
-    cv::Size textSize = cv::getTextSize(resultText, cv::FONT_HERSHEY_BOLD,
-                                       5.0 * scale, static_cast<int>(8 * scale),
-                                       nullptr);
-
-    cv::Point pos(frame.cols / 2 - textSize.width / 2,
-                 frame.rows / 2 + textSize.height / 2);
+    float animationTime = std::max(0.0f, resultAnimationTime_ - drawLag_);
+    float scale = 1.0f + animationTime * 0.5f;
+    float alpha = std::max(0.0f, 1.0f - animationTime * 0.5f);
 
-    cv::putText(frame, resultText, pos, cv::FONT_HERSHEY_BOLD,
-               5.0 * scale, color, static_cast<int>(8 * scale * alpha));
+    list.text(resultText, list.getWidth() / 2, list.getHeight() / 2, DrawFont::Bold,
+              5.0f * scale, color, static_cast<int>(8 * scale * alpha), TextAnchor::Center);
 }
 
-void PenaltyShootout::renderAimingGuide(cv::Mat& frame) {
+void PenaltyShootout::drawAimingGuide(DrawList& list) {
     // Draw aiming reticle
-    std::string aimText = "Aim with your kick direction!";
-    cv::putText(frame, aimText,
-               cv::Point(frame.cols / 2 - 250, frame.rows - 100),
-               cv::FONT_HERSHEY_SIMPLEX, 1.2, cv::Scalar(255, 255, 0), 2);
+    int originY = list.getHeight() - 150;
+    aimTextLayer_.update(0, originY, list.getWidth(), 80, 0, [](DrawList& layer) {
+        layer.text("Aim with your kick direction!", layer.getWidth() / 2 - 250, 50,
+                   DrawFont::Regular, 1.2f, DrawColor(255, 255, 0), 2);
+    });
+    list.layer(aimTextLayer_);
 
     // Pulsing crosshair
     float pulse = 0.5f + 0.5f * std::sin(getElapsedTime() * 3.0f);
-    cv::Scalar crosshairColor(0, 255 * pulse, 255);
+    DrawColor crosshairColor(0, static_cast<int>(255 * pulse), 255);
 
-    int centerX = frame.cols / 2;
-    int centerY = frame.rows / 2;
+    int centerX = list.getWidth() / 2;
+    int centerY = list.getHeight() / 2;
     int size = 40;
 
-    cv::line(frame, cv::Point(centerX - size, centerY),
-            cv::Point(centerX + size, centerY), crosshairColor, 3);
-    cv::line(frame, cv::Point(centerX, centerY - size),
-            cv::Point(centerX, centerY + size), crosshairColor, 3);
+    list.line(centerX - size, centerY, centerX + size, centerY, crosshairColor, 3);
+    list.line(centerX, centerY - size, centerX, centerY + size, crosshairColor, 3);
 }
 
 } // namespace game
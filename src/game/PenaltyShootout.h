@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ChallengeBase.h"
+#include "BallPhysics.h"
 #include "../../include/GameConfig.h"
 #include <random>
 
@@ -17,7 +18,8 @@ struct PenaltyKick {
     };
 
     k4a_float3_t kickDirection;
-    k4a_float3_t targetPoint;
+    k4a_float3_t targetPoint;  // Where the ball crosses the goal plane
+    float timeToGoal;          // seconds
     TargetZone::Position targetZone;
     float velocity;  // m/s
     Result result;
@@ -28,16 +30,23 @@ struct PenaltyKick {
 // Goalkeeper AI
 class GoalkeeperAI {
 public:
+    // Candidate flights evaluated when reading a shot
+    static constexpr size_t CANDIDATE_COUNT = 16;
+
     explicit GoalkeeperAI(float reactionTime, float coverage, float randomness);
 
-    // Predict and dive
-    TargetZone::Position predictDive(const k4abt_skeleton_t& skeleton,
-                                     const k4a_float3_t& kickDirection);
+    // Read the shot: fly a spread of candidate launches around the observed
+    // one and dive to the zone most of them end up in
+    TargetZone::Position predictDive(const BallLaunch& observed,
+                                     const BallPhysics& physics,
+                                     float goalDistance);
     bool willSave(const TargetZone::Position& kickZone,
                   const TargetZone::Position& diveZone,
-                  float velocity);
+                  float velocity,
+                  float timeToGoal);
 
     void reset();
+    void seed(uint32_t seed) { rng_.seed(seed); }
 
 private:
     float reactionTime_;   // Delay before dive
@@ -55,13 +64,11 @@ public:
 
     // Override base methods
     void start() override;
-    void processFrame(const k4abt_skeleton_t& skeleton,
-                     const k4a_image_t& depthImage,
-                     float deltaTime) override;
     void finish() override;
     void reset() override;
+    void seed(uint32_t seed) override;
 
-    void render(cv::Mat& frame) override;
+    void draw(DrawList& list) override;
 
     std::string getName() const override { return "Penalty Shootout"; }
     std::string getDescription() const override {
@@ -74,12 +81,14 @@ public:
     int32_t getCurrentRound() const { return currentRound_; }
     bool isSuddenDeath() const { return suddenDeath_; }
 
+protected:
+    // Game rules
+    void update(const ChallengeFrame& frame) override;
+    void onKick(const KickResult& kick, const ChallengeFrame& frame) override;
+
 private:
-    // Kick detection and execution
-    void detectPenaltyKick(const k4abt_skeleton_t& skeleton, float deltaTime);
-    k4a_float3_t estimateKickDirection(const k4abt_skeleton_t& skeleton);
-    TargetZone::Position determineTargetZone(const k4a_float3_t& direction);
-    void executePenalty(const k4abt_skeleton_t& skeleton);
+    // Kick execution
+    void executePenalty(const KickResult& kickResult, const motion::PoseFeatures& pose);
 
     // Goalkeeper interaction
     void updateGoalkeeper(float deltaTime);
@@ -90,13 +99,14 @@ private:
     void advanceRound();
 
     // Rendering helpers
-    void renderGoalkeeper(cv::Mat& frame);
-    void renderScoreboard(cv::Mat& frame);
-    void renderKickResult(cv::Mat& frame);
-    void renderAimingGuide(cv::Mat& frame);
+    void drawGoalkeeper(DrawList& list);
+    void drawScoreboard(DrawList& list);
+    void drawKickResult(DrawList& list);
+    void drawAimingGuide(DrawList& list);
 
     // Configuration
     PenaltyShootoutConfig config_;
+    BallPhysics ballPhysics_;
 
     // Game state
     std::vector<PenaltyKick> kicks_;
@@ -122,13 +132,14 @@ private:
     PenaltyState penaltyState_;
     float stateTimer_;
 
-    // Kick detection
-    k4a_float3_t lastFootPosition_;
-    std::vector<k4a_float3_t> footTrajectory_;
-
     // Result animation
     PenaltyKick::Result lastResult_;
     float resultAnimationTime_;
+
+    // Cached overlay layers
+    RenderLayer goalLayer_;
+    RenderLayer scoreboardLayer_;
+    RenderLayer aimTextLayer_;
 };
 
 } // namespace game
@@ -1,4 +1,5 @@
 #include "PowerChallenge.h"
+#include "BallPhysics.h"
 #include <cmath>
 #include <algorithm>
 
@@ -11,6 +12,7 @@ PowerChallenge::PowerChallenge(const PowerChallengeConfig& config)
     , personalBest_(0.0f)
     , kickState_(PowerKickState::WAITING)
     , kickTimer_(0.0f)
+    , currentFootSpeed_(0.0f)
     , kickAnimationProgress_(0.0f)
     , lastKickVelocity_(0.0f)
 {
@@ -21,44 +23,77 @@ void PowerChallenge::start() {
     kickState_ = PowerKickState::WAITING;
 }
 
-void PowerChallenge::processFrame(const k4abt_skeleton_t& skeleton,
-                                  const k4a_image_t& depthImage,
-                                  float deltaTime)
-{
-    ChallengeBase::processFrame(skeleton, depthImage, deltaTime);
-
-    if (state_ != ChallengeState::ACTIVE) {
-        return;
-    }
-
+void PowerChallenge::update(const ChallengeFrame& frame) {
     // Check if all attempts used
     if (attempts_.size() >= static_cast<size_t>(config_.maxAttempts)) {
         finish();
         return;
     }
 
-    // Track foot positions for velocity calculation
-    k4a_float3_t footPos = skeleton.joints[K4ABT_JOINT_FOOT_RIGHT].position;
-    footPositions_.push_back(footPos);
-    footTimestamps_.push_back(getElapsedTime());
+    currentFootSpeed_ = frame.footSpeed;
+    kickTimer_ += frame.deltaTime;
 
-    if (footPositions_.size() > MAX_FOOT_HISTORY) {
-        footPositions_.pop_front();
-        footTimestamps_.pop_front();
-    }
+    switch (kickState_) {
+        case PowerKickState::WAITING:
+            if (frame.kickPhase == KickPhase::WindUp || frame.kickPhase == KickPhase::Acceleration) {
+                kickState_ = PowerKickState::WINDUP;
+                kickTimer_ = 0.0f;
+            }
+            break;
 
-    // Detect power kicks
-    detectPowerKick(skeleton, deltaTime);
+        case PowerKickState::WINDUP:
+            // Detector abandoned the kick
+            if (frame.kickPhase == KickPhase::Idle) {
+                kickState_ = PowerKickState::WAITING;
+            }
+            break;
+
+        case PowerKickState::IMPACT:
+            if (kickTimer_ > 0.5f) {
+                kickState_ = PowerKickState::COOLDOWN;
+                kickTimer_ = 0.0f;
+            }
+            break;
+
+        case PowerKickState::COOLDOWN:
+            // Wait before allowing next attempt
+            if (kickTimer_ > 2.0f) {
+                kickState_ = PowerKickState::WAITING;
+            }
+            break;
+    }
 
     // Update animation
     if (kickAnimationProgress_ > 0.0f) {
-        kickAnimationProgress_ -= deltaTime * 2.0f;
+        kickAnimationProgress_ -= frame.deltaTime * 2.0f;
         if (kickAnimationProgress_ < 0.0f) {
             kickAnimationProgress_ = 0.0f;
         }
     }
 }
 
+void PowerChallenge::onKick(const KickResult& kick, const ChallengeFrame&) {
+    // Ignore kicks while the previous attempt is still on screen
+    if (kickState_ == PowerKickState::IMPACT || kickState_ == PowerKickState::COOLDOWN) {
+        return;
+    }
+
+    PowerKickAttempt attempt;
+    attempt.legSpeed = kick.quality.footVelocity / 1000.0f;  // mm/s to m/s
+    attempt.velocityKmh = kick.quality.estimatedBallSpeed;
+    attempt.velocity = attempt.velocityKmh / 3.6f;  // Convert km/h to m/s
+    attempt.technique = calculateTechnique(kick.quality);
+    attempt.rating = getRating(attempt.velocityKmh);
+    attempt.timestamp = clock_->nowNs();
+
+    recordPowerKick(attempt);
+
+    kickState_ = PowerKickState::IMPACT;
+    kickTimer_ = 0.0f;
+    kickAnimationProgress_ = 1.0f;
+    lastKickVelocity_ = attempt.velocityKmh;
+}
+
 void PowerChallenge::finish() {
     // Calculate final score
     updateResult();
@@ -96,147 +131,16 @@ void PowerChallenge::reset() {
     attempts_.clear();
     kickState_ = PowerKickState::WAITING;
     kickTimer_ = 0.0f;
-    footPositions_.clear();
-    footTimestamps_.clear();
+    currentFootSpeed_ = 0.0f;
     kickAnimationProgress_ = 0.0f;
     lastKickVelocity_ = 0.0f;
 }
 
-void PowerChallenge::detectPowerKick(const k4abt_skeleton_t& skeleton, float deltaTime) {
-    kickTimer_ += deltaTime;
-
-    switch (kickState_) {
-        case PowerKickState::WAITING: {
-            // Look for wind-up (foot moving back and up)
-            if (footPositions_.size() >= 3) {
-                auto current = footPositions_.back();
-                auto prev = footPositions_[footPositions_.size() - 3];
-
-                float deltaZ = current.v[2] - prev.v[2];
-                float deltaY = current.v[1] - prev.v[1];
-
-                if (deltaZ > 0.15f && deltaY > 0.05f) {  // Moving back and up
-                    kickState_ = PowerKickState::WINDUP;
-                    kickTimer_ = 0.0f;
-                }
-            }
-            break;
-        }
-
-        case PowerKickState::WINDUP: {
-            // Look for forward motion (impact)
-            if (footPositions_.size() >= 5) {
-                float velocity = calculateLegVelocity(skeleton);
-
-                if (velocity > 3.0f) {  // Fast forward motion (m/s)
-                    // Record the kick
-                    PowerKickAttempt attempt;
-                    attempt.legSpeed = velocity;
-                    attempt.velocity = velocity;
-                    attempt.velocityKmh = velocity * 3.6f;  // Convert m/s to km/h
-                    attempt.technique = calculateTechnique(skeleton);
-                    attempt.rating = getRating(attempt.velocityKmh);
-                    attempt.timestamp = std::chrono::steady_clock::now()
-                                       .time_since_epoch().count();
-
-                    recordPowerKick(attempt);
-
-                    kickState_ = PowerKickState::IMPACT;
-                    kickTimer_ = 0.0f;
-                    kickAnimationProgress_ = 1.0f;
-                    lastKickVelocity_ = attempt.velocityKmh;
-                }
-            }
-
-            // Timeout if wind-up takes too long
-            if (kickTimer_ > 2.0f) {
-                kickState_ = PowerKickState::WAITING;
-            }
-            break;
-        }
-
-        case PowerKickState::IMPACT: {
-            if (kickTimer_ > 0.5f) {
-                kickState_ = PowerKickState::COOLDOWN;
-                kickTimer_ = 0.0f;
-            }
-            break;
-        }
-
-        case PowerKickState::COOLDOWN: {
-            // Wait before allowing next attempt
-            if (kickTimer_ > 2.0f) {
-                kickState_ = PowerKickState::WAITING;
-            }
-            break;
-        }
-    }
-}
-
-float PowerChallenge::calculateLegVelocity(const k4abt_skeleton_t& skeleton) {
-    if (footPositions_.size() < 5 || footTimestamps_.size() < 5) {
-        return 0.0f;
-    }
-
-    // Calculate velocity over recent frames
-    size_t frameCount = 5;
-    auto endPos = footPositions_.back();
-    auto startPos = footPositions_[footPositions_.size() - frameCount];
-
-    float endTime = footTimestamps_.back();
-    float startTime = footTimestamps_[footTimestamps_.size() - frameCount];
-
-    float deltaTime = endTime - startTime;
-    if (deltaTime < 0.001f) {
-        return 0.0f;
-    }
-
-    float dx = endPos.v[0] - startPos.v[0];
-    float dy = endPos.v[1] - startPos.v[1];
-    float dz = endPos.v[2] - startPos.v[2];
-
-    float distance = std::sqrt(dx * dx + dy * dy + dz * dz);
-    return distance / deltaTime;
-}
-
-float PowerChallenge::calculateTechnique(const k4abt_skeleton_t& skeleton) {
-    // Technique scoring based on form
-    float score = 1.0f;
-
-    // Check hip rotation
-    auto hipLeft = skeleton.joints[K4ABT_JOINT_HIP_LEFT].position;
-    auto hipRight = skeleton.joints[K4ABT_JOINT_HIP_RIGHT].position;
-    float hipAngle = std::atan2(hipRight.v[0] - hipLeft.v[0],
-                                hipRight.v[2] - hipLeft.v[2]);
-
-    // Good hip rotation adds to technique
-    if (std::abs(hipAngle) > 0.3f) {
-        score *= 1.2f;
-    }
-
-    // Check knee bend
-    auto knee = skeleton.joints[K4ABT_JOINT_KNEE_RIGHT].position;
-    auto ankle = skeleton.joints[K4ABT_JOINT_ANKLE_RIGHT].position;
-    auto hip = skeleton.joints[K4ABT_JOINT_HIP_RIGHT].position;
-
-    float thighLength = std::sqrt(
-        std::pow(knee.v[0] - hip.v[0], 2) +
-        std::pow(knee.v[1] - hip.v[1], 2) +
-        std::pow(knee.v[2] - hip.v[2], 2)
-    );
-
-    float shinLength = std::sqrt(
-        std::pow(ankle.v[0] - knee.v[0], 2) +
-        std::pow(ankle.v[1] - knee.v[1], 2) +
-        std::pow(ankle.v[2] - knee.v[2], 2)
-    );
-
-    // Good knee bend in wind-up
-    if (thighLength > 0.001f && shinLength / thighLength < 0.8f) {
-        score *= 1.15f;
-    }
-
-    return std::min(2.0f, score);  // Cap at 2x
+float PowerChallenge::calculateTechnique(const KickQuality& quality) {
+    // Technique multiplier from the analyzer's form score (knee bend,
+    // hip rotation, follow-through): 1x for poor form up to 2x
+    float score = 1.0f + quality.techniqueScore / 100.0f;
+    return std::max(1.0f, std::min(2.0f, score));  // Cap at 2x
 }
 
 std::string PowerChallenge::getRating(float velocityKmh) {
@@ -282,143 +186,154 @@ int32_t PowerChallenge::calculatePowerScore(const PowerKickAttempt& attempt) {
     return baseScore;
 }
 
-void PowerChallenge::render(cv::Mat& frame) {
+void PowerChallenge::draw(DrawList& list) {
     switch (state_) {
         case ChallengeState::INSTRUCTIONS:
-            renderInstructions(frame);
+            drawInstructions(list);
             break;
         case ChallengeState::COUNTDOWN:
-            renderCountdown(frame);
+            drawCountdown(list);
             break;
         case ChallengeState::ACTIVE:
-            renderPowerMeter(frame);
-            renderAttemptHistory(frame);
-            renderCurrentAttempt(frame);
-            renderKickAnimation(frame);
+            drawPowerMeter(list);
+            drawAttemptHistory(list);
+            drawCurrentAttempt(list);
+            drawKickAnimation(list);
             break;
         case ChallengeState::COMPLETE:
-            renderResults(frame);
+            drawResults(list);
             break;
         default:
             break;
     }
 }
 
-void PowerChallenge::renderPowerMeter(cv::Mat& frame) {
+void PowerChallenge::drawPowerMeter(DrawList& list) {
     int meterWidth = 60;
     int meterHeight = 400;
-    int meterX = frame.cols - meterWidth - 50;
-    int meterY = frame.rows / 2 - meterHeight / 2;
+    int meterX = list.getWidth() - meterWidth - 50;
+    int meterY = list.getHeight() / 2 - meterHeight / 2;
 
     // Background
-    cv::rectangle(frame, cv::Point(meterX, meterY),
-                 cv::Point(meterX + meterWidth, meterY + meterHeight),
-                 cv::Scalar(50, 50, 50), -1);
+    list.rect(meterX, meterY, meterX + meterWidth, meterY + meterHeight,
+              DrawColor(50, 50, 50), DrawList::FILLED);
 
     // Current velocity (if kicking)
-    if (footPositions_.size() >= 5) {
-        float currentVelocity = calculateLegVelocity(
-            k4abt_skeleton_t()  // Would need actual skeleton
-        ) * 3.6f;  // Convert to km/h
+    if (currentFootSpeed_ > 0.0f) {
+        // Estimated ball speed for the current foot speed (mm/s), in km/h
+        float currentVelocity = currentFootSpeed_ / 1000.0f * BallPhysics::FOOT_TO_BALL_SPEED * 3.6f;
 
         float fillRatio = std::min(1.0f, currentVelocity / config_.worldClassVelocity);
         int fillHeight = static_cast<int>(meterHeight * fillRatio);
 
-        cv::Scalar color = currentVelocity >= config_.worldClassVelocity
-            ? cv::Scalar(0, 0, 255)   // Red
+        DrawColor color = currentVelocity >= config_.worldClassVelocity
+            ? DrawColor(0, 0, 255)   // Red
             : currentVelocity >= config_.excellentVelocity
-            ? cv::Scalar(0, 255, 255)  // Yellow
-            : cv::Scalar(0, 255, 0);   // Green
+            ? DrawColor(0, 255, 255)  // Yellow
+            : DrawColor(0, 255, 0);   // Green
 
-        cv::rectangle(frame,
-                     cv::Point(meterX, meterY + meterHeight - fillHeight),
-                     cv::Point(meterX + meterWidth, meterY + meterHeight),
-                     color, -1);
+        list.rect(meterX, meterY + meterHeight - fillHeight,
+                  meterX + meterWidth, meterY + meterHeight,
+                  color, DrawList::FILLED);
     }
 
-    // Threshold markers
-    auto drawThreshold = [&](float velocity, const std::string& label) {
-        float ratio = velocity / config_.worldClassVelocity;
-        int y = meterY + meterHeight - static_cast<int>(meterHeight * ratio);
-
-        cv::line(frame, cv::Point(meterX - 5, y),
-                cv::Point(meterX + meterWidth + 5, y),
-                cv::Scalar(255, 255, 255), 2);
-
-        cv::putText(frame, label, cv::Point(meterX + meterWidth + 15, y + 5),
-                   cv::FONT_HERSHEY_SIMPLEX, 0.5, cv::Scalar(255, 255, 255), 1);
-    };
-
-    drawThreshold(config_.minimumVelocity, "MIN");
-    drawThreshold(config_.goodVelocity, "GOOD");
-    drawThreshold(config_.excellentVelocity, "EXCELLENT");
-    drawThreshold(config_.worldClassVelocity, "WORLD CLASS");
+    // Threshold markers, over the fill; they only move with the config
+    int originX = meterX - 10;
+    int originY = meterY - 20;
+    uint64_t key = layerKey(config_.minimumVelocity, config_.goodVelocity,
+                            config_.excellentVelocity, config_.worldClassVelocity);
+    meterMarksLayer_.update(originX, originY, list.getWidth() - originX, meterHeight + 40, key,
+                            [&](DrawList& layer) {
+        auto drawThreshold = [&](float velocity, const std::string& label) {
+            float ratio = velocity / config_.worldClassVelocity;
+            int y = meterY + meterHeight - static_cast<int>(meterHeight * ratio) - originY;
+            int x = meterX - originX;
+
+            layer.line(x - 5, y, x + meterWidth + 5, y, DrawColor(255, 255, 255), 2);
+            layer.text(label, x + meterWidth + 15, y + 5, DrawFont::Regular, 0.5f,
+                       DrawColor(255, 255, 255), 1);
+        };
+
+        drawThreshold(config_.minimumVelocity, "MIN");
+        drawThreshold(config_.goodVelocity, "GOOD");
+        drawThreshold(config_.excellentVelocity, "EXCELLENT");
+        drawThreshold(config_.worldClassVelocity, "WORLD CLASS");
+    });
+    list.layer(meterMarksLayer_);
 }
 
-void PowerChallenge::renderAttemptHistory(cv::Mat& frame) {
-    int yPos = 50;
-
-    // Title
-    std::string title = "Attempts: " + std::to_string(attempts_.size()) +
-                       "/" + std::to_string(config_.maxAttempts);
-    cv::putText(frame, title, cv::Point(50, yPos),
-               cv::FONT_HERSHEY_SIMPLEX, 1.2, cv::Scalar(255, 255, 255), 2);
-    yPos += 60;
-
-    // List attempts
-    for (size_t i = 0; i < attempts_.size(); i++) {
-        const auto& attempt = attempts_[i];
-
-        std::string attemptText = "#" + std::to_string(i + 1) + ": " +
-                                 std::to_string(static_cast<int>(attempt.velocityKmh)) +
-                                 " km/h - " + attempt.rating;
-
-        cv::Scalar color = attempt.velocityKmh >= config_.excellentVelocity
-            ? cv::Scalar(0, 255, 0)
-            : cv::Scalar(255, 255, 255);
-
-        cv::putText(frame, attemptText, cv::Point(50, yPos),
-                   cv::FONT_HERSHEY_SIMPLEX, 1.0, color, 2);
-        yPos += 50;
-    }
+void PowerChallenge::drawAttemptHistory(DrawList& list) {
+    // Rebuilt only when an attempt lands or the personal best moves
+    uint64_t key = layerKey(attempts_.size(), config_.maxAttempts,
+                            static_cast<int>(personalBest_),
+                            attempts_.empty() ? 0 : static_cast<int>(attempts_.back().velocityKmh));
+    int height = 200 + 50 * static_cast<int>(attempts_.size());
+    historyLayer_.update(0, 0, list.getWidth(), height, key, [this](DrawList& layer) {
+        int yPos = 50;
+
+        // Title
+        std::string title = "Attempts: " + std::to_string(attempts_.size()) +
+                           "/" + std::to_string(config_.maxAttempts);
+        layer.text(title, 50, yPos, DrawFont::Regular, 1.2f, DrawColor(255, 255, 255), 2);
+        yPos += 60;
+
+        // List attempts
+        for (size_t i = 0; i < attempts_.size(); i++) {
+            const auto& attempt = attempts_[i];
+
+            std::string attemptText = "#" + std::to_string(i + 1) + ": " +
+                                     std::to_string(static_cast<int>(attempt.velocityKmh)) +
+                                     " km/h - " + attempt.rating;
+
+            DrawColor color = attempt.velocityKmh >= config_.excellentVelocity
+                ? DrawColor(0, 255, 0)
+                : DrawColor(255, 255, 255);
+
+            layer.text(attemptText, 50, yPos, DrawFont::Regular, 1.0f, color, 2);
+            yPos += 50;
+        }
 
-    // Personal best
-    yPos += 20;
-    std::string pbText = "Personal Best: " +
-                        std::to_string(static_cast<int>(personalBest_)) + " km/h";
-    cv::putText(frame, pbText, cv::Point(50, yPos),
-               cv::FONT_HERSHEY_BOLD, 1.3, cv::Scalar(0, 255, 255), 3);
+        // Personal best
+        yPos += 20;
+        std::string pbText = "Personal Best: " +
+                            std::to_string(static_cast<int>(personalBest_)) + " km/h";
+        layer.text(pbText, 50, yPos, DrawFont::Bold, 1.3f, DrawColor(0, 255, 255), 3);
+    });
+    list.layer(historyLayer_);
 }
 
-void PowerChallenge::renderCurrentAttempt(cv::Mat& frame) {
-    std::string stateText;
-    cv::Scalar color(255, 255, 255);
-
-    switch (kickState_) {
-        case PowerKickState::WAITING:
-            stateText = "Ready to kick...";
-            break;
-        case PowerKickState::WINDUP:
-            stateText = "WIND UP!";
-            color = cv::Scalar(0, 255, 255);
-            break;
-        case PowerKickState::IMPACT:
-            stateText = "KICK!";
-            color = cv::Scalar(0, 255, 0);
-            break;
-        case PowerKickState::COOLDOWN:
-            stateText = "Get ready for next attempt";
-            break;
-    }
+void PowerChallenge::drawCurrentAttempt(DrawList& list) {
+    // Text band around the prompt's baseline
+    int originY = list.getHeight() - 210;
+    attemptStateLayer_.update(0, originY, list.getWidth(), 90, layerKey(kickState_),
+                              [this](DrawList& layer) {
+        std::string stateText;
+        DrawColor color(255, 255, 255);
+
+        switch (kickState_) {
+            case PowerKickState::WAITING:
+                stateText = "Ready to kick...";
+                break;
+            case PowerKickState::WINDUP:
+                stateText = "WIND UP!";
+                color = DrawColor(0, 255, 255);
+                break;
+            case PowerKickState::IMPACT:
+                stateText = "KICK!";
+                color = DrawColor(0, 255, 0);
+                break;
+            case PowerKickState::COOLDOWN:
+                stateText = "Get ready for next attempt";
+                break;
+        }
 
-    cv::Size textSize = cv::getTextSize(stateText, cv::FONT_HERSHEY_BOLD,
-                                       1.5, 3, nullptr);
-    cv::Point pos(frame.cols / 2 - textSize.width / 2, frame.rows - 150);
-    cv::putText(frame, stateText, pos, cv::FONT_HERSHEY_BOLD,
-               1.5, color, 3);
+        layer.text(stateText, layer.getWidth() / 2, 60, DrawFont::Bold, 1.5f, color, 3,
+                   TextAnchor::BaselineCenter);
+    });
+    list.layer(attemptStateLayer_);
 }
 
-void PowerChallenge::renderKickAnimation(cv::Mat& frame) {
+void PowerChallenge::drawKickAnimation(DrawList& list) {
     if (kickAnimationProgress_ <= 0.0f) {
         return;
     }
@@ -426,19 +341,14 @@ void PowerChallenge::renderKickAnimation(cv::Mat& frame) {
     // Show velocity achieved
     std::string velocityText = std::to_string(static_cast<int>(lastKickVelocity_)) + " KM/H!";
 
-    cv::Size textSize = cv::getTextSize(velocityText, cv::FONT_HERSHEY_BOLD,
-                                       3.0, 5, nullptr);
-
     // Animate upward and fade
-    int yOffset = static_cast<int>((1.0f - kickAnimationProgress_) * 200);
-    float alpha = kickAnimationProgress_;
-
-    cv::Point pos(frame.cols / 2 - textSize.width / 2,
-                 frame.rows / 2 - yOffset);
+    float progress = std::min(1.0f, kickAnimationProgress_ + drawLag_ * 2.0f);
+    int yOffset = static_cast<int>((1.0f - progress) * 200);
+    float alpha = progress;
 
-    cv::putText(frame, velocityText, pos, cv::FONT_HERSHEY_BOLD,
-               3.0 * kickAnimationProgress_,
-               cv::Scalar(0, 255, 255), static_cast<int>(5 * alpha));
+    list.text(velocityText, list.getWidth() / 2, list.getHeight() / 2 - yOffset,
+              DrawFont::Bold, 3.0f * progress,
+              DrawColor(0, 255, 255), static_cast<int>(5 * alpha), TextAnchor::BaselineCenter);
 }
 
 } // namespace game
@@ -2,7 +2,6 @@
 
 #include "ChallengeBase.h"
 #include "../../include/GameConfig.h"
-#include <deque>
 
 namespace kinect {
 namespace game {
@@ -25,13 +24,10 @@ public:
 
     // Override base methods
     void start() override;
-    void processFrame(const k4abt_skeleton_t& skeleton,
-                     const k4a_image_t& depthImage,
-                     float deltaTime) override;
     void finish() override;
     void reset() override;
 
-    void render(cv::Mat& frame) override;
+    void draw(DrawList& list) override;
 
     std::string getName() const override { return "Power Challenge"; }
     std::string getDescription() const override {
@@ -43,11 +39,14 @@ public:
     float getPersonalBest() const { return personalBest_; }
     void setPersonalBest(float velocity) { personalBest_ = velocity; }
 
+protected:
+    // Game rules
+    void update(const ChallengeFrame& frame) override;
+    void onKick(const KickResult& kick, const ChallengeFrame& frame) override;
+
 private:
-    // Kick detection
-    void detectPowerKick(const k4abt_skeleton_t& skeleton, float deltaTime);
-    float calculateLegVelocity(const k4abt_skeleton_t& skeleton);
-    float calculateTechnique(const k4abt_skeleton_t& skeleton);
+    // Kick evaluation
+    float calculateTechnique(const KickQuality& quality);
     std::string getRating(float velocityKmh);
 
     // Scoring
@@ -55,10 +54,10 @@ private:
     int32_t calculatePowerScore(const PowerKickAttempt& attempt);
 
     // Rendering helpers
-    void renderPowerMeter(cv::Mat& frame);
-    void renderAttemptHistory(cv::Mat& frame);
-    void renderCurrentAttempt(cv::Mat& frame);
-    void renderKickAnimation(cv::Mat& frame);
+    void drawPowerMeter(DrawList& list);
+    void drawAttemptHistory(DrawList& list);
+    void drawCurrentAttempt(DrawList& list);
+    void drawKickAnimation(DrawList& list);
 
     // Configuration
     PowerChallengeConfig config_;
@@ -67,7 +66,7 @@ private:
     std::vector<PowerKickAttempt> attempts_;
     float personalBest_;
 
-    // Kick detection
+    // Attempt display state, driven by the shared kick detector
     enum class PowerKickState {
         WAITING,
         WINDUP,
@@ -77,14 +76,17 @@ private:
     PowerKickState kickState_;
     float kickTimer_;
 
-    // Velocity tracking
-    std::deque<k4a_float3_t> footPositions_;
-    std::deque<float> footTimestamps_;
-    static const size_t MAX_FOOT_HISTORY = 10;
+    // Live kicking foot speed for the power meter (m/s)
+    float currentFootSpeed_;
 
     // Animation
     float kickAnimationProgress_;
     float lastKickVelocity_;
+
+    // Cached overlay layers
+    RenderLayer meterMarksLayer_;
+    RenderLayer historyLayer_;
+    RenderLayer attemptStateLayer_;
 };
 
 } // namespace game
@@ -0,0 +1,44 @@
+#include "RenderLayer.h"
+#include <algorithm>
+#include <atomic>
+
+namespace kinect {
+namespace game {
+
+namespace {
+std::atomic<uint64_t> nextLayerId{1};
+}
+
+RenderLayer::RenderLayer()
+    : id_(nextLayerId.fetch_add(1, std::memory_order_relaxed))
+    , version_(0)
+    , x_(0)
+    , y_(0)
+    , key_(0)
+    , valid_(false)
+{
+}
+
+bool RenderLayer::update(int x, int y, int width, int height, uint64_t key, const BuildFn& build) {
+    width = std::max(0, width);
+    height = std::max(0, height);
+    if (valid_ && key == key_ && x == x_ && y == y_ &&
+        width == commands_.getWidth() && height == commands_.getHeight()) {
+        return false;
+    }
+
+    x_ = x;
+    y_ = y;
+    key_ = key;
+    valid_ = true;
+    version_++;
+
+    commands_.reset(width, height);
+    if (width > 0 && height > 0) {
+        build(commands_);
+    }
+    return true;
+}
+
+} // namespace game
+} // namespace kinect
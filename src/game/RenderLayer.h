@@ -0,0 +1,74 @@
+#pragma once
+
+#include "DrawList.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace kinect {
+namespace game {
+
+// Retained overlay content for challenge rendering.
+//
+// A layer holds the draw commands for one piece of overlay (a scoreboard,
+// the target grid, ...) in layer-local coordinates. Each frame the owner
+// passes a key hashing whatever the layer shows (see layerKey). The
+// commands are rebuilt only when the key or bounds change, and otherwise
+// the layer is referenced from the frame's DrawList as-is.
+//
+// Backends can cache per layer version: OpenCvDrawBackend rasterises a
+// layer once and then only copies its inked pixels. Content that changes
+// every frame (pulses, animations) goes straight into the frame's DrawList
+// instead.
+class RenderLayer {
+public:
+    using BuildFn = std::function<void(DrawList& commands)>;
+
+    RenderLayer();
+
+    RenderLayer(const RenderLayer&) = delete;
+    RenderLayer& operator=(const RenderLayer&) = delete;
+
+    // Rebuild if the key or bounds changed. build() gets an empty list
+    // sized to the bounds, with (0, 0) at their top-left. Returns true if
+    // rebuilt.
+    bool update(int x, int y, int width, int height, uint64_t key, const BuildFn& build);
+
+    void invalidate() { valid_ = false; }
+    bool isValid() const { return valid_; }
+
+    int getX() const { return x_; }
+    int getY() const { return y_; }
+    int getWidth() const { return commands_.getWidth(); }
+    int getHeight() const { return commands_.getHeight(); }
+    const DrawList& getCommands() const { return commands_; }
+
+    // Unique per layer object; version changes on every rebuild
+    uint64_t getId() const { return id_; }
+    uint64_t getVersion() const { return version_; }
+
+private:
+    uint64_t id_;
+    uint64_t version_;
+    int x_;
+    int y_;
+    uint64_t key_;
+    bool valid_;
+    DrawList commands_;
+};
+
+// Hash the inputs a layer displays into its key
+inline void hashLayerValue(uint64_t& key, uint64_t value) {
+    key = (key ^ value) * 1099511628211ull;
+}
+
+template <typename... Args>
+uint64_t layerKey(const Args&... args) {
+    uint64_t key = 1469598103934665603ull;
+    (hashLayerValue(key, static_cast<uint64_t>(std::hash<Args>()(args))), ...);
+    return key;
+}
+
+} // namespace game
+} // namespace kinect
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ChallengeBase.h"
+#include "Leaderboard.h"
 #include "../../include/GameConfig.h"
 #include <vector>
 #include <map>
@@ -57,13 +58,6 @@ public:
     // Time bonuses
     int32_t calculateTimeBonus(float timeRemaining);
 
-    // Achievements
-    bool checkAchievement(const AchievementConfig& config,
-                         const ChallengeResult& result);
-    std::vector<std::string> checkAllAchievements(
-        const std::vector<AchievementConfig>& achievements,
-        const ChallengeResult& result);
-
     // Score breakdown
     ScoreBreakdown getBreakdown() const { return breakdown_; }
     void resetBreakdown();
@@ -78,64 +72,5 @@ private:
     ScoreBreakdown breakdown_;
 };
 
-// Achievement checker utilities
-class AchievementChecker {
-public:
-    // Accuracy achievements
-    static bool checkBullseye(const ChallengeResult& result,
-                             const std::vector<TargetZone>& zones);
-    static bool checkCornerSpecialist(const std::vector<TargetZone>& zones);
-    static bool checkSharpshooter(const ChallengeResult& result);
-
-    // Power achievements
-    static bool checkThunderstrike(float velocityKmh);
-    static bool checkRocketShot(float velocityKmh);
-    static bool checkConsistentPower(const std::vector<float>& recentKicks);
-
-    // Penalty achievements
-    static bool checkPerfectFive(int32_t goals, int32_t attempts);
-    static bool checkIceCold(bool suddenDeathWon);
-    static bool checkPenaltyMaster(int32_t lifetimeGoals);
-};
-
-// Leaderboard entry
-struct LeaderboardEntry {
-    std::string playerName;
-    int32_t score;
-    float accuracy;
-    float maxVelocity;
-    uint64_t timestamp;
-    std::string grade;
-
-    bool operator<(const LeaderboardEntry& other) const {
-        return score > other.score;  // Higher scores first
-    }
-};
-
-class Leaderboard {
-public:
-    explicit Leaderboard(size_t maxEntries = 10);
-
-    // Entry management
-    bool addEntry(const LeaderboardEntry& entry);
-    std::vector<LeaderboardEntry> getTopEntries(size_t count = 10) const;
-    std::vector<LeaderboardEntry> getEntriesForChallenge(ChallengeType type) const;
-
-    // Ranking
-    int32_t getRank(int32_t score) const;
-    bool isHighScore(int32_t score) const;
-
-    // Persistence
-    bool save(const std::string& filepath);
-    bool load(const std::string& filepath);
-
-    void clear() { entries_.clear(); }
-    size_t getEntryCount() const { return entries_.size(); }
-
-private:
-    std::map<ChallengeType, std::vector<LeaderboardEntry>> entries_;
-    size_t maxEntries_;
-};
-
 } // namespace game
 } // namespace kinect
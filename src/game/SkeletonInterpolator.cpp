@@ -0,0 +1,101 @@
+#include "SkeletonInterpolator.h"
+#include <algorithm>
+#include <cmath>
+
+namespace kinect {
+namespace game {
+
+SkeletonInterpolator::SkeletonInterpolator()
+    : frames_()
+    , head_(0)
+    , count_(0)
+{
+}
+
+void SkeletonInterpolator::push(const k4abt_skeleton_t& skeleton, uint64_t timestamp) {
+    if (count_ > 0 && timestamp <= getNewestTimestamp()) {
+        return;
+    }
+
+    frames_[head_].skeleton = skeleton;
+    frames_[head_].timestamp = timestamp;
+    head_ = (head_ + 1) % CAPACITY;
+    count_ = std::min(count_ + 1, CAPACITY);
+}
+
+void SkeletonInterpolator::clear() {
+    head_ = 0;
+    count_ = 0;
+}
+
+bool SkeletonInterpolator::sample(uint64_t timestamp, k4abt_skeleton_t& skeleton) const {
+    if (count_ == 0) {
+        return false;
+    }
+
+    // Hold the ends
+    if (timestamp >= at(0).timestamp) {
+        skeleton = at(0).skeleton;
+        return true;
+    }
+    if (timestamp <= at(count_ - 1).timestamp) {
+        skeleton = at(count_ - 1).skeleton;
+        return true;
+    }
+
+    // Newest first: the first older frame at or before timestamp brackets it
+    size_t age = 1;
+    while (at(age).timestamp > timestamp) {
+        age++;
+    }
+    const Frame& before = at(age);
+    const Frame& after = at(age - 1);
+    float t = static_cast<float>(timestamp - before.timestamp) /
+              static_cast<float>(after.timestamp - before.timestamp);
+
+    for (int i = 0; i < K4ABT_JOINT_COUNT; ++i) {
+        const k4abt_joint_t& a = before.skeleton.joints[i];
+        const k4abt_joint_t& b = after.skeleton.joints[i];
+        k4abt_joint_t& joint = skeleton.joints[i];
+
+        for (int axis = 0; axis < 3; ++axis) {
+            joint.position.v[axis] = a.position.v[axis] + (b.position.v[axis] - a.position.v[axis]) * t;
+        }
+
+        // Shortest-arc nlerp
+        float dot = 0.0f;
+        for (int c = 0; c < 4; ++c) {
+            dot += a.orientation.v[c] * b.orientation.v[c];
+        }
+        float sign = dot < 0.0f ? -1.0f : 1.0f;
+        float length = 0.0f;
+        for (int c = 0; c < 4; ++c) {
+            joint.orientation.v[c] = a.orientation.v[c] * (1.0f - t) + sign * b.orientation.v[c] * t;
+            length += joint.orientation.v[c] * joint.orientation.v[c];
+        }
+        if (length > 0.0f) {
+            float scale = 1.0f / std::sqrt(length);
+            for (int c = 0; c < 4; ++c) {
+                joint.orientation.v[c] *= scale;
+            }
+        }
+
+        joint.confidence_level = std::min(a.confidence_level, b.confidence_level);
+    }
+    return true;
+}
+
+uint64_t SkeletonInterpolator::getNewestTimestamp() const {
+    return count_ > 0 ? at(0).timestamp : 0;
+}
+
+uint64_t SkeletonInterpolator::getOldestTimestamp() const {
+    return count_ > 0 ? at(count_ - 1).timestamp : 0;
+}
+
+const SkeletonInterpolator::Frame& SkeletonInterpolator::at(size_t age) const {
+    return frames_[(head_ + CAPACITY - 1 - age) % CAPACITY];
+}
+
+} // namespace game
+} // namespace kinect
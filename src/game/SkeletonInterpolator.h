@@ -0,0 +1,51 @@
+#pragma once
+
+#include <k4abt.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace kinect {
+namespace game {
+
+// Tracker skeletons resampled at any time.
+//
+// Keeps the last few tracker frames by timestamp. sample() interpolates
+// joint positions linearly between the two frames around the requested
+// time, normalised-lerps orientations and takes the lower confidence.
+// Before the oldest or after the newest frame it holds that frame, so a
+// tracker stall freezes the pose rather than extrapolating it.
+class SkeletonInterpolator {
+public:
+    static constexpr size_t CAPACITY = 8;
+
+    SkeletonInterpolator();
+
+    // Timestamps in microseconds, increasing; a frame not newer than the
+    // last one is ignored
+    void push(const k4abt_skeleton_t& skeleton, uint64_t timestamp);
+    void clear();
+
+    // False (skeleton untouched) when no frame has been pushed
+    bool sample(uint64_t timestamp, k4abt_skeleton_t& skeleton) const;
+
+    bool empty() const { return count_ == 0; }
+    size_t size() const { return count_; }
+    uint64_t getNewestTimestamp() const;
+    uint64_t getOldestTimestamp() const;
+
+private:
+    struct Frame {
+        k4abt_skeleton_t skeleton;
+        uint64_t timestamp;
+    };
+
+    std::array<Frame, CAPACITY> frames_;
+    size_t head_;     // Next slot to write
+    size_t count_;
+
+    const Frame& at(size_t age) const;  // 0 = newest
+};
+
+} // namespace game
+} // namespace kinect
@@ -0,0 +1,242 @@
+#include "SplitScreenMatch.h"
+#include <algorithm>
+#include <cstdlib>
+#ifdef HAVE_OPENCV
+#include <opencv2/opencv.hpp>
+#endif
+
+namespace kinect {
+namespace game {
+
+namespace {
+
+void copySkeleton(const core::BodyData& body, k4abt_skeleton_t& skeleton) {
+    size_t count = std::min<size_t>(body.joints.size(), K4ABT_JOINT_COUNT);
+    for (size_t i = 0; i < count; ++i) {
+        skeleton.joints[i].position = body.joints[i].position;
+        skeleton.joints[i].orientation = body.joints[i].orientation;
+        skeleton.joints[i].confidence_level = body.joints[i].confidence;
+    }
+}
+
+} // namespace
+
+SplitScreenMatch::SplitScreenMatch(const GameConfig& config, bool concurrent)
+    : left_(config)
+    , right_(config)
+    , concurrent_(concurrent)
+    , matchActive_(false)
+    , type_(ChallengeType::ACCURACY)
+    , framesPosted_(0)
+    , framesDone_(0)
+    , stopping_(false)
+{
+    for (Lane* lane : {&left_, &right_}) {
+        lane->manager.initialize();
+        lane->manager.setOnChallengeComplete([this, lane](const ChallengeResult& result) {
+            lane->result = result;
+            lane->finished = true;
+        });
+    }
+
+    if (concurrent_) {
+        worker_ = std::thread(&SplitScreenMatch::workerThreadFunc, this);
+    }
+}
+
+SplitScreenMatch::~SplitScreenMatch() {
+    if (worker_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(workerMutex_);
+            stopping_ = true;
+        }
+        frameReady_.notify_one();
+        worker_.join();
+    }
+
+    // Lanes shut down after the worker, which may not touch them any more
+    left_.manager.shutdown();
+    right_.manager.shutdown();
+}
+
+bool SplitScreenMatch::start(ChallengeType type) {
+    if (matchActive_) {
+        stop();
+    }
+
+    left_.finished = false;
+    right_.finished = false;
+    if (!left_.manager.startChallenge(type) || !right_.manager.startChallenge(type)) {
+        left_.manager.stopCurrentChallenge();
+        right_.manager.stopCurrentChallenge();
+        return false;
+    }
+
+    type_ = type;
+    matchActive_ = true;
+    return true;
+}
+
+void SplitScreenMatch::startCountdown() {
+    left_.manager.startCountdown();
+    right_.manager.startCountdown();
+}
+
+void SplitScreenMatch::stop() {
+    left_.manager.stopCurrentChallenge();
+    right_.manager.stopCurrentChallenge();
+    checkMatchComplete();
+}
+
+void SplitScreenMatch::pause() {
+    left_.manager.pauseCurrentChallenge();
+    right_.manager.pauseCurrentChallenge();
+}
+
+void SplitScreenMatch::resume() {
+    left_.manager.resumeCurrentChallenge();
+    right_.manager.resumeCurrentChallenge();
+}
+
+void SplitScreenMatch::processFrame(const k4abt_skeleton_t* left, const k4abt_skeleton_t* right,
+                                    float deltaTime)
+{
+    if (left) {
+        left_.skeleton = *left;
+    }
+    if (right) {
+        right_.skeleton = *right;
+    }
+    left_.deltaTime = deltaTime;
+    right_.deltaTime = deltaTime;
+
+    if (!concurrent_) {
+        step(left_);
+        step(right_);
+        checkMatchComplete();
+        return;
+    }
+
+    // Hand the right lane to the worker, run the left lane here
+    uint64_t frame;
+    {
+        std::lock_guard<std::mutex> lock(workerMutex_);
+        frame = ++framesPosted_;
+    }
+    frameReady_.notify_one();
+
+    step(left_);
+
+    {
+        std::unique_lock<std::mutex> lock(workerMutex_);
+        frameDone_.wait(lock, [this, frame] { return framesDone_ >= frame; });
+    }
+    checkMatchComplete();
+}
+
+void SplitScreenMatch::processFrame(const core::PlayerData* left, const core::PlayerData* right,
+                                    float deltaTime)
+{
+    if (left) {
+        copySkeleton(left->body, left_.skeleton);
+    }
+    if (right) {
+        copySkeleton(right->body, right_.skeleton);
+    }
+    processFrame(static_cast<const k4abt_skeleton_t*>(nullptr), nullptr, deltaTime);
+}
+
+void SplitScreenMatch::draw(core::PlayerZone zone, DrawList& list) {
+    lane(zone).manager.draw(list);
+}
+
+#ifdef HAVE_OPENCV
+void SplitScreenMatch::render(cv::Mat& frame) {
+    int half = frame.cols / 2;
+    for (core::PlayerZone zone : {core::PlayerZone::Left, core::PlayerZone::Right}) {
+        int x = zone == core::PlayerZone::Left ? 0 : half;
+        cv::Mat view = frame(cv::Rect(x, 0, frame.cols - half, frame.rows));
+        drawList_.reset(view.cols, view.rows);
+        draw(zone, drawList_);
+        rasterizer_.setTarget(view);
+        rasterizer_.submit(drawList_);
+    }
+}
+#endif
+
+void SplitScreenMatch::setDeterministic(uint32_t seed) {
+    left_.manager.setDeterministic(seed);
+    right_.manager.setDeterministic(seed);
+}
+
+bool SplitScreenMatch::isActive() const {
+    return left_.manager.hasActiveChallenge() || right_.manager.hasActiveChallenge();
+}
+
+GameManager& SplitScreenMatch::getManager(core::PlayerZone zone) {
+    return lane(zone).manager;
+}
+
+void SplitScreenMatch::workerThreadFunc() {
+    uint64_t frame = 0;
+    std::unique_lock<std::mutex> lock(workerMutex_);
+    while (true) {
+        frameReady_.wait(lock, [this, frame] { return stopping_ || framesPosted_ > frame; });
+        if (stopping_) {
+            return;
+        }
+        frame = framesPosted_;
+
+        lock.unlock();
+        step(right_);
+        lock.lock();
+
+        framesDone_ = frame;
+        frameDone_.notify_one();
+    }
+}
+
+void SplitScreenMatch::step(Lane& lane) {
+    k4a_image_t noDepth = nullptr;
+    lane.manager.processFrame(lane.skeleton, noDepth, lane.deltaTime);
+}
+
+void SplitScreenMatch::checkMatchComplete() {
+    if (!matchActive_ || !left_.finished || !right_.finished) {
+        return;
+    }
+
+    matchActive_ = false;
+    lastResult_ = merge();
+
+    if (onMatchComplete_) {
+        onMatchComplete_(lastResult_);
+    }
+}
+
+HeadToHeadResult SplitScreenMatch::merge() const {
+    HeadToHeadResult match;
+    match.type = type_;
+    match.left = left_.result;
+    match.right = right_.result;
+
+    const ChallengeResult& a = match.left;
+    const ChallengeResult& b = match.right;
+    int order = 0;
+    if (a.finalScore != b.finalScore) {
+        order = a.finalScore > b.finalScore ? 1 : -1;
+    } else if (a.successes != b.successes) {
+        order = a.successes > b.successes ? 1 : -1;
+    } else if (a.maxVelocity != b.maxVelocity) {
+        order = a.maxVelocity > b.maxVelocity ? 1 : -1;
+    }
+
+    if (order != 0) {
+        match.winner = order > 0 ? core::PlayerZone::Left : core::PlayerZone::Right;
+        match.margin = std::abs(a.finalScore - b.finalScore);
+    }
+    return match;
+}
+
+} // namespace game
+} // namespace kinect
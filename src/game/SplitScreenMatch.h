@@ -0,0 +1,124 @@
+#pragma once
+
+#include "GameManager.h"
+#include "../core/PlayerTracker.h"
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace kinect {
+namespace game {
+
+// Outcome of one split-screen challenge
+struct HeadToHeadResult {
+    ChallengeType type = ChallengeType::ACCURACY;
+    ChallengeResult left;
+    ChallengeResult right;
+    core::PlayerZone winner = core::PlayerZone::Unknown;  // Unknown: draw
+    int32_t margin = 0;                                    // Winner's score lead
+};
+
+using HeadToHeadCallback = std::function<void(const HeadToHeadResult&)>;
+
+// Two players, one challenge each, side by side.
+//
+// Each PlayerZone (Left, Right) gets its own GameManager lane, with its own
+// kick detector, clock, session stats and achievements, fed from that
+// player's skeleton. processFrame() runs the right lane on a worker thread
+// while the calling thread runs the left lane, then waits for both, so a
+// frame costs the slower lane rather than the sum. Lanes share no mutable
+// state. Control calls (start, pause, stop) happen between frames.
+//
+// When both lanes have finished the challenge, their results are merged
+// into a HeadToHeadResult: higher score wins, then more successes, then
+// higher top speed.
+class SplitScreenMatch {
+public:
+    // concurrent = false runs both lanes on the calling thread
+    explicit SplitScreenMatch(const GameConfig& config = GameConfig(), bool concurrent = true);
+    ~SplitScreenMatch();
+
+    SplitScreenMatch(const SplitScreenMatch&) = delete;
+    SplitScreenMatch& operator=(const SplitScreenMatch&) = delete;
+
+    // Both players play the same challenge
+    bool start(ChallengeType type);
+    void startCountdown();
+    void stop();
+    void pause();
+    void resume();
+
+    // One frame for both players. A missing player (nullptr, e.g. no
+    // confirmed player in PlayerTracker::getPlayerInZone()) holds their
+    // last pose so both lanes stay on the same clock.
+    void processFrame(const k4abt_skeleton_t* left, const k4abt_skeleton_t* right, float deltaTime);
+    void processFrame(const core::PlayerData* left, const core::PlayerData* right, float deltaTime);
+
+    // Each lane draws into a list sized to its half of the screen; render()
+    // rasterises them onto the two halves of frame (OpenCV builds only)
+    void draw(core::PlayerZone zone, DrawList& list);
+#ifdef HAVE_OPENCV
+    void render(cv::Mat& frame);
+#endif
+
+    // Same seed for both lanes, so both players face the same targets
+    // and goalkeeper
+    void setDeterministic(uint32_t seed);
+
+    // State
+    bool isActive() const;    // Either lane still playing
+    bool isConcurrent() const { return concurrent_; }
+    const HeadToHeadResult& getLastResult() const { return lastResult_; }
+
+    // Per-player manager, for sessions, stats and the other callbacks
+    // (the match owns onChallengeComplete). The right lane's callbacks run
+    // on the worker thread.
+    GameManager& getManager(core::PlayerZone zone);
+
+    void setOnMatchComplete(HeadToHeadCallback callback) {
+        onMatchComplete_ = callback;
+    }
+
+private:
+    struct Lane {
+        explicit Lane(const GameConfig& config) : manager(config), skeleton() {}
+
+        GameManager manager;
+        k4abt_skeleton_t skeleton;    // Last pose seen
+        ChallengeResult result;
+        bool finished = false;
+        float deltaTime = 0.0f;
+    };
+
+    Lane left_;
+    Lane right_;
+    bool concurrent_;
+    bool matchActive_;
+    ChallengeType type_;
+    HeadToHeadResult lastResult_;
+    HeadToHeadCallback onMatchComplete_;
+
+#ifdef HAVE_OPENCV
+    DrawList drawList_;
+    OpenCvDrawBackend rasterizer_;
+#endif
+
+    // Right-lane worker: the game thread posts a frame and waits for it
+    std::thread worker_;
+    std::mutex workerMutex_;
+    std::condition_variable frameReady_;
+    std::condition_variable frameDone_;
+    uint64_t framesPosted_;
+    uint64_t framesDone_;
+    bool stopping_;
+
+    void workerThreadFunc();
+    void step(Lane& lane);
+    void checkMatchComplete();
+    HeadToHeadResult merge() const;
+    Lane& lane(core::PlayerZone zone) { return zone == core::PlayerZone::Right ? right_ : left_; }
+};
+
+} // namespace game
+} // namespace kinect
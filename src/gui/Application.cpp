@@ -5,9 +5,10 @@
 
 #include "Application.h"
 #include "../include/UITheme.h"
-#include "kiosk/KioskManager.h"
+#include "kiosk/QualityGovernor.h"
 #include "kiosk/SessionManager.h"
 #include <iostream>
+#include <algorithm>
 #include <chrono>
 #include <cmath>
 
@@ -19,7 +20,23 @@
 namespace kinect {
 namespace gui {
 
-Application::Application() = default;
+namespace {
+
+uint64_t elapsedUs(std::chrono::steady_clock::time_point start) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count());
+}
+
+} // namespace
+
+Application::Application() {
+    // Detectors and the player tracker publish from the analysis thread;
+    // the UI takes player arrivals on the main thread
+    eventBus_.attach(kickDetector_);
+    eventBus_.attach(headerDetector_);
+    eventBus_.attach(playerTracker_);
+    uiEvents_ = eventBus_.subscribe("gui", motion::motionEventBit(motion::MotionEventType::PlayerEnter));
+}
 
 Application::~Application() {
     shutdown();
@@ -32,39 +49,86 @@ bool Application::initialize(HWND hWnd, int width, int height) {
 
     logInfo("Initializing application...");
 
-    // Create D3D device
-    if (!createD3DDevice()) {
-        logError("Failed to create D3D device");
-        return false;
-    }
-
-    // Create render target
-    if (!createRenderTarget()) {
-        logError("Failed to create render target");
-        return false;
-    }
+    startup_ = std::make_unique<core::StartupGraph>();
+    startupReported_ = false;
+    buildStartupGraph();
 
-    // Initialize ImGui
-    if (!initImGui()) {
-        logError("Failed to initialize ImGui");
+    // Everything the attract screen needs; the rest keeps loading
+    if (!startup_->runUntil("imgui")) {
+        logError("Failed to initialize UI");
         return false;
     }
 
-    // Demo mode - no Kinect/player tracker needed
-
     running_ = true;
     gameState_ = GameState::Attract;
     stateStartTime_ = std::chrono::steady_clock::now();
 
-    logInfo("Application initialized successfully (Demo Mode - No Kinect)");
+    logInfo("Attract screen ready, Kinect still loading in the background");
     return true;
 }
 
+void Application::buildStartupGraph() {
+    using Affinity = core::StartupGraph::Affinity;
+
+    // UI: D3D and ImGui belong to the window's thread
+    startup_->add("d3d_device", Affinity::MAIN, {}, [this]() { return createD3DDevice(); });
+    startup_->add("render_target", Affinity::MAIN, {"d3d_device"}, [this]() { return createRenderTarget(); });
+    startup_->add("imgui", Affinity::MAIN, {"render_target"}, [this]() { return initImGui(); });
+
+    // Kinect: device open and calibration fetch, then the tracker model
+    // load (the slowest step); neither is needed for the attract screen
+    startup_->add("kinect_device", Affinity::WORKER, {}, [this]() {
+        kinect_ = std::make_unique<core::KinectDevice>();
+        return kinect_->initialize();
+    });
+    startup_->add("body_tracker", Affinity::WORKER, {"kinect_device"}, [this]() {
+        tracker_ = std::make_unique<core::BodyTracker>();
+        return tracker_->initialize(*kinect_);
+    });
+}
+
+void Application::reportStartup() {
+    logInfo(startup_->formatTimeline());
+
+    for (const auto& step : startup_->getTimeline()) {
+        if (step.name == "imgui" && step.endMs > ATTRACT_SCREEN_TARGET_SECONDS * 1000.0f) {
+            logWarning("Attract screen took " + std::to_string(static_cast<int>(step.endMs)) + " ms (target " +
+                       std::to_string(static_cast<int>(ATTRACT_SCREEN_TARGET_SECONDS * 1000.0f)) + " ms)");
+        }
+    }
+
+    if (startup_->getStatus("body_tracker") != core::StartupGraph::Status::DONE) {
+        logWarning("Kinect unavailable, staying in demo mode");
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(pipelineMutex_);
+    startPipeline();
+}
+
 void Application::shutdown() {
     logInfo("Shutting down application...");
 
     running_ = false;
 
+    // Background steps still write kinect_ and tracker_
+    if (startup_) {
+        startup_->wait();
+    }
+
+    // Join before destroy: the pipeline threads use both Kinect objects
+    {
+        std::lock_guard<std::mutex> lock(pipelineMutex_);
+        stopPipeline();
+    }
+
+    if (tracker_) {
+        tracker_->shutdown();
+    }
+    if (kinect_) {
+        kinect_->shutdown();
+    }
+
     // Cleanup ImGui
     cleanupImGui();
 
@@ -76,13 +140,31 @@ void Application::shutdown() {
 }
 
 void Application::update() {
+    auto workStart = std::chrono::steady_clock::now();
+
+    if (startup_ && !startupReported_) {
+        startup_->pump();
+        if (startup_->isFinished()) {
+            startupReported_ = true;
+            reportStartup();
+        }
+    }
+
+    pollMotionEvents();
     updateStateLogic();
+    if (qualityGovernor_) {
+        qualityGovernor_->recordLatency(kiosk::PipelineStage::GAME, elapsedUs(workStart));
+    }
+    if (gameHeartbeat_) {
+        gameHeartbeat_->beat("update");
+    }
 }
 
 void Application::render() {
     if (!d3dContext_ || !swapChain_ || !renderTarget_) {
         return;
     }
+    auto workStart = std::chrono::steady_clock::now();
 
     // Clear background based on selected theme
     float clearColor[4];
@@ -133,8 +215,14 @@ void Application::render() {
         ImGui_ImplDX11_RenderDrawData(drawData);
     }
 
-    // Present
+    // Present; vsync waits are not load, so the work ends here
+    if (qualityGovernor_) {
+        qualityGovernor_->recordLatency(kiosk::PipelineStage::RENDER, elapsedUs(workStart));
+    }
     swapChain_->Present(1, 0);
+    if (renderHeartbeat_) {
+        renderHeartbeat_->beat("present");
+    }
 }
 
 void Application::onResize(int width, int height) {
@@ -174,11 +262,46 @@ void Application::onKeyDown(int key) {
             // Simulate player detection
             transitionTo(GameState::PlayerDetected);
             break;
+        case VK_F12:
+            onKinectRestart();
+            break;
     }
 }
 
-void Application::onKinectRestart() {
-    logInfo("Kinect restart requested (Demo Mode - No Action)");
+void Application::setHeartbeats(kiosk::Heartbeat* game, kiosk::Heartbeat* render) {
+    gameHeartbeat_ = game;
+    renderHeartbeat_ = render;
+}
+
+void Application::setPipelineHeartbeats(kiosk::Heartbeat* capture, kiosk::Heartbeat* trackerEnqueue,
+                                        kiosk::Heartbeat* trackerPop, kiosk::Heartbeat* analysis) {
+    captureHeartbeat_ = capture;
+    trackerEnqueueHeartbeat_ = trackerEnqueue;
+    trackerPopHeartbeat_ = trackerPop;
+    analysisHeartbeat_ = analysis;
+}
+
+bool Application::onKinectRestart() {
+    // kinect_ and tracker_ belong to the startup workers until then
+    if (!startup_ || startup_->getStatus("body_tracker") != core::StartupGraph::Status::DONE) {
+        logWarning("Kinect restart requested before the Kinect loaded, ignoring");
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(pipelineMutex_);
+    logInfo("Kinect restart requested, reconnecting device");
+
+    // Join before touching the device; the tracker model stays loaded
+    stopPipeline();
+    if (!kinect_->reconnect() || !tracker_->resume(*kinect_)) {
+        logError("Kinect reconnect failed");
+        return false;
+    }
+
+    // Body ids restart with the new stream
+    playerTracker_.reset();
+    startPipeline();
+    return pipelineStarted_;
 }
 
 // D3D setup
@@ -1174,9 +1297,168 @@ void Application::logWarning(const std::string& msg) {
     std::cout << "[WARN] " << msg << std::endl;
 }
 
-// Stub implementations for thread functions (not used in demo mode)
-void Application::captureThreadFunc() {}
-void Application::analysisThreadFunc() {}
+// Kinect pipeline
+void Application::startPipeline() {
+    if (pipelineStarted_) {
+        return;
+    }
+
+    if (!kinect_->startCapture()) {
+        logError("Failed to start Kinect capture, staying in demo mode");
+        return;
+    }
+
+    captureRunning_ = true;
+    analysisRunning_ = true;
+    analysisThread_ = std::thread(&Application::analysisThreadFunc, this);
+    captureThread_ = std::thread(&Application::captureThreadFunc, this);
+    pipelineStarted_ = true;
+    logInfo("Kinect pipeline started");
+}
+
+void Application::stopPipeline() {
+    if (!pipelineStarted_) {
+        return;
+    }
+
+    captureRunning_ = false;
+    if (captureThread_.joinable()) {
+        captureThread_.join();
+    }
+    analysisRunning_ = false;
+    if (analysisThread_.joinable()) {
+        analysisThread_.join();
+    }
+
+    // Stopped on purpose, not stalled
+    for (kiosk::Heartbeat* heartbeat : {captureHeartbeat_, trackerEnqueueHeartbeat_,
+                                        trackerPopHeartbeat_, analysisHeartbeat_}) {
+        if (heartbeat) {
+            heartbeat->disarm();
+        }
+    }
+
+    kinect_->stopCapture();
+    bodyBuffer_.clear();
+    pipelineStarted_ = false;
+}
+
+void Application::captureThreadFunc() {
+    size_t appliedLevel = kiosk::QualityGovernor::NO_LEVEL;
+
+    while (captureRunning_) {
+        // Quality changes touch the cameras, so they happen between captures
+        if (qualityGovernor_ && qualityGovernor_->getLevel() != appliedLevel) {
+            appliedLevel = qualityGovernor_->getLevel();
+            const kiosk::QualityProfile& profile = qualityGovernor_->getProfile();
+            if (kiosk::applyQualityProfile(profile, *kinect_, *tracker_)) {
+                qualityGovernor_->setAppliedLevel(appliedLevel);
+                logInfo("Quality profile applied: " + profile.name);
+            } else {
+                // The health check sees the device down and reconnects
+                logError("Failed to apply quality profile " + profile.name);
+            }
+        }
+
+        if (!kinect_->captureFrame()) {
+            // A timeout retries at once; a lost stream waits for
+            // onKinectRestart() without spinning
+            if (kinect_->isStreamLost()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+            continue;
+        }
+        if (captureHeartbeat_) {
+            captureHeartbeat_->beat("get_capture");
+        }
+
+        if (!tracker_->processCapture(kinect_->getCurrentCapture())) {
+            continue;
+        }
+        if (trackerEnqueueHeartbeat_) {
+            trackerEnqueueHeartbeat_->beat("enqueue");
+        }
+
+        // An empty frame still counts toward players leaving
+        auto popStart = std::chrono::steady_clock::now();
+        std::vector<core::BodyData> bodies = tracker_->processFrame();
+        if (qualityGovernor_) {
+            qualityGovernor_->recordLatency(kiosk::PipelineStage::TRACKER_POP, elapsedUs(popStart));
+        }
+        if (trackerPopHeartbeat_) {
+            trackerPopHeartbeat_->beat("pop");
+        }
+        bodyBuffer_.push(bodies);
+    }
+}
+
+void Application::analysisThreadFunc() {
+    std::vector<core::BodyData> bodies;
+    k4abt_skeleton_t skeleton = {};
+    uint32_t analyzedBodyId = 0;
+
+    while (analysisRunning_) {
+        if (qualityGovernor_) {
+            qualityGovernor_->recordQueueDepth(kiosk::PipelineStage::ANALYSIS, bodyBuffer_.size(),
+                                               bodyBuffer_.capacity());
+        }
+        if (!bodyBuffer_.pop(bodies)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            continue;
+        }
+
+        auto workStart = std::chrono::steady_clock::now();
+        uint64_t timestamp = motion::motionEventClockUs();
+        eventBus_.setDeviceTimestamp(timestamp);
+        playerTracker_.update(bodies);
+
+        // Detectors follow the primary player; a new player starts clean
+        const core::PlayerData* player = playerTracker_.getPrimaryPlayer();
+        if (player && player->isConfirmed) {
+            if (player->bodyId != analyzedBodyId) {
+                kickDetector_.reset();
+                headerDetector_.reset();
+                analyzedBodyId = player->bodyId;
+            }
+
+            size_t count = std::min<size_t>(player->body.joints.size(), K4ABT_JOINT_COUNT);
+            for (size_t i = 0; i < count; ++i) {
+                skeleton.joints[i].position = player->body.joints[i].position;
+                skeleton.joints[i].orientation = player->body.joints[i].orientation;
+                skeleton.joints[i].confidence_level = player->body.joints[i].confidence;
+            }
+            motion::PoseFeatures pose(skeleton, timestamp);
+            kickDetector_.processFrame(pose);
+            if (!qualityGovernor_ || qualityGovernor_->getProfile().optionalDetectors) {
+                headerDetector_.processFrame(pose);
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(currentBodyMutex_);
+            currentBodies_.swap(bodies);
+        }
+        if (qualityGovernor_) {
+            qualityGovernor_->recordLatency(kiosk::PipelineStage::ANALYSIS, elapsedUs(workStart));
+        }
+        if (analysisHeartbeat_) {
+            analysisHeartbeat_->beat("publish");
+        }
+    }
+}
+
+void Application::pollMotionEvents() {
+    if (sessionManager_) {
+        sessionManager_->pollMotionEvents();
+    }
+
+    motion::MotionEvent event;
+    while (uiEvents_ && uiEvents_->poll(event)) {
+        if (event.type == motion::MotionEventType::PlayerEnter && gameState_ == GameState::Attract) {
+            transitionTo(GameState::PlayerDetected);
+        }
+    }
+}
 
 } // namespace gui
 } // namespace kinect
@@ -4,6 +4,10 @@
 #include "core/BodyTracker.h"
 #include "core/PlayerTracker.h"
 #include "core/RingBuffer.h"
+#include "core/StartupGraph.h"
+#include "motion/KickDetector.h"
+#include "motion/HeaderDetector.h"
+#include "motion/MotionEventBus.h"
 #include "DisplayConfig.h"
 #include "common.h"
 #include <imgui.h>
@@ -22,7 +26,8 @@ namespace kinect {
 
 // Forward declarations
 namespace kiosk {
-    class KioskManager;
+    class Heartbeat;
+    class QualityGovernor;
     class SessionManager;
 }
 
@@ -64,6 +69,10 @@ public:
 
     /**
      * @brief Initialize application
+     *
+     * Returns as soon as the attract screen can be drawn (D3D and ImGui on
+     * this thread); opening the Kinect, fetching its calibration and loading
+     * the tracker model continue on worker threads (see StartupGraph).
      * @param hWnd Window handle
      * @param width Window width (1080 for portrait)
      * @param height Window height (1920 for portrait)
@@ -97,10 +106,54 @@ public:
     void onKeyDown(int key);
 
     /**
-     * @brief Full Kinect restart (F12)
-     * Uses join-before-destroy pattern from kinect-native
+     * @brief Kinect restart (F12, or KioskManager recovery on any thread)
+     *
+     * Warm recovery: joins the pipeline threads, reconnects the device and
+     * resumes the loaded tracker (no model reload unless the calibration
+     * changed), then restarts the threads.
+     * @return true if the pipeline is streaming again; false before the
+     *         Kinect has loaded or if the reconnect failed
      */
-    void onKinectRestart();
+    bool onKinectRestart();
+
+    /**
+     * @brief Watch the main loop: update() beats the game slot and render()
+     *        the render slot (either may be null)
+     */
+    void setHeartbeats(kiosk::Heartbeat* game, kiosk::Heartbeat* render);
+
+    /**
+     * @brief Watch the Kinect pipeline: the capture thread beats capture,
+     *        tracker enqueue and tracker pop, the analysis thread analysis
+     *        (any may be null). Set before the Kinect finishes loading.
+     */
+    void setPipelineHeartbeats(kiosk::Heartbeat* capture, kiosk::Heartbeat* trackerEnqueue,
+                               kiosk::Heartbeat* trackerPop, kiosk::Heartbeat* analysis);
+
+    /**
+     * @brief Kicks, headers and player enter/exit from the analysis thread
+     *
+     * Subscribe before the Kinect finishes loading; poll on the consumer's
+     * own thread.
+     */
+    motion::MotionEventBus& getEventBus() { return eventBus_; }
+
+    /**
+     * @brief Drain the session manager's motion events from update()
+     *        (not owned; null to stop). It must be subscribed to getEventBus().
+     */
+    void setSessionManager(kiosk::SessionManager* sessionManager) { sessionManager_ = sessionManager; }
+
+    /**
+     * @brief Report game, render, tracker and analysis load to the governor
+     *        and follow its levels (not owned; null to run at full quality).
+     *        Set before the Kinect finishes loading.
+     *
+     * The capture thread applies each new profile to the device and tracker;
+     * the analysis thread drops header detection when the profile turns
+     * optional detectors off.
+     */
+    void setQualityGovernor(kiosk::QualityGovernor* governor) { qualityGovernor_ = governor; }
 
     // State queries
     GameState getGameState() const { return gameState_; }
@@ -124,21 +177,37 @@ private:
     // ImGui
     ImGuiContext* imguiContext_ = nullptr;
 
-    // Kinect components (disabled in demo mode)
-    // std::unique_ptr<core::KinectDevice> kinect_;
-    // std::unique_ptr<core::BodyTracker> tracker_;
-    // std::unique_ptr<core::PlayerTracker> playerTracker_;
-
-    // Motion analysis (disabled in demo mode)
-    // std::unique_ptr<motion::KickDetector> kickDetector_;
-    // std::unique_ptr<motion::KickAnalyzer> kickAnalyzer_;
+    // Startup graph; background steps finish while the attract screen runs
+    std::unique_ptr<core::StartupGraph> startup_;
+    bool startupReported_ = false;
+
+    // Kinect components, opened and loaded in the background. Only touch
+    // them once their startup step reports DONE; the capture and analysis
+    // threads start then, and without a Kinect the app stays in demo mode.
+    std::unique_ptr<core::KinectDevice> kinect_;
+    std::unique_ptr<core::BodyTracker> tracker_;
+    bool pipelineStarted_ = false;   // Guarded by pipelineMutex_
+    std::mutex pipelineMutex_;       // Start, stop and recovery
+
+    // Motion analysis (analysis thread); results fan out on the bus
+    core::PlayerTracker playerTracker_;
+    motion::KickDetector kickDetector_;
+    motion::HeaderDetector headerDetector_;
+    motion::MotionEventBus eventBus_;
+    motion::MotionSubscription* uiEvents_ = nullptr;
 
     // Game logic (disabled in demo mode)
     // std::unique_ptr<game::GameManager> gameManager_;
 
-    // Kiosk management
-    std::unique_ptr<kiosk::KioskManager> kioskManager_;
-    std::unique_ptr<kiosk::SessionManager> sessionManager_;
+    // Kiosk management (not owned)
+    kiosk::QualityGovernor* qualityGovernor_ = nullptr;
+    kiosk::Heartbeat* gameHeartbeat_ = nullptr;
+    kiosk::Heartbeat* renderHeartbeat_ = nullptr;
+    kiosk::Heartbeat* captureHeartbeat_ = nullptr;
+    kiosk::Heartbeat* trackerEnqueueHeartbeat_ = nullptr;
+    kiosk::Heartbeat* trackerPopHeartbeat_ = nullptr;
+    kiosk::Heartbeat* analysisHeartbeat_ = nullptr;
+    kiosk::SessionManager* sessionManager_ = nullptr;
 
     // Threading (3-thread architecture from kinect-native)
     std::thread captureThread_;
@@ -147,8 +216,8 @@ private:
     std::atomic<bool> analysisRunning_{false};
     std::atomic<bool> running_{false};
 
-    // Ring buffer for thread decoupling
-    core::RingBuffer<core::BodyData, 30> bodyBuffer_;
+    // Ring buffer for thread decoupling, one entry per tracker frame
+    core::RingBuffer<std::vector<core::BodyData>, 30> bodyBuffer_;
 
     // Shared state with mutex protection
     std::mutex currentBodyMutex_;
@@ -163,9 +232,12 @@ private:
     JerseyColor selectedJersey_ = JerseyColor::TEAL;
     BackgroundTheme selectedBackground_ = BackgroundTheme::NIGHT;
 
-    // Thread functions
+    // Thread functions; start/stop need pipelineMutex_ held
+    void startPipeline();
+    void stopPipeline();
     void captureThreadFunc();
     void analysisThreadFunc();
+    void pollMotionEvents();
 
     // DirectX setup
     bool createD3DDevice();
@@ -177,6 +249,10 @@ private:
     bool initImGui();
     void cleanupImGui();
 
+    // Startup
+    void buildStartupGraph();
+    void reportStartup();
+
     // Rendering
     void renderAttractMode();
     void renderPlayerDetected();
@@ -0,0 +1,146 @@
+/**
+ * @file ImGuiDrawBackend.cpp
+ * @brief game::DrawList to ImDrawList translation
+ */
+
+#include "ImGuiDrawBackend.h"
+#include "game/RenderLayer.h"
+#include <algorithm>
+#include <cfloat>
+
+namespace kinect {
+namespace gui {
+
+namespace {
+
+ImU32 toImColor(game::DrawColor color) {
+    return IM_COL32(color.r, color.g, color.b, color.a);
+}
+
+} // namespace
+
+ImGuiDrawBackend::ImGuiDrawBackend(ImDrawList* target, ImVec2 origin, float scale)
+    : target_(target)
+    , origin_(origin)
+    , scale_(scale)
+{
+}
+
+void ImGuiDrawBackend::setTarget(ImDrawList* target, ImVec2 origin, float scale) {
+    target_ = target;
+    origin_ = origin;
+    scale_ = scale;
+}
+
+ImVec2 ImGuiDrawBackend::toScreen(ImVec2 offset, float x, float y) const {
+    return ImVec2(origin_.x + (offset.x + x) * scale_, origin_.y + (offset.y + y) * scale_);
+}
+
+void ImGuiDrawBackend::submit(const game::DrawList& list) {
+    if (!target_) {
+        return;
+    }
+    replay(list, ImVec2(0.0f, 0.0f));
+}
+
+void ImGuiDrawBackend::replay(const game::DrawList& list, ImVec2 offset) {
+    using game::DrawOp;
+    using game::TextAnchor;
+
+    for (const game::DrawCommand& command : list.getCommands()) {
+        ImU32 color = toImColor(command.color);
+        float thickness = std::max(1.0f, command.thickness * scale_);
+        bool filled = command.thickness < 0;
+
+        switch (command.op) {
+            case DrawOp::Rect: {
+                ImVec2 p0 = toScreen(offset, command.x0, command.y0);
+                ImVec2 p1 = toScreen(offset, command.x1, command.y1);
+                if (filled) {
+                    target_->AddRectFilled(p0, p1, color);
+                } else {
+                    target_->AddRect(p0, p1, color, 0.0f, 0, thickness);
+                }
+                break;
+            }
+
+            case DrawOp::Line:
+                target_->AddLine(toScreen(offset, command.x0, command.y0),
+                                 toScreen(offset, command.x1, command.y1), color, thickness);
+                break;
+
+            case DrawOp::Circle: {
+                ImVec2 center = toScreen(offset, command.x0, command.y0);
+                float radius = command.x1 * scale_;
+                if (filled) {
+                    target_->AddCircleFilled(center, radius, color);
+                } else {
+                    target_->AddCircle(center, radius, color, 0, thickness);
+                }
+                break;
+            }
+
+            case DrawOp::Text: {
+                ImFont* font = ImGui::GetFont();
+                float size = command.x1 * HERSHEY_PIXELS * scale_;
+                const char* begin = list.getText(command);
+                const char* end = begin + command.length;
+                ImVec2 extent = font->CalcTextSizeA(size, FLT_MAX, 0.0f, begin, end);
+                float ascent = font->Ascent * size / font->FontSize;
+
+                // ImGui places text by its top-left corner
+                ImVec2 pos = toScreen(offset, command.x0, command.y0);
+                switch (command.anchor) {
+                    case TextAnchor::BaselineLeft:
+                        pos.y -= ascent;
+                        break;
+                    case TextAnchor::BaselineCenter:
+                        pos.x -= extent.x / 2.0f;
+                        pos.y -= ascent;
+                        break;
+                    case TextAnchor::TopCenter:
+                        pos.x -= extent.x / 2.0f;
+                        break;
+                    case TextAnchor::Center:
+                        pos.x -= extent.x / 2.0f;
+                        pos.y -= extent.y / 2.0f;
+                        break;
+                }
+
+                target_->AddText(font, size, pos, color, begin, end);
+                if (command.font == game::DrawFont::Bold) {
+                    // Faux bold: a second pass one pixel over
+                    target_->AddText(font, size, ImVec2(pos.x + 1.0f, pos.y), color, begin, end);
+                }
+                break;
+            }
+
+            case DrawOp::Sprite: {
+                auto it = sprites_.find(command.payload);
+                if (it != sprites_.end()) {
+                    target_->AddImage(it->second, toScreen(offset, command.x0, command.y0),
+                                      toScreen(offset, command.x1, command.y1));
+                }
+                break;
+            }
+
+            case DrawOp::Layer: {
+                const game::RenderLayer& layer = list.getLayer(command);
+                if (layer.isValid()) {
+                    // Clip to the layer bounds, as the OpenCV canvas does
+                    ImVec2 layerOffset(offset.x + layer.getX(), offset.y + layer.getY());
+                    target_->PushClipRect(toScreen(layerOffset, 0.0f, 0.0f),
+                                          toScreen(layerOffset, static_cast<float>(layer.getWidth()),
+                                                   static_cast<float>(layer.getHeight())),
+                                          true);
+                    replay(layer.getCommands(), layerOffset);
+                    target_->PopClipRect();
+                }
+                break;
+            }
+        }
+    }
+}
+
+} // namespace gui
+} // namespace kinect
@@ -0,0 +1,61 @@
+/**
+ * @file ImGuiDrawBackend.h
+ * @brief Draws game draw lists through an ImGui draw list
+ */
+
+#pragma once
+
+#include "game/DrawList.h"
+#include <imgui.h>
+#include <cstdint>
+#include <unordered_map>
+
+namespace kinect {
+namespace gui {
+
+/**
+ * @brief Translates game::DrawList commands into ImDrawList calls
+ *
+ * Lets challenges render straight into the GUI's D3D11 frame, so nothing
+ * is rasterised on the CPU. Retained layers are replayed from their cached
+ * command lists at the layer's offset.
+ *
+ * Text sizes follow the OpenCV Hershey scale the challenges are laid out
+ * in: scale 1.0 maps to HERSHEY_PIXELS of ImGui font size.
+ */
+class ImGuiDrawBackend : public game::DrawBackend {
+public:
+    static constexpr float HERSHEY_PIXELS = 30.0f;
+
+    /**
+     * @param target Draw list to append to (e.g. ImGui::GetWindowDrawList())
+     * @param origin Screen position of the game frame's top-left corner
+     * @param scale Game pixels to screen pixels
+     */
+    explicit ImGuiDrawBackend(ImDrawList* target = nullptr,
+                              ImVec2 origin = ImVec2(0.0f, 0.0f), float scale = 1.0f);
+
+    /**
+     * @brief Set where the next submits draw
+     */
+    void setTarget(ImDrawList* target, ImVec2 origin, float scale);
+
+    /**
+     * @brief Register a texture for game::DrawList::sprite()
+     */
+    void setSprite(uint32_t id, ImTextureID texture) { sprites_[id] = texture; }
+
+    void submit(const game::DrawList& list) override;
+
+private:
+    ImDrawList* target_;
+    ImVec2 origin_;
+    float scale_;
+    std::unordered_map<uint32_t, ImTextureID> sprites_;
+
+    void replay(const game::DrawList& list, ImVec2 offset);
+    ImVec2 toScreen(ImVec2 offset, float x, float y) const;
+};
+
+} // namespace gui
+} // namespace kinect
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace kinect {
+namespace kiosk {
+
+// Threads and loops the kiosk watches; each owns one heartbeat slot
+enum class PipelineStage : uint8_t {
+    CAPTURE,           // KinectDevice::captureFrame loop
+    TRACKER_ENQUEUE,   // BodyTracker::processCapture
+    TRACKER_POP,       // BodyTracker::processFrame
+    ANALYSIS,          // Motion analysis and event bus publishing
+    GAME,              // GameManager update
+    RENDER,            // UI frame loop
+    SESSION_IO,        // SessionJournal writer thread
+    COUNT
+};
+
+constexpr size_t PIPELINE_STAGE_COUNT = static_cast<size_t>(PipelineStage::COUNT);
+
+inline const char* pipelineStageName(PipelineStage stage) {
+    switch (stage) {
+        case PipelineStage::CAPTURE: return "capture";
+        case PipelineStage::TRACKER_ENQUEUE: return "tracker_enqueue";
+        case PipelineStage::TRACKER_POP: return "tracker_pop";
+        case PipelineStage::ANALYSIS: return "analysis";
+        case PipelineStage::GAME: return "game";
+        case PipelineStage::RENDER: return "render";
+        case PipelineStage::SESSION_IO: return "session_io";
+        default: return "unknown";
+    }
+}
+
+/**
+ * Heartbeat is one stage's slot in the KioskManager heartbeat table:
+ * - beat() is called by the stage's own thread after each unit of work and
+ *   is a few relaxed atomic stores on the slot's own cache line
+ * - The marker names the last step the stage finished ("enqueue", "sync")
+ *   and must be a string literal; it is what a stall report shows
+ * - A slot is not watched until its first beat, so stages that are not
+ *   running in this build never expire
+ */
+class alignas(64) Heartbeat {
+public:
+    void beat(const char* marker) {
+        marker_.store(marker, std::memory_order_relaxed);
+        progress_.fetch_add(1, std::memory_order_relaxed);
+        lastBeatUs_.store(nowUs(), std::memory_order_release);
+    }
+
+    // Stop watching until the next beat (stage paused or restarted on purpose)
+    void disarm() { lastBeatUs_.store(0, std::memory_order_release); }
+
+    void setTimeoutUs(uint64_t timeoutUs) { timeoutUs_.store(timeoutUs, std::memory_order_relaxed); }
+
+    bool isArmed() const { return getLastBeatUs() != 0; }
+    uint64_t getLastBeatUs() const { return lastBeatUs_.load(std::memory_order_acquire); }
+    uint64_t getProgress() const { return progress_.load(std::memory_order_relaxed); }
+    uint64_t getTimeoutUs() const { return timeoutUs_.load(std::memory_order_relaxed); }
+    const char* getMarker() const {
+        const char* marker = marker_.load(std::memory_order_relaxed);
+        return marker ? marker : "none";
+    }
+
+    // Steady clock in microseconds, never 0 once the process is running
+    static uint64_t nowUs() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count()) | 1;
+    }
+
+private:
+    std::atomic<uint64_t> lastBeatUs_{0};
+    std::atomic<uint64_t> progress_{0};
+    std::atomic<uint64_t> timeoutUs_{0};
+    std::atomic<const char*> marker_{nullptr};
+};
+
+} // namespace kiosk
+} // namespace kinect
@@ -1,5 +1,7 @@
 #include "KioskManager.h"
+#include <algorithm>
 #include <iostream>
+#include <sstream>
 
 namespace kinect {
 namespace kiosk {
@@ -8,10 +10,27 @@ KioskManager::KioskManager()
     : running_(false)
     , systemHealthy_(true)
     , consecutiveErrors_(0)
+    , recoveryDelaySeconds_(0.0f)
+    , lastHealthTime_(std::chrono::steady_clock::now())
+    , registry_(core::MetricsRegistry::global())
+    , healthyGauge_(registry_.gauge("kinect_kiosk_healthy", "1 while no unrecovered errors are outstanding"))
+    , uptimeGauge_(registry_.gauge("kinect_kiosk_uptime_seconds", "Seconds since the kiosk manager started"))
+    , recoveriesCounter_(registry_.counter("kinect_kiosk_recoveries_total", "Auto-recovery attempts"))
     , lastWatchdogKick_(0)
     , watchdogExpired_(false)
 {
     stats_.startTime = std::chrono::system_clock::now();
+    currentHealth_.startTime = stats_.startTime;
+    healthyGauge_.set(1.0);
+
+    for (size_t i = 0; i < PIPELINE_STAGE_COUNT; ++i) {
+        core::MetricLabels labels = {{"stage", pipelineStageName(static_cast<PipelineStage>(i))}};
+        stageStalled_[i] = false;
+        stageAgeGauges_[i] = &registry_.gauge("kinect_stage_heartbeat_age_seconds",
+                                              "Seconds since the stage last reported progress", labels);
+        stageStallCounters_[i] = &registry_.counter("kinect_stage_stalls_total",
+                                                    "Heartbeat timeouts per pipeline stage", labels);
+    }
 }
 
 KioskManager::~KioskManager() {
@@ -20,11 +39,17 @@ KioskManager::~KioskManager() {
 
 bool KioskManager::initialize(const Config& config) {
     config_ = config;
+    for (size_t i = 0; i < PIPELINE_STAGE_COUNT; ++i) {
+        setStageTimeout(static_cast<PipelineStage>(i), config_.stageTimeoutSeconds[i]);
+    }
+    qualityGovernor_.configure(config_.quality);
 
     LOG_INFO("KioskManager initialized");
     LOG_INFO("  Health check interval: " << config_.healthCheckIntervalSeconds << "s");
     LOG_INFO("  Watchdog timeout: " << config_.watchdogTimeoutSeconds << "s");
     LOG_INFO("  Auto-recovery: " << (config_.enableAutoRecovery ? "enabled" : "disabled"));
+    LOG_INFO("  Quality governor: " << (config_.enableQualityGovernor ? "enabled" : "disabled")
+             << " (" << qualityGovernor_.getLevelCount() << " levels)");
 
     return true;
 }
@@ -39,6 +64,11 @@ void KioskManager::start() {
     running_ = true;
     kickWatchdog(); // Initialize watchdog
 
+    // A kiosk without its metrics endpoint still runs
+    if (config_.enableMetricsEndpoint && !metricsExporter_.start(registry_, config_.metrics)) {
+        LOG_WARN("Metrics endpoint unavailable");
+    }
+
     monitorThread_ = std::thread(&KioskManager::monitorThreadFunc, this);
 }
 
@@ -53,22 +83,14 @@ void KioskManager::stop() {
     if (monitorThread_.joinable()) {
         monitorThread_.join();
     }
+    metricsExporter_.stop();
 
     LOG_INFO("KioskManager stopped");
 }
 
-void KioskManager::updateHealth(const HealthMetrics& metrics) {
+HealthMetrics KioskManager::getHealth() const {
     std::lock_guard<std::mutex> lock(healthMutex_);
-    // Copy atomic values individually (std::atomic is not copy-assignable)
-    currentHealth_.framesProcessed.store(metrics.framesProcessed.load());
-    currentHealth_.framesDropped.store(metrics.framesDropped.load());
-    currentHealth_.kicksDetected.store(metrics.kicksDetected.load());
-    currentHealth_.sessionsCompleted.store(metrics.sessionsCompleted.load());
-    currentHealth_.avgFps.store(metrics.avgFps.load());
-    currentHealth_.kinectHealthy.store(metrics.kinectHealthy.load());
-    currentHealth_.trackerHealthy.store(metrics.trackerHealthy.load());
-    currentHealth_.lastFrameTime = metrics.lastFrameTime;
-    currentHealth_.startTime = metrics.startTime;
+    return currentHealth_;
 }
 
 bool KioskManager::isHealthy() const {
@@ -80,6 +102,24 @@ void KioskManager::kickWatchdog() {
     watchdogExpired_ = false;
 }
 
+void KioskManager::setStageTimeout(PipelineStage stage, float seconds) {
+    getHeartbeat(stage).setTimeoutUs(static_cast<uint64_t>(seconds * 1000000.0f));
+}
+
+KioskManager::StageStatus KioskManager::getStageStatus(PipelineStage stage) const {
+    const Heartbeat& heartbeat = heartbeats_[static_cast<size_t>(stage)];
+    uint64_t lastBeat = heartbeat.getLastBeatUs();
+    uint64_t now = Heartbeat::nowUs();
+
+    StageStatus status;
+    status.armed = lastBeat != 0;
+    status.stalled = stageStalled_[static_cast<size_t>(stage)].load();
+    status.secondsSinceBeat = status.armed && now > lastBeat ? (now - lastBeat) / 1000000.0f : 0.0f;
+    status.progress = heartbeat.getProgress();
+    status.marker = heartbeat.getMarker();
+    return status;
+}
+
 void KioskManager::reportError(const std::string& errorType, const std::string& message) {
     LOG_ERROR("Error reported: [" << errorType << "] " << message);
 
@@ -104,8 +144,12 @@ void KioskManager::reportError(const std::string& errorType, const std::string&
         stats_.lastError = error.timestamp;
     }
 
+    registry_.counter("kinect_errors_total", "Errors reported to the kiosk manager, by type",
+                      {{"type", errorType}}).inc();
+
     consecutiveErrors_++;
     systemHealthy_ = false;
+    healthyGauge_.set(0.0);
 }
 
 void KioskManager::clearErrors() {
@@ -113,6 +157,7 @@ void KioskManager::clearErrors() {
     consecutiveErrors_ = 0;
     systemHealthy_ = true;
     watchdogExpired_ = false;
+    healthyGauge_.set(1.0);
 }
 
 void KioskManager::setRestartCallback(RestartCallback callback) {
@@ -120,6 +165,11 @@ void KioskManager::setRestartCallback(RestartCallback callback) {
     restartCallback_ = callback;
 }
 
+void KioskManager::setKinectRecoveryCallback(KinectRecoveryCallback callback) {
+    std::lock_guard<std::mutex> lock(callbackMutex_);
+    kinectRecoveryCallback_ = callback;
+}
+
 KioskManager::Statistics KioskManager::getStatistics() const {
     std::lock_guard<std::mutex> lock(statsMutex_);
     return stats_;
@@ -139,6 +189,16 @@ void KioskManager::monitorThreadFunc() {
             lastCheckTime = now;
         }
 
+        // Stage timeouts are a few seconds, so check them every pass
+        if (config_.enableWatchdog) {
+            checkHeartbeats();
+        }
+
+        // One load window per pass
+        if (config_.enableQualityGovernor) {
+            qualityGovernor_.evaluate(static_cast<uint64_t>(registry_.getValue(HealthMetrics::FRAMES_DROPPED)), now);
+        }
+
         std::this_thread::sleep_for(std::chrono::seconds(1));
     }
 
@@ -148,6 +208,8 @@ void KioskManager::monitorThreadFunc() {
 void KioskManager::performHealthCheck() {
     LOG_DEBUG("Performing health check...");
 
+    collectHealth();
+
     // Check watchdog
     if (config_.enableWatchdog) {
         checkWatchdog();
@@ -162,6 +224,11 @@ void KioskManager::performHealthCheck() {
     // Log status
     logHealthStatus();
 
+    // A full healthy interval means the last recovery worked
+    if (systemHealthy_) {
+        recoveryDelaySeconds_ = 0.0f;
+    }
+
     // Attempt recovery if needed
     if (!systemHealthy_ && config_.enableAutoRecovery) {
         int errors = consecutiveErrors_.load();
@@ -172,6 +239,30 @@ void KioskManager::performHealthCheck() {
     }
 }
 
+void KioskManager::collectHealth() {
+    auto now = std::chrono::steady_clock::now();
+    uptimeGauge_.set(std::chrono::duration<double>(std::chrono::system_clock::now() - stats_.startTime).count());
+
+    std::lock_guard<std::mutex> lock(healthMutex_);
+    uint64_t previousFrames = currentHealth_.framesProcessed;
+    float elapsed = std::chrono::duration<float>(now - lastHealthTime_).count();
+    lastHealthTime_ = now;
+
+    currentHealth_.framesProcessed = static_cast<uint64_t>(registry_.getValue(HealthMetrics::FRAMES_PROCESSED));
+    currentHealth_.framesDropped = static_cast<uint64_t>(registry_.getValue(HealthMetrics::FRAMES_DROPPED));
+    currentHealth_.kicksDetected = static_cast<uint64_t>(registry_.getValue(HealthMetrics::KICKS_DETECTED));
+    currentHealth_.sessionsCompleted = static_cast<uint64_t>(registry_.getValue(HealthMetrics::SESSIONS_COMPLETED));
+    currentHealth_.kinectHealthy = registry_.getValue(HealthMetrics::DEVICE_UP) > 0.0;
+    currentHealth_.trackerHealthy = registry_.getValue(HealthMetrics::TRACKER_UP) > 0.0;
+    currentHealth_.avgFps = elapsed > 0.0f && currentHealth_.framesProcessed >= previousFrames
+        ? (currentHealth_.framesProcessed - previousFrames) / elapsed
+        : 0.0f;
+
+    double lastFrameSeconds = registry_.getValue(HealthMetrics::LAST_FRAME_TIME);
+    currentHealth_.lastFrameTime = std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::duration<double>(lastFrameSeconds)));
+}
+
 void KioskManager::checkWatchdog() {
     uint64_t lastKick = lastWatchdogKick_.load();
     uint64_t now = getCurrentTimestamp();
@@ -189,25 +280,111 @@ void KioskManager::checkWatchdog() {
     }
 }
 
+void KioskManager::checkHeartbeats() {
+    uint64_t now = Heartbeat::nowUs();
+
+    for (size_t i = 0; i < PIPELINE_STAGE_COUNT; ++i) {
+        const Heartbeat& heartbeat = heartbeats_[i];
+        uint64_t lastBeat = heartbeat.getLastBeatUs();
+        if (lastBeat == 0) {
+            stageAgeGauges_[i]->set(0.0);
+            continue;
+        }
+
+        uint64_t age = now > lastBeat ? now - lastBeat : 0;
+        stageAgeGauges_[i]->set(age / 1000000.0);
+
+        uint64_t timeout = heartbeat.getTimeoutUs();
+        bool stalled = timeout > 0 && age > timeout;
+        if (stalled && !stageStalled_[i]) {
+            stageStalled_[i] = true;
+            stageStallCounters_[i]->inc();
+            handleStageStall(static_cast<PipelineStage>(i), age / 1000000.0f);
+        } else if (!stalled && stageStalled_[i]) {
+            stageStalled_[i] = false;
+            LOG_INFO("Stage " << pipelineStageName(static_cast<PipelineStage>(i))
+                     << " is making progress again (marker '" << heartbeat.getMarker() << "')");
+        }
+    }
+}
+
+void KioskManager::handleStageStall(PipelineStage stage, float secondsSinceBeat) {
+    Heartbeat& heartbeat = getHeartbeat(stage);
+    std::ostringstream message;
+    message << "Stage " << pipelineStageName(stage) << " stalled: no progress for " << secondsSinceBeat
+            << "s after " << heartbeat.getProgress() << " beats, last marker '" << heartbeat.getMarker() << "'";
+
+    // Capture and tracker threads only block in k4a calls with timeouts, so
+    // the warm recovery can join them; the stage is watched again from its
+    // next beat. Other stages run on the main thread or on a thread that
+    // cannot be torn down while stuck, so they go through the global recovery
+    bool kinectStage = stage == PipelineStage::CAPTURE || stage == PipelineStage::TRACKER_ENQUEUE ||
+                       stage == PipelineStage::TRACKER_POP;
+    if (kinectStage && recoverKinect(message.str())) {
+        stageStalled_[static_cast<size_t>(stage)] = false;
+        return;
+    }
+    reportError("STAGE_STALL", message.str());
+}
+
 void KioskManager::checkKinectHealth() {
-    std::lock_guard<std::mutex> lock(healthMutex_);
+    bool kinectHealthy;
+    bool trackerHealthy;
+    {
+        std::lock_guard<std::mutex> lock(healthMutex_);
+        kinectHealthy = currentHealth_.kinectHealthy;
+        trackerHealthy = currentHealth_.trackerHealthy;
+    }
+
+    // A reconnect keeps the tracker model loaded and the UI running; only
+    // when it fails do the errors head for the global restart
+    if ((!kinectHealthy || !trackerHealthy) &&
+        recoverKinect(!kinectHealthy ? "Kinect device unhealthy" : "Body tracker unhealthy")) {
+        return;
+    }
 
-    if (!currentHealth_.kinectHealthy) {
+    if (!kinectHealthy) {
         reportError("KINECT", "Kinect device unhealthy");
     }
 
-    if (!currentHealth_.trackerHealthy) {
+    if (!trackerHealthy) {
         reportError("TRACKER", "Body tracker unhealthy");
     }
 }
 
+bool KioskManager::recoverKinect(const std::string& reason) {
+    std::lock_guard<std::mutex> lock(callbackMutex_);
+    if (!kinectRecoveryCallback_) {
+        return false;
+    }
+
+    LOG_INFO("Reconnecting Kinect: " << reason);
+    if (!kinectRecoveryCallback_()) {
+        LOG_WARN("Kinect reconnect failed: " << reason);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> statsLock(statsMutex_);
+    stats_.kinectRecoveries++;
+    return true;
+}
+
 void KioskManager::checkFrameRate() {
     std::lock_guard<std::mutex> lock(healthMutex_);
 
-    float fps = currentHealth_.avgFps.load();
+    float fps = currentHealth_.avgFps;
     if (fps < 10.0f && fps > 0.0f) {
         LOG_WARN("Low frame rate detected: " << fps << " FPS");
-        reportError("PERFORMANCE", "Low frame rate");
+
+        // Lowering quality is the remedy while the governor sees the load
+        // and the pipeline follows its levels, until there is no level left;
+        // otherwise a low frame rate counts towards a restart
+        bool degrading = config_.enableQualityGovernor && qualityGovernor_.getPressure() > 1.0f &&
+                         qualityGovernor_.getAppliedLevel() != QualityGovernor::NO_LEVEL &&
+                         qualityGovernor_.getLevel() + 1 < qualityGovernor_.getLevelCount();
+        if (!degrading) {
+            reportError("PERFORMANCE", "Low frame rate");
+        }
     }
 }
 
@@ -218,13 +395,18 @@ void KioskManager::attemptRecovery() {
         std::lock_guard<std::mutex> lock(statsMutex_);
         stats_.autoRecoveries++;
     }
-
-    // Wait before recovery
-    std::this_thread::sleep_for(
-        std::chrono::milliseconds(
-            static_cast<int>(config_.autoRestartDelaySeconds * 1000)
-        )
-    );
+    recoveriesCounter_.inc();
+
+    // First recovery runs at once; each one that does not stick backs off
+    // exponentially, up to autoRestartDelaySeconds
+    if (recoveryDelaySeconds_ > 0.0f) {
+        LOG_INFO("Waiting " << recoveryDelaySeconds_ << "s before recovery");
+        std::this_thread::sleep_for(
+            std::chrono::milliseconds(static_cast<int>(recoveryDelaySeconds_ * 1000))
+        );
+    }
+    recoveryDelaySeconds_ = std::min(std::max(config_.recoveryBackoffSeconds, recoveryDelaySeconds_ * 2.0f),
+                                     config_.autoRestartDelaySeconds);
 
     // Call restart callback if set
     {
@@ -253,10 +435,13 @@ void KioskManager::logHealthStatus() const {
     LOG_DEBUG("Health Status:");
     LOG_DEBUG("  Kinect: " << (currentHealth_.kinectHealthy ? "OK" : "FAILED"));
     LOG_DEBUG("  Tracker: " << (currentHealth_.trackerHealthy ? "OK" : "FAILED"));
-    LOG_DEBUG("  FPS: " << currentHealth_.avgFps.load());
-    LOG_DEBUG("  Frames processed: " << currentHealth_.framesProcessed.load());
-    LOG_DEBUG("  Frames dropped: " << currentHealth_.framesDropped.load());
-    LOG_DEBUG("  Sessions completed: " << currentHealth_.sessionsCompleted.load());
+    LOG_DEBUG("  FPS: " << currentHealth_.avgFps);
+    LOG_DEBUG("  Frames processed: " << currentHealth_.framesProcessed);
+    LOG_DEBUG("  Frames dropped: " << currentHealth_.framesDropped);
+    LOG_DEBUG("  Kicks detected: " << currentHealth_.kicksDetected);
+    LOG_DEBUG("  Sessions completed: " << currentHealth_.sessionsCompleted);
+    LOG_DEBUG("  Quality: " << qualityGovernor_.getProfile().name << " (level " << qualityGovernor_.getLevel()
+              << ", pressure " << qualityGovernor_.getPressure() << ")");
     LOG_DEBUG("  System healthy: " << (systemHealthy_ ? "YES" : "NO"));
 }
 
@@ -1,6 +1,11 @@
 #pragma once
 
 #include "../../include/common.h"
+#include "../core/Metrics.h"
+#include "Heartbeat.h"
+#include "MetricsExporter.h"
+#include "QualityGovernor.h"
+#include <array>
 #include <thread>
 #include <atomic>
 #include <chrono>
@@ -13,9 +18,11 @@ namespace kiosk {
  * KioskManager handles:
  * - System health monitoring
  * - Auto-recovery from errors
- * - Watchdog for hang detection
+ * - Watchdog for hang detection, globally and per pipeline stage
+ * - Stepping quality down under sustained load and back up after it
  * - Periodic maintenance tasks
  * - Session lifecycle management
+ * - Serving the process metrics registry to Prometheus
  */
 class KioskManager {
 public:
@@ -26,10 +33,26 @@ public:
     struct Config {
         float healthCheckIntervalSeconds = 5.0f;
         float watchdogTimeoutSeconds = 30.0f;
-        float autoRestartDelaySeconds = 10.0f;
+        float autoRestartDelaySeconds = 10.0f;      // Longest wait between repeated recoveries
+        float recoveryBackoffSeconds = 0.5f;        // Wait before the second; doubles after
         int maxConsecutiveErrors = 3;
         bool enableAutoRecovery = true;
         bool enableWatchdog = true;
+        bool enableMetricsEndpoint = true;
+        MetricsExporter::Config metrics;   // Localhost /metrics listener
+        bool enableQualityGovernor = true;
+        QualityGovernor::Config quality;   // Levels, stage latency budgets, hysteresis
+
+        // Per-stage heartbeat timeouts, indexed by PipelineStage
+        std::array<float, PIPELINE_STAGE_COUNT> stageTimeoutSeconds = {{
+            2.0f,    // CAPTURE
+            2.0f,    // TRACKER_ENQUEUE
+            2.0f,    // TRACKER_POP
+            2.0f,    // ANALYSIS
+            2.0f,    // GAME
+            2.0f,    // RENDER
+            10.0f,   // SESSION_IO (fsync can be slow on kiosk SSDs)
+        }};
     };
 
     // Initialize manager
@@ -39,13 +62,38 @@ public:
     void start();
     void stop();
 
-    // Health monitoring
-    void updateHealth(const HealthMetrics& metrics);
+    // Health monitoring; refreshed from the metrics registry every check
+    HealthMetrics getHealth() const;
     bool isHealthy() const;
 
     // Watchdog (call regularly from main loop)
     void kickWatchdog();
 
+    // Per-stage heartbeats: a stage keeps its slot and calls beat() from
+    // its own thread; the slot lives as long as the manager
+    Heartbeat& getHeartbeat(PipelineStage stage) { return heartbeats_[static_cast<size_t>(stage)]; }
+    void beat(PipelineStage stage, const char* marker) { getHeartbeat(stage).beat(marker); }
+    void setStageTimeout(PipelineStage stage, float seconds);
+
+    struct StageStatus {
+        bool armed = false;        // Has beaten since start
+        bool stalled = false;
+        float secondsSinceBeat = 0.0f;
+        uint64_t progress = 0;     // Beats so far
+        const char* marker = "none";
+    };
+    StageStatus getStageStatus(PipelineStage stage) const;
+
+    // Adaptive quality: stages report load here and apply the current
+    // profile on their own thread when the level changes
+    QualityGovernor& getQualityGovernor() { return qualityGovernor_; }
+    void recordLatency(PipelineStage stage, uint64_t micros) { qualityGovernor_.recordLatency(stage, micros); }
+    void recordQueueDepth(PipelineStage stage, size_t depth, size_t capacity) {
+        qualityGovernor_.recordQueueDepth(stage, depth, capacity);
+    }
+    size_t getQualityLevel() const { return qualityGovernor_.getLevel(); }
+    const QualityProfile& getQualityProfile() const { return qualityGovernor_.getProfile(); }
+
     // Error reporting
     void reportError(const std::string& errorType, const std::string& message);
     void clearErrors();
@@ -54,11 +102,18 @@ public:
     using RestartCallback = std::function<void()>;
     void setRestartCallback(RestartCallback callback);
 
+    // Warm Kinect recovery (Application::onKinectRestart()): reconnect the
+    // device and resume the loaded tracker. Returns true once frames flow
+    // again; Kinect and tracker failures try it before counting as errors.
+    using KinectRecoveryCallback = std::function<bool()>;
+    void setKinectRecoveryCallback(KinectRecoveryCallback callback);
+
     // Statistics
     struct Statistics {
         uint64_t totalSessions = 0;
         uint64_t totalErrors = 0;
         uint64_t autoRecoveries = 0;
+        uint64_t kinectRecoveries = 0;    // Warm reconnects that worked
         std::chrono::system_clock::time_point startTime;
         std::chrono::system_clock::time_point lastError;
     };
@@ -76,13 +131,31 @@ private:
     // Health state
     std::atomic<bool> systemHealthy_;
     std::atomic<int> consecutiveErrors_;
+    float recoveryDelaySeconds_;    // Monitor thread only; 0 until a recovery fails to stick
     mutable std::mutex healthMutex_;
     HealthMetrics currentHealth_;
+    std::chrono::steady_clock::time_point lastHealthTime_;   // For avgFps
+
+    // Metrics
+    core::MetricsRegistry& registry_;
+    core::Gauge& healthyGauge_;
+    core::Gauge& uptimeGauge_;
+    core::Counter& recoveriesCounter_;
+    MetricsExporter metricsExporter_;
 
     // Watchdog
     std::atomic<uint64_t> lastWatchdogKick_;
     std::atomic<bool> watchdogExpired_;
 
+    // Stage heartbeats; stalled flags are owned by the monitor thread
+    std::array<Heartbeat, PIPELINE_STAGE_COUNT> heartbeats_;
+    std::array<std::atomic<bool>, PIPELINE_STAGE_COUNT> stageStalled_;
+    std::array<core::Gauge*, PIPELINE_STAGE_COUNT> stageAgeGauges_;
+    std::array<core::Counter*, PIPELINE_STAGE_COUNT> stageStallCounters_;
+
+    // Adaptive quality; evaluated by the monitor thread every pass
+    QualityGovernor qualityGovernor_;
+
     // Statistics
     Statistics stats_;
     mutable std::mutex statsMutex_;
@@ -98,6 +171,7 @@ private:
 
     // Callbacks
     RestartCallback restartCallback_;
+    KinectRecoveryCallback kinectRecoveryCallback_;
     std::mutex callbackMutex_;
 
     // Thread functions
@@ -105,8 +179,12 @@ private:
 
     // Health checks
     void performHealthCheck();
+    void collectHealth();
     void checkWatchdog();
+    void checkHeartbeats();
+    void handleStageStall(PipelineStage stage, float secondsSinceBeat);
     void checkKinectHealth();
+    bool recoverKinect(const std::string& reason);
     void checkFrameRate();
     void attemptRecovery();
 
@@ -0,0 +1,251 @@
+#include "MetricsExporter.h"
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+namespace kinect {
+namespace kiosk {
+
+namespace {
+
+#ifdef _WIN32
+using NativeSocket = SOCKET;
+#else
+using NativeSocket = int;
+#endif
+
+constexpr intptr_t NO_SOCKET = -1;
+constexpr int ACCEPT_POLL_MS = 200;     // How quickly stop() is noticed
+constexpr size_t MAX_REQUEST_BYTES = 8192;
+
+void closeSocket(intptr_t socket) {
+#ifdef _WIN32
+    closesocket(static_cast<NativeSocket>(socket));
+#else
+    close(static_cast<NativeSocket>(socket));
+#endif
+}
+
+// Wait until the listening socket has a connection to accept
+bool waitReadable(intptr_t socket, int timeoutMs) {
+#ifdef _WIN32
+    WSAPOLLFD descriptor{};
+    descriptor.fd = static_cast<NativeSocket>(socket);
+    descriptor.events = POLLRDNORM;
+    return WSAPoll(&descriptor, 1, timeoutMs) > 0;
+#else
+    pollfd descriptor{};
+    descriptor.fd = static_cast<NativeSocket>(socket);
+    descriptor.events = POLLIN;
+    return poll(&descriptor, 1, timeoutMs) > 0;
+#endif
+}
+
+void setTimeouts(intptr_t socket, uint32_t timeoutMs) {
+#ifdef _WIN32
+    DWORD timeout = timeoutMs;
+    setsockopt(static_cast<NativeSocket>(socket), SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&timeout), sizeof(timeout));
+    setsockopt(static_cast<NativeSocket>(socket), SOL_SOCKET, SO_SNDTIMEO, reinterpret_cast<const char*>(&timeout), sizeof(timeout));
+#else
+    timeval timeout{};
+    timeout.tv_sec = timeoutMs / 1000;
+    timeout.tv_usec = (timeoutMs % 1000) * 1000;
+    setsockopt(static_cast<NativeSocket>(socket), SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(static_cast<NativeSocket>(socket), SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+#endif
+}
+
+bool sendAll(intptr_t socket, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+#ifdef _WIN32
+        int result = send(static_cast<NativeSocket>(socket), data.data() + sent, static_cast<int>(data.size() - sent), 0);
+#else
+        ssize_t result = send(static_cast<NativeSocket>(socket), data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+#endif
+        if (result <= 0) {
+            return false;
+        }
+        sent += static_cast<size_t>(result);
+    }
+    return true;
+}
+
+std::string response(const char* status, const char* contentType, const std::string& body) {
+    std::string text = std::string("HTTP/1.1 ") + status + "\r\n";
+    text += std::string("Content-Type: ") + contentType + "\r\n";
+    text += "Content-Length: " + std::to_string(body.size()) + "\r\n";
+    text += "Connection: close\r\n\r\n";
+    text += body;
+    return text;
+}
+
+} // namespace
+
+MetricsExporter::MetricsExporter()
+    : registry_(nullptr)
+    , listenSocket_(NO_SOCKET)
+    , port_(0)
+    , running_(false)
+    , scrapes_(0)
+{
+}
+
+MetricsExporter::~MetricsExporter() {
+    stop();
+}
+
+bool MetricsExporter::start(const core::MetricsRegistry& registry, const Config& config) {
+    if (running_) {
+        LOG_WARN("Metrics exporter already running");
+        return false;
+    }
+    config_ = config;
+
+#ifdef _WIN32
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
+        LOG_ERROR("Metrics exporter: WSAStartup failed");
+        return false;
+    }
+#endif
+    registry_ = &registry;
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(config_.port);
+    if (inet_pton(AF_INET, config_.bindAddress.c_str(), &address.sin_addr) != 1) {
+        LOG_ERROR("Metrics exporter: invalid bind address " << config_.bindAddress);
+        stop();
+        return false;
+    }
+
+    intptr_t listener = static_cast<intptr_t>(socket(AF_INET, SOCK_STREAM, IPPROTO_TCP));
+    if (listener == NO_SOCKET) {
+        LOG_ERROR("Metrics exporter: socket() failed");
+        stop();
+        return false;
+    }
+    listenSocket_ = listener;
+
+    // A restarted kiosk must be able to rebind while old connections linger
+    int reuse = 1;
+    setsockopt(static_cast<NativeSocket>(listener), SOL_SOCKET, SO_REUSEADDR,
+               reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+
+    if (bind(static_cast<NativeSocket>(listener), reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(static_cast<NativeSocket>(listener), 8) != 0) {
+        LOG_ERROR("Metrics exporter: cannot listen on " << config_.bindAddress << ":" << config_.port);
+        stop();
+        return false;
+    }
+
+    socklen_t length = sizeof(address);
+    getsockname(static_cast<NativeSocket>(listener), reinterpret_cast<sockaddr*>(&address), &length);
+    port_ = ntohs(address.sin_port);
+
+    running_ = true;
+    serverThread_ = std::thread(&MetricsExporter::serverThreadFunc, this);
+
+    LOG_INFO("Metrics exporter listening on http://" << config_.bindAddress << ":" << port_ << "/metrics");
+    return true;
+}
+
+void MetricsExporter::stop() {
+    running_ = false;
+    if (serverThread_.joinable()) {
+        serverThread_.join();
+    }
+
+    if (listenSocket_ != NO_SOCKET) {
+        closeSocket(listenSocket_);
+        listenSocket_ = NO_SOCKET;
+    }
+
+#ifdef _WIN32
+    if (registry_) {
+        WSACleanup();
+    }
+#endif
+    registry_ = nullptr;
+}
+
+void MetricsExporter::serverThreadFunc() {
+    while (running_) {
+        if (!waitReadable(listenSocket_, ACCEPT_POLL_MS)) {
+            continue;
+        }
+
+        intptr_t client = static_cast<intptr_t>(accept(static_cast<NativeSocket>(listenSocket_), nullptr, nullptr));
+        if (client == NO_SOCKET) {
+            continue;
+        }
+        setTimeouts(client, config_.requestTimeoutMs);
+        handleClient(client);
+        closeSocket(client);
+    }
+}
+
+void MetricsExporter::handleClient(Socket client) {
+    // Only the request line matters; read until the end of the headers
+    std::string request;
+    char buffer[1024];
+    while (request.find("\r\n\r\n") == std::string::npos && request.size() < MAX_REQUEST_BYTES) {
+#ifdef _WIN32
+        int received = recv(static_cast<NativeSocket>(client), buffer, sizeof(buffer), 0);
+#else
+        ssize_t received = recv(static_cast<NativeSocket>(client), buffer, sizeof(buffer), 0);
+#endif
+        if (received <= 0) {
+            break;
+        }
+        request.append(buffer, static_cast<size_t>(received));
+    }
+
+    size_t lineEnd = request.find("\r\n");
+    std::string line = request.substr(0, lineEnd);
+    size_t methodEnd = line.find(' ');
+    size_t pathEnd = methodEnd == std::string::npos ? std::string::npos : line.find(' ', methodEnd + 1);
+    if (lineEnd == std::string::npos || pathEnd == std::string::npos) {
+        sendAll(client, response("400 Bad Request", "text/plain", "Bad request\n"));
+        return;
+    }
+
+    std::string method = line.substr(0, methodEnd);
+    std::string path = line.substr(methodEnd + 1, pathEnd - methodEnd - 1);
+    path = path.substr(0, path.find('?'));
+
+    if (method != "GET") {
+        sendAll(client, response("405 Method Not Allowed", "text/plain", "Only GET is supported\n"));
+    } else if (path == "/metrics") {
+        std::string body;
+        body.reserve(16 * 1024);
+        registry_->writePrometheusText(body);
+        scrapes_.fetch_add(1, std::memory_order_relaxed);
+        sendAll(client, response("200 OK", "text/plain; version=0.0.4; charset=utf-8", body));
+    } else if (path == "/") {
+        sendAll(client, response("200 OK", "text/plain", "Kinect Football kiosk metrics: /metrics\n"));
+    } else {
+        sendAll(client, response("404 Not Found", "text/plain", "Not found\n"));
+    }
+}
+
+} // namespace kiosk
+} // namespace kinect
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "../../include/common.h"
+#include "../core/Metrics.h"
+#include <atomic>
+#include <thread>
+
+namespace kinect {
+namespace kiosk {
+
+/**
+ * MetricsExporter serves a MetricsRegistry over HTTP for Prometheus:
+ * - GET /metrics returns every metric in the text exposition format
+ * - Listens on localhost by default; a scraper reaches it through the
+ *   kiosk's own agent or an SSH tunnel
+ * - One small thread handles one request at a time; scrapes only read
+ *   the registry, so the pipeline never waits on them
+ */
+class MetricsExporter {
+public:
+    // Configuration
+    struct Config {
+        std::string bindAddress = "127.0.0.1";
+        uint16_t port = 9464;
+        uint32_t requestTimeoutMs = 1000;   // Per client, read and write
+    };
+
+    MetricsExporter();
+    ~MetricsExporter();
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+    // Bind and start serving; false if the address is unavailable
+    bool start(const core::MetricsRegistry& registry, const Config& config);
+    void stop();
+
+    bool isRunning() const { return running_.load(std::memory_order_acquire); }
+    uint16_t getPort() const { return port_; }   // Bound port (config port 0 picks one)
+    uint64_t getScrapeCount() const { return scrapes_.load(std::memory_order_relaxed); }
+
+private:
+    using Socket = intptr_t;
+
+    Config config_;
+    const core::MetricsRegistry* registry_;
+    Socket listenSocket_;
+    uint16_t port_;
+
+    std::thread serverThread_;
+    std::atomic<bool> running_;
+    std::atomic<uint64_t> scrapes_;
+
+    void serverThreadFunc();
+    void handleClient(Socket client);
+};
+
+} // namespace kiosk
+} // namespace kinect
@@ -0,0 +1,235 @@
+#include "QualityGovernor.h"
+#include "../core/BodyTracker.h"
+#include "../core/KinectDevice.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+
+namespace kinect {
+namespace kiosk {
+
+std::vector<QualityProfile> defaultQualityLevels() {
+    std::vector<QualityProfile> levels;
+
+    QualityProfile profile;
+    profile.name = "full";
+    levels.push_back(profile);
+
+    // Color is only shown, never tracked
+    profile.name = "no_color";
+    profile.colorResolution = K4A_COLOR_RESOLUTION_OFF;
+    levels.push_back(profile);
+
+    // A quarter of the depth pixels for the tracker to process
+    profile.name = "depth_binned";
+    profile.depthMode = K4A_DEPTH_MODE_NFOV_2X2BINNED;
+    levels.push_back(profile);
+
+    // Bodies at 15 Hz; the game interpolates between them
+    profile.name = "tracker_half_rate";
+    profile.trackerFrameStride = 2;
+    levels.push_back(profile);
+
+    profile.name = "minimal";
+    profile.optionalDetectors = false;
+    profile.effects = false;
+    levels.push_back(profile);
+
+    return levels;
+}
+
+QualityGovernor::QualityGovernor()
+    : activeWindow_(0)
+    , level_(0)
+    , appliedLevel_(NO_LEVEL)
+    , pressure_(0.0f)
+    , evaluated_(false)
+    , lastDropped_(0)
+    , overloadedSeconds_(0.0f)
+    , headroomSeconds_(0.0f)
+    , levelGauge_(core::MetricsRegistry::global().gauge("kinect_quality_level", "Quality level, 0 = full quality"))
+    , pressureGauge_(core::MetricsRegistry::global().gauge("kinect_quality_pressure",
+                                                           "Pipeline load over budget in the last window (1 = at budget)"))
+    , degradesCounter_(core::MetricsRegistry::global().counter("kinect_quality_transitions_total",
+                                                               "Quality level changes", {{"direction", "degrade"}}))
+    , restoresCounter_(core::MetricsRegistry::global().counter("kinect_quality_transitions_total",
+                                                               "Quality level changes", {{"direction", "restore"}}))
+{
+    windows_[0] = std::make_unique<Window>();
+    windows_[1] = std::make_unique<Window>();
+    for (auto& fill : maxQueueFill_) {
+        fill = 0;
+    }
+}
+
+QualityGovernor::~QualityGovernor() = default;
+
+void QualityGovernor::configure(const Config& config) {
+    config_ = config;
+    if (config_.levels.empty()) {
+        config_.levels = defaultQualityLevels();
+    }
+
+    level_.store(0, std::memory_order_release);
+    levelGauge_.set(0.0);
+    evaluated_ = false;
+    overloadedSeconds_ = 0.0f;
+    headroomSeconds_ = 0.0f;
+}
+
+void QualityGovernor::recordLatency(PipelineStage stage, uint64_t micros) {
+    int window = activeWindow_.load(std::memory_order_acquire);
+    windows_[window]->latency[static_cast<size_t>(stage)].record(micros);
+}
+
+void QualityGovernor::recordQueueDepth(PipelineStage stage, size_t depth, size_t capacity) {
+    if (capacity == 0) {
+        return;
+    }
+    // Stored plus one, so an empty queue still counts as reported
+    uint32_t fill = static_cast<uint32_t>(std::min<size_t>(depth, capacity) * 1000 / capacity) + 1;
+    std::atomic<uint32_t>& max = maxQueueFill_[static_cast<size_t>(stage)];
+    uint32_t current = max.load(std::memory_order_relaxed);
+    while (fill > current && !max.compare_exchange_weak(current, fill, std::memory_order_relaxed)) {
+    }
+}
+
+bool QualityGovernor::evaluate(uint64_t droppedFrames, std::chrono::steady_clock::time_point now) {
+    if (!evaluated_) {
+        // First call only opens the window
+        evaluated_ = true;
+        lastDropped_ = droppedFrames;
+        lastEvaluation_ = now;
+        settleUntil_ = now;
+        closeWindow(0);
+        return false;
+    }
+
+    float elapsed = std::chrono::duration<float>(now - lastEvaluation_).count();
+    lastEvaluation_ = now;
+    uint64_t dropped = droppedFrames > lastDropped_ ? droppedFrames - lastDropped_ : 0;
+    lastDropped_ = droppedFrames;
+
+    Load load = closeWindow(dropped);
+    pressure_.store(load.pressure, std::memory_order_relaxed);
+    pressureGauge_.set(load.pressure);
+
+    // Windows right after a change still show the old level's load
+    if (now < settleUntil_) {
+        overloadedSeconds_ = 0.0f;
+        headroomSeconds_ = 0.0f;
+        return false;
+    }
+
+    size_t level = getLevel();
+    if (load.pressure > 1.0f) {
+        headroomSeconds_ = 0.0f;
+        overloadedSeconds_ += elapsed;
+        if (overloadedSeconds_ >= config_.degradeAfterSeconds && level + 1 < config_.levels.size()) {
+            transition(level + 1, load.reason, now);
+            return true;
+        }
+    } else if (load.hasSamples && load.pressure < config_.restoreBelow) {
+        overloadedSeconds_ = 0.0f;
+        headroomSeconds_ += elapsed;
+        if (headroomSeconds_ >= config_.restoreAfterSeconds && level > 0) {
+            char reason[96];
+            std::snprintf(reason, sizeof(reason), "load at %.0f%% of budget for %.0fs", load.pressure * 100.0f,
+                          headroomSeconds_);
+            transition(level - 1, reason, now);
+            return true;
+        }
+    } else {
+        // Between the thresholds, or no data: hold
+        overloadedSeconds_ = 0.0f;
+        headroomSeconds_ = 0.0f;
+    }
+    return false;
+}
+
+QualityGovernor::Load QualityGovernor::closeWindow(uint64_t droppedInWindow) {
+    int closing = activeWindow_.load(std::memory_order_relaxed);
+    activeWindow_.store(1 - closing, std::memory_order_release);
+    Window& window = *windows_[closing];
+
+    Load load;
+    char reason[96];
+    for (size_t i = 0; i < PIPELINE_STAGE_COUNT; ++i) {
+        const char* stage = pipelineStageName(static_cast<PipelineStage>(i));
+
+        core::AtomicHdrHistogram& latency = window.latency[i];
+        float budgetMs = config_.stageLatencyBudgetMs[i];
+        if (budgetMs > 0.0f && latency.getTotalCount() >= config_.minSamples) {
+            float p90Ms = static_cast<float>(latency.getValueAtPercentile(90.0)) / 1000.0f;
+            float pressure = p90Ms / budgetMs;
+            load.hasSamples = true;
+            if (pressure > load.pressure) {
+                load.pressure = pressure;
+                std::snprintf(reason, sizeof(reason), "%s p90 %.1f ms, budget %.1f ms", stage, p90Ms, budgetMs);
+                load.reason = reason;
+            }
+        }
+        latency.reset();
+
+        uint32_t reported = maxQueueFill_[i].exchange(0, std::memory_order_relaxed);
+        if (reported > 0 && config_.queueHighWatermark > 0.0f) {
+            uint32_t fill = reported - 1;
+            float pressure = fill / 1000.0f / config_.queueHighWatermark;
+            load.hasSamples = true;
+            if (pressure > load.pressure) {
+                load.pressure = pressure;
+                std::snprintf(reason, sizeof(reason), "%s queue %.0f%% full", stage, fill / 10.0f);
+                load.reason = reason;
+            }
+        }
+    }
+
+    if (droppedInWindow > 0) {
+        load.hasSamples = true;
+        if (load.pressure <= 1.0f) {
+            // Just past the threshold, so a worse stage still names the cause
+            load.pressure = std::nextafter(1.0f, 2.0f);
+            load.reason = std::to_string(droppedInWindow) + " frames dropped";
+        }
+    }
+    return load;
+}
+
+void QualityGovernor::transition(size_t level, const std::string& reason, std::chrono::steady_clock::time_point now) {
+    size_t previous = getLevel();
+    level_.store(level, std::memory_order_release);
+    levelGauge_.set(static_cast<double>(level));
+    settleUntil_ = now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                             std::chrono::duration<float>(config_.settleSeconds));
+    overloadedSeconds_ = 0.0f;
+    headroomSeconds_ = 0.0f;
+
+    const QualityProfile& from = config_.levels[previous];
+    const QualityProfile& to = config_.levels[level];
+    if (level > previous) {
+        degradesCounter_.inc();
+        LOG_WARN("Quality degraded " << from.name << " -> " << to.name << " (level " << level << "): " << reason);
+    } else {
+        restoresCounter_.inc();
+        LOG_INFO("Quality restored " << from.name << " -> " << to.name << " (level " << level << "): " << reason);
+    }
+
+    if (levelCallback_) {
+        levelCallback_(level, to);
+    }
+}
+
+bool applyQualityProfile(const QualityProfile& profile, core::KinectDevice& device, core::BodyTracker& tracker) {
+    tracker.setFrameStride(profile.trackerFrameStride);
+
+    bool depthChanged = device.getDepthMode() != profile.depthMode;
+    if (!device.reconfigure(profile.depthMode, profile.colorResolution)) {
+        return false;
+    }
+    // The tracker only reads the depth camera, so a color change keeps it
+    return !depthChanged || tracker.resume(device);
+}
+
+} // namespace kiosk
+} // namespace kinect
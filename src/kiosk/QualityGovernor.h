@@ -0,0 +1,175 @@
+#pragma once
+
+#include "../../include/common.h"
+#include "../core/HdrHistogram.h"
+#include "../core/Metrics.h"
+#include "Heartbeat.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace kinect {
+
+namespace core {
+    class KinectDevice;
+    class BodyTracker;
+}
+
+namespace kiosk {
+
+/**
+ * One step of the quality ladder. Level 0 is full quality; each level
+ * after it gives something up to take load off the pipeline.
+ */
+struct QualityProfile {
+    std::string name;
+    k4a_depth_mode_t depthMode = K4A_DEPTH_MODE_NFOV_UNBINNED;
+    k4a_color_resolution_t colorResolution = K4A_COLOR_RESOLUTION_720P;
+    uint32_t trackerFrameStride = 1;   // Track every nth capture
+    bool optionalDetectors = true;     // Header detection, kick classification
+    bool effects = true;               // Celebrations, trails, particles
+};
+
+// full, no_color, depth_binned, tracker_half_rate, minimal
+std::vector<QualityProfile> defaultQualityLevels();
+
+/**
+ * QualityGovernor steps the kiosk down a ladder of quality levels under
+ * sustained load and back up once the load subsides:
+ * - Stages report work latency and queue depth from their own threads;
+ *   both are a few relaxed atomic operations
+ * - evaluate() runs once per monitor pass. It closes the window and turns
+ *   it into a pressure: the worst stage's p90 latency over its budget,
+ *   queue fill over the high watermark, or overload if frames were dropped
+ * - Pressure above 1 for degradeAfterSeconds moves down one level;
+ *   pressure below restoreBelow for restoreAfterSeconds moves up one.
+ *   Windows during settleSeconds after a change are ignored.
+ * - A window without samples neither degrades nor restores, so a stopped
+ *   pipeline holds its level
+ *
+ * The governor only publishes the level. Each stage reads getLevel() on
+ * its own thread and applies the profile there; see applyQualityProfile.
+ */
+class QualityGovernor {
+public:
+    // Configuration
+    struct Config {
+        std::vector<QualityProfile> levels = defaultQualityLevels();
+
+        // p90 work time per unit (frame, event batch) at which a stage counts
+        // as overloaded, indexed by PipelineStage (0 = not watched)
+        std::array<float, PIPELINE_STAGE_COUNT> stageLatencyBudgetMs = {{
+            0.0f,    // CAPTURE (waits on the device, not a load signal)
+            0.0f,    // TRACKER_ENQUEUE (never blocks)
+            66.0f,   // TRACKER_POP (enqueue to result, two frames at 30 fps)
+            10.0f,   // ANALYSIS
+            10.0f,   // GAME
+            16.0f,   // RENDER (work before Present, 60 Hz)
+            0.0f,    // SESSION_IO (off the frame path)
+        }};
+
+        float queueHighWatermark = 0.75f;   // Queue fill that counts as overloaded
+        float restoreBelow = 0.6f;          // Pressure that counts as headroom
+        float degradeAfterSeconds = 3.0f;
+        float restoreAfterSeconds = 20.0f;
+        float settleSeconds = 5.0f;         // After a change, before judging again
+        uint32_t minSamples = 10;           // Latency samples a stage needs per window
+    };
+
+    QualityGovernor();
+    ~QualityGovernor();
+
+    QualityGovernor(const QualityGovernor&) = delete;
+    QualityGovernor& operator=(const QualityGovernor&) = delete;
+
+    // Reset to level 0 (not while stages are recording)
+    void configure(const Config& config);
+
+    // Stage side (any thread)
+    void recordLatency(PipelineStage stage, uint64_t micros);
+    void recordQueueDepth(PipelineStage stage, size_t depth, size_t capacity);
+
+    /**
+     * @brief Close the current window and move at most one level
+     * @param droppedFrames Running total of frames dropped anywhere in the
+     *        pipeline; any increase marks the window overloaded
+     * @return true if the level changed
+     */
+    bool evaluate(uint64_t droppedFrames, std::chrono::steady_clock::time_point now);
+
+    // Current level and its profile (any thread)
+    size_t getLevel() const { return level_.load(std::memory_order_acquire); }
+    size_t getLevelCount() const { return config_.levels.size(); }
+    const QualityProfile& getProfile() const { return config_.levels[getLevel()]; }
+    float getPressure() const { return pressure_.load(std::memory_order_relaxed); }
+
+    // Level whose profile a stage last applied to the pipeline, NO_LEVEL
+    // until one does; tells the kiosk that degrading can actually help
+    static constexpr size_t NO_LEVEL = static_cast<size_t>(-1);
+    void setAppliedLevel(size_t level) { appliedLevel_.store(level, std::memory_order_release); }
+    size_t getAppliedLevel() const { return appliedLevel_.load(std::memory_order_acquire); }
+
+    // Called on the evaluating thread after each transition (set before
+    // evaluation starts)
+    using LevelCallback = std::function<void(size_t level, const QualityProfile& profile)>;
+    void setLevelCallback(LevelCallback callback) { levelCallback_ = callback; }
+
+private:
+    struct Window {
+        std::array<core::AtomicHdrHistogram, PIPELINE_STAGE_COUNT> latency;
+    };
+
+    struct Load {
+        float pressure = 0.0f;
+        bool hasSamples = false;
+        std::string reason;   // What set the pressure
+    };
+
+    Config config_;
+
+    // Two windows: stages record into the active one while evaluate()
+    // reads and clears the other. A sample racing the flip may be counted
+    // in the next window instead.
+    std::unique_ptr<Window> windows_[2];
+    std::atomic<int> activeWindow_;
+    std::array<std::atomic<uint32_t>, PIPELINE_STAGE_COUNT> maxQueueFill_;   // Per mille + 1, 0 = none
+
+    std::atomic<size_t> level_;
+    std::atomic<size_t> appliedLevel_;
+    std::atomic<float> pressure_;
+    LevelCallback levelCallback_;
+
+    // Evaluating thread only
+    bool evaluated_;
+    uint64_t lastDropped_;
+    std::chrono::steady_clock::time_point lastEvaluation_;
+    std::chrono::steady_clock::time_point settleUntil_;
+    float overloadedSeconds_;
+    float headroomSeconds_;
+
+    // Metrics
+    core::Gauge& levelGauge_;
+    core::Gauge& pressureGauge_;
+    core::Counter& degradesCounter_;
+    core::Counter& restoresCounter_;
+
+    Load closeWindow(uint64_t droppedInWindow);
+    void transition(size_t level, const std::string& reason, std::chrono::steady_clock::time_point now);
+};
+
+/**
+ * Apply a profile to the capture side of the pipeline. Call on the capture
+ * thread when QualityGovernor::getLevel() changes. Changing the depth mode
+ * restarts the cameras and reloads the tracker model (about 2 s without
+ * body frames); color and tracker rate changes keep the loaded tracker.
+ * @return false if the device or tracker could not be brought back up
+ */
+bool applyQualityProfile(const QualityProfile& profile, core::KinectDevice& device, core::BodyTracker& tracker);
+
+} // namespace kiosk
+} // namespace kinect
@@ -0,0 +1,252 @@
+#include "SessionAnalytics.h"
+#include "../core/BinaryRecord.h"
+#include <algorithm>
+#include <cmath>
+
+namespace kinect {
+namespace kiosk {
+
+namespace {
+
+const char* const SHARE_METHOD_NAMES[] = {"qr", "email", "sms", "other"};
+
+std::atomic<uint64_t> nextInstanceId{1};
+
+using core::fromMicroseconds;
+using core::toMicroseconds;
+
+int64_t steadyMicroseconds() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Non-negative float in tenths
+uint64_t tenths(float value) {
+    return value > 0.0f ? static_cast<uint64_t>(std::lround(value * 10.0f)) : 0;
+}
+
+} // namespace
+
+SessionAnalytics::SessionAnalytics()
+    : instanceId_(nextInstanceId.fetch_add(1, std::memory_order_relaxed))
+    , shards_(nullptr)
+    , generation_(0)
+    , firstSessionUs_(toMicroseconds(std::chrono::system_clock::now()))
+    , lastSessionUs_(0)
+    , activeStartUs_(0)
+    , awaitingFirstKick_(false)
+{
+}
+
+SessionAnalytics::~SessionAnalytics() {
+    Shard* shard = shards_.load(std::memory_order_acquire);
+    while (shard) {
+        Shard* next = shard->next;
+        delete shard;
+        shard = next;
+    }
+}
+
+void SessionAnalytics::recordStart(std::chrono::system_clock::time_point startTime) {
+    Shard& shard = beginWrite();
+    shard.started.fetch_add(1, std::memory_order_relaxed);
+    endWrite(shard);
+
+    lastSessionUs_.store(toMicroseconds(startTime), std::memory_order_relaxed);
+    activeStartUs_.store(steadyMicroseconds(), std::memory_order_relaxed);
+    awaitingFirstKick_.store(true, std::memory_order_release);
+}
+
+void SessionAnalytics::recordCompleted(const SessionData& session) {
+    awaitingFirstKick_.store(false, std::memory_order_relaxed);
+
+    Shard& shard = beginWrite();
+    shard.completed.fetch_add(1, std::memory_order_relaxed);
+    size_t challenge = static_cast<size_t>(session.selectedChallenge);
+    if (challenge < CHALLENGE_TYPES) {
+        shard.challenges[challenge].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    shard.histograms[SESSION_DURATION].record(session.getDurationMs());
+    shard.histograms[SCORE].record(tenths(session.result.getPercentage()));
+    for (const KickData& kick : session.result.kicks) {
+        shard.histograms[KICK_SPEED].record(tenths(kick.estimatedBallSpeed));
+    }
+    endWrite(shard);
+}
+
+void SessionAnalytics::recordCancelled() {
+    awaitingFirstKick_.store(false, std::memory_order_relaxed);
+
+    Shard& shard = beginWrite();
+    shard.cancelled.fetch_add(1, std::memory_order_relaxed);
+    endWrite(shard);
+}
+
+void SessionAnalytics::recordShare(const std::string& method) {
+    size_t index = SHARE_METHODS - 1;
+    for (size_t i = 0; i + 1 < SHARE_METHODS; ++i) {
+        if (method == SHARE_METHOD_NAMES[i]) {
+            index = i;
+            break;
+        }
+    }
+
+    Shard& shard = beginWrite();
+    shard.shared.fetch_add(1, std::memory_order_relaxed);
+    shard.shareMethods[index].fetch_add(1, std::memory_order_relaxed);
+    endWrite(shard);
+}
+
+void SessionAnalytics::recordKick() {
+    // One relaxed load per kick once the first has been timed
+    if (!awaitingFirstKick_.load(std::memory_order_relaxed) ||
+        !awaitingFirstKick_.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+
+    int64_t elapsedUs = steadyMicroseconds() - activeStartUs_.load(std::memory_order_relaxed);
+    Shard& shard = beginWrite();
+    shard.histograms[TIME_TO_FIRST_KICK].record(static_cast<uint64_t>(std::max<int64_t>(0, elapsedUs)) / 1000);
+    endWrite(shard);
+}
+
+SessionAnalytics::Snapshot SessionAnalytics::snapshot() const {
+    Snapshot result;
+    result.firstSession = fromMicroseconds(firstSessionUs_.load(std::memory_order_relaxed));
+    result.lastSession = fromMicroseconds(lastSessionUs_.load(std::memory_order_relaxed));
+
+    uint64_t generation = generation_.load(std::memory_order_acquire);
+    uint64_t started = 0;
+    uint64_t completed = 0;
+    uint64_t cancelled = 0;
+    uint64_t shared = 0;
+    std::array<uint64_t, CHALLENGE_TYPES> challenges{};
+    std::array<uint64_t, SHARE_METHODS> shareMethods{};
+    std::array<core::HdrHistogram, METRIC_COUNT> histograms;
+
+    for (const Shard* shard = shards_.load(std::memory_order_acquire); shard; shard = shard->next) {
+        // Copy, then keep the copy only if no write overlapped it
+        for (;;) {
+            uint64_t before = shard->sequence.load(std::memory_order_acquire);
+            if (before & 1) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            bool current = shard->generation.load(std::memory_order_relaxed) == generation;
+            if (current) {
+                started = shard->started.load(std::memory_order_relaxed);
+                completed = shard->completed.load(std::memory_order_relaxed);
+                cancelled = shard->cancelled.load(std::memory_order_relaxed);
+                shared = shard->shared.load(std::memory_order_relaxed);
+                for (size_t i = 0; i < CHALLENGE_TYPES; ++i) {
+                    challenges[i] = shard->challenges[i].load(std::memory_order_relaxed);
+                }
+                for (size_t i = 0; i < SHARE_METHODS; ++i) {
+                    shareMethods[i] = shard->shareMethods[i].load(std::memory_order_relaxed);
+                }
+                for (size_t m = 0; m < METRIC_COUNT; ++m) {
+                    histograms[m].reset();
+                    histograms[m].merge(shard->histograms[m]);
+                }
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (shard->sequence.load(std::memory_order_relaxed) != before) {
+                continue;
+            }
+
+            if (current) {
+                result.totalSessions += started;
+                result.completedSessions += completed;
+                result.cancelledSessions += cancelled;
+                result.sharedSessions += shared;
+                for (size_t i = 0; i < CHALLENGE_TYPES; ++i) {
+                    if (challenges[i] > 0) {
+                        result.challengeCounts[static_cast<ChallengeType>(i)] += challenges[i];
+                    }
+                }
+                for (size_t i = 0; i < SHARE_METHODS; ++i) {
+                    if (shareMethods[i] > 0) {
+                        result.shareMethodCounts[SHARE_METHOD_NAMES[i]] += shareMethods[i];
+                    }
+                }
+                for (size_t m = 0; m < METRIC_COUNT; ++m) {
+                    result.histograms[m].merge(histograms[m]);
+                }
+            }
+            break;
+        }
+    }
+
+    return result;
+}
+
+void SessionAnalytics::reset() {
+    generation_.fetch_add(1, std::memory_order_acq_rel);
+    firstSessionUs_.store(toMicroseconds(std::chrono::system_clock::now()), std::memory_order_relaxed);
+    lastSessionUs_.store(0, std::memory_order_relaxed);
+}
+
+SessionAnalytics::Shard& SessionAnalytics::beginWrite() {
+    Shard& shard = localShard();
+    shard.sequence.store(shard.sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    // First write since reset(): start this shard over
+    uint64_t generation = generation_.load(std::memory_order_acquire);
+    if (shard.generation.load(std::memory_order_relaxed) != generation) {
+        shard.started.store(0, std::memory_order_relaxed);
+        shard.completed.store(0, std::memory_order_relaxed);
+        shard.cancelled.store(0, std::memory_order_relaxed);
+        shard.shared.store(0, std::memory_order_relaxed);
+        for (auto& count : shard.challenges) {
+            count.store(0, std::memory_order_relaxed);
+        }
+        for (auto& count : shard.shareMethods) {
+            count.store(0, std::memory_order_relaxed);
+        }
+        for (auto& histogram : shard.histograms) {
+            histogram.reset();
+        }
+        shard.generation.store(generation, std::memory_order_relaxed);
+    }
+    return shard;
+}
+
+void SessionAnalytics::endWrite(Shard& shard) {
+    shard.sequence.store(shard.sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+SessionAnalytics::Shard& SessionAnalytics::localShard() {
+    // A thread almost always records into one instance
+    thread_local uint64_t cachedInstance = 0;
+    thread_local Shard* cachedShard = nullptr;
+    if (cachedInstance == instanceId_) {
+        return *cachedShard;
+    }
+
+    std::thread::id self = std::this_thread::get_id();
+    Shard* shard = shards_.load(std::memory_order_acquire);
+    while (shard && shard->owner != self) {
+        shard = shard->next;
+    }
+
+    if (!shard) {
+        shard = new Shard();
+        shard->owner = self;
+        shard->generation.store(generation_.load(std::memory_order_acquire), std::memory_order_relaxed);
+        shard->next = shards_.load(std::memory_order_relaxed);
+        while (!shards_.compare_exchange_weak(shard->next, shard, std::memory_order_release,
+                                              std::memory_order_relaxed)) {
+        }
+    }
+
+    cachedInstance = instanceId_;
+    cachedShard = shard;
+    return *shard;
+}
+
+} // namespace kiosk
+} // namespace kinect
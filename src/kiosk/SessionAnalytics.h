@@ -0,0 +1,106 @@
+#pragma once
+
+#include "../../include/common.h"
+#include "../core/HdrHistogram.h"
+#include <array>
+#include <atomic>
+#include <map>
+#include <thread>
+
+namespace kinect {
+namespace kiosk {
+
+/**
+ * SessionAnalytics collects session counters and distributions:
+ * - Every recording thread writes only its own shard (found through a
+ *   thread-local cache), with relaxed atomic adds and no locks
+ * - Distributions are HDR-style histograms, so percentiles are available
+ *   at any time and histograms from several kiosks merge exactly
+ * - snapshot() sums the shards without blocking writers; each shard is
+ *   read under a sequence counter, so a snapshot never sees half of a
+ *   recorded session
+ * - reset() bumps a generation; each shard clears itself on its owner's
+ *   next write, and snapshots skip shards from older generations
+ */
+class SessionAnalytics {
+public:
+    // Recorded distributions and their units
+    enum Metric {
+        SESSION_DURATION,     // Milliseconds
+        SCORE,                // Tenths of a percent of max score
+        KICK_SPEED,           // Tenths of km/h, estimated ball speed
+        TIME_TO_FIRST_KICK,   // Milliseconds from session start
+        METRIC_COUNT
+    };
+
+    static constexpr size_t CHALLENGE_TYPES = static_cast<size_t>(ChallengeType::SKILL_TEST) + 1;
+
+    struct Snapshot {
+        uint64_t totalSessions = 0;
+        uint64_t completedSessions = 0;
+        uint64_t cancelledSessions = 0;
+        uint64_t sharedSessions = 0;
+
+        std::map<ChallengeType, uint64_t> challengeCounts;
+        std::map<std::string, uint64_t> shareMethodCounts;
+
+        std::array<core::HdrHistogram, METRIC_COUNT> histograms;
+
+        std::chrono::system_clock::time_point firstSession;
+        std::chrono::system_clock::time_point lastSession;
+    };
+
+    SessionAnalytics();
+    ~SessionAnalytics();
+
+    SessionAnalytics(const SessionAnalytics&) = delete;
+    SessionAnalytics& operator=(const SessionAnalytics&) = delete;
+
+    // Recording (any thread, never blocks)
+    void recordStart(std::chrono::system_clock::time_point startTime);
+    void recordCompleted(const SessionData& session);
+    void recordCancelled();
+    void recordShare(const std::string& method);
+    void recordKick();   // Only the first kick after recordStart() is timed
+
+    // Reading (any thread)
+    Snapshot snapshot() const;
+    void reset();
+
+private:
+    // Share methods counted by name; the rest count as "other"
+    static constexpr size_t SHARE_METHODS = 4;
+
+    struct alignas(64) Shard {
+        std::thread::id owner;
+        Shard* next = nullptr;
+
+        std::atomic<uint64_t> sequence{0};     // Odd while the owner writes
+        std::atomic<uint64_t> generation{0};
+
+        std::atomic<uint64_t> started{0};
+        std::atomic<uint64_t> completed{0};
+        std::atomic<uint64_t> cancelled{0};
+        std::atomic<uint64_t> shared{0};
+        std::array<std::atomic<uint64_t>, CHALLENGE_TYPES> challenges{};
+        std::array<std::atomic<uint64_t>, SHARE_METHODS> shareMethods{};
+        std::array<core::AtomicHdrHistogram, METRIC_COUNT> histograms;
+    };
+
+    const uint64_t instanceId_;
+    std::atomic<Shard*> shards_;          // Lock-free list, only ever grows
+    std::atomic<uint64_t> generation_;
+
+    std::atomic<int64_t> firstSessionUs_;
+    std::atomic<int64_t> lastSessionUs_;
+    std::atomic<int64_t> activeStartUs_;  // Steady clock, for time to first kick
+    std::atomic<bool> awaitingFirstKick_;
+
+    // Calling thread's shard, opened for writing; pair with endWrite()
+    Shard& beginWrite();
+    void endWrite(Shard& shard);
+    Shard& localShard();
+};
+
+} // namespace kiosk
+} // namespace kinect
@@ -0,0 +1,314 @@
+#include "SessionExporter.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+
+namespace fs = std::filesystem;
+
+namespace kinect {
+namespace kiosk {
+
+namespace {
+
+// Buffered output is written out past this size
+constexpr size_t WRITE_CHUNK_BYTES = 64 * 1024;
+
+void appendf(std::string& out, const char* format, double value) {
+    char text[32];
+    int length = std::snprintf(text, sizeof(text), format, value);
+    out.append(text, static_cast<size_t>(std::max(0, length)));
+}
+
+void appendNumber(std::string& out, uint64_t value) {
+    out += std::to_string(value);
+}
+
+void appendNumber(std::string& out, int64_t value) {
+    out += std::to_string(value);
+}
+
+// Same text the old ostream-based export produced
+void appendFloat(std::string& out, float value) {
+    appendf(out, "%g", value);
+}
+
+void appendCsvField(std::string& out, std::string_view text) {
+    if (text.find_first_of(",\"\r\n") == std::string_view::npos) {
+        out.append(text.data(), text.size());
+        return;
+    }
+    out += '"';
+    for (char c : text) {
+        if (c == '"') {
+            out += '"';
+        }
+        out += c;
+    }
+    out += '"';
+}
+
+void appendJsonString(std::string& out, std::string_view text) {
+    out += '"';
+    for (char c : text) {
+        switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escape[8];
+                    std::snprintf(escape, sizeof(escape), "\\u%04x", static_cast<unsigned>(static_cast<unsigned char>(c)));
+                    out.append(escape, 6);
+                } else {
+                    out += c;
+                }
+        }
+    }
+    out += '"';
+}
+
+void appendJsonFloat(std::string& out, float value) {
+    if (std::isfinite(value)) {
+        appendFloat(out, value);
+    } else {
+        out += "null";
+    }
+}
+
+int64_t toMilliseconds(std::chrono::system_clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count();
+}
+
+void appendCsvRow(std::string& out, const SessionRow& row) {
+    appendCsvField(out, row.getSessionId());
+    out += ',';
+    appendNumber(out, static_cast<uint64_t>(row.getPlayerId()));
+    out += ',';
+    appendNumber(out, static_cast<int64_t>(std::chrono::system_clock::to_time_t(row.getStartTime())));
+    out += ',';
+    appendNumber(out, static_cast<int64_t>(std::chrono::system_clock::to_time_t(row.getEndTime())));
+    out += ',';
+    appendNumber(out, static_cast<int64_t>(row.getChallenge()));
+    out += ',';
+    appendNumber(out, static_cast<int64_t>(row.getScore()));
+    out += ',';
+    appendFloat(out, row.getAccuracy());
+    out += row.wasShared() ? ",1," : ",0,";
+    appendCsvField(out, row.getShareMethod());
+    out += '\n';
+}
+
+void appendJsonRow(std::string& out, const SessionRow& row) {
+    out += "{\"sessionId\":";
+    appendJsonString(out, row.getSessionId());
+    out += ",\"playerId\":";
+    appendNumber(out, static_cast<uint64_t>(row.getPlayerId()));
+    out += ",\"startTimeMs\":";
+    appendNumber(out, toMilliseconds(row.getStartTime()));
+    out += ",\"endTimeMs\":";
+    appendNumber(out, toMilliseconds(row.getEndTime()));
+    out += ",\"challenge\":";
+    appendNumber(out, static_cast<int64_t>(row.getChallenge()));
+    out += ",\"jersey\":";
+    appendNumber(out, static_cast<int64_t>(row.getJersey()));
+    out += ",\"background\":";
+    appendNumber(out, static_cast<int64_t>(row.getBackground()));
+    out += ",\"score\":";
+    appendNumber(out, static_cast<int64_t>(row.getScore()));
+    out += ",\"maxScore\":";
+    appendNumber(out, static_cast<int64_t>(row.getMaxScore()));
+    out += ",\"accuracy\":";
+    appendJsonFloat(out, row.getAccuracy());
+    out += ",\"avgPower\":";
+    appendJsonFloat(out, row.getAvgPower());
+    out += ",\"durationMs\":";
+    appendNumber(out, row.getDurationMs());
+    out += row.wasShared() ? ",\"shared\":true,\"shareMethod\":" : ",\"shared\":false,\"shareMethod\":";
+    appendJsonString(out, row.getShareMethod());
+    out += ",\"downloadUrl\":";
+    appendJsonString(out, row.getDownloadUrl());
+
+    out += ",\"kicks\":[";
+    for (size_t i = 0; i < row.getKickCount(); ++i) {
+        KickData kick = row.getKick(i);
+        out += i > 0 ? ",{\"type\":" : "{\"type\":";
+        appendNumber(out, static_cast<int64_t>(kick.type));
+        out += ",\"power\":";
+        appendJsonFloat(out, kick.power);
+        out += ",\"direction\":";
+        appendJsonFloat(out, kick.direction);
+        out += ",\"accuracy\":";
+        appendJsonFloat(out, kick.accuracy);
+        out += ",\"ballSpeed\":";
+        appendJsonFloat(out, kick.estimatedBallSpeed);
+        out += ",\"timestamp\":";
+        appendNumber(out, kick.timestamp);
+        out += '}';
+    }
+    out += "]}\n";
+}
+
+} // namespace
+
+SessionExporter::SessionExporter()
+    : running_(false)
+    , cancelled_(false)
+    , succeeded_(false)
+    , totalSessions_(0)
+    , exportedSessions_(0)
+    , bytesWritten_(0)
+{
+}
+
+SessionExporter::~SessionExporter() {
+    cancel();
+    wait();
+}
+
+bool SessionExporter::start(const std::string& filepath, Format format, Source source) {
+    if (running_.load(std::memory_order_acquire)) {
+        LOG_WARN("Session export already running, not starting " << filepath);
+        return false;
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+
+    cancelled_.store(false, std::memory_order_relaxed);
+    succeeded_.store(false, std::memory_order_relaxed);
+    totalSessions_.store(0, std::memory_order_relaxed);
+    exportedSessions_.store(0, std::memory_order_relaxed);
+    bytesWritten_.store(0, std::memory_order_relaxed);
+    running_.store(true, std::memory_order_release);
+
+    thread_ = std::thread(&SessionExporter::exportThreadFunc, this, filepath, format, std::move(source));
+    return true;
+}
+
+void SessionExporter::cancel() {
+    cancelled_.store(true, std::memory_order_relaxed);
+}
+
+bool SessionExporter::wait() {
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    return succeeded_.load(std::memory_order_acquire);
+}
+
+SessionExporter::Progress SessionExporter::getProgress() const {
+    Progress progress;
+    progress.running = running_.load(std::memory_order_acquire);
+    progress.succeeded = succeeded_.load(std::memory_order_acquire);
+    progress.totalSessions = totalSessions_.load(std::memory_order_relaxed);
+    progress.exportedSessions = exportedSessions_.load(std::memory_order_relaxed);
+    progress.bytesWritten = bytesWritten_.load(std::memory_order_relaxed);
+    return progress;
+}
+
+void SessionExporter::exportThreadFunc(std::string filepath, Format format, Source source) {
+    auto startTime = std::chrono::steady_clock::now();
+
+    SessionCursor cursor = source();
+    totalSessions_.store(cursor.countRemaining(), std::memory_order_relaxed);
+
+    bool ok;
+    if (format == Format::COLUMNAR) {
+        ok = writeColumnar(filepath, cursor);
+    } else {
+        std::string tempPath = filepath + ".tmp";
+        std::FILE* file = std::fopen(tempPath.c_str(), "wb");
+        ok = file != nullptr && writeText(file, format, cursor);
+        if (file) {
+            ok = std::fclose(file) == 0 && ok;
+        }
+
+        std::error_code ec;
+        if (ok) {
+            fs::rename(tempPath, filepath, ec);
+            ok = !ec;
+        }
+        if (!ok) {
+            fs::remove(tempPath, ec);
+        }
+    }
+
+    float seconds = std::chrono::duration<float>(std::chrono::steady_clock::now() - startTime).count();
+    if (ok) {
+        LOG_INFO("Exported " << exportedSessions_.load(std::memory_order_relaxed) << " sessions to "
+                 << filepath << " in " << seconds << "s");
+    } else if (cancelled_.load(std::memory_order_relaxed)) {
+        LOG_WARN("Session export cancelled: " << filepath);
+    } else {
+        LOG_ERROR("Failed to export sessions: " << filepath);
+    }
+
+    succeeded_.store(ok, std::memory_order_release);
+    running_.store(false, std::memory_order_release);
+}
+
+bool SessionExporter::writeText(std::FILE* file, Format format, SessionCursor& cursor) {
+    std::string buffer;
+    buffer.reserve(WRITE_CHUNK_BYTES * 2);
+    uint64_t exported = 0;
+    uint64_t written = 0;
+
+    auto flush = [&]() {
+        if (std::fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size()) {
+            return false;
+        }
+        written += buffer.size();
+        bytesWritten_.store(written, std::memory_order_relaxed);
+        buffer.clear();
+        return true;
+    };
+
+    if (format == Format::CSV) {
+        buffer += "SessionID,PlayerID,StartTime,EndTime,Challenge,Score,Accuracy,Shared,ShareMethod\n";
+    }
+
+    while (cursor.next()) {
+        if (cancelled_.load(std::memory_order_relaxed)) {
+            return false;
+        }
+
+        if (format == Format::CSV) {
+            appendCsvRow(buffer, cursor.row());
+        } else {
+            appendJsonRow(buffer, cursor.row());
+        }
+        exportedSessions_.store(++exported, std::memory_order_relaxed);
+
+        if (buffer.size() >= WRITE_CHUNK_BYTES && !flush()) {
+            return false;
+        }
+    }
+    return flush();
+}
+
+bool SessionExporter::writeColumnar(const std::string& path, SessionCursor& cursor) {
+    std::vector<SessionData> sessions;
+    sessions.reserve(static_cast<size_t>(totalSessions_.load(std::memory_order_relaxed)));
+
+    while (cursor.next()) {
+        if (cancelled_.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        sessions.push_back(cursor.row().toSessionData());
+        exportedSessions_.store(sessions.size(), std::memory_order_relaxed);
+    }
+
+    if (!SessionStore::writeSegment(sessions, 0, path)) {
+        return false;
+    }
+    std::error_code ec;
+    bytesWritten_.store(fs::file_size(path, ec), std::memory_order_relaxed);
+    return true;
+}
+
+} // namespace kiosk
+} // namespace kinect
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "../../include/common.h"
+#include "SessionStore.h"
+#include <atomic>
+#include <functional>
+#include <thread>
+
+namespace kinect {
+namespace kiosk {
+
+/**
+ * SessionExporter writes stored sessions to a file on its own thread:
+ * - It reads from a SessionCursor, which pins an immutable snapshot of the
+ *   store's segments, so live sessions are never locked or copied
+ * - Output streams through a small buffer as CSV, JSON Lines (one object
+ *   per session, kicks included) or a binary columnar segment in the
+ *   SessionStore layout
+ * - Progress is readable at any time; cancel() stops between sessions
+ *
+ * The file is written under a temporary name and renamed when complete,
+ * so a partial export never appears at the target path.
+ */
+class SessionExporter {
+public:
+    enum class Format {
+        CSV,
+        JSON_LINES,
+        COLUMNAR    // Loadable as a SessionStore segment
+    };
+
+    struct Progress {
+        uint64_t totalSessions = 0;
+        uint64_t exportedSessions = 0;
+        uint64_t bytesWritten = 0;
+        bool running = false;
+        bool succeeded = false;
+
+        float getFraction() const {
+            return totalSessions > 0 ? static_cast<float>(exportedSessions) / totalSessions : (running ? 0.0f : 1.0f);
+        }
+    };
+
+    SessionExporter();
+    ~SessionExporter();
+
+    SessionExporter(const SessionExporter&) = delete;
+    SessionExporter& operator=(const SessionExporter&) = delete;
+
+    // Called on the export thread to take the snapshot, so any waiting it
+    // does (e.g. flushing the journal) stays off the caller's thread
+    using Source = std::function<SessionCursor()>;
+
+    // Start an export; false if one is already running
+    bool start(const std::string& filepath, Format format, Source source);
+
+    // Stop at the next session; the partial file is removed
+    void cancel();
+
+    // Block until the current export finishes; true if it succeeded
+    bool wait();
+
+    Progress getProgress() const;
+
+private:
+    std::thread thread_;
+    std::atomic<bool> running_;
+    std::atomic<bool> cancelled_;
+    std::atomic<bool> succeeded_;
+    std::atomic<uint64_t> totalSessions_;
+    std::atomic<uint64_t> exportedSessions_;
+    std::atomic<uint64_t> bytesWritten_;
+
+    void exportThreadFunc(std::string filepath, Format format, Source source);
+    bool writeText(std::FILE* file, Format format, SessionCursor& cursor);
+    bool writeColumnar(const std::string& path, SessionCursor& cursor);
+};
+
+} // namespace kiosk
+} // namespace kinect
@@ -0,0 +1,485 @@
+#include "SessionJournal.h"
+#include "../core/BinaryRecord.h"
+#include "../core/MappedFile.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+
+namespace fs = std::filesystem;
+
+namespace kinect {
+namespace kiosk {
+
+namespace {
+
+// File format. Fields are stored in host byte order (little-endian on every
+// kiosk target).
+//
+// File:    [FileHeader][record]...
+// Record:  [u32 payload length][u32 CRC-32 of payload][payload]
+// Payload: i64 start us, i64 end us, u32 player, u8 challenge, u8 jersey,
+//          u8 background, u8 shared, u8 result challenge, i32 score,
+//          i32 max score, f32 accuracy, f32 avg power, i32 successful kicks,
+//          i32 total kicks, u64 duration ms, u16 id length,
+//          u16 share method length, u16 url length, u16 kick count,
+//          id, share method, url, kicks
+// Kick:    u8 type, f32 power, f32 direction, f32 accuracy,
+//          f32x3 foot position, f32x3 foot velocity, u64 timestamp,
+//          u32 player, f32x3 predicted impact, f32 ball speed
+
+constexpr uint32_t FILE_MAGIC = 0x4A53464Bu;   // "KFSJ"
+constexpr uint32_t FORMAT_VERSION = 1;
+
+constexpr size_t PAYLOAD_FIXED_SIZE = 8 + 8 + 4 + 1 + 1 + 1 + 1 + 1 + 4 + 4 + 4 + 4 + 4 + 4 + 8 + 2 + 2 + 2 + 2;
+constexpr size_t KICK_SIZE = 1 + 4 + 4 + 4 + 12 + 12 + 8 + 4 + 12 + 4;
+constexpr size_t MAX_PAYLOAD_SIZE = PAYLOAD_FIXED_SIZE + 3 * 0xFFFF + 0xFFFF * KICK_SIZE;
+
+struct FileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t sequence;
+};
+
+const char* const FILE_PREFIX = "sessions-";
+const char* const FILE_SUFFIX = ".log";
+
+using core::fromMicroseconds;
+using core::get;
+using core::put;
+using core::RECORD_HEADER_SIZE;
+using core::syncFile;
+using core::toMicroseconds;
+
+void putFloat3(std::string& out, const k4a_float3_t& value) {
+    put(out, value.xyz.x);
+    put(out, value.xyz.y);
+    put(out, value.xyz.z);
+}
+
+k4a_float3_t getFloat3(const uint8_t*& p) {
+    k4a_float3_t value;
+    value.xyz.x = get<float>(p);
+    value.xyz.y = get<float>(p);
+    value.xyz.z = get<float>(p);
+    return value;
+}
+
+uint16_t clampLength(size_t length) {
+    return static_cast<uint16_t>(std::min<size_t>(length, 0xFFFF));
+}
+
+void encodeRecord(const SessionData& session, std::string& out) {
+    const ChallengeResult& result = session.result;
+    uint16_t idLength = clampLength(session.sessionId.size());
+    uint16_t methodLength = clampLength(session.shareMethod.size());
+    uint16_t urlLength = clampLength(session.downloadUrl.size());
+    uint16_t kickCount = clampLength(result.kicks.size());
+
+    size_t headerAt = core::beginRecord(out);
+    put(out, toMicroseconds(session.startTime));
+    put(out, toMicroseconds(session.endTime));
+    put(out, session.playerId);
+    put(out, static_cast<uint8_t>(session.selectedChallenge));
+    put(out, static_cast<uint8_t>(session.selectedJersey));
+    put(out, static_cast<uint8_t>(session.selectedBackground));
+    put(out, static_cast<uint8_t>(session.wasShared ? 1 : 0));
+    put(out, static_cast<uint8_t>(result.challenge));
+    put(out, static_cast<int32_t>(result.score));
+    put(out, static_cast<int32_t>(result.maxScore));
+    put(out, result.accuracy);
+    put(out, result.avgPower);
+    put(out, static_cast<int32_t>(result.successfulKicks));
+    put(out, static_cast<int32_t>(result.totalKicks));
+    put(out, result.durationMs);
+    put(out, idLength);
+    put(out, methodLength);
+    put(out, urlLength);
+    put(out, kickCount);
+    out.append(session.sessionId.data(), idLength);
+    out.append(session.shareMethod.data(), methodLength);
+    out.append(session.downloadUrl.data(), urlLength);
+
+    for (uint16_t i = 0; i < kickCount; ++i) {
+        const KickData& kick = result.kicks[i];
+        put(out, static_cast<uint8_t>(kick.type));
+        put(out, kick.power);
+        put(out, kick.direction);
+        put(out, kick.accuracy);
+        putFloat3(out, kick.footPosition);
+        putFloat3(out, kick.footVelocity);
+        put(out, kick.timestamp);
+        put(out, kick.playerId);
+        putFloat3(out, kick.predictedImpactPoint);
+        put(out, kick.estimatedBallSpeed);
+    }
+    core::endRecord(out, headerAt);
+}
+
+// Decode one record at data[offset]; advances offset on success
+bool decodeRecord(const uint8_t* data, size_t size, size_t& offset, SessionData& session) {
+    const uint8_t* p = nullptr;
+    uint32_t payloadLength = 0;
+    if (!core::readRecord(data, size, offset, PAYLOAD_FIXED_SIZE, MAX_PAYLOAD_SIZE, p, payloadLength)) {
+        return false;
+    }
+
+    ChallengeResult& result = session.result;
+    session.startTime = fromMicroseconds(get<int64_t>(p));
+    session.endTime = fromMicroseconds(get<int64_t>(p));
+    session.playerId = get<uint32_t>(p);
+    session.selectedChallenge = static_cast<ChallengeType>(get<uint8_t>(p));
+    session.selectedJersey = static_cast<JerseyColor>(get<uint8_t>(p));
+    session.selectedBackground = static_cast<BackgroundTheme>(get<uint8_t>(p));
+    session.wasShared = get<uint8_t>(p) != 0;
+    result.challenge = static_cast<ChallengeType>(get<uint8_t>(p));
+    result.score = get<int32_t>(p);
+    result.maxScore = get<int32_t>(p);
+    result.accuracy = get<float>(p);
+    result.avgPower = get<float>(p);
+    result.successfulKicks = get<int32_t>(p);
+    result.totalKicks = get<int32_t>(p);
+    result.durationMs = get<uint64_t>(p);
+    uint16_t idLength = get<uint16_t>(p);
+    uint16_t methodLength = get<uint16_t>(p);
+    uint16_t urlLength = get<uint16_t>(p);
+    uint16_t kickCount = get<uint16_t>(p);
+    if (PAYLOAD_FIXED_SIZE + idLength + methodLength + urlLength + kickCount * KICK_SIZE != payloadLength) {
+        return false;
+    }
+
+    const char* text = reinterpret_cast<const char*>(p);
+    session.sessionId.assign(text, idLength);
+    session.shareMethod.assign(text + idLength, methodLength);
+    session.downloadUrl.assign(text + idLength + methodLength, urlLength);
+    p += idLength + methodLength + urlLength;
+
+    result.kicks.resize(kickCount);
+    for (KickData& kick : result.kicks) {
+        kick.type = static_cast<KickType>(get<uint8_t>(p));
+        kick.power = get<float>(p);
+        kick.direction = get<float>(p);
+        kick.accuracy = get<float>(p);
+        kick.footPosition = getFloat3(p);
+        kick.footVelocity = getFloat3(p);
+        kick.timestamp = get<uint64_t>(p);
+        kick.playerId = get<uint32_t>(p);
+        kick.predictedImpactPoint = getFloat3(p);
+        kick.estimatedBallSpeed = get<float>(p);
+    }
+
+    offset += RECORD_HEADER_SIZE + payloadLength;
+    return true;
+}
+
+// One journal file -> visitor. validBytes ends at the last intact record.
+bool readFile(const std::string& path, const SessionJournal::Visitor& visitor,
+              size_t& validBytes, size_t& fileBytes) {
+    validBytes = 0;
+    fileBytes = 0;
+
+    core::MappedFile file(path);
+    if (!file.isOpen()) {
+        return false;
+    }
+    fileBytes = file.size();
+    if (file.size() < sizeof(FileHeader)) {
+        return false;
+    }
+
+    const uint8_t* data = file.data();
+    const uint8_t* p = data;
+    FileHeader header = get<FileHeader>(p);
+    if (header.magic != FILE_MAGIC || header.version != FORMAT_VERSION) {
+        return false;
+    }
+
+    size_t offset = sizeof(FileHeader);
+    SessionData session;
+    while (offset < file.size() && decodeRecord(data, file.size(), offset, session)) {
+        if (visitor) {
+            visitor(session);
+        }
+    }
+    validBytes = offset;
+    return true;
+}
+
+} // namespace
+
+SessionJournal::SessionJournal()
+    : heartbeat_(nullptr)
+    , running_(false)
+    , queued_(0)
+    , written_(0)
+    , dropped_(0)
+    , failed_(0)
+    , syncs_(0)
+    , recoveredTornBytes_(0)
+    , writtenCounter_(core::MetricsRegistry::global().counter("kinect_journal_sessions_written_total", "Sessions written to the journal"))
+    , droppedCounter_(core::MetricsRegistry::global().counter("kinect_journal_sessions_dropped_total", "Sessions refused because the journal queue was full"))
+    , failedCounter_(core::MetricsRegistry::global().counter("kinect_journal_sessions_failed_total", "Sessions lost to journal write errors"))
+    , syncHistogram_(core::MetricsRegistry::global().histogram("kinect_journal_sync_seconds", "Time to sync the journal file to disk",
+                                                               core::Histogram::latencyBounds(), 1e-6))
+    , file_(nullptr)
+    , fileSequence_(0)
+    , fileBytes_(0)
+    , unsynced_(false)
+{
+}
+
+SessionJournal::~SessionJournal() {
+    close();
+}
+
+std::string SessionJournal::filePath(const std::string& directory, uint64_t sequence) {
+    return (fs::path(directory) / (FILE_PREFIX + std::to_string(sequence) + FILE_SUFFIX)).string();
+}
+
+std::vector<uint64_t> SessionJournal::listFiles(const std::string& directory) {
+    return core::listNumberedFiles(directory, FILE_PREFIX, FILE_SUFFIX);
+}
+
+bool SessionJournal::open(const std::string& directory, const Config& config) {
+    if (isOpen()) {
+        return false;
+    }
+
+    config_ = config;
+    directory_ = directory;
+    std::error_code ec;
+    fs::create_directories(directory_, ec);
+    if (!fs::is_directory(directory_, ec)) {
+        LOG_ERROR("Session journal directory unavailable: " << directory_);
+        return false;
+    }
+
+    // Older files were synced before rotating away from them; only the
+    // newest can end in a torn record
+    recoveredTornBytes_ = 0;
+    std::vector<uint64_t> sequences = listFiles(directory_);
+    uint64_t sequence = sequences.empty() ? 1 : sequences.back();
+    size_t validBytes = 0;
+    if (!sequences.empty()) {
+        size_t fileBytes = 0;
+        readFile(filePath(directory_, sequence), nullptr, validBytes, fileBytes);
+        recoveredTornBytes_ = fileBytes - validBytes;
+        if (validBytes < sizeof(FileHeader)) {
+            sequence++;  // Unreadable header: leave it for inspection
+            validBytes = 0;
+        }
+    }
+    if (recoveredTornBytes_ > 0) {
+        LOG_WARN("Session journal: dropping " << recoveredTornBytes_ << " bytes of torn record");
+    }
+
+    if (!openFile(sequence, validBytes)) {
+        LOG_ERROR("Failed to open session journal: " << filePath(directory_, sequence));
+        return false;
+    }
+
+    lastSync_ = std::chrono::steady_clock::now();
+    running_.store(true, std::memory_order_release);
+    writerThread_ = std::thread(&SessionJournal::writerThreadFunc, this);
+    return true;
+}
+
+void SessionJournal::close() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+
+    if (writerThread_.joinable()) {
+        writerThread_.join();
+    }
+
+    if (file_) {
+        sync();
+        std::fclose(file_);
+        file_ = nullptr;
+    }
+}
+
+bool SessionJournal::submit(const SessionData& session) {
+    if (!isOpen() || !queue_.push(session)) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        droppedCounter_.inc();
+        return false;
+    }
+    queued_.fetch_add(1, std::memory_order_release);
+    return true;
+}
+
+void SessionJournal::flush() {
+    uint64_t target = queued_.load(std::memory_order_acquire);
+    while (isOpen() && written_.load(std::memory_order_acquire) +
+                       failed_.load(std::memory_order_acquire) < target) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+bool SessionJournal::readAll(const std::string& directory, const Visitor& visitor) {
+    std::error_code ec;
+    if (!fs::is_directory(directory, ec)) {
+        return false;
+    }
+
+    for (uint64_t sequence : listFiles(directory)) {
+        size_t validBytes = 0;
+        size_t fileBytes = 0;
+        readFile(filePath(directory, sequence), visitor, validBytes, fileBytes);
+    }
+    return true;
+}
+
+bool SessionJournal::read(const std::string& directory, uint64_t sequence, const Visitor& visitor) {
+    size_t validBytes = 0;
+    size_t fileBytes = 0;
+    return readFile(filePath(directory, sequence), visitor, validBytes, fileBytes);
+}
+
+void SessionJournal::writerThreadFunc() {
+    std::string buffer;
+    SessionData session;
+
+    for (;;) {
+        // Read the flag first so sessions queued before close() are drained
+        bool stopping = !running_.load(std::memory_order_acquire);
+
+        buffer.clear();
+        size_t count = 0;
+        // At most one queue's worth, so a busy producer cannot grow a batch past rotation
+        while (count < QUEUE_SIZE && queue_.pop(session)) {
+            encodeRecord(session, buffer);
+            count++;
+        }
+        const char* marker = "idle";
+        if (count > 0) {
+            writeBatch(buffer, count);
+            marker = "write";
+        }
+
+        auto sinceSync = std::chrono::steady_clock::now() - lastSync_;
+        if (unsynced_ && (config_.syncIntervalMs == 0 ||
+                          sinceSync >= std::chrono::milliseconds(config_.syncIntervalMs))) {
+            sync();
+            marker = "sync";
+        }
+
+        if (Heartbeat* heartbeat = heartbeat_.load(std::memory_order_acquire)) {
+            heartbeat->beat(marker);
+        }
+
+        if (stopping) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(std::max<uint32_t>(1, config_.writeIntervalMs)));
+    }
+}
+
+bool SessionJournal::writeBatch(const std::string& buffer, size_t count) {
+    if (fileBytes_ > sizeof(FileHeader) && fileBytes_ + buffer.size() > config_.maxFileBytes) {
+        rotate();
+    }
+
+    // Flushed to the OS per batch, so a process crash loses nothing; a
+    // power loss loses at most one sync interval
+    bool ok = file_ && std::fwrite(buffer.data(), 1, buffer.size(), file_) == buffer.size() &&
+              std::fflush(file_) == 0;
+    if (ok) {
+        fileBytes_ += buffer.size();
+        unsynced_ = true;
+        written_.fetch_add(count, std::memory_order_release);
+        writtenCounter_.inc(count);
+    } else {
+        failed_.fetch_add(count, std::memory_order_release);
+        failedCounter_.inc(count);
+        rewindFile();
+    }
+    return ok;
+}
+
+bool SessionJournal::rewindFile() {
+    // Part of the failed batch may be on disk. Recovery stops at that torn
+    // record, so sessions appended after it would be lost; cut the file
+    // back to the last whole batch instead
+    if (file_) {
+        std::fclose(file_);
+        file_ = nullptr;
+    }
+    if (openFile(fileSequence_, fileBytes_)) {
+        return true;
+    }
+
+    // Cannot cut it: seal it there and continue in the next file, which
+    // is read on its own
+    return rotate();
+}
+
+bool SessionJournal::openFile(uint64_t sequence, size_t validBytes) {
+    std::string path = filePath(directory_, sequence);
+
+    if (validBytes >= sizeof(FileHeader)) {
+        // Existing file: drop any torn tail and append after it
+        if (!core::truncateTail(path, validBytes)) {
+            return false;
+        }
+        file_ = std::fopen(path.c_str(), "ab");
+        fileBytes_ = validBytes;
+    } else {
+        file_ = std::fopen(path.c_str(), "wb");
+        if (file_) {
+            FileHeader header{FILE_MAGIC, FORMAT_VERSION, sequence};
+            std::fwrite(&header, sizeof(header), 1, file_);
+            syncFile(file_);
+        }
+        fileBytes_ = sizeof(FileHeader);
+    }
+
+    fileSequence_ = sequence;
+    return file_ != nullptr;
+}
+
+bool SessionJournal::rotate() {
+    if (file_) {
+        sync();
+        std::fclose(file_);
+        file_ = nullptr;
+    }
+    uint64_t sealed = fileSequence_;
+    if (!openFile(sealed + 1, 0)) {
+        return false;
+    }
+    if (onSealed_) {
+        onSealed_(sealed);
+    }
+    pruneFiles();
+    return true;
+}
+
+void SessionJournal::sync() {
+    auto start = std::chrono::steady_clock::now();
+    if (file_) {
+        syncFile(file_);
+        syncs_.fetch_add(1, std::memory_order_relaxed);
+    }
+    unsynced_ = false;
+    lastSync_ = std::chrono::steady_clock::now();
+    syncHistogram_.record(static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(lastSync_ - start).count()));
+}
+
+void SessionJournal::pruneFiles() {
+    if (config_.maxFiles == 0) {
+        return;
+    }
+
+    std::vector<uint64_t> sequences = listFiles(directory_);
+    std::error_code ec;
+    for (size_t i = 0; i + config_.maxFiles < sequences.size(); ++i) {
+        fs::remove(filePath(directory_, sequences[i]), ec);
+    }
+}
+
+} // namespace kiosk
+} // namespace kinect
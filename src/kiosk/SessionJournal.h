@@ -0,0 +1,125 @@
+#pragma once
+
+#include "../../include/common.h"
+#include "../core/SpscQueue.h"
+#include "../core/Metrics.h"
+#include "Heartbeat.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <thread>
+
+namespace kinect {
+namespace kiosk {
+
+/**
+ * SessionJournal persists finished sessions off the game thread:
+ * - submit() copies the session onto a lock-free queue and returns
+ * - A writer thread batches queued sessions into one append per wake-up
+ * - Records go to sessions-<n>.log, rotated by size
+ * - The journal is flushed to the OS every batch and fsynced on a cadence
+ *
+ * Every record carries its length and a CRC-32, so a record torn by a
+ * crash or power loss is detected and cut off when the journal is next
+ * opened; everything before it is kept.
+ */
+class SessionJournal {
+public:
+    static constexpr size_t QUEUE_SIZE = 256;
+
+    // Configuration
+    struct Config {
+        size_t maxFileBytes = 4 * 1024 * 1024;   // Rotate to a new file past this size
+        size_t maxFiles = 0;                     // Rotated files kept (0 = keep all)
+        uint32_t writeIntervalMs = 50;           // Writer wake-up period; batches collect in between
+        uint32_t syncIntervalMs = 1000;          // fsync cadence (0 = every batch)
+    };
+
+    SessionJournal();
+    ~SessionJournal();
+
+    SessionJournal(const SessionJournal&) = delete;
+    SessionJournal& operator=(const SessionJournal&) = delete;
+
+    // Open (or create) the journal in directory and start the writer thread
+    bool open(const std::string& directory, const Config& config);
+
+    // Drain the queue, fsync and stop the writer thread
+    void close();
+
+    // Queue a session for the writer thread. Never blocks on disk; returns
+    // false and counts a drop if the queue is full. Calls must not overlap
+    // (SessionManager submits under sessionsMutex_).
+    bool submit(const SessionData& session);
+
+    // Wait until every queued session has been written
+    void flush();
+
+    bool isOpen() const { return running_.load(std::memory_order_acquire); }
+
+    // Called on the writer thread once a file is full, synced and closed
+    // (set before open())
+    using SealedCallback = std::function<void(uint64_t sequence)>;
+    void setOnSealed(SealedCallback callback) { onSealed_ = callback; }
+
+    // Writer thread beats after every pass (any time; nullptr stops)
+    void setHeartbeat(Heartbeat* heartbeat) { heartbeat_.store(heartbeat, std::memory_order_release); }
+
+    // Read every intact record in directory, oldest first
+    using Visitor = std::function<void(const SessionData& session)>;
+    static bool readAll(const std::string& directory, const Visitor& visitor);
+
+    // Read the intact records of one file; files are numbered in order
+    static bool read(const std::string& directory, uint64_t sequence, const Visitor& visitor);
+    static std::vector<uint64_t> listFiles(const std::string& directory);
+    static std::string filePath(const std::string& directory, uint64_t sequence);
+
+    // Statistics
+    uint64_t getWrittenCount() const { return written_.load(std::memory_order_relaxed); }
+    uint64_t getDroppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+    uint64_t getFailedCount() const { return failed_.load(std::memory_order_relaxed); }
+    uint64_t getSyncCount() const { return syncs_.load(std::memory_order_relaxed); }
+    size_t getRecoveredTornBytes() const { return recoveredTornBytes_; }
+
+private:
+    Config config_;
+    std::string directory_;
+    SealedCallback onSealed_;
+    std::atomic<Heartbeat*> heartbeat_;
+
+    core::SpscQueue<SessionData, QUEUE_SIZE> queue_;
+    std::thread writerThread_;
+    std::atomic<bool> running_;
+
+    std::atomic<uint64_t> queued_;
+    std::atomic<uint64_t> written_;
+    std::atomic<uint64_t> dropped_;   // Queue full
+    std::atomic<uint64_t> failed_;    // Write errors
+    std::atomic<uint64_t> syncs_;
+    size_t recoveredTornBytes_;
+
+    // Metrics
+    core::Counter& writtenCounter_;
+    core::Counter& droppedCounter_;
+    core::Counter& failedCounter_;
+    core::Histogram& syncHistogram_;
+
+    // Writer thread state
+    std::FILE* file_;
+    uint64_t fileSequence_;
+    size_t fileBytes_;
+    bool unsynced_;
+    std::chrono::steady_clock::time_point lastSync_;
+
+    void writerThreadFunc();
+    bool writeBatch(const std::string& buffer, size_t count);
+    bool rewindFile();
+    bool openFile(uint64_t sequence, size_t validBytes);
+    bool rotate();
+    void sync();
+    void pruneFiles();
+};
+
+} // namespace kiosk
+} // namespace kinect
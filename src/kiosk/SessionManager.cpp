@@ -11,11 +11,16 @@ namespace kiosk {
 
 SessionManager::SessionManager()
     : activePlayerId_(0)
+    , startedCounter_(core::MetricsRegistry::global().counter("kinect_sessions_started_total", "Sessions started"))
+    , completedCounter_(core::MetricsRegistry::global().counter(HealthMetrics::SESSIONS_COMPLETED, "Sessions completed"))
+    , cancelledCounter_(core::MetricsRegistry::global().counter("kinect_sessions_cancelled_total", "Sessions cancelled or timed out"))
+    , motionEvents_(nullptr)
 {
-    analytics_.firstSession = std::chrono::system_clock::now();
 }
 
 SessionManager::~SessionManager() {
+    exporter_.wait();
+    journal_.close();
 }
 
 bool SessionManager::initialize(const Config& config) {
@@ -25,6 +30,7 @@ bool SessionManager::initialize(const Config& config) {
     LOG_INFO("  Session timeout: " << config_.sessionTimeoutSeconds << "s");
     LOG_INFO("  Storage path: " << config_.sessionStoragePath);
     LOG_INFO("  Analytics: " << (config_.enableAnalytics ? "enabled" : "disabled"));
+    LOG_INFO("  Persistence: " << (config_.enablePersistence ? "enabled" : "disabled"));
 
     // Create storage directory if it doesn't exist
     if (!config_.sessionStoragePath.empty()) {
@@ -34,42 +40,54 @@ bool SessionManager::initialize(const Config& config) {
             LOG_ERROR("Failed to create session storage directory: " << e.what());
             return false;
         }
+
+        if (config_.enablePersistence) {
+            if (!store_.open(config_.sessionStoragePath)) {
+                return false;
+            }
+            journal_.setOnSealed([this](uint64_t sequence) { store_.buildSegment(sequence); });
+            if (!journal_.open(config_.sessionStoragePath, config_.journal)) {
+                return false;
+            }
+        }
     }
 
     return true;
 }
 
 std::string SessionManager::startSession(uint32_t playerId) {
-    std::scoped_lock lock(activeMutex_, sessionsMutex_);
+    SessionData session;
+    bool replaced;
+    {
+        std::scoped_lock lock(activeMutex_, sessionsMutex_);
 
-    // End any existing active session
-    if (!activeSessionId_.empty()) {
-        LOG_WARN("Starting new session while one is active, ending previous");
+        // End any existing active session
         // Note: Don't call endSession here as it would deadlock
-    }
+        replaced = !activeSessionId_.empty();
 
-    // Create new session
-    SessionData session;
-    session.sessionId = util::generateSessionId();
-    session.playerId = playerId;
-    session.startTime = std::chrono::system_clock::now();
+        // Create new session
+        session.sessionId = util::generateSessionId();
+        session.playerId = playerId;
+        session.startTime = std::chrono::system_clock::now();
 
-    // Store session
-    sessions_[session.sessionId] = session;
-    sessionHistory_.push_back(session.sessionId);
+        // Store session
+        sessions_[session.sessionId] = session;
+        sessionHistory_.push_back(session.sessionId);
 
-    // Set as active
-    activeSessionId_ = session.sessionId;
-    activePlayerId_ = playerId;
-    lastPlayerUpdate_ = std::chrono::steady_clock::now();
+        // Set as active
+        activeSessionId_ = session.sessionId;
+        activePlayerId_ = playerId;
+        lastPlayerUpdate_ = std::chrono::steady_clock::now();
 
-    // Update analytics
-    {
-        std::lock_guard<std::mutex> analyticsLock(analyticsMutex_);
-        analytics_.totalSessions++;
-        analytics_.lastSession = session.startTime;
+        // Update analytics
+        analytics_.recordStart(session.startTime);
+        startedCounter_.inc();
     }
 
+    // Logging flushes the console; keep it outside the locks
+    if (replaced) {
+        LOG_WARN("Starting new session while one is active, ending previous");
+    }
     logSessionStart(session);
 
     LOG_INFO("Session started: " << session.sessionId << " for player " << playerId);
@@ -78,38 +96,47 @@ std::string SessionManager::startSession(uint32_t playerId) {
 }
 
 void SessionManager::endSession(const std::string& sessionId, const ChallengeResult& result) {
-    std::scoped_lock lock(activeMutex_, sessionsMutex_);
+    SessionData session;
+    bool queued = true;
+    {
+        std::scoped_lock lock(activeMutex_, sessionsMutex_);
 
-    auto it = sessions_.find(sessionId);
-    if (it == sessions_.end()) {
-        LOG_WARN("Attempted to end non-existent session: " << sessionId);
-        return;
-    }
+        auto it = sessions_.find(sessionId);
+        if (it == sessions_.end()) {
+            LOG_WARN("Attempted to end non-existent session: " << sessionId);
+            return;
+        }
 
-    SessionData& session = it->second;
-    session.endTime = std::chrono::system_clock::now();
-    session.result = result;
+        it->second.endTime = std::chrono::system_clock::now();
+        it->second.result = result;
 
-    // Update analytics
-    updateAnalytics(session);
+        // Pruning below may drop the entry; the log needs a copy
+        session = it->second;
 
-    // Save to disk
-    if (config_.enableLogging) {
-        saveSession(session);
-    }
+        // Update analytics
+        analytics_.recordCompleted(session);
+        completedCounter_.inc();
 
-    // Clear active session
-    if (activeSessionId_ == sessionId) {
-        activeSessionId_.clear();
-        activePlayerId_ = 0;
+        // Queue for the journal writer; no disk I/O on this thread
+        queued = !journal_.isOpen() || journal_.submit(session);
+
+        // Clear active session
+        if (activeSessionId_ == sessionId) {
+            activeSessionId_.clear();
+            activePlayerId_ = 0;
+        }
+
+        // Prune old sessions
+        pruneOldSessions();
     }
 
+    // Logging flushes the console; keep it outside the locks
+    if (!queued) {
+        LOG_WARN("Session journal queue full, session not saved: " << sessionId);
+    }
     logSessionEnd(session);
 
     LOG_INFO("Session ended: " << sessionId);
-
-    // Prune old sessions
-    pruneOldSessions();
 }
 
 void SessionManager::cancelSession(const std::string& sessionId) {
@@ -125,10 +152,8 @@ void SessionManager::cancelSession(const std::string& sessionId) {
     session.endTime = std::chrono::system_clock::now();
 
     // Update analytics
-    {
-        std::lock_guard<std::mutex> analyticsLock(analyticsMutex_);
-        analytics_.cancelledSessions++;
-    }
+    analytics_.recordCancelled();
+    cancelledCounter_.inc();
 
     // Clear active session
     if (activeSessionId_ == sessionId) {
@@ -216,89 +241,122 @@ void SessionManager::setShareData(const std::string& sessionId,
         it->second.downloadUrl = url;
 
         // Update analytics
-        {
-            std::lock_guard<std::mutex> analyticsLock(analyticsMutex_);
-            analytics_.sharedSessions++;
-            analytics_.shareMethodCounts[method]++;
-        }
+        analytics_.recordShare(method);
 
         LOG_INFO("Share data set for session " << sessionId << ": " << method);
     }
 }
 
+void SessionManager::recordKick() {
+    analytics_.recordKick();
+}
+
+bool SessionManager::subscribe(motion::MotionEventBus& bus) {
+    motionEvents_ = bus.subscribe("session", motion::motionEventBit(motion::MotionEventType::Kick) |
+                                                 motion::motionEventBit(motion::MotionEventType::PlayerEnter));
+    if (!motionEvents_) {
+        LOG_ERROR("No free motion event subscriber slot for session tracking");
+        return false;
+    }
+    return true;
+}
+
+void SessionManager::pollMotionEvents() {
+    if (!motionEvents_) {
+        return;
+    }
+
+    motion::MotionEvent event;
+    while (motionEvents_->poll(event)) {
+        if (event.type == motion::MotionEventType::Kick) {
+            recordKick();
+        } else if (!hasActiveSession()) {
+            // A player walking up opens the session its first kick is timed from
+            startSession(event.player.bodyId);
+        } else {
+            updatePlayerPresence(event.player.bodyId);
+        }
+    }
+}
+
 SessionManager::Analytics SessionManager::getAnalytics() const {
-    std::lock_guard<std::mutex> lock(analyticsMutex_);
-    return analytics_;
+    SessionAnalytics::Snapshot snapshot = analytics_.snapshot();
+
+    Analytics analytics;
+    analytics.totalSessions = snapshot.totalSessions;
+    analytics.completedSessions = snapshot.completedSessions;
+    analytics.cancelledSessions = snapshot.cancelledSessions;
+    analytics.sharedSessions = snapshot.sharedSessions;
+    analytics.challengeCounts = snapshot.challengeCounts;
+    analytics.shareMethodCounts = snapshot.shareMethodCounts;
+    analytics.firstSession = snapshot.firstSession;
+    analytics.lastSession = snapshot.lastSession;
+
+    // Histogram units -> reported units
+    auto distribution = [&](SessionAnalytics::Metric metric, float scale) {
+        const core::HdrHistogram& histogram = snapshot.histograms[metric];
+        Distribution result;
+        result.count = histogram.getTotalCount();
+        result.mean = static_cast<float>(histogram.getMean()) * scale;
+        result.p50 = histogram.getValueAtPercentile(50.0) * scale;
+        result.p90 = histogram.getValueAtPercentile(90.0) * scale;
+        result.p99 = histogram.getValueAtPercentile(99.0) * scale;
+        result.max = histogram.getMax() * scale;
+        return result;
+    };
+    analytics.sessionDurationSeconds = distribution(SessionAnalytics::SESSION_DURATION, 0.001f);
+    analytics.scorePercent = distribution(SessionAnalytics::SCORE, 0.1f);
+    analytics.kickSpeedKmh = distribution(SessionAnalytics::KICK_SPEED, 0.1f);
+    analytics.timeToFirstKickSeconds = distribution(SessionAnalytics::TIME_TO_FIRST_KICK, 0.001f);
+
+    analytics.avgSessionDurationSeconds = analytics.sessionDurationSeconds.mean;
+    analytics.avgScore = analytics.scorePercent.mean;
+    return analytics;
 }
 
-void SessionManager::resetAnalytics() {
-    std::lock_guard<std::mutex> lock(analyticsMutex_);
+SessionAnalytics::Snapshot SessionManager::getAnalyticsSnapshot() const {
+    return analytics_.snapshot();
+}
 
-    analytics_ = Analytics();
-    analytics_.firstSession = std::chrono::system_clock::now();
+void SessionManager::resetAnalytics() {
+    analytics_.reset();
 
     LOG_INFO("Analytics reset");
 }
 
 std::vector<SessionData> SessionManager::getRecentSessions(size_t count) const {
-    std::lock_guard<std::mutex> lock(sessionsMutex_);
+    // Read from the store, not sessions_: no session lock, and only the
+    // rows returned are copied
+    SessionCursor cursor = querySessions(SessionQuery());
+    uint64_t total = cursor.countRemaining();
+    uint64_t skip = total > count ? total - count : 0;
 
     std::vector<SessionData> recent;
-    recent.reserve(std::min(count, sessionHistory_.size()));
-
-    // Iterate from end (most recent)
-    auto it = sessionHistory_.rbegin();
-    size_t added = 0;
-
-    while (it != sessionHistory_.rend() && added < count) {
-        auto sessionIt = sessions_.find(*it);
-        if (sessionIt != sessions_.end()) {
-            recent.push_back(sessionIt->second);
-            added++;
+    recent.reserve(static_cast<size_t>(total - skip));
+    for (uint64_t index = 0; cursor.next(); ++index) {
+        if (index >= skip) {
+            recent.push_back(cursor.row().toSessionData());
         }
-        ++it;
     }
 
+    // Most recent first
+    std::reverse(recent.begin(), recent.end());
     return recent;
 }
 
-void SessionManager::exportSessions(const std::string& filepath) const {
-    std::lock_guard<std::mutex> lock(sessionsMutex_);
-
-    try {
-        std::ofstream file(filepath);
-        if (!file.is_open()) {
-            LOG_ERROR("Failed to open file for export: " << filepath);
-            return;
-        }
-
-        // Write header
-        file << "SessionID,PlayerID,StartTime,EndTime,Challenge,Score,Accuracy,Shared,ShareMethod\n";
-
-        // Write sessions
-        for (const auto& sessionId : sessionHistory_) {
-            auto it = sessions_.find(sessionId);
-            if (it == sessions_.end()) continue;
-
-            const SessionData& session = it->second;
-
-            file << session.sessionId << ","
-                 << session.playerId << ","
-                 << std::chrono::system_clock::to_time_t(session.startTime) << ","
-                 << std::chrono::system_clock::to_time_t(session.endTime) << ","
-                 << static_cast<int>(session.selectedChallenge) << ","
-                 << session.result.score << ","
-                 << session.result.accuracy << ","
-                 << (session.wasShared ? "1" : "0") << ","
-                 << session.shareMethod << "\n";
-        }
-
-        file.close();
-        LOG_INFO("Exported " << sessionHistory_.size() << " sessions to " << filepath);
-
-    } catch (const std::exception& e) {
-        LOG_ERROR("Failed to export sessions: " << e.what());
+bool SessionManager::exportSessions(const std::string& filepath,
+                                    SessionExporter::Format format,
+                                    const SessionQuery& query) {
+    if (!journal_.isOpen()) {
+        LOG_ERROR("Cannot export sessions: session journal not open");
+        return false;
     }
+
+    // The flush and snapshot run on the export thread
+    return exporter_.start(filepath, format, [this, query]() {
+        journal_.flush();
+        return store_.query(query);
+    });
 }
 
 void SessionManager::checkTimeouts() {
@@ -332,69 +390,6 @@ void SessionManager::setTimeoutCallback(TimeoutCallback callback) {
     timeoutCallback_ = callback;
 }
 
-void SessionManager::updateAnalytics(const SessionData& session) {
-    std::lock_guard<std::mutex> lock(analyticsMutex_);
-
-    analytics_.completedSessions++;
-    analytics_.challengeCounts[session.selectedChallenge]++;
-
-    // Update averages
-    uint64_t total = analytics_.completedSessions;
-    if (total > 0) {
-        // Running average for duration
-        float sessionDuration = session.getDurationMs() / 1000.0f;
-        analytics_.avgSessionDurationSeconds =
-            ((analytics_.avgSessionDurationSeconds * (total - 1)) + sessionDuration) / total;
-
-        // Running average for score
-        float score = session.result.getPercentage();
-        analytics_.avgScore =
-            ((analytics_.avgScore * (total - 1)) + score) / total;
-    }
-}
-
-void SessionManager::saveSession(const SessionData& session) {
-    if (config_.sessionStoragePath.empty()) {
-        return;
-    }
-
-    try {
-        // Create filename with timestamp
-        auto time_t = std::chrono::system_clock::to_time_t(session.startTime);
-        std::tm tm;
-        localtime_s(&tm, &time_t);
-
-        char filename[64];
-        std::strftime(filename, sizeof(filename), "%Y%m%d_%H%M%S", &tm);
-
-        std::string filepath = config_.sessionStoragePath + "/" +
-                              std::string(filename) + "_" +
-                              session.sessionId + ".json";
-
-        std::ofstream file(filepath);
-        if (!file.is_open()) {
-            LOG_ERROR("Failed to save session to file: " << filepath);
-            return;
-        }
-
-        // Write session data as JSON (simplified)
-        file << "{\n";
-        file << "  \"sessionId\": \"" << session.sessionId << "\",\n";
-        file << "  \"playerId\": " << session.playerId << ",\n";
-        file << "  \"challenge\": " << static_cast<int>(session.selectedChallenge) << ",\n";
-        file << "  \"score\": " << session.result.score << ",\n";
-        file << "  \"accuracy\": " << session.result.accuracy << ",\n";
-        file << "  \"duration_ms\": " << session.getDurationMs() << ",\n";
-        file << "  \"shared\": " << (session.wasShared ? "true" : "false") << "\n";
-        file << "}\n";
-
-        file.close();
-
-    } catch (const std::exception& e) {
-        LOG_ERROR("Failed to save session: " << e.what());
-    }
-}
-
 void SessionManager::pruneOldSessions() {
     if (sessionHistory_.size() <= config_.maxStoredSessions) {
         return;
@@ -1,6 +1,11 @@
 #pragma once
 
 #include "../../include/common.h"
+#include "../motion/MotionEventBus.h"
+#include "SessionAnalytics.h"
+#include "SessionExporter.h"
+#include "SessionJournal.h"
+#include "SessionStore.h"
 #include <unordered_map>
 #include <map>
 #include <deque>
@@ -30,7 +35,9 @@ public:
         size_t maxStoredSessions = 1000;
         std::string sessionStoragePath = "./sessions";
         bool enableAnalytics = true;
-        bool enableLogging = true;
+        bool enableLogging = true;        // Session start/end in the log
+        bool enablePersistence = true;    // Journal and store under sessionStoragePath
+        SessionJournal::Config journal;   // Finished sessions, written off-thread
     };
 
     // Initialize manager
@@ -60,7 +67,28 @@ public:
                           JerseyColor jersey,
                           BackgroundTheme background);
 
-    // Analytics
+    // Player kicked in the active session; times the first kick. Lock-free,
+    // safe to call from the game thread on every kick.
+    void recordKick();
+
+    // Take kicks and player presence from the motion pipeline (the kiosk's
+    // Application::getEventBus()). pollMotionEvents() drains them into
+    // recordKick() and updatePlayerPresence(), and starts a session when a
+    // player enters with none active; call it from one thread only.
+    bool subscribe(motion::MotionEventBus& bus);
+    void pollMotionEvents();
+
+    // Analytics. Distributions come from histograms, so percentiles are
+    // within about 3%; means are exact.
+    struct Distribution {
+        uint64_t count = 0;
+        float mean = 0.0f;
+        float p50 = 0.0f;
+        float p90 = 0.0f;
+        float p99 = 0.0f;
+        float max = 0.0f;
+    };
+
     struct Analytics {
         uint64_t totalSessions = 0;
         uint64_t completedSessions = 0;
@@ -73,16 +101,42 @@ public:
         float avgSessionDurationSeconds = 0.0f;
         float avgScore = 0.0f;
 
+        Distribution sessionDurationSeconds;
+        Distribution scorePercent;
+        Distribution kickSpeedKmh;
+        Distribution timeToFirstKickSeconds;
+
         std::chrono::system_clock::time_point firstSession;
         std::chrono::system_clock::time_point lastSession;
     };
 
+    // Neither blocks session calls or the game thread
     Analytics getAnalytics() const;
+    SessionAnalytics::Snapshot getAnalyticsSnapshot() const;   // Raw, mergeable histograms
     void resetAnalytics();
 
-    // Session history
+    // Last `count` persisted sessions, most recent first (any thread; reads
+    // the store, so sessions appear once the journal writer has them)
     std::vector<SessionData> getRecentSessions(size_t count) const;
-    void exportSessions(const std::string& filepath) const;
+
+    // Export persisted sessions on a background thread, from a snapshot of
+    // the store; never blocks session calls. False if an export is running
+    // or nothing is persisted (empty sessionStoragePath or persistence off).
+    bool exportSessions(const std::string& filepath,
+                        SessionExporter::Format format = SessionExporter::Format::CSV,
+                        const SessionQuery& query = SessionQuery());
+    SessionExporter::Progress getExportProgress() const { return exporter_.getProgress(); }
+    bool waitForExport() { return exporter_.wait(); }
+
+    // Persisted sessions (empty sessionStoragePath or persistence off: closed)
+    const SessionJournal& getJournal() const { return journal_; }
+    void flushJournal() { journal_.flush(); }
+    void setJournalHeartbeat(Heartbeat* heartbeat) { journal_.setHeartbeat(heartbeat); }
+
+    // Full persisted history, newest sessions included (any thread)
+    SessionCursor querySessions(const SessionQuery& query) const { return store_.query(query); }
+    SessionAggregate aggregateSessions(const SessionQuery& query) const { return store_.aggregate(query); }
+    const SessionStore& getStore() const { return store_; }
 
     // Timeout management
     void checkTimeouts();
@@ -105,16 +159,24 @@ private:
     mutable std::mutex sessionsMutex_;
 
     // Analytics
-    Analytics analytics_;
-    mutable std::mutex analyticsMutex_;
+    SessionAnalytics analytics_;
+    core::Counter& startedCounter_;
+    core::Counter& completedCounter_;
+    core::Counter& cancelledCounter_;
+
+    // Persistence; the journal's writer thread feeds sealed files to the store
+    SessionStore store_;
+    SessionJournal journal_;
+    SessionExporter exporter_;
+
+    // Motion events; nullptr until subscribe()
+    motion::MotionSubscription* motionEvents_;
 
     // Callbacks
     TimeoutCallback timeoutCallback_;
     std::mutex callbackMutex_;
 
     // Internal helpers
-    void updateAnalytics(const SessionData& session);
-    void saveSession(const SessionData& session);
     void pruneOldSessions();
     bool isSessionTimedOut(const SessionData& session) const;
 
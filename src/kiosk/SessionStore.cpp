@@ -0,0 +1,727 @@
+#include "SessionStore.h"
+#include "SessionJournal.h"
+#include "../core/BinaryRecord.h"
+#include "../core/MappedFile.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <set>
+
+namespace fs = std::filesystem;
+
+namespace kinect {
+namespace kiosk {
+
+namespace {
+
+// Segment file: [SegmentHeader][ColumnEntry x COLUMN_COUNT][columns]
+// Each column starts on an 8-byte boundary. Session columns hold one value
+// per row; KICK_BEGIN and the string offset columns hold rows + 1 offsets
+// into the kick columns and string bytes. Fields are in host byte order.
+
+constexpr uint32_t SEGMENT_MAGIC = 0x4353464Bu;   // "KFSC"
+constexpr uint32_t FORMAT_VERSION = 1;
+
+enum Column : uint32_t {
+    START_US,            // i64, sorted
+    END_US,              // i64
+    PLAYER_ID,           // u32
+    CHALLENGE,           // u8
+    JERSEY,              // u8
+    BACKGROUND,          // u8
+    SHARED,              // u8
+    RESULT_CHALLENGE,    // u8
+    SCORE,               // i32
+    MAX_SCORE,           // i32
+    ACCURACY,            // f32
+    AVG_POWER,           // f32
+    SUCCESSFUL_KICKS,    // i32
+    TOTAL_KICKS,         // i32
+    RESULT_DURATION_MS,  // u64
+    KICK_BEGIN,          // u32, rows + 1
+    ID_OFFSETS,          // u32, rows + 1
+    ID_BYTES,
+    METHOD_OFFSETS,      // u32, rows + 1
+    METHOD_BYTES,
+    URL_OFFSETS,         // u32, rows + 1
+    URL_BYTES,
+    KICK_TYPE,           // u8
+    KICK_POWER,          // f32
+    KICK_DIRECTION,      // f32
+    KICK_ACCURACY,       // f32
+    KICK_FOOT_POSITION,  // f32 x3
+    KICK_FOOT_VELOCITY,  // f32 x3
+    KICK_TIMESTAMP,      // u64
+    KICK_PLAYER_ID,      // u32
+    KICK_IMPACT_POINT,   // f32 x3
+    KICK_BALL_SPEED,     // f32
+    COLUMN_COUNT
+};
+
+struct SegmentHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t sequence;
+    uint32_t rowCount;
+    uint32_t kickCount;
+    int64_t minStartUs;
+    int64_t maxStartUs;
+    uint32_t challengeMask;
+    uint32_t columnCount;
+};
+
+struct ColumnEntry {
+    uint64_t offset;
+    uint64_t length;
+    uint32_t crc;
+    uint32_t reserved;
+};
+
+const char* const SEGMENT_PREFIX = "segment-";
+const char* const SEGMENT_SUFFIX = ".col";
+
+using core::fromMicroseconds;
+using core::syncFile;
+using core::toMicroseconds;
+
+// Column-at-a-time segment builder
+class SegmentWriter {
+public:
+    explicit SegmentWriter(std::string& out) : out_(out), entries_() {
+        out_.assign(sizeof(SegmentHeader) + sizeof(ColumnEntry) * COLUMN_COUNT, '\0');
+    }
+
+    template<typename T, typename Value>
+    void column(Column column, size_t count, Value value) {
+        begin(column);
+        for (size_t i = 0; i < count; ++i) {
+            T item = value(i);
+            out_.append(reinterpret_cast<const char*>(&item), sizeof(T));
+        }
+        end(column);
+    }
+
+    void bytes(Column column, const std::string& data) {
+        begin(column);
+        out_.append(data);
+        end(column);
+    }
+
+    void finish(const SegmentHeader& header) {
+        std::memcpy(&out_[0], &header, sizeof(header));
+        std::memcpy(&out_[sizeof(header)], entries_.data(), sizeof(ColumnEntry) * COLUMN_COUNT);
+    }
+
+private:
+    std::string& out_;
+    std::array<ColumnEntry, COLUMN_COUNT> entries_;
+
+    void begin(Column column) {
+        out_.resize((out_.size() + 7) & ~size_t(7), '\0');
+        entries_[column].offset = out_.size();
+    }
+
+    void end(Column column) {
+        ColumnEntry& entry = entries_[column];
+        entry.length = out_.size() - entry.offset;
+        entry.crc = core::crc32(reinterpret_cast<const uint8_t*>(out_.data()) + entry.offset,
+                                static_cast<size_t>(entry.length));
+    }
+};
+
+struct Float3 {
+    float v[3];
+};
+
+Float3 toFloat3(const k4a_float3_t& value) {
+    return Float3{{value.xyz.x, value.xyz.y, value.xyz.z}};
+}
+
+// Sessions -> segment bytes; sorts sessions by start time
+void encodeSegment(std::vector<SessionData>& sessions, uint64_t sequence, std::string& out) {
+    std::stable_sort(sessions.begin(), sessions.end(), [](const SessionData& a, const SessionData& b) {
+        return a.startTime < b.startTime;
+    });
+
+    SegmentHeader header{};
+    header.magic = SEGMENT_MAGIC;
+    header.version = FORMAT_VERSION;
+    header.sequence = sequence;
+    header.rowCount = static_cast<uint32_t>(sessions.size());
+    header.columnCount = COLUMN_COUNT;
+    header.minStartUs = sessions.empty() ? 0 : toMicroseconds(sessions.front().startTime);
+    header.maxStartUs = sessions.empty() ? 0 : toMicroseconds(sessions.back().startTime);
+
+    std::vector<uint32_t> kickBegin{0};
+    std::vector<const KickData*> kicks;
+    std::string ids, methods, urls;
+    std::vector<uint32_t> idOffsets{0}, methodOffsets{0}, urlOffsets{0};
+    for (const SessionData& session : sessions) {
+        for (const KickData& kick : session.result.kicks) {
+            kicks.push_back(&kick);
+        }
+        kickBegin.push_back(static_cast<uint32_t>(kicks.size()));
+        ids += session.sessionId;
+        idOffsets.push_back(static_cast<uint32_t>(ids.size()));
+        methods += session.shareMethod;
+        methodOffsets.push_back(static_cast<uint32_t>(methods.size()));
+        urls += session.downloadUrl;
+        urlOffsets.push_back(static_cast<uint32_t>(urls.size()));
+        header.challengeMask |= SessionQuery::challengeBit(session.selectedChallenge);
+    }
+    header.kickCount = static_cast<uint32_t>(kicks.size());
+
+    size_t rows = sessions.size();
+    auto at = [&](size_t i) -> const SessionData& { return sessions[i]; };
+    auto kick = [&](size_t i) -> const KickData& { return *kicks[i]; };
+
+    SegmentWriter writer(out);
+    writer.column<int64_t>(START_US, rows, [&](size_t i) { return toMicroseconds(at(i).startTime); });
+    writer.column<int64_t>(END_US, rows, [&](size_t i) { return toMicroseconds(at(i).endTime); });
+    writer.column<uint32_t>(PLAYER_ID, rows, [&](size_t i) { return at(i).playerId; });
+    writer.column<uint8_t>(CHALLENGE, rows, [&](size_t i) { return static_cast<uint8_t>(at(i).selectedChallenge); });
+    writer.column<uint8_t>(JERSEY, rows, [&](size_t i) { return static_cast<uint8_t>(at(i).selectedJersey); });
+    writer.column<uint8_t>(BACKGROUND, rows, [&](size_t i) { return static_cast<uint8_t>(at(i).selectedBackground); });
+    writer.column<uint8_t>(SHARED, rows, [&](size_t i) { return static_cast<uint8_t>(at(i).wasShared ? 1 : 0); });
+    writer.column<uint8_t>(RESULT_CHALLENGE, rows, [&](size_t i) { return static_cast<uint8_t>(at(i).result.challenge); });
+    writer.column<int32_t>(SCORE, rows, [&](size_t i) { return static_cast<int32_t>(at(i).result.score); });
+    writer.column<int32_t>(MAX_SCORE, rows, [&](size_t i) { return static_cast<int32_t>(at(i).result.maxScore); });
+    writer.column<float>(ACCURACY, rows, [&](size_t i) { return at(i).result.accuracy; });
+    writer.column<float>(AVG_POWER, rows, [&](size_t i) { return at(i).result.avgPower; });
+    writer.column<int32_t>(SUCCESSFUL_KICKS, rows, [&](size_t i) { return static_cast<int32_t>(at(i).result.successfulKicks); });
+    writer.column<int32_t>(TOTAL_KICKS, rows, [&](size_t i) { return static_cast<int32_t>(at(i).result.totalKicks); });
+    writer.column<uint64_t>(RESULT_DURATION_MS, rows, [&](size_t i) { return at(i).result.durationMs; });
+    writer.column<uint32_t>(KICK_BEGIN, rows + 1, [&](size_t i) { return kickBegin[i]; });
+    writer.column<uint32_t>(ID_OFFSETS, rows + 1, [&](size_t i) { return idOffsets[i]; });
+    writer.bytes(ID_BYTES, ids);
+    writer.column<uint32_t>(METHOD_OFFSETS, rows + 1, [&](size_t i) { return methodOffsets[i]; });
+    writer.bytes(METHOD_BYTES, methods);
+    writer.column<uint32_t>(URL_OFFSETS, rows + 1, [&](size_t i) { return urlOffsets[i]; });
+    writer.bytes(URL_BYTES, urls);
+
+    size_t kickRows = kicks.size();
+    writer.column<uint8_t>(KICK_TYPE, kickRows, [&](size_t i) { return static_cast<uint8_t>(kick(i).type); });
+    writer.column<float>(KICK_POWER, kickRows, [&](size_t i) { return kick(i).power; });
+    writer.column<float>(KICK_DIRECTION, kickRows, [&](size_t i) { return kick(i).direction; });
+    writer.column<float>(KICK_ACCURACY, kickRows, [&](size_t i) { return kick(i).accuracy; });
+    writer.column<Float3>(KICK_FOOT_POSITION, kickRows, [&](size_t i) { return toFloat3(kick(i).footPosition); });
+    writer.column<Float3>(KICK_FOOT_VELOCITY, kickRows, [&](size_t i) { return toFloat3(kick(i).footVelocity); });
+    writer.column<uint64_t>(KICK_TIMESTAMP, kickRows, [&](size_t i) { return kick(i).timestamp; });
+    writer.column<uint32_t>(KICK_PLAYER_ID, kickRows, [&](size_t i) { return kick(i).playerId; });
+    writer.column<Float3>(KICK_IMPACT_POINT, kickRows, [&](size_t i) { return toFloat3(kick(i).predictedImpactPoint); });
+    writer.column<float>(KICK_BALL_SPEED, kickRows, [&](size_t i) { return kick(i).estimatedBallSpeed; });
+    writer.finish(header);
+}
+
+} // namespace
+
+// Mapped (or, for a journal tail, in-memory) segment with typed column views
+class SessionSegment {
+public:
+    static std::shared_ptr<const SessionSegment> map(const std::string& path) {
+        auto segment = std::make_shared<SessionSegment>();
+        segment->file_ = std::make_unique<core::MappedFile>(path);
+        if (!segment->file_->isOpen() || !segment->parse(segment->file_->data(), segment->file_->size())) {
+            return nullptr;
+        }
+        return segment;
+    }
+
+    static std::shared_ptr<const SessionSegment> fromBytes(std::string bytes) {
+        auto segment = std::make_shared<SessionSegment>();
+        segment->bytes_ = std::move(bytes);
+        if (!segment->parse(reinterpret_cast<const uint8_t*>(segment->bytes_.data()), segment->bytes_.size())) {
+            return nullptr;
+        }
+        return segment;
+    }
+
+    template<typename T>
+    const T* column(Column column) const {
+        return reinterpret_cast<const T*>(data_ + columns_[column].offset);
+    }
+
+    std::string_view text(Column offsets, Column bytes, uint32_t row) const {
+        const uint32_t* offset = column<uint32_t>(offsets);
+        return std::string_view(column<char>(bytes) + offset[row], offset[row + 1] - offset[row]);
+    }
+
+    uint32_t getRowCount() const { return header_.rowCount; }
+    int64_t getMinStartUs() const { return header_.minStartUs; }
+    int64_t getMaxStartUs() const { return header_.maxStartUs; }
+    uint32_t getChallengeMask() const { return header_.challengeMask; }
+
+    // Rows with start time in [fromUs, toUs)
+    void range(int64_t fromUs, int64_t toUs, uint32_t& begin, uint32_t& end) const {
+        const int64_t* start = column<int64_t>(START_US);
+        begin = static_cast<uint32_t>(std::lower_bound(start, start + header_.rowCount, fromUs) - start);
+        end = static_cast<uint32_t>(std::lower_bound(start + begin, start + header_.rowCount, toUs) - start);
+    }
+
+    bool overlaps(int64_t fromUs, int64_t toUs, uint32_t challengeMask) const {
+        return header_.rowCount > 0 && header_.minStartUs < toUs && header_.maxStartUs >= fromUs &&
+               (header_.challengeMask & challengeMask) != 0;
+    }
+
+private:
+    std::unique_ptr<core::MappedFile> file_;
+    std::string bytes_;
+    const uint8_t* data_ = nullptr;
+    SegmentHeader header_{};
+    std::array<ColumnEntry, COLUMN_COUNT> columns_{};
+
+    bool parse(const uint8_t* data, size_t size) {
+        if (!data || size < sizeof(SegmentHeader) + sizeof(ColumnEntry) * COLUMN_COUNT) {
+            return false;
+        }
+        std::memcpy(&header_, data, sizeof(header_));
+        std::memcpy(columns_.data(), data + sizeof(header_), sizeof(ColumnEntry) * COLUMN_COUNT);
+        if (header_.magic != SEGMENT_MAGIC || header_.version != FORMAT_VERSION ||
+            header_.columnCount != COLUMN_COUNT) {
+            return false;
+        }
+
+        // Every column in bounds, intact and the size its type implies
+        uint64_t rows = header_.rowCount;
+        uint64_t kicks = header_.kickCount;
+        for (uint32_t c = 0; c < COLUMN_COUNT; ++c) {
+            const ColumnEntry& entry = columns_[c];
+            if (entry.offset % 8 != 0 || entry.offset > size || entry.length > size - entry.offset ||
+                core::crc32(data + entry.offset, static_cast<size_t>(entry.length)) != entry.crc) {
+                return false;
+            }
+        }
+        auto sized = [&](Column c, uint64_t count, size_t width) { return columns_[c].length == count * width; };
+        bool ok = sized(START_US, rows, 8) && sized(END_US, rows, 8) && sized(PLAYER_ID, rows, 4) &&
+                  sized(CHALLENGE, rows, 1) && sized(JERSEY, rows, 1) && sized(BACKGROUND, rows, 1) &&
+                  sized(SHARED, rows, 1) && sized(RESULT_CHALLENGE, rows, 1) && sized(SCORE, rows, 4) &&
+                  sized(MAX_SCORE, rows, 4) && sized(ACCURACY, rows, 4) && sized(AVG_POWER, rows, 4) &&
+                  sized(SUCCESSFUL_KICKS, rows, 4) && sized(TOTAL_KICKS, rows, 4) &&
+                  sized(RESULT_DURATION_MS, rows, 8) && sized(KICK_BEGIN, rows + 1, 4) &&
+                  sized(ID_OFFSETS, rows + 1, 4) && sized(METHOD_OFFSETS, rows + 1, 4) &&
+                  sized(URL_OFFSETS, rows + 1, 4) && sized(KICK_TYPE, kicks, 1) && sized(KICK_POWER, kicks, 4) &&
+                  sized(KICK_DIRECTION, kicks, 4) && sized(KICK_ACCURACY, kicks, 4) &&
+                  sized(KICK_FOOT_POSITION, kicks, 12) && sized(KICK_FOOT_VELOCITY, kicks, 12) &&
+                  sized(KICK_TIMESTAMP, kicks, 8) && sized(KICK_PLAYER_ID, kicks, 4) &&
+                  sized(KICK_IMPACT_POINT, kicks, 12) && sized(KICK_BALL_SPEED, kicks, 4);
+        if (!ok) {
+            return false;
+        }
+
+        data_ = data;
+
+        // Offsets must stay inside their byte and kick columns
+        const uint32_t* kickBegin = column<uint32_t>(KICK_BEGIN);
+        if (kickBegin[rows] != kicks) {
+            return false;
+        }
+        const Column strings[][2] = {{ID_OFFSETS, ID_BYTES}, {METHOD_OFFSETS, METHOD_BYTES}, {URL_OFFSETS, URL_BYTES}};
+        for (const auto& pair : strings) {
+            const uint32_t* offsets = column<uint32_t>(pair[0]);
+            for (uint64_t r = 0; r < rows; ++r) {
+                if (offsets[r] > offsets[r + 1] || kickBegin[r] > kickBegin[r + 1]) {
+                    return false;
+                }
+            }
+            if (offsets[rows] != columns_[pair[1]].length) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+// SessionRow
+
+std::chrono::system_clock::time_point SessionRow::getStartTime() const {
+    return fromMicroseconds(segment_->column<int64_t>(START_US)[row_]);
+}
+
+std::chrono::system_clock::time_point SessionRow::getEndTime() const {
+    return fromMicroseconds(segment_->column<int64_t>(END_US)[row_]);
+}
+
+uint32_t SessionRow::getPlayerId() const {
+    return segment_->column<uint32_t>(PLAYER_ID)[row_];
+}
+
+ChallengeType SessionRow::getChallenge() const {
+    return static_cast<ChallengeType>(segment_->column<uint8_t>(CHALLENGE)[row_]);
+}
+
+JerseyColor SessionRow::getJersey() const {
+    return static_cast<JerseyColor>(segment_->column<uint8_t>(JERSEY)[row_]);
+}
+
+BackgroundTheme SessionRow::getBackground() const {
+    return static_cast<BackgroundTheme>(segment_->column<uint8_t>(BACKGROUND)[row_]);
+}
+
+bool SessionRow::wasShared() const {
+    return segment_->column<uint8_t>(SHARED)[row_] != 0;
+}
+
+int32_t SessionRow::getScore() const {
+    return segment_->column<int32_t>(SCORE)[row_];
+}
+
+int32_t SessionRow::getMaxScore() const {
+    return segment_->column<int32_t>(MAX_SCORE)[row_];
+}
+
+float SessionRow::getAccuracy() const {
+    return segment_->column<float>(ACCURACY)[row_];
+}
+
+float SessionRow::getAvgPower() const {
+    return segment_->column<float>(AVG_POWER)[row_];
+}
+
+uint64_t SessionRow::getDurationMs() const {
+    const int64_t* start = segment_->column<int64_t>(START_US);
+    const int64_t* end = segment_->column<int64_t>(END_US);
+    return end[row_] > start[row_] ? static_cast<uint64_t>(end[row_] - start[row_]) / 1000 : 0;
+}
+
+std::string_view SessionRow::getSessionId() const {
+    return segment_->text(ID_OFFSETS, ID_BYTES, row_);
+}
+
+std::string_view SessionRow::getShareMethod() const {
+    return segment_->text(METHOD_OFFSETS, METHOD_BYTES, row_);
+}
+
+std::string_view SessionRow::getDownloadUrl() const {
+    return segment_->text(URL_OFFSETS, URL_BYTES, row_);
+}
+
+size_t SessionRow::getKickCount() const {
+    const uint32_t* begin = segment_->column<uint32_t>(KICK_BEGIN);
+    return begin[row_ + 1] - begin[row_];
+}
+
+KickData SessionRow::getKick(size_t index) const {
+    size_t k = segment_->column<uint32_t>(KICK_BEGIN)[row_] + index;
+    auto float3 = [&](Column column) {
+        const Float3& value = segment_->column<Float3>(column)[k];
+        return k4a_float3_t{{value.v[0], value.v[1], value.v[2]}};
+    };
+
+    KickData kick;
+    kick.type = static_cast<KickType>(segment_->column<uint8_t>(KICK_TYPE)[k]);
+    kick.power = segment_->column<float>(KICK_POWER)[k];
+    kick.direction = segment_->column<float>(KICK_DIRECTION)[k];
+    kick.accuracy = segment_->column<float>(KICK_ACCURACY)[k];
+    kick.footPosition = float3(KICK_FOOT_POSITION);
+    kick.footVelocity = float3(KICK_FOOT_VELOCITY);
+    kick.timestamp = segment_->column<uint64_t>(KICK_TIMESTAMP)[k];
+    kick.playerId = segment_->column<uint32_t>(KICK_PLAYER_ID)[k];
+    kick.predictedImpactPoint = float3(KICK_IMPACT_POINT);
+    kick.estimatedBallSpeed = segment_->column<float>(KICK_BALL_SPEED)[k];
+    return kick;
+}
+
+SessionData SessionRow::toSessionData() const {
+    SessionData session;
+    session.sessionId = std::string(getSessionId());
+    session.playerId = getPlayerId();
+    session.startTime = getStartTime();
+    session.endTime = getEndTime();
+    session.selectedChallenge = getChallenge();
+    session.selectedJersey = getJersey();
+    session.selectedBackground = getBackground();
+    session.wasShared = wasShared();
+    session.shareMethod = std::string(getShareMethod());
+    session.downloadUrl = std::string(getDownloadUrl());
+
+    ChallengeResult& result = session.result;
+    result.challenge = static_cast<ChallengeType>(segment_->column<uint8_t>(RESULT_CHALLENGE)[row_]);
+    result.score = getScore();
+    result.maxScore = getMaxScore();
+    result.accuracy = getAccuracy();
+    result.avgPower = getAvgPower();
+    result.successfulKicks = segment_->column<int32_t>(SUCCESSFUL_KICKS)[row_];
+    result.totalKicks = segment_->column<int32_t>(TOTAL_KICKS)[row_];
+    result.durationMs = segment_->column<uint64_t>(RESULT_DURATION_MS)[row_];
+    result.kicks.reserve(getKickCount());
+    for (size_t i = 0; i < getKickCount(); ++i) {
+        result.kicks.push_back(getKick(i));
+    }
+    return session;
+}
+
+// SessionCursor
+
+bool SessionCursor::enterSegment() {
+    while (segment_ < segments_.size()) {
+        const SessionSegment& segment = *segments_[segment_];
+        if (segment.overlaps(fromUs_, toUs_, challengeMask_)) {
+            segment.range(fromUs_, toUs_, next_, end_);
+            if (next_ < end_) {
+                row_.segment_ = &segment;
+                return true;
+            }
+        }
+        segment_++;
+    }
+    return false;
+}
+
+uint64_t SessionCursor::countRemaining() const {
+    SessionCursor copy(*this);
+    uint64_t count = 0;
+    while (copy.next()) {
+        count++;
+    }
+    return count;
+}
+
+bool SessionCursor::next() {
+    if (!started_) {
+        started_ = true;
+        if (!enterSegment()) {
+            return false;
+        }
+    }
+
+    while (segment_ < segments_.size()) {
+        const uint8_t* challenge = segments_[segment_]->column<uint8_t>(CHALLENGE);
+        while (next_ < end_) {
+            uint32_t row = next_++;
+            if (challengeMask_ & (1u << challenge[row])) {
+                row_.row_ = row;
+                return true;
+            }
+        }
+        segment_++;
+        if (!enterSegment()) {
+            return false;
+        }
+    }
+    return false;
+}
+
+// SessionStore
+
+SessionStore::SessionStore()
+    : tailSequence_(0)
+    , tailBytes_(0)
+{
+}
+
+SessionStore::~SessionStore() {
+}
+
+std::string SessionStore::segmentPath(uint64_t sequence) const {
+    return (fs::path(directory_) / (SEGMENT_PREFIX + std::to_string(sequence) + SEGMENT_SUFFIX)).string();
+}
+
+bool SessionStore::open(const std::string& directory) {
+    directory_ = directory;
+    std::error_code ec;
+    fs::create_directories(directory_, ec);
+    if (!fs::is_directory(directory_, ec)) {
+        LOG_ERROR("Session store directory unavailable: " << directory_);
+        return false;
+    }
+
+    std::set<uint64_t> journals;
+    for (uint64_t sequence : SessionJournal::listFiles(directory_)) {
+        journals.insert(sequence);
+    }
+    uint64_t newestJournal = journals.empty() ? 0 : *journals.rbegin();
+
+    // Existing segments; damaged ones are rebuilt below if their journal remains
+    for (uint64_t sequence : core::listNumberedFiles(directory_, SEGMENT_PREFIX, SEGMENT_SUFFIX)) {
+        std::string path = segmentPath(sequence);
+        auto segment = SessionSegment::map(path);
+        if (segment) {
+            std::lock_guard<std::mutex> lock(segmentsMutex_);
+            segments_[sequence] = segment;
+        } else {
+            LOG_WARN("Session store: damaged segment " << path);
+        }
+    }
+
+    // Sealed journal files not yet converted (the process stopped first)
+    for (uint64_t sequence : journals) {
+        bool converted;
+        {
+            std::lock_guard<std::mutex> lock(segmentsMutex_);
+            converted = segments_.count(sequence) > 0;
+        }
+        if (sequence != newestJournal && !converted) {
+            buildSegment(sequence);
+        }
+    }
+
+    LOG_INFO("Session store: " << getSegmentCount() << " segments in " << directory_);
+    return true;
+}
+
+bool SessionStore::buildSegment(uint64_t sequence) {
+    std::vector<SessionData> sessions;
+    if (!SessionJournal::read(directory_, sequence, [&](const SessionData& session) {
+            sessions.push_back(session);
+        })) {
+        return false;
+    }
+
+    std::string path = segmentPath(sequence);
+    if (!writeSegment(sessions, sequence, path)) {
+        LOG_ERROR("Session store: failed to write " << path);
+        return false;
+    }
+
+    auto segment = SessionSegment::map(path);
+    if (!segment) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(segmentsMutex_);
+    segments_[sequence] = segment;
+    return true;
+}
+
+bool SessionStore::writeSegment(std::vector<SessionData>& sessions, uint64_t sequence, const std::string& path) {
+    std::string bytes;
+    encodeSegment(sessions, sequence, bytes);
+
+    // Write beside, then rename into place
+    std::string tempPath = path + ".tmp";
+    std::FILE* file = std::fopen(tempPath.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    bool ok = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    syncFile(file);
+    std::fclose(file);
+
+    std::error_code ec;
+    if (ok) {
+        fs::rename(tempPath, path, ec);
+        ok = !ec;
+    }
+    if (!ok) {
+        fs::remove(tempPath, ec);
+    }
+    return ok;
+}
+
+size_t SessionStore::getSegmentCount() const {
+    std::lock_guard<std::mutex> lock(segmentsMutex_);
+    return segments_.size();
+}
+
+std::vector<std::shared_ptr<const SessionSegment>> SessionStore::snapshot() const {
+    std::vector<std::shared_ptr<const SessionSegment>> segments;
+    std::set<uint64_t> sealed;
+    {
+        std::lock_guard<std::mutex> lock(segmentsMutex_);
+        segments.reserve(segments_.size() + 1);
+        for (const auto& pair : segments_) {
+            segments.push_back(pair.second);
+            sealed.insert(pair.first);
+        }
+    }
+
+    // Journal files without a segment (normally just the open one). Listed
+    // after the segments, so a file sealed in between is read here instead.
+    for (uint64_t sequence : SessionJournal::listFiles(directory_)) {
+        if (sealed.count(sequence) == 0) {
+            if (auto tail = loadTail(sequence)) {
+                segments.push_back(tail);
+            }
+        }
+    }
+    return segments;
+}
+
+std::shared_ptr<const SessionSegment> SessionStore::loadTail(uint64_t sequence) const {
+    std::error_code ec;
+    uint64_t bytes = fs::file_size(SessionJournal::filePath(directory_, sequence), ec);
+    if (ec) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(tailMutex_);
+    if (tail_ && tailSequence_ == sequence && tailBytes_ == bytes) {
+        return tail_;
+    }
+
+    std::vector<SessionData> sessions;
+    SessionJournal::read(directory_, sequence, [&](const SessionData& session) {
+        sessions.push_back(session);
+    });
+    std::string segmentBytes;
+    encodeSegment(sessions, sequence, segmentBytes);
+
+    tail_ = SessionSegment::fromBytes(std::move(segmentBytes));
+    tailSequence_ = sequence;
+    tailBytes_ = bytes;
+    return tail_;
+}
+
+SessionCursor SessionStore::query(const SessionQuery& query) const {
+    SessionCursor cursor;
+    cursor.segments_ = snapshot();
+    cursor.fromUs_ = toMicroseconds(query.from);
+    cursor.toUs_ = toMicroseconds(query.to);
+    cursor.challengeMask_ = query.challengeMask;
+    return cursor;
+}
+
+SessionAggregate SessionStore::aggregate(const SessionQuery& query) const {
+    SessionAggregate result;
+    int64_t fromUs = toMicroseconds(query.from);
+    int64_t toUs = toMicroseconds(query.to);
+    std::array<uint64_t, 32> challengeCounts{};
+
+    // Column at a time over each segment's matching row range
+    for (const auto& segment : snapshot()) {
+        if (!segment->overlaps(fromUs, toUs, query.challengeMask)) {
+            continue;
+        }
+        uint32_t begin = 0;
+        uint32_t end = 0;
+        segment->range(fromUs, toUs, begin, end);
+
+        const uint8_t* challenge = segment->column<uint8_t>(CHALLENGE);
+        const uint8_t* shared = segment->column<uint8_t>(SHARED);
+        const int32_t* score = segment->column<int32_t>(SCORE);
+        const float* accuracy = segment->column<float>(ACCURACY);
+        const int64_t* start = segment->column<int64_t>(START_US);
+        const int64_t* finish = segment->column<int64_t>(END_US);
+        const uint32_t* kickBegin = segment->column<uint32_t>(KICK_BEGIN);
+        const float* ballSpeed = segment->column<float>(KICK_BALL_SPEED);
+
+        for (uint32_t row = begin; row < end; ++row) {
+            if ((query.challengeMask & (1u << challenge[row])) == 0) {
+                continue;
+            }
+            result.sessions++;
+            result.shared += shared[row];
+            result.scoreSum += score[row];
+            result.maxScore = std::max(result.maxScore, score[row]);
+            result.accuracySum += accuracy[row];
+            result.durationMsSum += finish[row] > start[row] ? static_cast<uint64_t>(finish[row] - start[row]) / 1000 : 0;
+            challengeCounts[challenge[row] & 31]++;
+
+            result.kicks += kickBegin[row + 1] - kickBegin[row];
+            for (uint32_t k = kickBegin[row]; k < kickBegin[row + 1]; ++k) {
+                result.maxBallSpeed = std::max(result.maxBallSpeed, ballSpeed[k]);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < challengeCounts.size(); ++i) {
+        if (challengeCounts[i] > 0) {
+            result.challengeCounts[static_cast<ChallengeType>(i)] = challengeCounts[i];
+        }
+    }
+    return result;
+}
+
+} // namespace kiosk
+} // namespace kinect
@@ -0,0 +1,172 @@
+#pragma once
+
+#include "../../include/common.h"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string_view>
+
+namespace kinect {
+namespace kiosk {
+
+class SessionSegment;
+
+// Filters for SessionStore queries
+struct SessionQuery {
+    static constexpr uint32_t ALL_CHALLENGES = 0xFFFFFFFFu;
+
+    std::chrono::system_clock::time_point from = std::chrono::system_clock::time_point::min();  // Session start, inclusive
+    std::chrono::system_clock::time_point to = std::chrono::system_clock::time_point::max();    // Session start, exclusive
+    uint32_t challengeMask = ALL_CHALLENGES;                                                    // challengeBit() per type
+
+    static uint32_t challengeBit(ChallengeType type) { return 1u << static_cast<uint32_t>(type); }
+};
+
+// Totals over the sessions matching a query
+struct SessionAggregate {
+    uint64_t sessions = 0;
+    uint64_t kicks = 0;
+    uint64_t shared = 0;
+    int64_t scoreSum = 0;
+    int32_t maxScore = 0;
+    double accuracySum = 0.0;
+    uint64_t durationMsSum = 0;
+    float maxBallSpeed = 0.0f;
+    std::map<ChallengeType, uint64_t> challengeCounts;
+
+    double getMeanScore() const { return sessions > 0 ? static_cast<double>(scoreSum) / sessions : 0.0; }
+    double getMeanAccuracy() const { return sessions > 0 ? accuracySum / sessions : 0.0; }
+    double getMeanDurationSeconds() const { return sessions > 0 ? durationMsSum / 1000.0 / sessions : 0.0; }
+};
+
+/**
+ * One stored session, read column by column from its segment. Valid until
+ * the cursor that returned it advances or is destroyed.
+ */
+class SessionRow {
+public:
+    std::chrono::system_clock::time_point getStartTime() const;
+    std::chrono::system_clock::time_point getEndTime() const;
+    uint32_t getPlayerId() const;
+    ChallengeType getChallenge() const;
+    JerseyColor getJersey() const;
+    BackgroundTheme getBackground() const;
+    bool wasShared() const;
+    int32_t getScore() const;
+    int32_t getMaxScore() const;
+    float getAccuracy() const;
+    float getAvgPower() const;
+    uint64_t getDurationMs() const;
+
+    std::string_view getSessionId() const;
+    std::string_view getShareMethod() const;
+    std::string_view getDownloadUrl() const;
+
+    size_t getKickCount() const;
+    KickData getKick(size_t index) const;
+
+    // Full copy, kicks included
+    SessionData toSessionData() const;
+
+private:
+    friend class SessionCursor;
+
+    const SessionSegment* segment_ = nullptr;
+    uint32_t row_ = 0;
+};
+
+/**
+ * Streams the sessions matching a query, one row at a time, straight from
+ * the mapped segments. Sessions come segment by segment (the order they
+ * were journaled), ordered by start time within each segment.
+ */
+class SessionCursor {
+public:
+    SessionCursor() = default;
+
+    // Advance to the next matching session; false when there are no more
+    bool next();
+    const SessionRow& row() const { return row_; }
+
+    // Matching sessions after the current one (scans a copy)
+    uint64_t countRemaining() const;
+
+private:
+    friend class SessionStore;
+
+    std::vector<std::shared_ptr<const SessionSegment>> segments_;
+    int64_t fromUs_ = 0;
+    int64_t toUs_ = 0;
+    uint32_t challengeMask_ = SessionQuery::ALL_CHALLENGES;
+
+    size_t segment_ = 0;
+    uint32_t next_ = 0;   // Next row to test in the current segment
+    uint32_t end_ = 0;
+    bool started_ = false;
+    SessionRow row_;
+
+    bool enterSegment();
+};
+
+/**
+ * SessionStore keeps the full session history queryable without loading it:
+ * - Each SessionJournal file, once sealed, is rewritten as an immutable
+ *   columnar segment (segment-<n>.col beside sessions-<n>.log): one
+ *   8-byte-aligned array per field, rows sorted by start time, kicks in
+ *   their own columns
+ * - Segments are memory-mapped; a query touches only the columns and row
+ *   ranges it needs. Each segment's start-time range and challenge set
+ *   let whole segments be skipped
+ * - The journal file still being written is read as one small in-memory
+ *   segment, so queries always include the newest sessions
+ *
+ * Every column carries a CRC-32; a damaged segment is rebuilt from its
+ * journal file when that still exists, or left out.
+ */
+class SessionStore {
+public:
+    SessionStore();
+    ~SessionStore();
+
+    SessionStore(const SessionStore&) = delete;
+    SessionStore& operator=(const SessionStore&) = delete;
+
+    // Map existing segments and build any missing ones for sealed journal
+    // files (all but the newest)
+    bool open(const std::string& directory);
+
+    // Rewrite sealed journal file <sequence> as a segment (journal writer
+    // thread, via SessionJournal::setOnSealed)
+    bool buildSegment(uint64_t sequence);
+
+    // Write sessions (sorted in place by start time) as a segment file,
+    // synced and renamed into place
+    static bool writeSegment(std::vector<SessionData>& sessions, uint64_t sequence, const std::string& path);
+
+    // Queries (any thread)
+    SessionCursor query(const SessionQuery& query) const;
+    SessionAggregate aggregate(const SessionQuery& query) const;
+
+    size_t getSegmentCount() const;
+
+private:
+    std::string directory_;
+
+    // Sealed segments by journal sequence; queries copy the pointers
+    std::map<uint64_t, std::shared_ptr<const SessionSegment>> segments_;
+    mutable std::mutex segmentsMutex_;
+
+    // Last in-memory segment built from an open journal file, reused while
+    // that file has not grown
+    mutable std::shared_ptr<const SessionSegment> tail_;
+    mutable uint64_t tailSequence_;
+    mutable uint64_t tailBytes_;
+    mutable std::mutex tailMutex_;
+
+    std::vector<std::shared_ptr<const SessionSegment>> snapshot() const;
+    std::shared_ptr<const SessionSegment> loadTail(uint64_t sequence) const;
+    std::string segmentPath(uint64_t sequence) const;
+};
+
+} // namespace kiosk
+} // namespace kinect
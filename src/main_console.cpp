@@ -1,6 +1,7 @@
 #include "gui/Application.h"
 #include "kiosk/KioskManager.h"
 #include "kiosk/SessionManager.h"
+#include "core/StartupGraph.h"
 #include "../include/common.h"
 #include <iostream>
 #include <csignal>
@@ -45,7 +46,7 @@ int main(int argc, char** argv) {
     g_kioskManager = &kioskManager;
     g_sessionManager = &sessionManager;
 
-    // Initialize Session Manager
+    // Session Manager configuration
     SessionManager::Config sessionConfig;
     sessionConfig.sessionTimeoutSeconds = SESSION_TIMEOUT_SECONDS;
     sessionConfig.playerReidentificationSeconds = 5.0f;
@@ -53,13 +54,9 @@ int main(int argc, char** argv) {
     sessionConfig.sessionStoragePath = "./sessions";
     sessionConfig.enableAnalytics = true;
     sessionConfig.enableLogging = true;
+    sessionConfig.enablePersistence = true;
 
-    if (!sessionManager.initialize(sessionConfig)) {
-        LOG_ERROR("Failed to initialize SessionManager");
-        return 1;
-    }
-
-    // Initialize Kiosk Manager
+    // Kiosk Manager configuration
     KioskManager::Config kioskConfig;
     kioskConfig.healthCheckIntervalSeconds = 5.0f;
     kioskConfig.watchdogTimeoutSeconds = 30.0f;
@@ -67,22 +64,56 @@ int main(int argc, char** argv) {
     kioskConfig.maxConsecutiveErrors = 3;
     kioskConfig.enableAutoRecovery = true;
     kioskConfig.enableWatchdog = true;
-
-    if (!kioskManager.initialize(kioskConfig)) {
-        LOG_ERROR("Failed to initialize KioskManager");
+    kioskConfig.enableMetricsEndpoint = true;   // http://127.0.0.1:9464/metrics
+
+    // The managers do not depend on each other: journal recovery and the
+    // store open run alongside the kiosk manager and the application
+    using kinect::core::StartupGraph;
+    StartupGraph startup;
+    startup.add("session_manager", StartupGraph::Affinity::WORKER, {},
+                [&]() { return sessionManager.initialize(sessionConfig); });
+    startup.add("kiosk_manager", StartupGraph::Affinity::WORKER, {},
+                [&]() { return kioskManager.initialize(kioskConfig); });
+    startup.add("application", StartupGraph::Affinity::MAIN, {}, [&]() { return application.initialize(); });
+
+    if (!startup.wait()) {
+        LOG_ERROR("Startup failed\n" << startup.formatTimeline());
         return 1;
     }
+    LOG_INFO(startup.formatTimeline());
+
+    // Watch the session writer, the main loop and the Kinect pipeline; the
+    // capture and analysis slots arm once the Kinect finishes loading
+    sessionManager.setJournalHeartbeat(&kioskManager.getHeartbeat(PipelineStage::SESSION_IO));
+    application.setHeartbeats(&kioskManager.getHeartbeat(PipelineStage::GAME),
+                              &kioskManager.getHeartbeat(PipelineStage::RENDER));
+    application.setPipelineHeartbeats(&kioskManager.getHeartbeat(PipelineStage::CAPTURE),
+                                      &kioskManager.getHeartbeat(PipelineStage::TRACKER_ENQUEUE),
+                                      &kioskManager.getHeartbeat(PipelineStage::TRACKER_POP),
+                                      &kioskManager.getHeartbeat(PipelineStage::ANALYSIS));
+
+    // Load from the main loop and the pipeline drives the quality level,
+    // which the capture thread applies
+    application.setQualityGovernor(&kioskManager.getQualityGovernor());
+
+    // Sessions follow the players and kicks the analysis thread detects;
+    // the main loop drains them
+    if (sessionManager.subscribe(application.getEventBus())) {
+        application.setSessionManager(&sessionManager);
+    }
 
-    // Set up restart callback
+    // Kinect and tracker failures reconnect the device and keep the loaded
+    // tracker; the window and the UI stay up
+    kioskManager.setKinectRecoveryCallback([&application]() {
+        return application.onKinectRestart();
+    });
+
+    // Set up restart callback. The UI belongs to the main thread, so the
+    // monitor's restart is the same warm Kinect recovery
     kioskManager.setRestartCallback([&application]() {
         LOG_INFO("KioskManager requested restart");
-        application.shutdown();
-        std::this_thread::sleep_for(std::chrono::seconds(2));
-        if (application.initialize()) {
-            // Application will be restarted by main loop
-            LOG_INFO("Application reinitialized successfully");
-        } else {
-            LOG_ERROR("Failed to reinitialize application");
+        if (!application.onKinectRestart()) {
+            LOG_ERROR("Kinect recovery failed, staying in demo mode");
         }
     });
 
@@ -92,12 +123,6 @@ int main(int argc, char** argv) {
         sessionManager.cancelSession(sessionId);
     });
 
-    // Initialize Application
-    if (!application.initialize()) {
-        LOG_ERROR("Failed to initialize Application");
-        return 1;
-    }
-
     // Start Kiosk Manager
     kioskManager.start();
 
@@ -117,7 +142,9 @@ int main(int argc, char** argv) {
 
     // Export final session data
     LOG_INFO("Exporting session data...");
-    sessionManager.exportSessions("./sessions/export_final.csv");
+    if (sessionManager.exportSessions("./sessions/export_final.csv")) {
+        sessionManager.waitForExport();
+    }
 
     // Print final statistics
     auto kioskStats = kioskManager.getStatistics();
@@ -130,6 +157,7 @@ int main(int argc, char** argv) {
     LOG_INFO("  Total sessions: " << kioskStats.totalSessions);
     LOG_INFO("  Total errors: " << kioskStats.totalErrors);
     LOG_INFO("  Auto recoveries: " << kioskStats.autoRecoveries);
+    LOG_INFO("  Kinect reconnects: " << kioskStats.kinectRecoveries);
 
     LOG_INFO("Session Analytics:");
     LOG_INFO("  Total sessions: " << sessionAnalytics.totalSessions);
@@ -138,6 +166,14 @@ int main(int argc, char** argv) {
     LOG_INFO("  Shared: " << sessionAnalytics.sharedSessions);
     LOG_INFO("  Avg duration: " << sessionAnalytics.avgSessionDurationSeconds << "s");
     LOG_INFO("  Avg score: " << sessionAnalytics.avgScore << "%");
+    LOG_INFO("  Duration p50/p90/p99: " << sessionAnalytics.sessionDurationSeconds.p50 << "/"
+             << sessionAnalytics.sessionDurationSeconds.p90 << "/"
+             << sessionAnalytics.sessionDurationSeconds.p99 << "s");
+    LOG_INFO("  Score p50/p90/p99: " << sessionAnalytics.scorePercent.p50 << "/"
+             << sessionAnalytics.scorePercent.p90 << "/"
+             << sessionAnalytics.scorePercent.p99 << "%");
+    LOG_INFO("  Time to first kick p50/p90: " << sessionAnalytics.timeToFirstKickSeconds.p50 << "/"
+             << sessionAnalytics.timeToFirstKickSeconds.p90 << "s");
     LOG_INFO("========================================");
 
     // Clear global pointers
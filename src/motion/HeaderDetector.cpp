@@ -12,11 +12,16 @@ HeaderDetector::HeaderDetector()
     , headerDirection_{0.0f, 0.0f, 0.0f}
     , currentTimestamp_(0)
 {
-    currentSkeleton_ = {};
 }
 
 void HeaderDetector::processSkeleton(const k4abt_skeleton_t& skeleton, uint64_t timestamp) {
-    currentSkeleton_ = skeleton;
+    PoseFeatures pose(skeleton, timestamp);
+    processFrame(pose);
+}
+
+void HeaderDetector::processFrame(const PoseFeatures& pose) {
+    const k4abt_skeleton_t& skeleton = pose.getSkeleton();
+    uint64_t timestamp = pose.getTimestamp();
     currentTimestamp_ = timestamp;
 
     // Update motion histories for relevant joints
@@ -57,10 +62,12 @@ void HeaderDetector::processSkeleton(const k4abt_skeleton_t& skeleton, uint64_t
     );
 
     // Update phase state machine
-    updatePhase(timestamp);
+    updatePhase(pose);
 }
 
-void HeaderDetector::updatePhase(uint64_t timestamp) {
+void HeaderDetector::updatePhase(const PoseFeatures& pose) {
+    uint64_t timestamp = pose.getTimestamp();
+
     switch (currentPhase_) {
         case HeaderPhase::Idle:
             if (detectPreparation(headHistory_)) {
@@ -106,7 +113,7 @@ void HeaderDetector::updatePhase(uint64_t timestamp) {
         case HeaderPhase::Recovery:
             // Complete header after recovery period
             if (timestamp - phaseStartTime_ > 300000) { // 0.3 seconds
-                completeHeader();
+                completeHeader(pose);
                 reset();
             }
             break;
@@ -165,18 +172,13 @@ k4a_float3_t HeaderDetector::calculateHeaderDirection() const {
     return normalize(direction);
 }
 
-HeaderType HeaderDetector::classifyHeaderType(const k4abt_skeleton_t& skeleton,
+HeaderType HeaderDetector::classifyHeaderType(const PoseFeatures& pose,
                                                const MotionHistory& headHistory) {
     k4a_float3_t velocity = headHistory.getCurrentVelocity();
     float speed = magnitude(velocity);
 
-    // Get body position to determine diving vs standing
-    k4a_float3_t head = skeleton.joints[K4ABT_JOINT_HEAD].position;
-    k4a_float3_t pelvis = skeleton.joints[K4ABT_JOINT_PELVIS].position;
-    float bodyLean = angleBetweenVectors(
-        subtract(head, pelvis),
-        k4a_float3_t{0.0f, 1.0f, 0.0f} // Vertical
-    );
+    // Head-to-pelvis lean from vertical distinguishes diving from standing
+    float bodyLean = pose.getHeadLean();
 
     // Classification heuristics
     if (bodyLean > 45.0f) {
@@ -192,7 +194,7 @@ HeaderType HeaderDetector::classifyHeaderType(const k4abt_skeleton_t& skeleton,
     return HeaderType::PowerHeader; // Default
 }
 
-HeaderQuality HeaderDetector::analyzeHeaderQuality(const k4abt_skeleton_t& skeleton,
+HeaderQuality HeaderDetector::analyzeHeaderQuality(const PoseFeatures& pose,
                                                     const MotionHistory& headHistory,
                                                     HeaderType type) {
     HeaderQuality quality;
@@ -201,10 +203,10 @@ HeaderQuality HeaderDetector::analyzeHeaderQuality(const k4abt_skeleton_t& skele
     quality.headVelocity = peakHeadVelocity_;
 
     // Neck angle
-    quality.neckAngle = calculateNeckAngle(skeleton);
+    quality.neckAngle = pose.getNeckAngle();
 
     // Body alignment
-    quality.bodyAlignment = calculateBodyAlignment(skeleton);
+    quality.bodyAlignment = calculateBodyAlignment(pose);
 
     // Power score based on velocity
     quality.powerScore = std::min(100.0f, (quality.headVelocity / 4.0f) * 100.0f);
@@ -220,7 +222,7 @@ HeaderQuality HeaderDetector::analyzeHeaderQuality(const k4abt_skeleton_t& skele
     return quality;
 }
 
-void HeaderDetector::completeHeader() {
+void HeaderDetector::completeHeader(const PoseFeatures& pose) {
     if (!headerCallback_) {
         return;
     }
@@ -231,10 +233,10 @@ void HeaderDetector::completeHeader() {
     result.direction = headerDirection_;
 
     // Classify header type
-    result.type = classifyHeaderType(currentSkeleton_, headHistory_);
+    result.type = classifyHeaderType(pose, headHistory_);
 
     // Analyze quality
-    result.quality = analyzeHeaderQuality(currentSkeleton_, headHistory_, result.type);
+    result.quality = analyzeHeaderQuality(pose, headHistory_, result.type);
 
     headerCallback_(result);
 }
@@ -246,26 +248,9 @@ void HeaderDetector::reset() {
     headerDirection_ = {0.0f, 0.0f, 0.0f};
 }
 
-float HeaderDetector::calculateNeckAngle(const k4abt_skeleton_t& skeleton) const {
-    k4a_float3_t head = skeleton.joints[K4ABT_JOINT_HEAD].position;
-    k4a_float3_t neck = skeleton.joints[K4ABT_JOINT_NECK].position;
-    k4a_float3_t spineChest = skeleton.joints[K4ABT_JOINT_SPINE_CHEST].position;
-
-    k4a_float3_t neckToHead = subtract(head, neck);
-    k4a_float3_t spineToNeck = subtract(neck, spineChest);
-
-    return angleBetweenVectors(neckToHead, spineToNeck);
-}
-
-float HeaderDetector::calculateBodyAlignment(const k4abt_skeleton_t& skeleton) const {
+float HeaderDetector::calculateBodyAlignment(const PoseFeatures& pose) const {
     // Good body alignment means torso is aligned with header direction
-    k4a_float3_t pelvis = skeleton.joints[K4ABT_JOINT_PELVIS].position;
-    k4a_float3_t spineChest = skeleton.joints[K4ABT_JOINT_SPINE_CHEST].position;
-
-    k4a_float3_t torsoVector = subtract(spineChest, pelvis);
-
-    // Compare with header direction
-    float alignment = dotProduct(normalize(torsoVector), normalize(headerDirection_));
+    float alignment = dotProduct(pose.getTorsoDirection(), normalize(headerDirection_));
 
     // Convert to 0-100 score
     return (alignment + 1.0f) * 50.0f; // -1 to 1 becomes 0 to 100
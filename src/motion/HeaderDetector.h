@@ -2,6 +2,7 @@
 #define KINECT_FOOTBALL_HEADER_DETECTOR_H
 
 #include "MotionHistory.h"
+#include "PoseFeatures.h"
 #include "../../include/KickTypes.h"
 #include <k4abt.h>
 #include <functional>
@@ -81,6 +82,9 @@ public:
     // Process new skeleton frame
     void processSkeleton(const k4abt_skeleton_t& skeleton, uint64_t timestamp);
 
+    // Process a frame whose derived features are shared with other consumers
+    void processFrame(const PoseFeatures& pose);
+
     // Set callback for header completion
     void setHeaderCallback(HeaderCallback callback) { headerCallback_ = callback; }
 
@@ -108,12 +112,10 @@ private:
     // Callback
     HeaderCallback headerCallback_;
 
-    // Current skeleton (stored for analysis)
-    k4abt_skeleton_t currentSkeleton_;
     uint64_t currentTimestamp_;
 
     // Phase detection methods
-    void updatePhase(uint64_t timestamp);
+    void updatePhase(const PoseFeatures& pose);
     bool detectPreparation(const MotionHistory& headHistory);
     bool detectContact(const MotionHistory& headHistory);
     bool detectRecovery(const MotionHistory& headHistory);
@@ -122,22 +124,19 @@ private:
     k4a_float3_t calculateHeaderDirection() const;
 
     // Classify header type
-    HeaderType classifyHeaderType(const k4abt_skeleton_t& skeleton,
+    HeaderType classifyHeaderType(const PoseFeatures& pose,
                                    const MotionHistory& headHistory);
 
     // Analyze header quality
-    HeaderQuality analyzeHeaderQuality(const k4abt_skeleton_t& skeleton,
+    HeaderQuality analyzeHeaderQuality(const PoseFeatures& pose,
                                        const MotionHistory& headHistory,
                                        HeaderType type);
 
     // Complete header and trigger callback
-    void completeHeader();
-
-    // Helper: calculate neck angle
-    float calculateNeckAngle(const k4abt_skeleton_t& skeleton) const;
+    void completeHeader(const PoseFeatures& pose);
 
     // Helper: calculate body alignment score
-    float calculateBodyAlignment(const k4abt_skeleton_t& skeleton) const;
+    float calculateBodyAlignment(const PoseFeatures& pose) const;
 
     // Helper: vector operations
     static float magnitude(const k4a_float3_t& v);
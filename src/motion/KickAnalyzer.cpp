@@ -1,4 +1,5 @@
 #include "KickAnalyzer.h"
+#include "KickClassifier.h"
 #include <cmath>
 #include <algorithm>
 
@@ -27,36 +28,70 @@ KickResult KickAnalyzer::analyzeKick(
     // Calculate kick direction from peak velocity
     result.kickDirection = normalize(footHistory.getAverageVelocity(3));
 
+    // Pose features for the final frame, shared by classification and scoring.
+    // The knee angle is read from this pose, not from the knee's history.
+    (void)kneeHistory;
+    PoseFeatures pose(skeleton, timestamp);
+
     // Classify kick type
-    result.type = classifyKickType(skeleton, footHistory, kneeHistory, foot);
+    result.type = classifyFromMetrics(pose.getKneeAngle(foot), footHistory.getPeakSpeed(),
+                                      footHistory.getCurrentVelocity());
 
-    // Power analysis
+    // Raw metrics from the motion histories
     result.quality.footVelocity = footHistory.getPeakSpeed();
-    result.quality.estimatedBallSpeed = calculateEstimatedBallSpeed(result.quality.footVelocity);
-    result.quality.powerScore = calculatePowerScore(result.quality.estimatedBallSpeed);
+    result.quality.kneeAngle = pose.getKneeAngle(foot);
+    result.quality.hipRotation = calculateHipRotation(pose);
+    result.quality.followThroughLength = calculateFollowThroughLength(footHistory);
+    result.quality.bodyLean = pose.getBodyLean();
+
+    scoreQuality(result.quality, result.kickDirection);
+
+    return result;
+}
+
+KickResult KickAnalyzer::analyzeKick(const KickQualityAccumulator& accumulator, uint64_t timestamp) {
+    KickResult result;
+    result.foot = accumulator.getFoot();
+    result.timestamp = timestamp;
+    result.isValid = accumulator.hasContact();
+    result.kickDirection = accumulator.getKickDirection();
+
+    // Learned classifier over the kick window (inline, allocation-free)
+    result.type = KickClassifier::classify(KickClassifier::extractFeatures(accumulator));
+
+    // Raw metrics were accumulated while the kick was in progress
+    result.quality.footVelocity = accumulator.getPeakFootSpeed();
+    result.quality.kneeAngle = accumulator.getKneeAngleAtContact();
+    result.quality.hipRotation = accumulator.getHipRotation();
+    result.quality.followThroughLength = accumulator.getFollowThroughLength();
+    result.quality.bodyLean = accumulator.getBodyLeanAtContact();
+
+    scoreQuality(result.quality, result.kickDirection);
+
+    return result;
+}
+
+void KickAnalyzer::scoreQuality(KickQuality& quality, const k4a_float3_t& kickDirection) {
+    // Power analysis
+    quality.estimatedBallSpeed = calculateEstimatedBallSpeed(quality.footVelocity);
+    quality.powerScore = calculatePowerScore(quality.estimatedBallSpeed);
 
     // Accuracy analysis
-    result.quality.directionAngle = calculateDirectionAngle(result.kickDirection);
-    result.quality.accuracyScore = calculateAccuracyScore(result.quality.directionAngle);
+    quality.directionAngle = calculateDirectionAngle(kickDirection);
+    quality.accuracyScore = calculateAccuracyScore(quality.directionAngle);
 
     // Technique analysis
-    result.quality.kneeAngle = calculateKneeAngle(skeleton, foot);
-    result.quality.hipRotation = calculateHipRotation(skeleton, foot);
-    result.quality.followThroughLength = calculateFollowThroughLength(footHistory);
-    result.quality.techniqueScore = calculateTechniqueScore(
-        result.quality.kneeAngle,
-        result.quality.hipRotation,
-        result.quality.followThroughLength
+    quality.techniqueScore = calculateTechniqueScore(
+        quality.kneeAngle,
+        quality.hipRotation,
+        quality.followThroughLength
     );
 
     // Balance analysis
-    result.quality.bodyLean = calculateBodyLean(skeleton);
-    result.quality.balanceScore = calculateBalanceScore(result.quality.bodyLean);
+    quality.balanceScore = calculateBalanceScore(quality.bodyLean);
 
     // Overall score
-    result.quality.overallScore = calculateOverallScore(result.quality);
-
-    return result;
+    quality.overallScore = calculateOverallScore(quality);
 }
 
 KickType KickAnalyzer::classifyKickType(
@@ -65,20 +100,12 @@ KickType KickAnalyzer::classifyKickType(
     const MotionHistory& kneeHistory,
     DominantFoot foot)
 {
-    // Get joint indices based on dominant foot
-    int ankleJoint = (foot == DominantFoot::Left) ? K4ABT_JOINT_ANKLE_LEFT : K4ABT_JOINT_ANKLE_RIGHT;
-    int kneeJoint = (foot == DominantFoot::Left) ? K4ABT_JOINT_KNEE_LEFT : K4ABT_JOINT_KNEE_RIGHT;
-    int hipJoint = (foot == DominantFoot::Left) ? K4ABT_JOINT_HIP_LEFT : K4ABT_JOINT_HIP_RIGHT;
-
-    float kneeAngle = calculateJointAngle(
-        skeleton.joints[hipJoint].position,
-        skeleton.joints[kneeJoint].position,
-        skeleton.joints[ankleJoint].position
-    );
-
-    float peakSpeed = footHistory.getPeakSpeed();
-    k4a_float3_t velocity = footHistory.getCurrentVelocity();
+    (void)kneeHistory;   // Knee angle comes from the pose
+    PoseFeatures pose(skeleton, 0);
+    return classifyFromMetrics(pose.getKneeAngle(foot), footHistory.getPeakSpeed(), footHistory.getCurrentVelocity());
+}
 
+KickType KickAnalyzer::classifyFromMetrics(float kneeAngle, float peakSpeed, const k4a_float3_t& velocity) {
     // Classification heuristics
     if (kneeAngle > 160.0f && peakSpeed > 3.0f) {
         return KickType::Instep; // Straight leg, high power
@@ -99,8 +126,8 @@ float KickAnalyzer::calculatePower(const MotionHistory& footHistory) {
 
 float KickAnalyzer::calculateEstimatedBallSpeed(float footVelocity) {
     // Empirical coefficient: ball speed is typically 1.2-1.3x foot speed
-    // Convert m/s to km/h
-    return footVelocity * 1.25f * 3.6f;
+    // Foot speed is in mm/s as tracked; convert to km/h
+    return footVelocity * 0.001f * 1.25f * 3.6f;
 }
 
 float KickAnalyzer::calculatePowerScore(float ballSpeed) {
@@ -122,35 +149,12 @@ float KickAnalyzer::calculateAccuracyScore(float directionAngle) {
     return std::max(0.0f, std::min(100.0f, score));
 }
 
-float KickAnalyzer::calculateKneeAngle(const k4abt_skeleton_t& skeleton, DominantFoot foot) {
-    int ankleJoint = (foot == DominantFoot::Left) ? K4ABT_JOINT_ANKLE_LEFT : K4ABT_JOINT_ANKLE_RIGHT;
-    int kneeJoint = (foot == DominantFoot::Left) ? K4ABT_JOINT_KNEE_LEFT : K4ABT_JOINT_KNEE_RIGHT;
-    int hipJoint = (foot == DominantFoot::Left) ? K4ABT_JOINT_HIP_LEFT : K4ABT_JOINT_HIP_RIGHT;
-
-    return calculateJointAngle(
-        skeleton.joints[hipJoint].position,
-        skeleton.joints[kneeJoint].position,
-        skeleton.joints[ankleJoint].position
-    );
-}
-
-float KickAnalyzer::calculateHipRotation(const k4abt_skeleton_t& skeleton, DominantFoot foot) {
-    // Calculate rotation by comparing hip orientation to pelvis forward direction
-    k4a_float3_t leftHip = skeleton.joints[K4ABT_JOINT_HIP_LEFT].position;
-    k4a_float3_t rightHip = skeleton.joints[K4ABT_JOINT_HIP_RIGHT].position;
-    k4a_float3_t pelvis = skeleton.joints[K4ABT_JOINT_PELVIS].position;
-
-    // Hip line vector
-    k4a_float3_t hipLine = subtract(rightHip, leftHip);
-
-    // Forward direction (Z-axis)
-    k4a_float3_t forward = {0.0f, 0.0f, 1.0f};
-
-    // Calculate angle
-    k4a_float3_t hipLineXZ = {hipLine.xyz.x, 0.0f, hipLine.xyz.z};
-    float angle = angleBetweenVectors(normalize(hipLineXZ), forward);
-
-    return angle;
+float KickAnalyzer::calculateHipRotation(const PoseFeatures& pose) {
+    // Angle between the hip line and the forward (Z) axis in the XZ plane.
+    // Hip yaw is the heading of that line measured from +X, so the angle
+    // to +Z is acos(sin(yaw)).
+    float yawRadians = pose.getHipYaw() * (3.14159265359f / 180.0f);
+    return std::acos(std::sin(yawRadians)) * (180.0f / 3.14159265359f);
 }
 
 float KickAnalyzer::calculateFollowThroughLength(const MotionHistory& footHistory) {
@@ -191,17 +195,6 @@ float KickAnalyzer::calculateTechniqueScore(float kneeAngle, float hipRotation,
     return (kneeScore * 0.4f + hipScore * 0.3f + followScore * 0.3f);
 }
 
-float KickAnalyzer::calculateBodyLean(const k4abt_skeleton_t& skeleton) {
-    // Calculate lean from vertical using spine joints
-    k4a_float3_t pelvis = skeleton.joints[K4ABT_JOINT_PELVIS].position;
-    k4a_float3_t spine = skeleton.joints[K4ABT_JOINT_SPINE_CHEST].position;
-
-    k4a_float3_t spineVector = subtract(spine, pelvis);
-    k4a_float3_t vertical = {0.0f, 1.0f, 0.0f};
-
-    return angleBetweenVectors(spineVector, vertical);
-}
-
 float KickAnalyzer::calculateBalanceScore(float bodyLean) {
     // Ideal lean is 5-15 degrees forward
     float idealLean = 10.0f;
@@ -219,18 +212,6 @@ float KickAnalyzer::calculateOverallScore(const KickQuality& quality) {
            quality.balanceScore * BALANCE_WEIGHT;
 }
 
-float KickAnalyzer::calculateJointAngle(const k4a_float3_t& joint1,
-                                         const k4a_float3_t& joint2,
-                                         const k4a_float3_t& joint3) {
-    k4a_float3_t v1 = normalize(subtract(joint1, joint2));
-    k4a_float3_t v2 = normalize(subtract(joint3, joint2));
-
-    float dot = dotProduct(v1, v2);
-    dot = std::max(-1.0f, std::min(1.0f, dot));
-
-    return std::acos(dot) * (180.0f / 3.14159265359f);
-}
-
 float KickAnalyzer::magnitude(const k4a_float3_t& v) {
     return std::sqrt(v.xyz.x * v.xyz.x + v.xyz.y * v.xyz.y + v.xyz.z * v.xyz.z);
 }
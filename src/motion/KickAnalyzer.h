@@ -2,6 +2,8 @@
 #define KINECT_FOOTBALL_KICK_ANALYZER_H
 
 #include "MotionHistory.h"
+#include "KickQualityAccumulator.h"
+#include "PoseFeatures.h"
 #include "../../include/KickTypes.h"
 #include <k4abt.h>
 
@@ -45,6 +47,9 @@ public:
         uint64_t timestamp
     );
 
+    // Score a kick from streamed metrics in constant time
+    KickResult analyzeKick(const KickQualityAccumulator& accumulator, uint64_t timestamp);
+
     // Set target zone for accuracy calculation
     void setTargetZone(const TargetZone& target) { targetZone_ = target; }
 
@@ -59,6 +64,12 @@ public:
 private:
     TargetZone targetZone_;
 
+    // Shared classification heuristics
+    static KickType classifyFromMetrics(float kneeAngle, float peakSpeed, const k4a_float3_t& velocity);
+
+    // Fill power/accuracy/technique/balance scores from raw metrics
+    void scoreQuality(KickQuality& quality, const k4a_float3_t& kickDirection);
+
     // Power analysis
     float calculatePower(const MotionHistory& footHistory);
     float calculateEstimatedBallSpeed(float footVelocity);
@@ -69,23 +80,16 @@ private:
     float calculateAccuracyScore(float directionAngle);
 
     // Technique analysis
-    float calculateKneeAngle(const k4abt_skeleton_t& skeleton, DominantFoot foot);
-    float calculateHipRotation(const k4abt_skeleton_t& skeleton, DominantFoot foot);
+    float calculateHipRotation(const PoseFeatures& pose);
     float calculateFollowThroughLength(const MotionHistory& footHistory);
     float calculateTechniqueScore(float kneeAngle, float hipRotation, float followThrough);
 
     // Balance analysis
-    float calculateBodyLean(const k4abt_skeleton_t& skeleton);
     float calculateBalanceScore(float bodyLean);
 
     // Overall score
     float calculateOverallScore(const KickQuality& quality);
 
-    // Helper: calculate angle between three joints
-    static float calculateJointAngle(const k4a_float3_t& joint1,
-                                     const k4a_float3_t& joint2,
-                                     const k4a_float3_t& joint3);
-
     // Helper: vector operations
     static float magnitude(const k4a_float3_t& v);
     static k4a_float3_t normalize(const k4a_float3_t& v);
@@ -0,0 +1,128 @@
+#include "KickClassifier.h"
+#include "KickClassifierWeights.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace kinect {
+namespace motion {
+
+static_assert(kick_model::FEATURE_COUNT == KickClassifier::FEATURE_COUNT,
+              "KickClassifierWeights.h was generated for a different feature layout");
+static_assert(kick_model::HIDDEN_SIZE == KickClassifier::HIDDEN_SIZE &&
+              kick_model::CLASS_COUNT == KickClassifier::CLASS_COUNT,
+              "KickClassifierWeights.h was generated for a different network shape");
+
+namespace {
+// The accumulator works in tracker units (mm, mm/s); the model in meters
+constexpr float MM_TO_M = 0.001f;
+
+const char* const CLASS_LABELS[KickClassifier::CLASS_COUNT] = {
+    "instep", "sidefoot", "outside", "toe", "volley"
+};
+} // namespace
+
+KickClassifier::Features KickClassifier::extractFeatures(const KickQualityAccumulator& accumulator) {
+    Features f{};
+
+    k4a_float3_t direction = accumulator.getKickDirection();
+    k4a_float3_t velocity = accumulator.getContactVelocity();
+    float lateral = std::abs(velocity.xyz.x);
+    float forward = std::abs(velocity.xyz.z);
+
+    f[KNEE_ANGLE] = accumulator.getKneeAngleAtContact();
+    f[PEAK_FOOT_SPEED] = accumulator.getPeakFootSpeed() * MM_TO_M;
+    f[DIRECTION_X] = direction.xyz.x;
+    f[DIRECTION_Y] = direction.xyz.y;
+    f[DIRECTION_Z] = direction.xyz.z;
+    f[LATERAL_RATIO] = (lateral + forward) > 0.0001f ? lateral / (lateral + forward) : 0.0f;
+    f[HIP_ROTATION] = accumulator.getHipRotation();
+    f[FOLLOW_THROUGH] = accumulator.getFollowThroughLength() * MM_TO_M;
+    f[BODY_LEAN] = accumulator.getBodyLeanAtContact();
+
+    // Foot height relative to the pelvis, scaled by leg length so it is
+    // independent of player size (Kinect Y axis points down)
+    const PoseFeatures& pose = accumulator.getContactPose();
+    DominantFoot side = accumulator.getFoot();
+    const k4a_float3_t& foot = pose.getJoint(side == DominantFoot::Left ? K4ABT_JOINT_FOOT_LEFT : K4ABT_JOINT_FOOT_RIGHT);
+    const k4a_float3_t& pelvis = pose.getJoint(K4ABT_JOINT_PELVIS);
+    float legLength = pose.getLegLength(side);
+    f[FOOT_HEIGHT] = legLength > 0.0001f ? (pelvis.xyz.y - foot.xyz.y) / legLength : 0.0f;
+
+    return f;
+}
+
+KickType KickClassifier::classify(const Features& features, Scores* probabilities) {
+    using namespace kick_model;
+
+    // Standardize
+    float input[FEATURE_COUNT];
+    for (size_t i = 0; i < FEATURE_COUNT; ++i) {
+        input[i] = (features[i] - INPUT_MEAN[i]) * INPUT_SCALE[i];
+    }
+
+    // Hidden layer (ReLU)
+    float hidden[HIDDEN_SIZE];
+    for (size_t j = 0; j < HIDDEN_SIZE; ++j) {
+        float sum = HIDDEN_BIAS[j];
+        const float* w = HIDDEN_WEIGHTS[j];
+        for (size_t i = 0; i < FEATURE_COUNT; ++i) {
+            sum += w[i] * input[i];
+        }
+        hidden[j] = sum > 0.0f ? sum : 0.0f;
+    }
+
+    // Output logits
+    float logits[CLASS_COUNT];
+    size_t best = 0;
+    for (size_t k = 0; k < CLASS_COUNT; ++k) {
+        float sum = OUTPUT_BIAS[k];
+        const float* w = OUTPUT_WEIGHTS[k];
+        for (size_t j = 0; j < HIDDEN_SIZE; ++j) {
+            sum += w[j] * hidden[j];
+        }
+        logits[k] = sum;
+        if (sum > logits[best]) {
+            best = k;
+        }
+    }
+
+    if (probabilities) {
+        float total = 0.0f;
+        for (size_t k = 0; k < CLASS_COUNT; ++k) {
+            (*probabilities)[k] = std::exp(logits[k] - logits[best]);
+            total += (*probabilities)[k];
+        }
+        for (size_t k = 0; k < CLASS_COUNT; ++k) {
+            (*probabilities)[k] /= total;
+        }
+    }
+
+    return CLASSES[best];
+}
+
+const char* KickClassifier::classLabel(size_t classIndex) {
+    return classIndex < CLASS_COUNT ? CLASS_LABELS[classIndex] : "unknown";
+}
+
+int KickClassifier::classIndexFromLabel(const std::string& label) {
+    for (size_t k = 0; k < CLASS_COUNT; ++k) {
+        if (label == CLASS_LABELS[k]) {
+            return static_cast<int>(k);
+        }
+    }
+    return -1;
+}
+
+std::string KickClassifier::formatRecordingRow(const std::string& label, const Features& features) {
+    std::string row = label;
+    char buffer[32];
+    for (float value : features) {
+        std::snprintf(buffer, sizeof(buffer), ",%.6g", value);
+        row += buffer;
+    }
+    return row;
+}
+
+} // namespace motion
+} // namespace kinect
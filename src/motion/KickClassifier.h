@@ -0,0 +1,67 @@
+#ifndef KINECT_FOOTBALL_KICK_CLASSIFIER_H
+#define KINECT_FOOTBALL_KICK_CLASSIFIER_H
+
+#include "KickQualityAccumulator.h"
+#include "../../include/KickTypes.h"
+#include <array>
+#include <cstddef>
+#include <string>
+
+namespace kinect {
+namespace motion {
+
+// Learned kick-type classifier: a small MLP over a fixed feature vector
+// taken from the kick window. Weights are compiled in from
+// KickClassifierWeights.h, which tools/train_kick_classifier generates
+// from labelled recordings. Inference uses fixed-size arrays only (no
+// allocation) and contiguous loops the compiler can vectorize.
+class KickClassifier {
+public:
+    // Feature layout (see extractFeatures)
+    enum Feature {
+        KNEE_ANGLE = 0,         // degrees at contact
+        PEAK_FOOT_SPEED,        // m/s
+        DIRECTION_X,            // unit kick direction at contact
+        DIRECTION_Y,
+        DIRECTION_Z,
+        LATERAL_RATIO,          // |vx| / (|vx| + |vz|) at contact
+        HIP_ROTATION,           // degrees swept during the kick
+        FOLLOW_THROUGH,         // meters after contact
+        BODY_LEAN,              // degrees from vertical at contact
+        FOOT_HEIGHT,            // foot above pelvis at contact / leg length
+        FEATURE_COUNT
+    };
+
+    // Classes the model predicts, in output order
+    static constexpr size_t CLASS_COUNT = 5;
+    static constexpr std::array<KickType, CLASS_COUNT> CLASSES = {
+        KickType::Instep,
+        KickType::SideFootPass,
+        KickType::Outside,
+        KickType::Toe,
+        KickType::Volley
+    };
+
+    static constexpr size_t HIDDEN_SIZE = 16;
+
+    using Features = std::array<float, FEATURE_COUNT>;
+    using Scores = std::array<float, CLASS_COUNT>;
+
+    // Build the feature vector from streamed kick metrics
+    static Features extractFeatures(const KickQualityAccumulator& accumulator);
+
+    // Predict kick type; optionally returns class probabilities
+    static KickType classify(const Features& features, Scores* probabilities = nullptr);
+
+    // Label names used in training recordings ("instep", "sidefoot", ...)
+    static const char* classLabel(size_t classIndex);
+    static int classIndexFromLabel(const std::string& label);
+
+    // One CSV row "label,f0,...,f9" for building labelled recordings
+    static std::string formatRecordingRow(const std::string& label, const Features& features);
+};
+
+} // namespace motion
+} // namespace kinect
+
+#endif // KINECT_FOOTBALL_KICK_CLASSIFIER_H
@@ -0,0 +1,56 @@
+#ifndef KINECT_FOOTBALL_KICK_CLASSIFIER_WEIGHTS_H
+#define KINECT_FOOTBALL_KICK_CLASSIFIER_WEIGHTS_H
+
+// Generated by tools/train_kick_classifier from 0 recorded and 10000 synthetic labelled kicks.
+// Do not edit by hand; retrain instead.
+
+#include <cstddef>
+
+namespace kinect {
+namespace motion {
+namespace kick_model {
+
+constexpr size_t FEATURE_COUNT = 10;
+constexpr size_t HIDDEN_SIZE = 16;
+constexpr size_t CLASS_COUNT = 5;
+
+alignas(32) constexpr float INPUT_MEAN[FEATURE_COUNT] = {139.946487f, 5.65436029f, -0.00488520926f, 0.109545372f, 0.863277733f, 0.248444915f, 31.0007591f, 0.408965141f, 15.5734186f, -0.761440277f};
+
+alignas(32) constexpr float INPUT_SCALE[FEATURE_COUNT] = {0.0560068302f, 0.532303274f, 2.34468341f, 6.23453093f, 5.3375473f, 4.72093821f, 0.0659402609f, 5.33550072f, 0.123505227f, 4.44069862f};
+
+alignas(32) constexpr float HIDDEN_WEIGHTS[HIDDEN_SIZE][FEATURE_COUNT] = {
+    {-1.49251568f, -0.205419183f, -0.0464358777f, -0.429816216f, 0.0805439726f, -0.201796994f, 0.785726249f, -0.0872187391f, -0.249110416f, -0.447438836f},
+    {-0.444924951f, 0.192330867f, 0.415327042f, -0.457253665f, 0.233478382f, -0.638554394f, -0.533643961f, -0.101926468f, -0.170118228f, -0.813601434f},
+    {-1.16889203f, -0.250058234f, 0.18642728f, -0.20322527f, 0.148535281f, -0.179789707f, -0.49819845f, 0.00875574443f, -0.591396809f, -0.356929868f},
+    {-1.01519251f, -0.0255853962f, -0.0326746888f, 0.0186378304f, 0.0373850353f, -0.0317015909f, 0.539916456f, 0.000670457492f, -0.506485462f, -0.199504733f},
+    {-0.562978506f, -0.371910483f, 0.583157063f, 0.135858506f, 0.274875492f, -0.289128751f, 0.882670283f, 0.847739577f, -0.156789869f, -1.07860053f},
+    {-0.217056483f, 0.711329043f, -0.0775650665f, 0.064131923f, -0.490071923f, 0.0177655444f, -0.416733205f, 1.578444f, 0.18733643f, 1.01767409f},
+    {-0.183695555f, -0.547589839f, -0.433646172f, -0.315585613f, -0.78072536f, 2.03502154f, -0.946884692f, -0.113116264f, -0.136299595f, -0.523733675f},
+    {0.641746461f, -0.311704248f, -0.725098789f, -0.710455835f, 0.645605624f, -1.37449217f, -0.0542104505f, -0.903556705f, -0.266487747f, -0.465558976f},
+    {-0.223189637f, -0.71167475f, -0.362671584f, 0.84910208f, 0.0176902208f, 0.463896394f, 0.563221514f, -0.466694325f, -0.230922222f, 1.85144961f},
+    {1.1190536f, 0.244134709f, 0.149945229f, 0.444908172f, 0.272789687f, -0.777838469f, 0.298740983f, -0.0819196627f, 0.530317545f, 1.3641324f},
+    {0.0652546212f, -0.655986488f, 0.504487693f, -0.11582882f, 0.162493542f, -0.477594167f, -0.524340332f, -0.375768423f, -0.110029876f, 0.392234474f},
+    {0.993535578f, 1.07456601f, 0.0408476591f, -0.00180035667f, 1.13977921f, -0.252601266f, -0.434534818f, 0.650201917f, -0.573460519f, -1.13022137f},
+    {0.063038066f, -0.563726485f, -0.593943536f, -1.12423515f, 0.067610994f, 0.633381128f, 1.33350503f, -0.465695173f, -0.270705134f, 0.180725813f},
+    {0.962246418f, 0.0843023732f, -0.725572526f, -0.577131629f, -0.901401877f, 0.985382795f, -0.180685624f, -0.0696640089f, 1.16555846f, -0.269982457f},
+    {0.655918956f, -0.133847162f, 0.983167946f, -0.262171447f, -0.131909803f, 0.713963628f, -0.145177618f, -0.587050498f, -0.0718177259f, 0.72071594f},
+    {-0.731341124f, 0.19738321f, 0.094897829f, -0.381208032f, 0.733280897f, -0.907312334f, -0.861257076f, -1.52255225f, 1.27263689f, -0.407458901f}
+};
+
+alignas(32) constexpr float HIDDEN_BIAS[HIDDEN_SIZE] = {0.408981979f, -0.274794132f, 0.258998871f, 0.0361670144f, 0.226217031f, 0.518739522f, 1.1761874f, -0.0507711768f, 0.342528105f, 0.52271086f, -0.361126512f, 0.720173776f, 0.0606566221f, 0.360160917f, -0.242855713f, 0.342742145f};
+
+alignas(32) constexpr float OUTPUT_WEIGHTS[CLASS_COUNT][HIDDEN_SIZE] = {
+    {-1.18804896f, -0.499747962f, -0.617000699f, -0.470271617f, 1.15493298f, 0.132344082f, -1.7012459f, 1.09346569f, -1.37119555f, 0.188004792f, 0.709307969f, 1.53341579f, 0.584886432f, 0.594025552f, 0.395890594f, -1.04149032f},
+    {1.15804625f, 0.488907427f, 0.930826426f, 0.800079226f, 0.640186429f, -1.28316307f, 0.67206651f, 0.328770846f, 0.385574758f, -0.434925944f, -0.678401351f, -1.71462965f, 1.21079874f, -1.22296751f, -0.0841738284f, -1.39577854f},
+    {-0.0575260334f, -0.649517238f, -0.159019083f, -0.452930003f, -0.296876699f, 1.02728605f, 1.92990291f, -0.932279706f, -0.557810187f, -1.00862324f, 0.435535669f, 0.295280695f, -0.206594676f, 1.07405269f, 0.632812142f, 0.169599995f},
+    {-0.373176038f, 0.79963243f, 0.621087611f, -0.269393474f, -1.05004859f, -0.72272861f, -0.367696077f, 0.820743859f, 0.0729914382f, -0.642063856f, 0.118922614f, 0.428853571f, -1.44072855f, -1.02075827f, -1.38739312f, 1.49071169f},
+    {0.490819961f, -0.170831114f, -0.573744774f, 0.157264858f, -0.492220432f, 1.07927823f, -0.355143666f, -1.36355829f, 1.46750438f, 1.69904912f, -0.516704917f, -0.411930472f, -0.248627573f, 0.470539808f, 0.429851651f, 0.780500948f}
+};
+
+alignas(32) constexpr float OUTPUT_BIAS[CLASS_COUNT] = {1.24969006f, -0.400919348f, 0.300178587f, 0.264009506f, -1.41302335f};
+
+} // namespace kick_model
+} // namespace motion
+} // namespace kinect
+
+#endif // KINECT_FOOTBALL_KICK_CLASSIFIER_WEIGHTS_H
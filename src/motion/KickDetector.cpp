@@ -9,15 +9,18 @@ KickDetector::KickDetector()
     : currentPhase_(KickPhase::Idle)
     , dominantFoot_(DominantFoot::Unknown)
     , phaseStartTime_(0)
-    , peakVelocity_(0.0f)
-    , kickDirection_{0.0f, 0.0f, 0.0f}
     , currentTimestamp_(0)
 {
-    currentSkeleton_ = {};
 }
 
 void KickDetector::processSkeleton(const k4abt_skeleton_t& skeleton, uint64_t timestamp) {
-    currentSkeleton_ = skeleton;
+    PoseFeatures pose(skeleton, timestamp);
+    processFrame(pose);
+}
+
+void KickDetector::processFrame(const PoseFeatures& pose) {
+    const k4abt_skeleton_t& skeleton = pose.getSkeleton();
+    uint64_t timestamp = pose.getTimestamp();
     currentTimestamp_ = timestamp;
 
     // Update motion histories for all relevant joints
@@ -76,10 +79,22 @@ void KickDetector::processSkeleton(const k4abt_skeleton_t& skeleton, uint64_t ti
     );
 
     // Update phase state machine
-    updatePhase(timestamp);
+    updatePhase(pose);
+}
+
+float KickDetector::getFootSpeed() const {
+    if (dominantFoot_ == DominantFoot::Left) {
+        return leftFootHistory_.getCurrentSpeed();
+    }
+    if (dominantFoot_ == DominantFoot::Right) {
+        return rightFootHistory_.getCurrentSpeed();
+    }
+    return std::max(leftFootHistory_.getCurrentSpeed(), rightFootHistory_.getCurrentSpeed());
 }
 
-void KickDetector::updatePhase(uint64_t timestamp) {
+void KickDetector::updatePhase(const PoseFeatures& pose) {
+    uint64_t timestamp = pose.getTimestamp();
+
     // Determine which foot is more active
     updateDominantFoot();
 
@@ -90,12 +105,18 @@ void KickDetector::updatePhase(uint64_t timestamp) {
     auto& ankleHistory = getActiveAnkleHistory();
     auto& footHistory = getActiveFootHistory();
 
+    // Stream this frame into the quality metrics of the kick in progress
+    if (currentPhase_ != KickPhase::Idle) {
+        qualityAccumulator_.addFrame(pose, footHistory.getCurrentVelocity(), currentPhase_);
+    }
+
     switch (currentPhase_) {
         case KickPhase::Idle:
             if (detectWindUp(ankleHistory, footHistory)) {
                 currentPhase_ = KickPhase::WindUp;
                 phaseStartTime_ = timestamp;
-                peakVelocity_ = 0.0f;
+                qualityAccumulator_.begin(dominantFoot_, timestamp);
+                qualityAccumulator_.addFrame(pose, footHistory.getCurrentVelocity(), currentPhase_);
             }
             break;
 
@@ -113,23 +134,16 @@ void KickDetector::updatePhase(uint64_t timestamp) {
             }
             break;
 
-        case KickPhase::Acceleration: {
-            // Track peak velocity
-            float currentSpeed = footHistory.getCurrentSpeed();
-            if (currentSpeed > peakVelocity_) {
-                peakVelocity_ = currentSpeed;
-            }
-
+        case KickPhase::Acceleration:
             // Check minimum time in phase
             if (timestamp - phaseStartTime_ >= MIN_ACCELERATION_TIME) {
                 if (detectContact(ankleHistory, footHistory)) {
                     currentPhase_ = KickPhase::Contact;
                     phaseStartTime_ = timestamp;
-                    kickDirection_ = calculateKickDirection();
+                    qualityAccumulator_.markContact(pose);
                 }
             }
             break;
-        }
 
         case KickPhase::Contact:
             // Contact is brief, quickly move to follow-through
@@ -217,13 +231,6 @@ void KickDetector::updateDominantFoot() {
     // Keep current dominantFoot_ if speeds are similar
 }
 
-k4a_float3_t KickDetector::calculateKickDirection() const {
-    // Direction is based on foot velocity at peak
-    auto& footHistory = getActiveFootHistory();
-    k4a_float3_t direction = footHistory.getAverageVelocity(3); // Average last 3 frames
-    return normalize(direction);
-}
-
 MotionHistory& KickDetector::getActiveAnkleHistory() {
     return dominantFoot_ == DominantFoot::Left ? leftAnkleHistory_ : rightAnkleHistory_;
 }
@@ -253,18 +260,8 @@ void KickDetector::completeKick() {
         return;
     }
 
-    KickResult result;
-    result.foot = dominantFoot_;
-    result.kickDirection = kickDirection_;
-    result.timestamp = currentTimestamp_;
-    result.isValid = true;
-
-    // Basic quality metrics (will be enhanced by KickAnalyzer)
-    result.quality.footVelocity = peakVelocity_;
-    result.quality.estimatedBallSpeed = peakVelocity_ * 3.6f; // m/s to km/h
-
-    // Determine kick type based on motion pattern
-    result.type = KickType::Instep; // Default, can be refined
+    // All metrics were accumulated during the kick, so scoring is constant time
+    KickResult result = analyzer_.analyzeKick(qualityAccumulator_, currentTimestamp_);
 
     kickCallback_(result);
 }
@@ -273,8 +270,7 @@ void KickDetector::reset() {
     currentPhase_ = KickPhase::Idle;
     dominantFoot_ = DominantFoot::Unknown;
     phaseStartTime_ = 0;
-    peakVelocity_ = 0.0f;
-    kickDirection_ = {0.0f, 0.0f, 0.0f};
+    qualityAccumulator_.reset();
 }
 
 float KickDetector::calculateJointAngle(const k4a_float3_t& joint1,
@@ -2,6 +2,9 @@
 #define KINECT_FOOTBALL_KICK_DETECTOR_H
 
 #include "MotionHistory.h"
+#include "KickAnalyzer.h"
+#include "KickQualityAccumulator.h"
+#include "PoseFeatures.h"
 #include "../../include/KickTypes.h"
 #include <k4abt.h>
 #include <functional>
@@ -30,15 +33,24 @@ public:
     // Process new skeleton frame
     void processSkeleton(const k4abt_skeleton_t& skeleton, uint64_t timestamp);
 
+    // Process a frame whose derived features are shared with other consumers
+    void processFrame(const PoseFeatures& pose);
+
     // Set callback for kick completion
     void setKickCallback(KickCallback callback) { kickCallback_ = callback; }
 
+    // Set target zone used when scoring accuracy
+    void setTargetZone(const TargetZone& target) { analyzer_.setTargetZone(target); }
+
     // Get current phase
     KickPhase getCurrentPhase() const { return currentPhase_; }
 
     // Get dominant foot being used
     DominantFoot getDominantFoot() const { return dominantFoot_; }
 
+    // Current speed of the kicking foot (m/s); faster foot if not yet known
+    float getFootSpeed() const;
+
     // Reset detector state
     void reset();
 
@@ -58,18 +70,18 @@ private:
     KickPhase currentPhase_;
     DominantFoot dominantFoot_;
     uint64_t phaseStartTime_;
-    float peakVelocity_;
-    k4a_float3_t kickDirection_;
+
+    // Quality metrics streamed from WindUp to FollowThrough
+    KickQualityAccumulator qualityAccumulator_;
+    KickAnalyzer analyzer_;
 
     // Callback
     KickCallback kickCallback_;
 
-    // Current skeleton (stored for analysis)
-    k4abt_skeleton_t currentSkeleton_;
     uint64_t currentTimestamp_;
 
     // Phase detection methods
-    void updatePhase(uint64_t timestamp);
+    void updatePhase(const PoseFeatures& pose);
     bool detectWindUp(const MotionHistory& ankleHistory, const MotionHistory& footHistory);
     bool detectAcceleration(const MotionHistory& ankleHistory, const MotionHistory& footHistory);
     bool detectContact(const MotionHistory& ankleHistory, const MotionHistory& footHistory);
@@ -78,9 +90,6 @@ private:
     // Determine which foot is kicking
     void updateDominantFoot();
 
-    // Calculate kick direction vector
-    k4a_float3_t calculateKickDirection() const;
-
     // Get the appropriate history for current dominant foot
     MotionHistory& getActiveAnkleHistory();
     MotionHistory& getActiveFootHistory();
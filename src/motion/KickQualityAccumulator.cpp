@@ -0,0 +1,139 @@
+#include "KickQualityAccumulator.h"
+#include <algorithm>
+#include <cmath>
+#include "../../include/VectorMath.h"
+
+namespace kinect {
+namespace motion {
+
+namespace {
+// Wrap an angle difference into [-180, 180)
+float wrapDegrees(float angle) {
+    while (angle >= 180.0f) angle -= 360.0f;
+    while (angle < -180.0f) angle += 360.0f;
+    return angle;
+}
+} // namespace
+
+KickQualityAccumulator::KickQualityAccumulator() {
+    reset();
+}
+
+void KickQualityAccumulator::begin(DominantFoot foot, uint64_t timestamp) {
+    reset();
+    active_ = true;
+    foot_ = foot;
+    startTime_ = timestamp;
+}
+
+void KickQualityAccumulator::addFrame(const PoseFeatures& pose,
+                                      const k4a_float3_t& footVelocity,
+                                      KickPhase phase) {
+    if (!active_ || phase == KickPhase::Idle) {
+        return;
+    }
+    frameCount_++;
+
+    // Power: running peak
+    float speed = math::magnitude(footVelocity);
+    if (phase == KickPhase::Acceleration || phase == KickPhase::Contact) {
+        peakFootSpeed_ = std::max(peakFootSpeed_, speed);
+    }
+
+    // Direction: keep the last few velocities in a fixed ring
+    recentVelocities_[velocityIndex_] = footVelocity;
+    velocityIndex_ = (velocityIndex_ + 1) % DIRECTION_SAMPLES;
+    velocityCount_ = std::min(velocityCount_ + 1, DIRECTION_SAMPLES);
+
+    // Hip rotation: sweep of the hip line relative to the first frame
+    float yaw = pose.getHipYaw();
+    if (frameCount_ == 1) {
+        baseHipYaw_ = yaw;
+    }
+    float relativeYaw = wrapDegrees(yaw - baseHipYaw_);
+    minHipYaw_ = std::min(minHipYaw_, relativeYaw);
+    maxHipYaw_ = std::max(maxHipYaw_, relativeYaw);
+
+    // Follow-through: foot path length after contact
+    if (pose.isJointTracked(footJoint())) {
+        const k4a_float3_t& footPosition = pose.getJoint(footJoint());
+        if (hasContact_ && hasLastFootPosition_ && pose.getTimestamp() > contactTime_) {
+            followThroughLength_ += math::magnitude(math::subtract(footPosition, lastFootPosition_));
+        }
+        lastFootPosition_ = footPosition;
+        hasLastFootPosition_ = true;
+    }
+}
+
+void KickQualityAccumulator::markContact(const PoseFeatures& pose) {
+    if (!active_) {
+        return;
+    }
+
+    hasContact_ = true;
+    contactTime_ = pose.getTimestamp();
+    contactPose_ = pose;
+
+    contactVelocity_ = averageRecentVelocity();
+    kickDirection_ = math::normalize(contactVelocity_);
+
+    kneeAngleAtContact_ = pose.getKneeAngle(foot_);
+    bodyLeanAtContact_ = pose.getBodyLean();
+
+    // Follow-through is measured from the contact position onward
+    lastFootPosition_ = pose.getJoint(footJoint());
+    hasLastFootPosition_ = true;
+    followThroughLength_ = 0.0f;
+}
+
+void KickQualityAccumulator::reset() {
+    active_ = false;
+    hasContact_ = false;
+    foot_ = DominantFoot::Unknown;
+    startTime_ = 0;
+    contactTime_ = 0;
+    frameCount_ = 0;
+
+    peakFootSpeed_ = 0.0f;
+
+    recentVelocities_.fill({0.0f, 0.0f, 0.0f});
+    velocityIndex_ = 0;
+    velocityCount_ = 0;
+    kickDirection_ = {0.0f, 0.0f, 0.0f};
+    contactVelocity_ = {0.0f, 0.0f, 0.0f};
+
+    kneeAngleAtContact_ = 0.0f;
+    baseHipYaw_ = 0.0f;
+    minHipYaw_ = 0.0f;
+    maxHipYaw_ = 0.0f;
+    followThroughLength_ = 0.0f;
+    lastFootPosition_ = {0.0f, 0.0f, 0.0f};
+    hasLastFootPosition_ = false;
+
+    bodyLeanAtContact_ = 0.0f;
+
+    contactPose_ = PoseFeatures();
+}
+
+k4abt_joint_id_t KickQualityAccumulator::footJoint() const {
+    return (foot_ == DominantFoot::Left) ? K4ABT_JOINT_FOOT_LEFT : K4ABT_JOINT_FOOT_RIGHT;
+}
+
+k4a_float3_t KickQualityAccumulator::averageRecentVelocity() const {
+    if (velocityCount_ == 0) {
+        return {0.0f, 0.0f, 0.0f};
+    }
+
+    k4a_float3_t sum = {0.0f, 0.0f, 0.0f};
+    for (size_t i = 0; i < velocityCount_; ++i) {
+        sum.xyz.x += recentVelocities_[i].xyz.x;
+        sum.xyz.y += recentVelocities_[i].xyz.y;
+        sum.xyz.z += recentVelocities_[i].xyz.z;
+    }
+
+    float inv = 1.0f / static_cast<float>(velocityCount_);
+    return {sum.xyz.x * inv, sum.xyz.y * inv, sum.xyz.z * inv};
+}
+
+} // namespace motion
+} // namespace kinect
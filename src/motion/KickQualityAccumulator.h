@@ -0,0 +1,107 @@
+#ifndef KINECT_FOOTBALL_KICK_QUALITY_ACCUMULATOR_H
+#define KINECT_FOOTBALL_KICK_QUALITY_ACCUMULATOR_H
+
+#include "PoseFeatures.h"
+#include "../../include/KickTypes.h"
+#include <k4abt.h>
+#include <array>
+#include <cstdint>
+
+namespace kinect {
+namespace motion {
+
+// Streaming accumulator for the raw biomechanical metrics of a single kick.
+// Fed one frame at a time from WindUp through FollowThrough so the finished
+// kick's quality can be produced in constant time, without rescanning the
+// motion histories. Per-frame cost is fixed and independent of kick length.
+class KickQualityAccumulator {
+public:
+    // Number of foot velocity samples averaged for the kick direction
+    static constexpr size_t DIRECTION_SAMPLES = 3;
+
+    KickQualityAccumulator();
+    ~KickQualityAccumulator() = default;
+
+    // Start accumulating a new kick with the given kicking foot
+    void begin(DominantFoot foot, uint64_t timestamp);
+
+    // Add one frame of an in-progress kick (phase must not be Idle)
+    void addFrame(const PoseFeatures& pose,
+                  const k4a_float3_t& footVelocity,
+                  KickPhase phase);
+
+    // Snapshot the pose and contact-time metrics
+    void markContact(const PoseFeatures& pose);
+
+    // Discard accumulated state
+    void reset();
+
+    // Accumulated state
+    bool isActive() const { return active_; }
+    bool hasContact() const { return hasContact_; }
+    DominantFoot getFoot() const { return foot_; }
+    uint64_t getStartTime() const { return startTime_; }
+    uint64_t getContactTime() const { return contactTime_; }
+    uint32_t getFrameCount() const { return frameCount_; }
+
+    // Power: peak foot speed seen during the swing (mm/s, tracker units)
+    float getPeakFootSpeed() const { return peakFootSpeed_; }
+
+    // Accuracy: unit kick direction and raw foot velocity at contact
+    k4a_float3_t getKickDirection() const { return kickDirection_; }
+    k4a_float3_t getContactVelocity() const { return contactVelocity_; }
+
+    // Technique: knee angle at contact (deg), hip rotation swept (deg),
+    // foot path length since contact (mm)
+    float getKneeAngleAtContact() const { return kneeAngleAtContact_; }
+    float getHipRotation() const { return maxHipYaw_ - minHipYaw_; }
+    float getFollowThroughLength() const { return followThroughLength_; }
+
+    // Balance: spine lean from vertical at contact (deg)
+    float getBodyLeanAtContact() const { return bodyLeanAtContact_; }
+
+    // Pose captured at contact (valid only if hasContact())
+    const PoseFeatures& getContactPose() const { return contactPose_; }
+    const k4abt_skeleton_t& getContactSkeleton() const { return contactPose_.getSkeleton(); }
+
+private:
+    bool active_;
+    bool hasContact_;
+    DominantFoot foot_;
+    uint64_t startTime_;
+    uint64_t contactTime_;
+    uint32_t frameCount_;
+
+    // Power
+    float peakFootSpeed_;
+
+    // Direction: fixed ring of the most recent foot velocities
+    std::array<k4a_float3_t, DIRECTION_SAMPLES> recentVelocities_;
+    size_t velocityIndex_;
+    size_t velocityCount_;
+    k4a_float3_t kickDirection_;
+    k4a_float3_t contactVelocity_;
+
+    // Technique
+    float kneeAngleAtContact_;
+    float baseHipYaw_;
+    float minHipYaw_;
+    float maxHipYaw_;
+    float followThroughLength_;
+    k4a_float3_t lastFootPosition_;
+    bool hasLastFootPosition_;
+
+    // Balance
+    float bodyLeanAtContact_;
+
+    PoseFeatures contactPose_;
+
+    // Per-frame metric helpers
+    k4abt_joint_id_t footJoint() const;
+    k4a_float3_t averageRecentVelocity() const;
+};
+
+} // namespace motion
+} // namespace kinect
+
+#endif // KINECT_FOOTBALL_KICK_QUALITY_ACCUMULATOR_H
@@ -4,6 +4,7 @@
 #include "KickDetector.h"
 #include "KickAnalyzer.h"
 #include "HeaderDetector.h"
+#include "MotionEventBus.h"
 #include "../core/BodyTracker.h"
 #include <iostream>
 #include <iomanip>
@@ -19,26 +20,29 @@ public:
         kickAnalyzer_ = std::make_unique<KickAnalyzer>();
         headerDetector_ = std::make_unique<HeaderDetector>();
 
-        // Set up callbacks
-        kickDetector_->setKickCallback([this](const KickResult& result) {
-            onKickDetected(result);
-        });
-
-        headerDetector_->setHeaderCallback([this](const HeaderResult& result) {
-            onHeaderDetected(result);
-        });
+        // Route detector results through the event bus so printing
+        // never runs inside the detectors' processSkeleton()
+        eventBus_.attach(*kickDetector_);
+        eventBus_.attach(*headerDetector_);
+        consoleEvents_ = eventBus_.subscribe("console",
+            motionEventBit(MotionEventType::Kick) | motionEventBit(MotionEventType::Header));
 
         // Configure target zone for accuracy scoring
         TargetZone target;
         target.center = {0.0f, 1.5f, 3.0f}; // 3 meters forward, 1.5m high
         target.radius = 0.5f;                // 0.5m radius
         kickAnalyzer_->setTargetZone(target);
+        kickDetector_->setTargetZone(target);
     }
 
     void processFrame(const k4abt_skeleton_t& skeleton, uint64_t timestamp) {
-        // Update both detectors with every frame
-        kickDetector_->processSkeleton(skeleton, timestamp);
-        headerDetector_->processSkeleton(skeleton, timestamp);
+        // Derive pose features once and share them between both detectors
+        pose_.reset(skeleton, timestamp);
+        kickDetector_->processFrame(pose_);
+        headerDetector_->processFrame(pose_);
+
+        // Consume events (in a real app this runs on the consumer's thread)
+        drainEvents();
 
         // Log current detection state
         logDetectionState();
@@ -48,6 +52,25 @@ private:
     std::unique_ptr<KickDetector> kickDetector_;
     std::unique_ptr<KickAnalyzer> kickAnalyzer_;
     std::unique_ptr<HeaderDetector> headerDetector_;
+    PoseFeatures pose_;
+    MotionEventBus eventBus_;
+    MotionSubscription* consoleEvents_ = nullptr;
+
+    void drainEvents() {
+        MotionEvent event;
+        while (consoleEvents_->poll(event)) {
+            if (event.type == MotionEventType::Kick) {
+                onKickDetected(event.kick);
+            } else if (event.type == MotionEventType::Header) {
+                onHeaderDetected(event.header);
+            }
+        }
+
+        if (consoleEvents_->getDropped() > 0) {
+            std::cout << "[Bus] console dropped " << consoleEvents_->getDropped()
+                      << " events, max lag " << consoleEvents_->getMaxLagUs() << " us\n";
+        }
+    }
 
     void onKickDetected(const KickResult& result) {
         std::cout << "\n========== KICK DETECTED ==========\n";
@@ -57,7 +80,7 @@ private:
 
         std::cout << "\n--- Quality Metrics ---\n";
         std::cout << std::fixed << std::setprecision(2);
-        std::cout << "Foot Velocity: " << result.quality.footVelocity << " m/s\n";
+        std::cout << "Foot Velocity: " << result.quality.footVelocity / 1000.0f << " m/s\n";
         std::cout << "Ball Speed: " << result.quality.estimatedBallSpeed << " km/h\n";
         std::cout << "Power Score: " << result.quality.powerScore << "/100\n";
 
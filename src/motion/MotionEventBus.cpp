@@ -0,0 +1,175 @@
+#include "MotionEventBus.h"
+#include "../../include/common.h"
+#include <chrono>
+
+namespace kinect {
+namespace motion {
+
+uint64_t motionEventClockUs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// ============================================================================
+// MotionSubscription
+// ============================================================================
+
+MotionSubscription::MotionSubscription(const std::string& name, uint32_t eventMask)
+    : name_(name)
+    , eventMask_(eventMask)
+    , droppedMetric_(core::MetricsRegistry::global().counter(
+          "kinect_motion_events_dropped_total", "Motion events lost because a subscriber queue was full",
+          {{"subscriber", name}}))
+{
+}
+
+bool MotionSubscription::poll(MotionEvent& event) {
+    if (!queue_.pop(event)) {
+        return false;
+    }
+
+    // Lag between publish and consumption, measured on the consumer side
+    uint64_t now = motionEventClockUs();
+    uint64_t lag = now > event.publishTime ? now - event.publishTime : 0;
+    if (lag > maxLagUs_.load(std::memory_order_relaxed)) {
+        maxLagUs_.store(lag, std::memory_order_relaxed);
+    }
+
+    delivered_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void MotionSubscription::offer(const MotionEvent& event) {
+    if (!queue_.push(event)) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        droppedMetric_.inc();
+        return;
+    }
+
+    size_t depth = queue_.size();
+    if (depth > maxDepth_.load(std::memory_order_relaxed)) {
+        maxDepth_.store(depth, std::memory_order_relaxed);
+    }
+}
+
+// ============================================================================
+// MotionEventBus
+// ============================================================================
+
+MotionEventBus::MotionEventBus()
+    : subscriberCount_(0)
+    , published_(0)
+    , deviceTimestamp_(0)
+    , kicksCounter_(core::MetricsRegistry::global().counter(HealthMetrics::KICKS_DETECTED, "Kicks published by the detector"))
+    , headersCounter_(core::MetricsRegistry::global().counter("kinect_headers_detected_total", "Headers published by the detector"))
+{
+}
+
+MotionSubscription* MotionEventBus::subscribe(const std::string& name, uint32_t eventMask) {
+    std::lock_guard<std::mutex> lock(subscribeMutex_);
+
+    size_t count = subscriberCount_.load(std::memory_order_relaxed);
+    if (count >= MAX_SUBSCRIBERS) {
+        return nullptr;
+    }
+
+    // Slot is fully constructed before the publisher can see it
+    subscribers_[count] = std::make_unique<MotionSubscription>(name, eventMask);
+    subscriberCount_.store(count + 1, std::memory_order_release);
+    return subscribers_[count].get();
+}
+
+void MotionEventBus::attach(KickDetector& detector) {
+    detector.setKickCallback([this](const KickResult& result) {
+        publishKick(result);
+    });
+}
+
+void MotionEventBus::attach(HeaderDetector& detector) {
+    detector.setHeaderCallback([this](const HeaderResult& result) {
+        publishHeader(result);
+    });
+}
+
+void MotionEventBus::attach(core::PlayerTracker& tracker) {
+    tracker.setPlayerEnterCallback([this](const core::PlayerData& player) {
+        publishPlayerEnter(player);
+    });
+    tracker.setPlayerExitCallback([this](const core::PlayerData& player) {
+        publishPlayerExit(player);
+    });
+}
+
+void MotionEventBus::publishKick(const KickResult& result) {
+    MotionEvent event;
+    event.type = MotionEventType::Kick;
+    event.deviceTimestamp = result.timestamp;
+    event.kick = result;
+    kicksCounter_.inc();
+    publish(event);
+}
+
+void MotionEventBus::publishHeader(const HeaderResult& result) {
+    MotionEvent event;
+    event.type = MotionEventType::Header;
+    event.deviceTimestamp = result.timestamp;
+    event.header = result;
+    headersCounter_.inc();
+    publish(event);
+}
+
+void MotionEventBus::publishPlayerEnter(const core::PlayerData& player) {
+    MotionEvent event;
+    event.type = MotionEventType::PlayerEnter;
+    event.deviceTimestamp = deviceTimestamp_;
+    event.player = toPlayerEvent(player);
+    publish(event);
+}
+
+void MotionEventBus::publishPlayerExit(const core::PlayerData& player) {
+    MotionEvent event;
+    event.type = MotionEventType::PlayerExit;
+    event.deviceTimestamp = deviceTimestamp_;
+    event.player = toPlayerEvent(player);
+    publish(event);
+}
+
+void MotionEventBus::publish(MotionEvent& event) {
+    event.publishTime = motionEventClockUs();
+    published_.fetch_add(1, std::memory_order_relaxed);
+
+    size_t count = subscriberCount_.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; ++i) {
+        MotionSubscription* sub = subscribers_[i].get();
+        if (sub->isActive() && sub->accepts(event.type)) {
+            sub->offer(event);
+        }
+    }
+}
+
+uint64_t MotionEventBus::getTotalDropped() const {
+    uint64_t total = 0;
+    size_t count = subscriberCount_.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; ++i) {
+        total += subscribers_[i]->getDropped();
+    }
+    return total;
+}
+
+const MotionSubscription* MotionEventBus::getSubscriber(size_t index) const {
+    if (index >= subscriberCount_.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+    return subscribers_[index].get();
+}
+
+PlayerEvent MotionEventBus::toPlayerEvent(const core::PlayerData& player) {
+    PlayerEvent event;
+    event.bodyId = player.bodyId;
+    event.zone = player.zone;
+    event.playerNumber = player.playerNumber;
+    return event;
+}
+
+} // namespace motion
+} // namespace kinect
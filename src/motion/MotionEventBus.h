@@ -0,0 +1,158 @@
+#ifndef KINECT_FOOTBALL_MOTION_EVENT_BUS_H
+#define KINECT_FOOTBALL_MOTION_EVENT_BUS_H
+
+#include "KickDetector.h"
+#include "HeaderDetector.h"
+#include "../core/PlayerTracker.h"
+#include "../core/SpscQueue.h"
+#include "../core/Metrics.h"
+#include "../../include/KickTypes.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace kinect {
+namespace motion {
+
+// Event categories carried on the bus
+enum class MotionEventType : uint8_t {
+    Kick,
+    Header,
+    PlayerEnter,
+    PlayerExit
+};
+
+// Subscription filter bits
+inline uint32_t motionEventBit(MotionEventType type) {
+    return 1u << static_cast<uint32_t>(type);
+}
+
+static constexpr uint32_t ALL_MOTION_EVENTS = 0xFu;
+
+// Player identity for enter/exit events
+struct PlayerEvent {
+    uint32_t bodyId;
+    core::PlayerZone zone;
+    int playerNumber;
+
+    PlayerEvent() : bodyId(0), zone(core::PlayerZone::Unknown), playerNumber(0) {}
+};
+
+// Single event; only the payload matching `type` is meaningful
+struct MotionEvent {
+    MotionEventType type;
+    uint64_t deviceTimestamp;   // microseconds, Kinect device clock
+    uint64_t publishTime;       // microseconds, steady clock (for lag)
+    KickResult kick;
+    HeaderResult header;
+    PlayerEvent player;
+
+    MotionEvent() : type(MotionEventType::Kick), deviceTimestamp(0), publishTime(0) {}
+};
+
+// Per-subscriber bounded queue plus health counters. The analysis thread
+// is the only producer; the owning consumer is the only reader.
+class MotionSubscription {
+public:
+    static constexpr size_t QUEUE_SIZE = 64;
+
+    MotionSubscription(const std::string& name, uint32_t eventMask);
+
+    // Pop next event (consumer thread). Returns false when drained.
+    bool poll(MotionEvent& event);
+
+    // Stop receiving events; the subscription object stays valid
+    void cancel() { active_.store(false, std::memory_order_release); }
+
+    const std::string& getName() const { return name_; }
+    bool isActive() const { return active_.load(std::memory_order_acquire); }
+    bool accepts(MotionEventType type) const { return (eventMask_ & motionEventBit(type)) != 0; }
+
+    // Consumer health: dropped events and queue/latency high-water marks
+    uint64_t getDelivered() const { return delivered_.load(std::memory_order_relaxed); }
+    uint64_t getDropped() const { return dropped_.load(std::memory_order_relaxed); }
+    size_t getPending() const { return queue_.size(); }
+    size_t getMaxDepth() const { return maxDepth_.load(std::memory_order_relaxed); }
+    uint64_t getMaxLagUs() const { return maxLagUs_.load(std::memory_order_relaxed); }
+
+private:
+    friend class MotionEventBus;
+
+    // Producer side: never blocks, counts a drop when full
+    void offer(const MotionEvent& event);
+
+    std::string name_;
+    uint32_t eventMask_;
+    std::atomic<bool> active_{true};
+    core::SpscQueue<MotionEvent, QUEUE_SIZE> queue_;
+
+    std::atomic<uint64_t> delivered_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<size_t> maxDepth_{0};
+    std::atomic<uint64_t> maxLagUs_{0};
+    core::Counter& droppedMetric_;    // Same drops, labelled by subscriber
+};
+
+// Fan-out of detector and player-tracker events to decoupled consumers.
+// Detector callbacks only copy the result into each subscriber's queue,
+// so a slow consumer loses its own events but never stalls detection.
+class MotionEventBus {
+public:
+    static constexpr size_t MAX_SUBSCRIBERS = 8;
+
+    MotionEventBus();
+    ~MotionEventBus() = default;
+
+    MotionEventBus(const MotionEventBus&) = delete;
+    MotionEventBus& operator=(const MotionEventBus&) = delete;
+
+    // Register a consumer. Returned pointer lives as long as the bus;
+    // nullptr if all subscriber slots are taken.
+    MotionSubscription* subscribe(const std::string& name, uint32_t eventMask = ALL_MOTION_EVENTS);
+
+    // Route detector/tracker callbacks onto the bus (replaces their callbacks)
+    void attach(KickDetector& detector);
+    void attach(HeaderDetector& detector);
+    void attach(core::PlayerTracker& tracker);
+
+    // Device time of the body frame being processed, used to stamp
+    // player enter/exit events (PlayerTracker has no device clock)
+    void setDeviceTimestamp(uint64_t timestamp) { deviceTimestamp_ = timestamp; }
+
+    // Publish (analysis thread only)
+    void publishKick(const KickResult& result);
+    void publishHeader(const HeaderResult& result);
+    void publishPlayerEnter(const core::PlayerData& player);
+    void publishPlayerExit(const core::PlayerData& player);
+    void publish(MotionEvent& event);
+
+    // Totals across all subscribers
+    uint64_t getPublished() const { return published_.load(std::memory_order_relaxed); }
+    uint64_t getTotalDropped() const;
+    size_t getSubscriberCount() const { return subscriberCount_.load(std::memory_order_acquire); }
+    const MotionSubscription* getSubscriber(size_t index) const;
+
+private:
+    std::array<std::unique_ptr<MotionSubscription>, MAX_SUBSCRIBERS> subscribers_;
+    std::atomic<size_t> subscriberCount_;
+    std::mutex subscribeMutex_;
+
+    std::atomic<uint64_t> published_;
+    uint64_t deviceTimestamp_;
+
+    core::Counter& kicksCounter_;
+    core::Counter& headersCounter_;
+
+    static PlayerEvent toPlayerEvent(const core::PlayerData& player);
+};
+
+// Steady clock in microseconds, shared by publisher and consumers
+uint64_t motionEventClockUs();
+
+} // namespace motion
+} // namespace kinect
+
+#endif // KINECT_FOOTBALL_MOTION_EVENT_BUS_H
@@ -0,0 +1,224 @@
+#include "PoseFeatures.h"
+#include <algorithm>
+#include <cmath>
+#include "../../include/VectorMath.h"
+
+namespace kinect {
+namespace motion {
+
+namespace {
+constexpr float RAD_TO_DEG = 180.0f / 3.14159265359f;
+
+k4a_float3_t midpoint(const k4a_float3_t& a, const k4a_float3_t& b) {
+    return {(a.xyz.x + b.xyz.x) * 0.5f, (a.xyz.y + b.xyz.y) * 0.5f, (a.xyz.z + b.xyz.z) * 0.5f};
+}
+
+// Segment mass fractions (Dempster), applied at segment midpoints
+struct Segment {
+    k4abt_joint_id_t from;
+    k4abt_joint_id_t to;
+    float mass;
+};
+
+const Segment MASS_SEGMENTS[] = {
+    {K4ABT_JOINT_NECK,           K4ABT_JOINT_HEAD,        0.081f},
+    {K4ABT_JOINT_PELVIS,         K4ABT_JOINT_SPINE_CHEST, 0.497f},
+    {K4ABT_JOINT_SHOULDER_LEFT,  K4ABT_JOINT_ELBOW_LEFT,  0.028f},
+    {K4ABT_JOINT_SHOULDER_RIGHT, K4ABT_JOINT_ELBOW_RIGHT, 0.028f},
+    {K4ABT_JOINT_ELBOW_LEFT,     K4ABT_JOINT_WRIST_LEFT,  0.022f},
+    {K4ABT_JOINT_ELBOW_RIGHT,    K4ABT_JOINT_WRIST_RIGHT, 0.022f},
+    {K4ABT_JOINT_HIP_LEFT,       K4ABT_JOINT_KNEE_LEFT,   0.100f},
+    {K4ABT_JOINT_HIP_RIGHT,      K4ABT_JOINT_KNEE_RIGHT,  0.100f},
+    {K4ABT_JOINT_KNEE_LEFT,      K4ABT_JOINT_FOOT_LEFT,   0.061f},
+    {K4ABT_JOINT_KNEE_RIGHT,     K4ABT_JOINT_FOOT_RIGHT,  0.061f},
+};
+
+const k4abt_joint_id_t HIP[2] = {K4ABT_JOINT_HIP_LEFT, K4ABT_JOINT_HIP_RIGHT};
+const k4abt_joint_id_t KNEE[2] = {K4ABT_JOINT_KNEE_LEFT, K4ABT_JOINT_KNEE_RIGHT};
+const k4abt_joint_id_t ANKLE[2] = {K4ABT_JOINT_ANKLE_LEFT, K4ABT_JOINT_ANKLE_RIGHT};
+const k4abt_joint_id_t SHOULDER[2] = {K4ABT_JOINT_SHOULDER_LEFT, K4ABT_JOINT_SHOULDER_RIGHT};
+const k4abt_joint_id_t ELBOW[2] = {K4ABT_JOINT_ELBOW_LEFT, K4ABT_JOINT_ELBOW_RIGHT};
+const k4abt_joint_id_t WRIST[2] = {K4ABT_JOINT_WRIST_LEFT, K4ABT_JOINT_WRIST_RIGHT};
+
+// Up in camera space: the tracker's Y axis points down
+const k4a_float3_t VERTICAL = {0.0f, -1.0f, 0.0f};
+} // namespace
+
+PoseFeatures::PoseFeatures()
+    : timestamp_(0)
+    , computed_(0)
+{
+    skeleton_ = {};
+}
+
+PoseFeatures::PoseFeatures(const k4abt_skeleton_t& skeleton, uint64_t timestamp)
+    : skeleton_(skeleton)
+    , timestamp_(timestamp)
+    , computed_(0)
+{
+}
+
+void PoseFeatures::reset(const k4abt_skeleton_t& skeleton, uint64_t timestamp) {
+    skeleton_ = skeleton;
+    timestamp_ = timestamp;
+    computed_ = 0;
+}
+
+float PoseFeatures::getKneeAngle(DominantFoot side) const {
+    if (!isComputed(KNEE_ANGLE)) {
+        for (int s = 0; s < 2; ++s) {
+            kneeAngle_[s] = jointAngle(getJoint(HIP[s]), getJoint(KNEE[s]), getJoint(ANKLE[s]));
+        }
+        markComputed(KNEE_ANGLE);
+    }
+    return kneeAngle_[sideIndex(side)];
+}
+
+float PoseFeatures::getHipFlexion(DominantFoot side) const {
+    if (!isComputed(HIP_FLEXION)) {
+        for (int s = 0; s < 2; ++s) {
+            hipFlexion_[s] = jointAngle(getJoint(K4ABT_JOINT_SPINE_NAVEL), getJoint(HIP[s]), getJoint(KNEE[s]));
+        }
+        markComputed(HIP_FLEXION);
+    }
+    return hipFlexion_[sideIndex(side)];
+}
+
+float PoseFeatures::getElbowAngle(DominantFoot side) const {
+    if (!isComputed(ELBOW_ANGLE)) {
+        for (int s = 0; s < 2; ++s) {
+            elbowAngle_[s] = jointAngle(getJoint(SHOULDER[s]), getJoint(ELBOW[s]), getJoint(WRIST[s]));
+        }
+        markComputed(ELBOW_ANGLE);
+    }
+    return elbowAngle_[sideIndex(side)];
+}
+
+float PoseFeatures::getNeckAngle() const {
+    if (!isComputed(NECK_ANGLE)) {
+        const k4a_float3_t& neck = getJoint(K4ABT_JOINT_NECK);
+        neckAngle_ = math::angleBetween(
+            math::subtract(getJoint(K4ABT_JOINT_HEAD), neck),
+            math::subtract(neck, getJoint(K4ABT_JOINT_SPINE_CHEST))
+        );
+        markComputed(NECK_ANGLE);
+    }
+    return neckAngle_;
+}
+
+float PoseFeatures::getThighLength(DominantFoot side) const {
+    computeSegments();
+    return thighLength_[sideIndex(side)];
+}
+
+float PoseFeatures::getShinLength(DominantFoot side) const {
+    computeSegments();
+    return shinLength_[sideIndex(side)];
+}
+
+float PoseFeatures::getLegLength(DominantFoot side) const {
+    computeSegments();
+    return legLength_[sideIndex(side)];
+}
+
+float PoseFeatures::getTorsoLength() const {
+    computeSegments();
+    return torsoLength_;
+}
+
+float PoseFeatures::getBodyLean() const {
+    if (!isComputed(BODY_LEAN)) {
+        bodyLean_ = math::angleBetween(
+            math::subtract(getJoint(K4ABT_JOINT_SPINE_CHEST), getJoint(K4ABT_JOINT_PELVIS)),
+            VERTICAL
+        );
+        markComputed(BODY_LEAN);
+    }
+    return bodyLean_;
+}
+
+float PoseFeatures::getHeadLean() const {
+    if (!isComputed(HEAD_LEAN)) {
+        headLean_ = math::angleBetween(
+            math::subtract(getJoint(K4ABT_JOINT_HEAD), getJoint(K4ABT_JOINT_PELVIS)),
+            VERTICAL
+        );
+        markComputed(HEAD_LEAN);
+    }
+    return headLean_;
+}
+
+k4a_float3_t PoseFeatures::getTorsoDirection() const {
+    if (!isComputed(TORSO_DIRECTION)) {
+        torsoDirection_ = math::normalize(
+            math::subtract(getJoint(K4ABT_JOINT_SPINE_CHEST), getJoint(K4ABT_JOINT_PELVIS)));
+        markComputed(TORSO_DIRECTION);
+    }
+    return torsoDirection_;
+}
+
+float PoseFeatures::getHipYaw() const {
+    if (!isComputed(HIP_YAW)) {
+        hipYaw_ = lineYaw(getJoint(K4ABT_JOINT_HIP_LEFT), getJoint(K4ABT_JOINT_HIP_RIGHT));
+        markComputed(HIP_YAW);
+    }
+    return hipYaw_;
+}
+
+float PoseFeatures::getShoulderYaw() const {
+    if (!isComputed(SHOULDER_YAW)) {
+        shoulderYaw_ = lineYaw(getJoint(K4ABT_JOINT_SHOULDER_LEFT), getJoint(K4ABT_JOINT_SHOULDER_RIGHT));
+        markComputed(SHOULDER_YAW);
+    }
+    return shoulderYaw_;
+}
+
+float PoseFeatures::getHipShoulderSeparation() const {
+    float separation = getShoulderYaw() - getHipYaw();
+    while (separation >= 180.0f) separation -= 360.0f;
+    while (separation < -180.0f) separation += 360.0f;
+    return separation;
+}
+
+k4a_float3_t PoseFeatures::getCenterOfMass() const {
+    if (!isComputed(CENTER_OF_MASS)) {
+        k4a_float3_t sum = {0.0f, 0.0f, 0.0f};
+        for (const Segment& segment : MASS_SEGMENTS) {
+            k4a_float3_t mid = midpoint(getJoint(segment.from), getJoint(segment.to));
+            sum.xyz.x += mid.xyz.x * segment.mass;
+            sum.xyz.y += mid.xyz.y * segment.mass;
+            sum.xyz.z += mid.xyz.z * segment.mass;
+        }
+        centerOfMass_ = sum; // Mass fractions sum to 1
+        markComputed(CENTER_OF_MASS);
+    }
+    return centerOfMass_;
+}
+
+void PoseFeatures::computeSegments() const {
+    if (isComputed(SEGMENTS)) {
+        return;
+    }
+
+    for (int s = 0; s < 2; ++s) {
+        thighLength_[s] = math::magnitude(math::subtract(getJoint(KNEE[s]), getJoint(HIP[s])));
+        shinLength_[s] = math::magnitude(math::subtract(getJoint(ANKLE[s]), getJoint(KNEE[s])));
+        legLength_[s] = math::magnitude(math::subtract(getJoint(ANKLE[s]), getJoint(HIP[s])));
+    }
+    torsoLength_ = math::magnitude(
+        math::subtract(getJoint(K4ABT_JOINT_SPINE_CHEST), getJoint(K4ABT_JOINT_PELVIS)));
+
+    markComputed(SEGMENTS);
+}
+
+float PoseFeatures::jointAngle(const k4a_float3_t& a, const k4a_float3_t& b, const k4a_float3_t& c) {
+    return math::angleBetween(math::subtract(a, b), math::subtract(c, b));
+}
+
+float PoseFeatures::lineYaw(const k4a_float3_t& from, const k4a_float3_t& to) {
+    k4a_float3_t line = math::subtract(to, from);
+    return std::atan2(line.xyz.z, line.xyz.x) * RAD_TO_DEG;
+}
+
+} // namespace motion
+} // namespace kinect
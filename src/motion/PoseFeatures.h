@@ -0,0 +1,108 @@
+#ifndef KINECT_FOOTBALL_POSE_FEATURES_H
+#define KINECT_FOOTBALL_POSE_FEATURES_H
+
+#include "../../include/KickTypes.h"
+#include <k4abt.h>
+#include <cstdint>
+
+namespace kinect {
+namespace motion {
+
+// Derived pose features for one skeleton frame. Built once per frame by
+// whoever owns the skeleton and passed by const reference to detectors,
+// analyzers and challenges. Each feature is computed on first access and
+// memoized until the next reset(), so consumers that ask for the same
+// value (e.g. knee angle) share one computation.
+class PoseFeatures {
+public:
+    PoseFeatures();
+    PoseFeatures(const k4abt_skeleton_t& skeleton, uint64_t timestamp);
+    ~PoseFeatures() = default;
+
+    // Load a new frame and invalidate all cached features
+    void reset(const k4abt_skeleton_t& skeleton, uint64_t timestamp);
+
+    // Raw frame access
+    const k4abt_skeleton_t& getSkeleton() const { return skeleton_; }
+    uint64_t getTimestamp() const { return timestamp_; }
+    const k4a_float3_t& getJoint(k4abt_joint_id_t joint) const {
+        return skeleton_.joints[joint].position;
+    }
+    bool isJointTracked(k4abt_joint_id_t joint) const {
+        return skeleton_.joints[joint].confidence_level >= K4ABT_JOINT_CONFIDENCE_LOW;
+    }
+
+    // Joint angles (degrees); side selects the left or right limb
+    float getKneeAngle(DominantFoot side) const;     // hip-knee-ankle
+    float getHipFlexion(DominantFoot side) const;    // naval-hip-knee
+    float getElbowAngle(DominantFoot side) const;    // shoulder-elbow-wrist
+    float getNeckAngle() const;                      // chest-neck vs neck-head
+
+    // Segment lengths (skeleton units)
+    float getThighLength(DominantFoot side) const;
+    float getShinLength(DominantFoot side) const;
+    float getLegLength(DominantFoot side) const;     // hip to ankle
+    float getTorsoLength() const;                    // pelvis to chest
+
+    // Lean from vertical (degrees)
+    float getBodyLean() const;                       // pelvis -> spine chest
+    float getHeadLean() const;                       // pelvis -> head
+    k4a_float3_t getTorsoDirection() const;          // unit pelvis -> chest
+
+    // Horizontal (XZ) heading of the hip and shoulder lines (degrees)
+    float getHipYaw() const;
+    float getShoulderYaw() const;
+    float getHipShoulderSeparation() const;          // shoulder - hip, wrapped
+
+    // Mass-weighted segment centroid
+    k4a_float3_t getCenterOfMass() const;
+
+private:
+    enum Feature : uint32_t {
+        KNEE_ANGLE      = 1u << 0,
+        HIP_FLEXION     = 1u << 1,
+        ELBOW_ANGLE     = 1u << 2,
+        NECK_ANGLE      = 1u << 3,
+        SEGMENTS        = 1u << 4,
+        BODY_LEAN       = 1u << 5,
+        HEAD_LEAN       = 1u << 6,
+        TORSO_DIRECTION = 1u << 7,
+        HIP_YAW         = 1u << 8,
+        SHOULDER_YAW    = 1u << 9,
+        CENTER_OF_MASS  = 1u << 10
+    };
+
+    k4abt_skeleton_t skeleton_;
+    uint64_t timestamp_;
+
+    // Memoized values, valid when the matching bit is set
+    mutable uint32_t computed_;
+    mutable float kneeAngle_[2];
+    mutable float hipFlexion_[2];
+    mutable float elbowAngle_[2];
+    mutable float neckAngle_;
+    mutable float thighLength_[2];
+    mutable float shinLength_[2];
+    mutable float legLength_[2];
+    mutable float torsoLength_;
+    mutable float bodyLean_;
+    mutable float headLean_;
+    mutable k4a_float3_t torsoDirection_;
+    mutable float hipYaw_;
+    mutable float shoulderYaw_;
+    mutable k4a_float3_t centerOfMass_;
+
+    bool isComputed(Feature feature) const { return (computed_ & feature) != 0; }
+    void markComputed(Feature feature) const { computed_ |= feature; }
+
+    void computeSegments() const;
+
+    static int sideIndex(DominantFoot side) { return side == DominantFoot::Left ? 0 : 1; }
+    static float jointAngle(const k4a_float3_t& a, const k4a_float3_t& b, const k4a_float3_t& c);
+    static float lineYaw(const k4a_float3_t& from, const k4a_float3_t& to);
+};
+
+} // namespace motion
+} // namespace kinect
+
+#endif // KINECT_FOOTBALL_POSE_FEATURES_H
@@ -0,0 +1,160 @@
+// Kick classifier check on tracker-unit input
+//
+// Streams one synthetic kick per class through KickQualityAccumulator the
+// way KickDetector does: joint positions in millimeters, foot velocity in
+// millimeters per second, Kinect camera axes (y down, z away from the
+// sensor, player seen from behind). Each kick is shaped after the class
+// prior the shipped model was trained on, so it must come back as its own
+// class; a unit slip between the tracker and the model's meters collapses
+// them onto one.
+//
+// Usage:
+//   kick_classifier_test
+
+#include "../src/motion/KickClassifier.h"
+#include "../src/motion/KickQualityAccumulator.h"
+#include <cmath>
+#include <cstdio>
+
+using namespace kinect;
+using namespace kinect::motion;
+
+namespace {
+
+constexpr float DEG_TO_RAD = 3.14159265f / 180.0f;
+constexpr float THIGH_MM = 450.0f;
+constexpr float SHIN_MM = 430.0f;
+constexpr int SWING_FRAMES = 8;
+constexpr int FOLLOW_FRAMES = 8;
+constexpr uint64_t FRAME_US = 33333;
+
+// Contact-time shape of one kick, in the units the model documents
+struct KickProfile {
+    const char* name;
+    KickType expected;
+    float kneeAngle;      // degrees
+    float footSpeed;      // m/s
+    float lateral;        // |vx| / (|vx| + |vz|)
+    float directionY;
+    float hipRotation;    // degrees swept
+    float followThrough;  // m
+    float bodyLean;       // degrees
+    float footHeight;     // (pelvis - foot) / leg length, y down
+};
+
+// Means of the synthetic priors in tools/train_kick_classifier.cpp
+const KickProfile PROFILES[] = {
+    {"instep", KickType::Instep, 160.0f, 7.0f, 0.10f, 0.10f, 35.0f, 0.60f, 12.0f, -0.85f},
+    {"sidefoot", KickType::SideFootPass, 115.0f, 3.5f, 0.30f, 0.00f, 45.0f, 0.35f, 8.0f, -0.85f},
+    {"outside", KickType::Outside, 140.0f, 5.0f, 0.60f, 0.05f, 20.0f, 0.40f, 15.0f, -0.85f},
+    {"toe", KickType::Toe, 135.0f, 6.5f, 0.08f, 0.05f, 15.0f, 0.20f, 18.0f, -0.90f},
+    {"volley", KickType::Volley, 150.0f, 6.0f, 0.15f, 0.30f, 40.0f, 0.50f, 25.0f, -0.35f},
+};
+
+void setJoint(k4abt_skeleton_t& skeleton, k4abt_joint_id_t joint, float x, float y, float z) {
+    skeleton.joints[joint].position = {x, y, z};
+    skeleton.joints[joint].confidence_level = K4ABT_JOINT_CONFIDENCE_MEDIUM;
+}
+
+// Right leg swung thighSwing degrees forward of straight down, knee bent
+// to the profile's angle; the foot trails footAdvance mm along +z
+k4abt_skeleton_t makeSkeleton(const KickProfile& profile, float hipYaw, float thighSwing, float footAdvance) {
+    k4abt_skeleton_t skeleton = {};
+    const float pelvis[3] = {0.0f, 0.0f, 2500.0f};
+    setJoint(skeleton, K4ABT_JOINT_PELVIS, pelvis[0], pelvis[1], pelvis[2]);
+
+    float lean = profile.bodyLean * DEG_TO_RAD;
+    setJoint(skeleton, K4ABT_JOINT_SPINE_CHEST, pelvis[0], pelvis[1] - 400.0f * std::cos(lean),
+             pelvis[2] + 400.0f * std::sin(lean));
+
+    float yaw = hipYaw * DEG_TO_RAD;
+    float hx = 100.0f * std::cos(yaw);
+    float hz = 100.0f * std::sin(yaw);
+    setJoint(skeleton, K4ABT_JOINT_HIP_LEFT, pelvis[0] - hx, pelvis[1], pelvis[2] - hz);
+    setJoint(skeleton, K4ABT_JOINT_HIP_RIGHT, pelvis[0] + hx, pelvis[1], pelvis[2] + hz);
+
+    const k4a_float3_t hip = skeleton.joints[K4ABT_JOINT_HIP_RIGHT].position;
+    float thigh = thighSwing * DEG_TO_RAD;
+    float shin = thigh - (180.0f - profile.kneeAngle) * DEG_TO_RAD;
+    float kx = hip.xyz.x;
+    float ky = hip.xyz.y + THIGH_MM * std::cos(thigh);
+    float kz = hip.xyz.z + THIGH_MM * std::sin(thigh);
+    float ay = ky + SHIN_MM * std::cos(shin);
+    float az = kz + SHIN_MM * std::sin(shin) + footAdvance;
+    setJoint(skeleton, K4ABT_JOINT_KNEE_RIGHT, kx, ky, kz);
+    setJoint(skeleton, K4ABT_JOINT_ANKLE_RIGHT, kx, ay, az);
+    setJoint(skeleton, K4ABT_JOINT_FOOT_RIGHT, kx, ay, az + 80.0f);
+    return skeleton;
+}
+
+// Thigh swing that puts the foot at the profile's height
+float thighSwingFor(const KickProfile& profile) {
+    float best = 0.0f;
+    float bestError = 1e9f;
+    for (float swing = -40.0f; swing <= 120.0f; swing += 0.5f) {
+        PoseFeatures pose(makeSkeleton(profile, 0.0f, swing, 0.0f), 0);
+        const k4a_float3_t& foot = pose.getJoint(K4ABT_JOINT_FOOT_RIGHT);
+        float height = (pose.getJoint(K4ABT_JOINT_PELVIS).xyz.y - foot.xyz.y) / pose.getLegLength(DominantFoot::Right);
+        float error = std::abs(height - profile.footHeight);
+        if (error < bestError) {
+            bestError = error;
+            best = swing;
+        }
+    }
+    return best;
+}
+
+KickType runKick(const KickProfile& profile, KickClassifier::Features& features) {
+    float swing = thighSwingFor(profile);
+
+    // Tracker units: millimeters per second
+    float speed = profile.footSpeed * 1000.0f;
+    float dz = 1.0f - profile.lateral;
+    float length = std::sqrt(profile.lateral * profile.lateral + profile.directionY * profile.directionY + dz * dz);
+    k4a_float3_t velocity = {speed * profile.lateral / length, speed * profile.directionY / length, speed * dz / length};
+
+    KickQualityAccumulator accumulator;
+    uint64_t timestamp = 1000000;
+    accumulator.begin(DominantFoot::Right, timestamp);
+
+    PoseFeatures pose;
+    for (int i = 0; i < SWING_FRAMES; ++i) {
+        float yaw = profile.hipRotation * i / (SWING_FRAMES - 1);
+        pose.reset(makeSkeleton(profile, yaw, swing, 0.0f), timestamp);
+        accumulator.addFrame(pose, velocity, i < 2 ? KickPhase::WindUp : KickPhase::Acceleration);
+        timestamp += FRAME_US;
+    }
+    accumulator.markContact(pose);
+
+    // Follow-through path in millimeters
+    float step = profile.followThrough * 1000.0f / FOLLOW_FRAMES;
+    for (int i = 1; i <= FOLLOW_FRAMES; ++i) {
+        timestamp += FRAME_US;
+        pose.reset(makeSkeleton(profile, profile.hipRotation, swing, step * i), timestamp);
+        accumulator.addFrame(pose, {0.0f, 0.0f, step * 30.0f}, KickPhase::FollowThrough);
+    }
+
+    features = KickClassifier::extractFeatures(accumulator);
+    return KickClassifier::classify(features);
+}
+
+} // namespace
+
+int main() {
+    int failures = 0;
+    for (const auto& profile : PROFILES) {
+        KickClassifier::Features features;
+        KickType type = runKick(profile, features);
+        bool ok = type == profile.expected;
+        failures += ok ? 0 : 1;
+        std::printf("%-9s speed %5.2f follow %4.2f knee %5.1f height %5.2f -> %-9s %s\n", profile.name,
+                    features[KickClassifier::PEAK_FOOT_SPEED], features[KickClassifier::FOLLOW_THROUGH],
+                    features[KickClassifier::KNEE_ANGLE], features[KickClassifier::FOOT_HEIGHT],
+                    KickClassifier::classLabel(static_cast<size_t>(type)), ok ? "ok" : "WRONG");
+    }
+
+    std::printf("%s: %d of %zu kicks classified as their own type\n", failures == 0 ? "PASS" : "FAIL",
+                static_cast<int>(sizeof(PROFILES) / sizeof(PROFILES[0])) - failures,
+                sizeof(PROFILES) / sizeof(PROFILES[0]));
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,591 @@
+// Headless game loop benchmark
+//
+// Drives GameManager through full Accuracy, Power and Penalty Shootout
+// sessions with a synthetic skeleton that kicks at a varying pace and
+// strength, and times every processFrame() call. Nothing is rendered and
+// no OpenCV or display is needed. Reports, per challenge, game frames per
+// second of CPU time, p50/p99/max frame latency and heap allocations per
+// frame (counted by replacing the global operator new).
+//
+// Runs in deterministic mode, so a given seed always plays the same
+// sessions. With --draw each frame also builds the challenge's draw list
+// and submits it to the null backend, to include the game side of
+// rendering.
+//
+// With --split two synthetic players play each challenge head to head
+// through SplitScreenMatch, and a frame is both lanes; add --sequential to
+// run the lanes on one thread for comparison.
+//
+// With --fixed-step the game runs its fixed-step simulation from a 60 Hz
+// loop while tracker frames arrive at a jittery 30 Hz with a 300 ms stall
+// every ten seconds; a frame is one loop iteration.
+//
+// With --record the first session of each challenge is also saved as an
+// input recording, <prefix>-accuracy.kfr and so on, to serve as a replay
+// fixture for replay_recording --check-scoring.
+//
+// Before timing anything, a penalty struck at a normal foot speed is flown
+// through BallPhysics; the run fails if it does not reach the goal mouth at
+// a plausible ball speed. After the sessions, the run also fails unless
+// some penalties went in and no kick was faster than 250 km/h, so a broken
+// simulation cannot pass as a fast one.
+//
+// Usage:
+//   game_benchmark [--sessions n] [--seed s] [--draw] [--record prefix]
+//                  [--split [--sequential] | --fixed-step]
+//
+// Defaults: 20 sessions per challenge, seed 2026.
+
+#include "../src/game/BallPhysics.h"
+#include "../src/game/GameManager.h"
+#include "../src/game/InputRecording.h"
+#include "../src/game/SplitScreenMatch.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace kinect::game;
+
+// Allocation counting. Only allocations made while counting is set are
+// recorded, so the benchmark's own bookkeeping is left out. Atomic because
+// split-screen lanes allocate from two threads.
+namespace {
+std::atomic<bool> counting{false};
+std::atomic<size_t> allocations{0};
+}
+
+void* operator new(size_t size) {
+    if (counting.load(std::memory_order_relaxed)) {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr float FRAME_TIME = 1.0f / 30.0f;
+constexpr float INSTRUCTIONS_SECONDS = 2.0f;
+constexpr float MAX_SESSION_SECONDS = 180.0f;
+
+// Fixed-step mode
+constexpr float LOOP_TIME = 1.0f / 60.0f;
+constexpr float TRACKER_JITTER = 0.008f;
+constexpr int STALL_EVERY_FRAMES = 300;
+constexpr float STALL_SECONDS = 0.3f;
+
+// Standing player seen from behind by the sensor, in millimetres (camera
+// space, y down), so the kick runs along +z
+struct JointOffset {
+    k4abt_joint_id_t joint;
+    float x, y, z;
+};
+
+const JointOffset STANDING_POSE[] = {
+    {K4ABT_JOINT_PELVIS, 0, 0, 0},
+    {K4ABT_JOINT_SPINE_NAVEL, 0, -200, 0},
+    {K4ABT_JOINT_SPINE_CHEST, 0, -380, 10},
+    {K4ABT_JOINT_NECK, 0, -560, 20},
+    {K4ABT_JOINT_CLAVICLE_LEFT, -40, -520, 20},
+    {K4ABT_JOINT_SHOULDER_LEFT, -180, -500, 20},
+    {K4ABT_JOINT_ELBOW_LEFT, -220, -240, 20},
+    {K4ABT_JOINT_WRIST_LEFT, -240, -10, 0},
+    {K4ABT_JOINT_HAND_LEFT, -245, 60, 0},
+    {K4ABT_JOINT_HANDTIP_LEFT, -250, 130, 0},
+    {K4ABT_JOINT_THUMB_LEFT, -220, 60, -30},
+    {K4ABT_JOINT_CLAVICLE_RIGHT, 40, -520, 20},
+    {K4ABT_JOINT_SHOULDER_RIGHT, 180, -500, 20},
+    {K4ABT_JOINT_ELBOW_RIGHT, 220, -240, 20},
+    {K4ABT_JOINT_WRIST_RIGHT, 240, -10, 0},
+    {K4ABT_JOINT_HAND_RIGHT, 245, 60, 0},
+    {K4ABT_JOINT_HANDTIP_RIGHT, 250, 130, 0},
+    {K4ABT_JOINT_THUMB_RIGHT, 220, 60, -30},
+    {K4ABT_JOINT_HIP_LEFT, -100, 20, 0},
+    {K4ABT_JOINT_KNEE_LEFT, -110, 440, 10},
+    {K4ABT_JOINT_ANKLE_LEFT, -115, 860, 20},
+    {K4ABT_JOINT_FOOT_LEFT, -120, 920, -110},
+    {K4ABT_JOINT_HIP_RIGHT, 100, 20, 0},
+    {K4ABT_JOINT_KNEE_RIGHT, 110, 440, 10},
+    {K4ABT_JOINT_ANKLE_RIGHT, 115, 860, 20},
+    {K4ABT_JOINT_FOOT_RIGHT, 120, 920, -110},
+    {K4ABT_JOINT_HEAD, 0, -700, 10},
+    {K4ABT_JOINT_NOSE, 0, -690, -90},
+    {K4ABT_JOINT_EYE_LEFT, -35, -720, -70},
+    {K4ABT_JOINT_EAR_LEFT, -75, -700, 0},
+    {K4ABT_JOINT_EYE_RIGHT, 35, -720, -70},
+    {K4ABT_JOINT_EAR_RIGHT, 75, -700, 0},
+};
+
+// Right-footed kicks at random intervals. Each kick winds the leg back,
+// swings it through fast, then follows through slowly, which is the
+// shape KickDetector looks for.
+class SyntheticPlayer {
+public:
+    explicit SyntheticPlayer(uint32_t seed)
+        : rng_(seed)
+        , time_(0.0f)
+        , kickStart_(0.0f)
+    {
+        nextKick();
+    }
+
+    const k4abt_skeleton_t& step(float deltaTime) {
+        time_ += deltaTime;
+        float t = time_ - kickStart_;
+        if (t >= period_) {
+            kickStart_ += period_;
+            t -= period_;
+            nextKick();
+        }
+
+        // Kicking-leg displacement along z, plus sideways aim and lift
+        float swing = 0.0f;
+        if (t < 0.3f) {
+            swing = -windup_ * t / 0.3f;
+        } else if (t < 0.3f + swingTime_) {
+            swing = -windup_ + (windup_ + reach_) * (t - 0.3f) / swingTime_;
+        } else if (t < period_ - 0.3f) {
+            swing = reach_ + (t - 0.3f - swingTime_);  // Slow follow-through
+        } else {
+            float hold = reach_ + (period_ - 0.6f - swingTime_);
+            swing = hold * (period_ - t) / 0.3f;       // Return to stance
+        }
+        float progress = reach_ > 0.0f ? std::max(0.0f, swing) / reach_ : 0.0f;
+
+        for (const JointOffset& offset : STANDING_POSE) {
+            k4abt_joint_t& joint = skeleton_.joints[offset.joint];
+            joint.position.xyz.x = offset.x;
+            joint.position.xyz.y = offset.y;
+            joint.position.xyz.z = 2500.0f + offset.z;
+            joint.orientation.wxyz.w = 1.0f;
+            joint.orientation.wxyz.x = 0.0f;
+            joint.orientation.wxyz.y = 0.0f;
+            joint.orientation.wxyz.z = 0.0f;
+            joint.confidence_level = K4ABT_JOINT_CONFIDENCE_MEDIUM;
+        }
+        for (k4abt_joint_id_t joint : {K4ABT_JOINT_KNEE_RIGHT, K4ABT_JOINT_ANKLE_RIGHT,
+                                       K4ABT_JOINT_FOOT_RIGHT}) {
+            float weight = joint == K4ABT_JOINT_KNEE_RIGHT ? 0.5f : 1.0f;
+            k4a_float3_t& position = skeleton_.joints[joint].position;
+            position.xyz.x += aim_ * progress * weight;
+            position.xyz.y -= lift_ * progress * weight;
+            position.xyz.z += swing * weight;
+        }
+        return skeleton_;
+    }
+
+private:
+    void nextKick() {
+        std::uniform_real_distribution<float> period(1.4f, 2.4f);
+        std::uniform_real_distribution<float> windup(150.0f, 400.0f);
+        std::uniform_real_distribution<float> reach(400.0f, 1000.0f);
+        std::uniform_real_distribution<float> swingTime(0.1f, 0.2f);
+        std::uniform_real_distribution<float> aim(-250.0f, 250.0f);
+        std::uniform_real_distribution<float> lift(0.0f, 300.0f);
+        period_ = period(rng_);
+        windup_ = windup(rng_);
+        reach_ = reach(rng_);
+        swingTime_ = swingTime(rng_);
+        aim_ = aim(rng_);
+        lift_ = lift(rng_);
+    }
+
+    std::mt19937 rng_;
+    k4abt_skeleton_t skeleton_;
+    float time_;
+    float kickStart_;
+    float period_;
+    float windup_;
+    float reach_;
+    float swingTime_;
+    float aim_;
+    float lift_;
+};
+
+constexpr float MAX_BALL_SPEED_KMH = 250.0f;
+
+struct ChallengeStats {
+    std::vector<double> frameUs;
+    double totalUs = 0.0;
+    size_t allocations = 0;
+    size_t kicks = 0;
+
+    // Outcomes, for the sanity check
+    int32_t penalties = 0;
+    int32_t goals = 0;
+    float maxKmh = 0.0f;
+
+    void addResult(const ChallengeResult& result) {
+        if (result.type == ChallengeType::PENALTY_SHOOTOUT) {
+            penalties += result.attempts;
+            goals += result.successes;
+        }
+        maxKmh = std::max(maxKmh, result.maxVelocity);
+    }
+
+    double percentile(size_t p) {
+        if (frameUs.empty()) {
+            return 0.0;
+        }
+        size_t index = std::min(frameUs.size() - 1, frameUs.size() * p / 100);
+        std::nth_element(frameUs.begin(), frameUs.begin() + index, frameUs.end());
+        return frameUs[index];
+    }
+};
+
+const char* recordingName(ChallengeType type) {
+    switch (type) {
+        case ChallengeType::ACCURACY: return "accuracy";
+        case ChallengeType::POWER: return "power";
+        case ChallengeType::PENALTY_SHOOTOUT: return "penalty";
+        default: return "other";
+    }
+}
+
+const char* challengeName(ChallengeType type) {
+    switch (type) {
+        case ChallengeType::ACCURACY: return "Accuracy";
+        case ChallengeType::POWER: return "Power";
+        case ChallengeType::PENALTY_SHOOTOUT: return "Penalty Shootout";
+        default: return "Other";
+    }
+}
+
+void runSession(GameManager& manager, ChallengeType type, uint32_t seed, bool draw,
+                DrawList& list, NullDrawBackend& null, ChallengeStats& stats,
+                InputRecording* recording) {
+    SyntheticPlayer player(seed);
+    k4a_image_t noDepth = nullptr;
+    kinect::motion::PoseFeatures pose;
+    uint64_t timestampUs = 0;
+
+    manager.setOnChallengeComplete([&stats](const ChallengeResult& result) { stats.addResult(result); });
+    manager.setDeterministic(seed);
+    if (recording) {
+        manager.startRecording(*recording);
+    }
+    manager.startSession();
+    manager.startChallenge(type);
+
+    auto frame = [&]() {
+        timestampUs += static_cast<uint64_t>(FRAME_TIME * 1000000.0f);
+        const k4abt_skeleton_t& skeleton = player.step(FRAME_TIME);
+
+        allocations = 0;
+        counting = true;
+        auto start = Clock::now();
+        pose.reset(skeleton, timestampUs);
+        manager.processFrame(pose, noDepth, FRAME_TIME);
+        if (draw) {
+            list.reset(1080, 1920);
+            manager.draw(list);
+            null.submit(list);
+        }
+        double us = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+        counting = false;
+
+        stats.frameUs.push_back(us);
+        stats.totalUs += us;
+        stats.allocations += allocations;
+    };
+
+    for (float t = 0.0f; t < INSTRUCTIONS_SECONDS; t += FRAME_TIME) {
+        frame();
+    }
+    manager.startCountdown();
+    for (float t = 0.0f; t < MAX_SESSION_SECONDS && manager.hasActiveChallenge(); t += FRAME_TIME) {
+        frame();
+    }
+    if (manager.hasActiveChallenge()) {
+        manager.stopCurrentChallenge();
+    }
+    manager.endSession();
+    manager.stopRecording();
+
+    stats.kicks += manager.getSessionStats().totalKicks;
+}
+
+// Tracker frames at an uneven rate feed pushFrame(); the loop advances
+// the simulation by real time
+void runFixedStepSession(GameManager& manager, ChallengeType type, uint32_t seed, bool draw,
+                         DrawList& list, NullDrawBackend& null, ChallengeStats& stats,
+                         InputRecording* recording) {
+    SyntheticPlayer player(seed);
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> jitter(-TRACKER_JITTER, TRACKER_JITTER);
+    kinect::motion::PoseFeatures pose;
+    double loopTime = 0.0;
+    double trackerTime = 0.0;
+    double playerTime = 0.0;
+    int trackerFrames = 0;
+
+    manager.setOnChallengeComplete([&stats](const ChallengeResult& result) { stats.addResult(result); });
+    manager.setDeterministic(seed);
+    if (recording) {
+        manager.startRecording(*recording);
+    }
+    manager.startSession();
+    manager.startChallenge(type);
+
+    auto frame = [&]() {
+        loopTime += LOOP_TIME;
+
+        allocations = 0;
+        counting = true;
+        auto start = Clock::now();
+        while (trackerTime <= loopTime) {
+            const k4abt_skeleton_t& skeleton = player.step(static_cast<float>(trackerTime - playerTime));
+            playerTime = trackerTime;
+            pose.reset(skeleton, static_cast<uint64_t>(trackerTime * 1000000.0));
+            manager.pushFrame(pose);
+
+            trackerTime += FRAME_TIME + jitter(rng);
+            if (++trackerFrames % STALL_EVERY_FRAMES == 0) {
+                trackerTime += STALL_SECONDS;
+            }
+        }
+        manager.advance(LOOP_TIME);
+        if (draw) {
+            list.reset(1080, 1920);
+            manager.draw(list);
+            null.submit(list);
+        }
+        double us = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+        counting = false;
+
+        stats.frameUs.push_back(us);
+        stats.totalUs += us;
+        stats.allocations += allocations;
+    };
+
+    for (float t = 0.0f; t < INSTRUCTIONS_SECONDS; t += LOOP_TIME) {
+        frame();
+    }
+    manager.startCountdown();
+    for (float t = 0.0f; t < MAX_SESSION_SECONDS && manager.hasActiveChallenge(); t += LOOP_TIME) {
+        frame();
+    }
+    if (manager.hasActiveChallenge()) {
+        manager.stopCurrentChallenge();
+    }
+    manager.endSession();
+    manager.stopRecording();
+
+    stats.kicks += manager.getSessionStats().totalKicks;
+}
+
+// Both players kick independently; the frame time covers both lanes
+void runSplitSession(SplitScreenMatch& match, ChallengeType type, uint32_t seed, bool draw,
+                     DrawList& list, NullDrawBackend& null, ChallengeStats& stats) {
+    SyntheticPlayer left(seed);
+    SyntheticPlayer right(seed ^ 0x9E3779B9u);
+
+    match.setOnMatchComplete([&stats](const HeadToHeadResult& result) {
+        stats.addResult(result.left);
+        stats.addResult(result.right);
+    });
+    match.setDeterministic(seed);
+    for (auto zone : {kinect::core::PlayerZone::Left, kinect::core::PlayerZone::Right}) {
+        match.getManager(zone).startSession();
+    }
+    match.start(type);
+
+    auto frame = [&]() {
+        const k4abt_skeleton_t& leftSkeleton = left.step(FRAME_TIME);
+        const k4abt_skeleton_t& rightSkeleton = right.step(FRAME_TIME);
+
+        allocations = 0;
+        counting = true;
+        auto start = Clock::now();
+        match.processFrame(&leftSkeleton, &rightSkeleton, FRAME_TIME);
+        if (draw) {
+            for (auto zone : {kinect::core::PlayerZone::Left, kinect::core::PlayerZone::Right}) {
+                list.reset(540, 1920);
+                match.draw(zone, list);
+                null.submit(list);
+            }
+        }
+        double us = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+        counting = false;
+
+        stats.frameUs.push_back(us);
+        stats.totalUs += us;
+        stats.allocations += allocations;
+    };
+
+    for (float t = 0.0f; t < INSTRUCTIONS_SECONDS; t += FRAME_TIME) {
+        frame();
+    }
+    match.startCountdown();
+    for (float t = 0.0f; t < MAX_SESSION_SECONDS && match.isActive(); t += FRAME_TIME) {
+        frame();
+    }
+    if (match.isActive()) {
+        match.stop();
+    }
+
+    for (auto zone : {kinect::core::PlayerZone::Left, kinect::core::PlayerZone::Right}) {
+        GameManager& manager = match.getManager(zone);
+        manager.endSession();
+        stats.kicks += manager.getSessionStats().totalKicks;
+    }
+}
+
+// A 15 m/s side-foot penalty, as the tracker reports it (mm, mm/s), must
+// cross the goal mouth at a realistic ball speed
+bool checkKickFlight() {
+    BallPhysics physics;
+    k4a_float3_t foot = {120.0f, 920.0f, 2390.0f};
+    k4a_float3_t footVelocity = {0.0f, -2000.0f, 14870.0f};
+    BallLaunch launch = physics.launchFromKick(foot, footVelocity, kinect::KickType::SideFootPass,
+                                                kinect::DominantFoot::Right);
+    BallFlightResult flight = physics.simulate(launch, PenaltyShootoutConfig().goalDistance);
+
+    const k4a_float3_t& v = flight.impactVelocity;
+    float speed = std::sqrt(v.xyz.x * v.xyz.x + v.xyz.y * v.xyz.y + v.xyz.z * v.xyz.z);
+    bool ok = flight.reachedGoal &&
+              TargetZone::isInsideGoal(flight.impactPoint.xyz.x, flight.impactPoint.xyz.y) &&
+              speed >= 10.0f && speed <= 30.0f;
+
+    std::cout << std::fixed << std::setprecision(1) << "Kick flight: 15 m/s foot, ball at the goal line "
+              << speed << " m/s, " << flight.timeToGoal << " s, (" << flight.impactPoint.xyz.x << ", "
+              << flight.impactPoint.xyz.y << ") m: " << (ok ? "PASS" : "FAIL") << "\n\n";
+    std::cout.unsetf(std::ios::floatfield);
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t sessions = 20;
+    uint32_t seed = 2026;
+    bool draw = false;
+    bool split = false;
+    bool concurrent = true;
+    bool fixedStep = false;
+    std::string recordPrefix;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--sessions" && i + 1 < argc) {
+            sessions = std::max<size_t>(1, std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--draw") {
+            draw = true;
+        } else if (arg == "--split") {
+            split = true;
+        } else if (arg == "--sequential") {
+            concurrent = false;
+        } else if (arg == "--fixed-step") {
+            fixedStep = true;
+        } else if (arg == "--record" && i + 1 < argc) {
+            recordPrefix = argv[++i];
+        } else {
+            std::cerr << "Usage: game_benchmark [--sessions n] [--seed s] [--draw] [--record prefix]"
+                         " [--split [--sequential] | --fixed-step]\n";
+            return 1;
+        }
+    }
+
+    std::cout << "Game loop benchmark: " << sessions << " sessions per challenge, seed " << seed
+              << (draw ? ", with draw lists" : ", logic only")
+              << (split ? (concurrent ? ", two players (concurrent lanes)" : ", two players (sequential lanes)") : "")
+              << (fixedStep && !split ? ", fixed step from a 60 Hz loop" : "")
+              << "\n\n";
+
+    if (!checkKickFlight()) {
+        return 1;
+    }
+
+    std::cout << "  " << std::left << std::setw(18) << "challenge" << std::right
+              << std::setw(9) << "frames" << std::setw(7) << "kicks"
+              << std::setw(12) << "frames/s" << std::setw(9) << "p50 us"
+              << std::setw(9) << "p99 us" << std::setw(9) << "max us"
+              << std::setw(14) << "allocs/frame" << "\n";
+
+    DrawList list;
+    NullDrawBackend null;
+    int32_t penalties = 0;
+    int32_t goals = 0;
+    float maxKmh = 0.0f;
+    for (ChallengeType type : {ChallengeType::ACCURACY, ChallengeType::POWER,
+                               ChallengeType::PENALTY_SHOOTOUT}) {
+        ChallengeStats stats;
+        for (size_t i = 0; i < sessions; ++i) {
+            uint32_t sessionSeed = seed + static_cast<uint32_t>(i);
+            if (split) {
+                SplitScreenMatch match(GameConfig(), concurrent);
+                runSplitSession(match, type, sessionSeed, draw, list, null, stats);
+            } else {
+                GameManager manager;
+                manager.initialize();
+                InputRecording recording;
+                InputRecording* record = i == 0 && !recordPrefix.empty() ? &recording : nullptr;
+                if (fixedStep) {
+                    runFixedStepSession(manager, type, sessionSeed, draw, list, null, stats, record);
+                } else {
+                    runSession(manager, type, sessionSeed, draw, list, null, stats, record);
+                }
+                std::string path = recordPrefix + "-" + recordingName(type) + ".kfr";
+                if (record && !recording.save(path)) {
+                    std::cerr << path << ": cannot save recording\n";
+                    return 1;
+                }
+            }
+        }
+
+        size_t frames = stats.frameUs.size();
+        double p50 = stats.percentile(50);
+        double p99 = stats.percentile(99);
+        double maxUs = frames > 0 ? *std::max_element(stats.frameUs.begin(), stats.frameUs.end()) : 0.0;
+        std::cout << "  " << std::left << std::setw(18) << challengeName(type) << std::right
+                  << std::setw(9) << frames << std::setw(7) << stats.kicks
+                  << std::fixed << std::setprecision(0)
+                  << std::setw(12) << (stats.totalUs > 0.0 ? frames * 1e6 / stats.totalUs : 0.0)
+                  << std::setprecision(2)
+                  << std::setw(9) << p50 << std::setw(9) << p99 << std::setw(9) << maxUs
+                  << std::setw(14) << static_cast<double>(stats.allocations) / std::max<size_t>(frames, 1)
+                  << "\n";
+
+        penalties += stats.penalties;
+        goals += stats.goals;
+        maxKmh = std::max(maxKmh, stats.maxKmh);
+    }
+
+    bool plausible = goals > 0 && maxKmh < MAX_BALL_SPEED_KMH;
+    std::cout << "\nOutcomes: " << goals << "/" << penalties << " penalties scored, fastest kick "
+              << std::setprecision(1) << maxKmh << " km/h: " << (plausible ? "PASS" : "FAIL") << "\n";
+    return plausible ? 0 : 1;
+}
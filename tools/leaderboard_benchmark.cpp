@@ -0,0 +1,317 @@
+// Leaderboard index benchmark
+//
+// Fills one challenge board with random scores and times insert,
+// rank-of-score, rank lookup and top-k walks. Results are cross-checked
+// against a sorted vector on a sample of queries.
+//
+// The persistence pass journals every entry through LeaderboardStore,
+// compacts, then times a cold reopen and a reopen after a torn write.
+//
+// Usage:
+//   leaderboard_benchmark [entries] [seed] [store directory]
+//
+// Defaults: 1000000 entries, seed 2026, <temp>/leaderboard_benchmark.
+
+#include "../src/game/Leaderboard.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace kinect::game;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedNs(Clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+void report(const char* label, double totalNs, size_t operations) {
+    std::cout << "  " << std::left << std::setw(26) << label
+              << std::right << std::setw(10) << std::fixed << std::setprecision(1)
+              << totalNs / static_cast<double>(operations) << " ns/op"
+              << "  (" << operations << " ops, "
+              << std::setprecision(1) << totalNs / 1e6 << " ms)\n";
+}
+
+// Whole decimal number, nothing else (strtoull alone reads "--help" as 0)
+bool parseNumber(const char* text, unsigned long long& value) {
+    if (*text < '0' || *text > '9') {
+        return false;
+    }
+    char* end = nullptr;
+    errno = 0;
+    value = std::strtoull(text, &end, 10);
+    return errno == 0 && *end == '\0';
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    unsigned long long entryArg = 1000000;
+    unsigned long long seedArg = 2026;
+    if (argc > 4 || (argc > 1 && (!parseNumber(argv[1], entryArg) || entryArg == 0)) ||
+        (argc > 2 && (!parseNumber(argv[2], seedArg) || seedArg > UINT32_MAX))) {
+        std::cerr << "Usage: leaderboard_benchmark [entries] [seed] [store directory]\n";
+        return 2;
+    }
+    size_t entryCount = static_cast<size_t>(entryArg);
+    uint32_t seed = static_cast<uint32_t>(seedArg);
+    const size_t queryCount = 100000;
+    const size_t topCount = 10;
+
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int32_t> scoreDist(0, 50000);
+
+    std::vector<LeaderboardEntry> entries(entryCount);
+    for (size_t i = 0; i < entryCount; ++i) {
+        entries[i].playerName = "P" + std::to_string(i);
+        entries[i].score = scoreDist(rng);
+        entries[i].timestamp = i;
+        entries[i].challengeType = ChallengeType::ACCURACY;
+    }
+
+    std::vector<int32_t> queries(queryCount);
+    for (auto& q : queries) {
+        q = scoreDist(rng);
+    }
+
+    std::cout << "Leaderboard benchmark: " << entryCount << " entries\n";
+
+    Leaderboard leaderboard;
+
+    auto start = Clock::now();
+    for (const auto& entry : entries) {
+        leaderboard.addEntry(entry);
+    }
+    report("addEntry", elapsedNs(start), entryCount);
+
+    const LeaderboardIndex& board = leaderboard.getBoard(ChallengeType::ACCURACY);
+
+    size_t checksum = 0;
+    start = Clock::now();
+    for (int32_t q : queries) {
+        checksum += static_cast<size_t>(leaderboard.getRank(ChallengeType::ACCURACY, q));
+    }
+    report("getRank", elapsedNs(start), queryCount);
+
+    std::uniform_int_distribution<size_t> rankDist(1, std::max<size_t>(entryCount, 1));
+    std::vector<size_t> ranks(queryCount);
+    for (auto& r : ranks) {
+        r = rankDist(rng);
+    }
+
+    start = Clock::now();
+    for (size_t r : ranks) {
+        const LeaderboardEntry* entry = board.at(r);
+        checksum += entry ? static_cast<size_t>(entry->score) : 0;
+    }
+    report("at(rank)", elapsedNs(start), queryCount);
+
+    start = Clock::now();
+    for (size_t i = 0; i < queryCount; ++i) {
+        size_t n = 0;
+        for (auto it = board.begin(); it != board.end() && n < topCount; ++it, ++n) {
+            checksum += static_cast<size_t>(it->score);
+        }
+    }
+    report("top-10 walk", elapsedNs(start), queryCount);
+
+    start = Clock::now();
+    for (int32_t q : queries) {
+        checksum += leaderboard.isHighScore(ChallengeType::ACCURACY, q) ? 1 : 0;
+    }
+    report("isHighScore", elapsedNs(start), queryCount);
+
+    // Cross-check against a sorted copy
+    std::vector<LeaderboardEntry> sorted = entries;
+    std::stable_sort(sorted.begin(), sorted.end());
+
+    bool ok = board.size() == sorted.size();
+    size_t position = 0;
+    for (auto it = board.begin(); ok && it != board.end(); ++it, ++position) {
+        ok = it->timestamp == sorted[position].timestamp;
+    }
+    for (size_t i = 0; ok && i < std::min<size_t>(queryCount, 1000); ++i) {
+        int32_t q = queries[i];
+        auto firstBelow = std::partition_point(sorted.begin(), sorted.end(),
+            [q](const LeaderboardEntry& e) { return e.score >= q; });
+        size_t expected = static_cast<size_t>(firstBelow - sorted.begin()) + 1;
+        ok = board.rankOfScore(q) == expected;
+    }
+
+    // A capped board must hold exactly the best entries
+    const size_t cap = std::min<size_t>(entryCount, 100);
+    Leaderboard capped(cap);
+    for (const auto& entry : entries) {
+        capped.addEntry(entry);
+    }
+    const LeaderboardIndex& cappedBoard = capped.getBoard(ChallengeType::ACCURACY);
+    ok = ok && cappedBoard.size() == cap;
+    position = 0;
+    for (auto it = cappedBoard.begin(); ok && it != cappedBoard.end(); ++it, ++position) {
+        ok = it->timestamp == sorted[position].timestamp;
+    }
+
+    // Rolling windows: entries are one second apart, so 10^6 entries span
+    // about 11.5 days and both windows keep expiring buckets. Uncapped, so
+    // ranks can be checked exactly against brute force.
+    {
+        LeaderboardWindowConfig todayConfig = LeaderboardWindowConfig::today();
+        LeaderboardWindowConfig weekConfig = LeaderboardWindowConfig::thisWeek();
+        todayConfig.maxEntriesPerBucket = 0;
+        weekConfig.maxEntriesPerBucket = 0;
+
+        Leaderboard windowed;
+        size_t today = windowed.addWindow(todayConfig);
+        size_t week = windowed.addWindow(weekConfig);
+
+        start = Clock::now();
+        for (const auto& entry : entries) {
+            windowed.addEntry(entry);
+        }
+        report("addEntry + 2 windows", elapsedNs(start), std::max<size_t>(entryCount, 1));
+
+        for (size_t window : {today, week}) {
+            const LeaderboardWindow* view = windowed.getWindow(ChallengeType::ACCURACY, window);
+            if (!view) {
+                continue;
+            }
+
+            start = Clock::now();
+            for (int32_t q : queries) {
+                checksum += static_cast<size_t>(windowed.getRank(ChallengeType::ACCURACY, q, window));
+            }
+            std::string label = "getRank (" + view->getConfig().name + ")";
+            report(label.c_str(), elapsedNs(start), queryCount);
+
+            // Brute force over the entries inside the window
+            uint64_t windowStart = view->getWindowStart();
+            size_t inWindow = 0;
+            for (const auto& entry : entries) {
+                inWindow += entry.timestamp >= windowStart ? 1 : 0;
+            }
+            ok = ok && view->size() == inWindow;
+            for (size_t i = 0; ok && i < 100; ++i) {
+                size_t expected = 1;
+                for (const auto& entry : entries) {
+                    expected += (entry.timestamp >= windowStart && entry.score >= queries[i]) ? 1 : 0;
+                }
+                ok = view->rankOfScore(queries[i]) == expected;
+            }
+            auto best = view->top(1);
+            ok = ok && (inWindow == 0 || (best.size() == 1 && best[0]->timestamp >= windowStart));
+        }
+
+        // With the default cap each bucket keeps only its best entries, and
+        // the window's best entry is never among the dropped ones
+        Leaderboard trimmed;
+        size_t trimmedToday = trimmed.addWindow(LeaderboardWindowConfig::today());
+        for (const auto& entry : entries) {
+            trimmed.addEntry(entry);
+        }
+        const LeaderboardWindow* exact = windowed.getWindow(ChallengeType::ACCURACY, today);
+        const LeaderboardWindow* capped = trimmed.getWindow(ChallengeType::ACCURACY, trimmedToday);
+        if (exact && capped) {
+            ok = ok && capped->size() <= LeaderboardWindowConfig::DEFAULT_MAX_ENTRIES_PER_BUCKET * 24;
+            auto exactBest = exact->top(1);
+            auto cappedBest = capped->top(1);
+            ok = ok && exactBest.size() == cappedBest.size() &&
+                 (exactBest.empty() || exactBest[0]->score == cappedBest[0]->score);
+        }
+    }
+
+    // Persistence: journal, compact, reopen
+    std::filesystem::path directory = argc > 3
+        ? std::filesystem::path(argv[3])
+        : std::filesystem::temp_directory_path() / "leaderboard_benchmark";
+    std::filesystem::remove_all(directory);
+
+    {
+        Leaderboard persisted;
+        ok = ok && persisted.open(directory.string());
+        LeaderboardStore* store = persisted.getStore();
+
+        // Game-thread cost only; the pacing flushes are not timed
+        double addNs = 0.0;
+        for (size_t i = 0; ok && i < entryCount; ++i) {
+            start = Clock::now();
+            persisted.addEntry(entries[i]);
+            addNs += elapsedNs(start);
+            // Pace the producer so a bulk fill does not overrun the queue
+            if (i % (LeaderboardStore::QUEUE_SIZE / 2) == 0) {
+                store->flush();
+            }
+        }
+        store->flush();
+        report("journaled addEntry", addNs, std::max<size_t>(entryCount, 1));
+
+        start = Clock::now();
+        uint64_t compactions = store->getCompactionCount();
+        store->requestCompaction();
+        while (store->getCompactionCount() == compactions && entryCount > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        std::cout << "  compaction " << std::setprecision(1) << elapsedNs(start) / 1e6 << " ms\n";
+        ok = ok && store->getDroppedCount() == 0 && store->getFailedCount() == 0;
+
+        // A few entries after compaction stay in the journal
+        for (size_t i = 0; i < std::min<size_t>(entryCount, 100); ++i) {
+            LeaderboardEntry late = entries[i];
+            late.timestamp += entryCount;
+            persisted.addEntry(late);
+        }
+        persisted.close();
+    }
+
+    size_t expectedCount = entryCount + std::min<size_t>(entryCount, 100);
+    {
+        Leaderboard reopened;
+        start = Clock::now();
+        ok = ok && reopened.open(directory.string());
+        double openNs = elapsedNs(start);
+        std::cout << "  reopen " << std::setprecision(1) << openNs / 1e6 << " ms (store load "
+                  << reopened.getStore()->getLastLoadTimeMs() << " ms)\n";
+        ok = ok && reopened.getEntryCount() == expectedCount;
+        ok = ok && static_cast<size_t>(reopened.getRank(ChallengeType::ACCURACY, queries[0])) ==
+                   board.rankOfScore(queries[0]) + static_cast<size_t>(std::count_if(
+                       entries.begin(), entries.begin() + std::min<size_t>(entryCount, 100),
+                       [&](const LeaderboardEntry& e) { return e.score >= queries[0]; }));
+
+        // Simulate power loss mid-write: append half a record to the journal
+        LeaderboardEntry torn = entries.empty() ? LeaderboardEntry() : entries[0];
+        reopened.addEntry(torn);
+        reopened.close();
+    }
+    for (const auto& item : std::filesystem::directory_iterator(directory)) {
+        if (item.path().extension() == ".log") {
+            std::ofstream journal(item.path(), std::ios::binary | std::ios::app);
+            journal.write("\x30\x00\x00\x00\xde\xad", 6);
+        }
+    }
+    {
+        Leaderboard recovered;
+        ok = ok && recovered.open(directory.string());
+        ok = ok && recovered.getEntryCount() == expectedCount + 1;
+        ok = ok && recovered.getStore()->getRecoveredTornBytes() == 6;
+        std::cout << "  torn write recovered (" << recovered.getStore()->getRecoveredTornBytes()
+                  << " bytes cut)\n";
+    }
+    std::filesystem::remove_all(directory);
+
+    std::cout << "  checksum " << checksum << "\n"
+              << "  verification " << (ok ? "passed" : "FAILED") << "\n";
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,172 @@
+// Kinect recovery fault-injection benchmark
+//
+// Runs the real KinectDevice and BodyTracker against the simulated SDK in
+// simulated_k4a.cpp and injects faults while a capture loop is running.
+// Recovery time is measured from the fault to the next body frame.
+//
+//   usb      the device drops off USB and re-enumerates. Warm recovery
+//            reconnects the device with backoff and resumes the loaded
+//            tracker; cold recovery (the old path) also recreates the
+//            tracker, reloading the model.
+//   tracker  the tracker starts failing; the warm standby takes over.
+//
+// Exits non-zero if any warm recovery takes longer than --budget ms.
+//
+// Usage:
+//   recovery_benchmark [--trials n] [--reenumerate ms] [--model-load ms]
+//                      [--budget ms]
+//
+// Defaults: 5 trials, 300 ms re-enumeration, 2000 ms model load, 1000 ms
+// budget.
+
+#include "../src/core/BodyTracker.h"
+#include "../src/core/KinectDevice.h"
+#include "simulated_k4a.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace kinect::core;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+// One pass of the capture loop; true if it produced a body frame
+bool step(KinectDevice& device, BodyTracker& tracker) {
+    if (!device.captureFrame()) {
+        return false;
+    }
+    tracker.processCapture(device.getCurrentCapture());
+    return !tracker.processFrame().empty();
+}
+
+void runFor(KinectDevice& device, BodyTracker& tracker, int ms) {
+    auto end = Clock::now() + std::chrono::milliseconds(ms);
+    while (Clock::now() < end) {
+        step(device, tracker);
+    }
+}
+
+// Milliseconds from inject() to the next body frame, recovering with
+// recover() whenever the device reports its stream lost
+double measure(KinectDevice& device, BodyTracker& tracker, const std::function<void()>& inject,
+               const std::function<bool()>& recover) {
+    auto start = Clock::now();
+    inject();
+    for (;;) {
+        if (step(device, tracker)) {
+            break;
+        }
+        if (device.isStreamLost() && !recover()) {
+            return -1.0;
+        }
+        if (Clock::now() - start > std::chrono::seconds(60)) {
+            return -1.0;
+        }
+    }
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+struct Summary {
+    std::string name;
+    std::vector<double> samples;
+};
+
+void printSummary(const Summary& summary) {
+    std::vector<double> sorted = summary.samples;
+    std::sort(sorted.begin(), sorted.end());
+    double median = sorted.empty() ? 0.0 : sorted[sorted.size() / 2];
+    double worst = sorted.empty() ? 0.0 : sorted.back();
+    std::cout << std::left << std::setw(22) << summary.name << std::right << std::fixed << std::setprecision(0)
+              << std::setw(8) << median << " ms" << std::setw(8) << worst << " ms\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int trials = 5;
+    uint32_t reenumerateMs = 300;
+    double budgetMs = 1000.0;
+    simk4a::Settings settings;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--trials") == 0 && i + 1 < argc) {
+            trials = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--reenumerate") == 0 && i + 1 < argc) {
+            reenumerateMs = static_cast<uint32_t>(std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--model-load") == 0 && i + 1 < argc) {
+            settings.modelLoadMs = static_cast<uint32_t>(std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--budget") == 0 && i + 1 < argc) {
+            budgetMs = std::atof(argv[++i]);
+        } else {
+            std::cerr << "Usage: recovery_benchmark [--trials n] [--reenumerate ms] [--model-load ms] [--budget ms]\n";
+            return 2;
+        }
+    }
+    simk4a::configure(settings);
+
+    KinectDevice device;
+    BodyTracker tracker;
+    if (!device.initialize() || !device.startCapture() || !tracker.initialize(device)) {
+        std::cerr << "Simulated device failed to start\n";
+        return 1;
+    }
+    runFor(device, tracker, 500);
+
+    ReconnectPolicy policy;
+    auto unplug = [&]() { simk4a::unplug(reenumerateMs); };
+
+    Summary warm{"usb, warm tracker", {}};
+    for (int i = 0; i < trials; ++i) {
+        warm.samples.push_back(measure(device, tracker, unplug, [&]() {
+            return device.reconnect(policy) && tracker.resume(device);
+        }));
+        runFor(device, tracker, 200);
+    }
+
+    Summary cold{"usb, tracker rebuilt", {}};
+    cold.samples.push_back(measure(device, tracker, unplug, [&]() {
+        tracker.shutdown();
+        return device.reconnect(policy) && tracker.initialize(device);
+    }));
+    runFor(device, tracker, 200);
+
+    Summary standby{"tracker, standby", {}};
+    tracker.startStandby();
+    for (int i = 0; i < trials; ++i) {
+        while (!tracker.hasStandby()) {
+            runFor(device, tracker, 50);
+        }
+        standby.samples.push_back(measure(device, tracker, []() { simk4a::failTracker(); }, []() { return false; }));
+        runFor(device, tracker, 200);
+    }
+    tracker.shutdown();
+    device.shutdown();
+
+    std::cout << "\nRecovery time, fault to next body frame (" << trials << " trials, "
+              << reenumerateMs << " ms re-enumeration, " << settings.modelLoadMs << " ms model load)\n";
+    std::cout << std::left << std::setw(22) << "scenario" << std::right << std::setw(11) << "p50"
+              << std::setw(11) << "max" << "\n";
+    printSummary(warm);
+    printSummary(cold);
+    printSummary(standby);
+    std::cout << "trackers created: " << simk4a::getTrackersCreated() << "\n";
+
+    bool ok = true;
+    for (const Summary* summary : {&warm, &standby}) {
+        for (double sample : summary->samples) {
+            if (sample < 0.0 || sample > budgetMs) {
+                ok = false;
+            }
+        }
+    }
+    std::cout << (ok ? "PASS" : "FAIL") << ": warm recovery within " << budgetMs << " ms\n";
+    return ok ? 0 : 1;
+}
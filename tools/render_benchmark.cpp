@@ -0,0 +1,163 @@
+// Challenge render benchmark
+//
+// Draws every challenge in each of its screens for a portrait kiosk frame
+// (1080x1920 by default) and reports the per-frame cost of building the
+// draw list, submitting it to the null backend (game side only) and
+// rasterising it with the OpenCV backend. The frame is refreshed from a
+// fixed camera image before each rasterisation, as in the live pipeline;
+// only draw and submit are timed. The first frame of each screen, which
+// builds the retained layers, is reported separately.
+//
+// Usage:
+//   render_benchmark [frames] [width] [height]
+//
+// Defaults: 600 frames, 1080x1920.
+
+#include "../src/game/AccuracyChallenge.h"
+#include "../src/game/PenaltyShootout.h"
+#include "../src/game/PowerChallenge.h"
+#include "../src/game/OpenCvDrawBackend.h"
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace kinect::game;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Lets the benchmark put a challenge straight into a screen
+template <typename Challenge>
+class Harness : public Challenge {
+public:
+    using Challenge::Challenge;
+
+    void enter(ChallengeState state) {
+        this->setState(state);
+        if (state == ChallengeState::ACTIVE) {
+            this->startTimer();
+        }
+    }
+};
+
+const char* stateName(ChallengeState state) {
+    switch (state) {
+        case ChallengeState::INSTRUCTIONS: return "instructions";
+        case ChallengeState::COUNTDOWN: return "countdown";
+        case ChallengeState::ACTIVE: return "active";
+        case ChallengeState::COMPLETE: return "results";
+        default: return "other";
+    }
+}
+
+struct Timing {
+    std::vector<double> samples;
+    double first = 0.0;
+
+    void add(size_t frame, double us) {
+        if (frame == 0) {
+            first = us;
+        } else {
+            samples.push_back(us);
+        }
+    }
+
+    double mean() const {
+        double total = 0.0;
+        for (double us : samples) {
+            total += us;
+        }
+        return total / static_cast<double>(std::max<size_t>(samples.size(), 1));
+    }
+
+    double p99() {
+        std::sort(samples.begin(), samples.end());
+        return samples.empty() ? 0.0 : samples[samples.size() * 99 / 100];
+    }
+};
+
+double elapsedUs(Clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+void benchmark(ChallengeBase& challenge, const std::function<void(ChallengeState)>& enter,
+               const cv::Mat& camera, size_t frames) {
+    cv::Mat frame;
+    DrawList list;
+    NullDrawBackend null;
+    OpenCvDrawBackend rasterizer;
+    rasterizer.setTarget(frame);
+
+    for (ChallengeState state : {ChallengeState::INSTRUCTIONS, ChallengeState::COUNTDOWN,
+                                 ChallengeState::ACTIVE, ChallengeState::COMPLETE}) {
+        enter(state);
+
+        Timing build;
+        Timing nullSubmit;
+        Timing opencv;
+        size_t commands = 0;
+        for (size_t i = 0; i <= frames; ++i) {
+            camera.copyTo(frame);
+
+            auto start = Clock::now();
+            list.reset(frame.cols, frame.rows);
+            challenge.draw(list);
+            build.add(i, elapsedUs(start));
+            commands = list.size();
+
+            start = Clock::now();
+            null.submit(list);
+            nullSubmit.add(i, elapsedUs(start));
+
+            start = Clock::now();
+            rasterizer.submit(list);
+            opencv.add(i, elapsedUs(start));
+        }
+
+        std::string label = challenge.getName() + " / " + stateName(state);
+        std::cout << "  " << std::left << std::setw(34) << label << std::right
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(5) << commands << " cmds"
+                  << std::setw(9) << build.mean() << " build"
+                  << std::setw(7) << nullSubmit.mean() << " null"
+                  << std::setw(9) << opencv.mean() << " opencv"
+                  << std::setw(9) << opencv.p99() << " p99"
+                  << std::setw(10) << build.first + opencv.first << " first  (us)\n";
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t frames = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 600;
+    int width = argc > 2 ? std::atoi(argv[2]) : 1080;
+    int height = argc > 3 ? std::atoi(argv[3]) : 1920;
+
+    // Stand-in for a camera image
+    cv::Mat camera(height, width, CV_8UC3);
+    cv::randu(camera, cv::Scalar::all(0), cv::Scalar::all(255));
+
+    std::cout << "Challenge render cost at " << width << "x" << height
+              << ", " << frames << " frames per screen\n";
+
+    Harness<AccuracyChallenge> accuracy{AccuracyChallengeConfig()};
+    accuracy.start();
+    benchmark(accuracy, [&](ChallengeState s) { accuracy.enter(s); }, camera, frames);
+
+    Harness<PowerChallenge> power{PowerChallengeConfig()};
+    power.start();
+    benchmark(power, [&](ChallengeState s) { power.enter(s); }, camera, frames);
+
+    Harness<PenaltyShootout> penalty{PenaltyShootoutConfig()};
+    penalty.start();
+    benchmark(penalty, [&](ChallengeState s) { penalty.enter(s); }, camera, frames);
+
+    return 0;
+}
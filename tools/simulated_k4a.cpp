@@ -0,0 +1,376 @@
+// Simulated Azure Kinect and Body Tracking SDK; see simulated_k4a.h
+
+#include "simulated_k4a.h"
+#include <k4a/k4a.h>
+#include <k4abt.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr uint64_t FRAME_PERIOD_USEC = 33333;
+constexpr int IMAGE_WIDTH = 64;
+constexpr int IMAGE_HEIGHT = 48;
+constexpr size_t TRACKER_QUEUE_SIZE = 3;
+
+struct SimDevice {
+    uint64_t generation = 0;    // Dead once the physical device is unplugged
+    bool streaming = false;
+    Clock::time_point streamStart;
+    uint64_t nextFrame = 0;
+};
+
+struct SimCapture {
+    uint64_t timestampUsec;
+    int references = 1;
+};
+
+struct SimImage {
+    uint64_t timestampUsec;
+    std::vector<uint8_t> buffer;
+};
+
+struct SimTracker {
+    bool used = false;
+    bool failed = false;
+    std::deque<uint64_t> queue;
+};
+
+struct SimFrame {
+    uint64_t timestampUsec;
+};
+
+std::mutex simMutex;
+simk4a::Settings settings;
+uint64_t deviceGeneration = 1;
+Clock::time_point unpluggedUntil;
+std::vector<SimTracker*> trackers;
+uint64_t trackersCreated = 0;
+
+template <typename T, typename Handle>
+T* sim(Handle handle) {
+    return reinterpret_cast<T*>(handle);
+}
+
+bool isAlive(const SimDevice* device) {
+    return device->generation == deviceGeneration;
+}
+
+} // namespace
+
+namespace simk4a {
+
+void configure(const Settings& newSettings) {
+    std::lock_guard<std::mutex> lock(simMutex);
+    settings = newSettings;
+}
+
+void unplug(uint32_t reenumerateMs) {
+    std::lock_guard<std::mutex> lock(simMutex);
+    deviceGeneration++;
+    unpluggedUntil = Clock::now() + std::chrono::milliseconds(reenumerateMs);
+}
+
+void failTracker() {
+    std::lock_guard<std::mutex> lock(simMutex);
+    for (SimTracker* tracker : trackers) {
+        if (tracker->used) {
+            tracker->failed = true;
+        }
+    }
+}
+
+uint64_t getTrackersCreated() {
+    std::lock_guard<std::mutex> lock(simMutex);
+    return trackersCreated;
+}
+
+} // namespace simk4a
+
+// ============================================================================
+// Device
+// ============================================================================
+
+uint32_t k4a_device_get_installed_count(void) {
+    std::lock_guard<std::mutex> lock(simMutex);
+    return Clock::now() < unpluggedUntil ? 0 : 1;
+}
+
+k4a_result_t k4a_device_open(uint32_t index, k4a_device_t* device_handle) {
+    uint32_t openMs;
+    {
+        std::lock_guard<std::mutex> lock(simMutex);
+        if (index != 0 || Clock::now() < unpluggedUntil) {
+            return K4A_RESULT_FAILED;
+        }
+        openMs = settings.openMs;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(openMs));
+
+    std::lock_guard<std::mutex> lock(simMutex);
+    SimDevice* device = new SimDevice();
+    device->generation = deviceGeneration;
+    *device_handle = reinterpret_cast<k4a_device_t>(device);
+    return K4A_RESULT_SUCCEEDED;
+}
+
+void k4a_device_close(k4a_device_t device_handle) {
+    delete sim<SimDevice>(device_handle);
+}
+
+k4a_result_t k4a_device_get_calibration(k4a_device_t device_handle, const k4a_depth_mode_t depth_mode,
+                                        const k4a_color_resolution_t color_resolution,
+                                        k4a_calibration_t* calibration) {
+    std::lock_guard<std::mutex> lock(simMutex);
+    if (!isAlive(sim<SimDevice>(device_handle))) {
+        return K4A_RESULT_FAILED;
+    }
+    // Same device and modes always give the same calibration; the depth
+    // camera's part depends on the depth mode only
+    std::memset(calibration, 0, sizeof(k4a_calibration_t));
+    calibration->depth_mode = depth_mode;
+    calibration->color_resolution = color_resolution;
+    calibration->depth_camera_calibration.resolution_width = depth_mode == K4A_DEPTH_MODE_NFOV_2X2BINNED ? 320 : 640;
+    calibration->depth_camera_calibration.resolution_height = depth_mode == K4A_DEPTH_MODE_NFOV_2X2BINNED ? 288 : 576;
+    calibration->color_camera_calibration.resolution_width = color_resolution == K4A_COLOR_RESOLUTION_OFF ? 0 : 1280;
+    calibration->color_camera_calibration.resolution_height = color_resolution == K4A_COLOR_RESOLUTION_OFF ? 0 : 720;
+    return K4A_RESULT_SUCCEEDED;
+}
+
+k4a_result_t k4a_device_start_cameras(k4a_device_t device_handle, const k4a_device_configuration_t* config) {
+    (void)config;
+    uint32_t startMs;
+    {
+        std::lock_guard<std::mutex> lock(simMutex);
+        if (!isAlive(sim<SimDevice>(device_handle))) {
+            return K4A_RESULT_FAILED;
+        }
+        startMs = settings.startCamerasMs;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(startMs));
+
+    std::lock_guard<std::mutex> lock(simMutex);
+    SimDevice* device = sim<SimDevice>(device_handle);
+    device->streaming = true;
+    device->streamStart = Clock::now();
+    device->nextFrame = 0;
+    return K4A_RESULT_SUCCEEDED;
+}
+
+void k4a_device_stop_cameras(k4a_device_t device_handle) {
+    std::lock_guard<std::mutex> lock(simMutex);
+    sim<SimDevice>(device_handle)->streaming = false;
+}
+
+k4a_wait_result_t k4a_device_get_capture(k4a_device_t device_handle, k4a_capture_t* capture_handle,
+                                         int32_t timeout_in_ms) {
+    Clock::time_point frameTime;
+    uint64_t timestamp;
+    {
+        std::lock_guard<std::mutex> lock(simMutex);
+        SimDevice* device = sim<SimDevice>(device_handle);
+        if (!isAlive(device) || !device->streaming) {
+            return K4A_WAIT_RESULT_FAILED;
+        }
+        timestamp = device->nextFrame * FRAME_PERIOD_USEC;
+        frameTime = device->streamStart + std::chrono::microseconds(timestamp);
+        if (frameTime > Clock::now() + std::chrono::milliseconds(timeout_in_ms)) {
+            frameTime = Clock::time_point();
+        } else {
+            device->nextFrame++;
+        }
+    }
+
+    if (frameTime == Clock::time_point()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(timeout_in_ms));
+        return K4A_WAIT_RESULT_TIMEOUT;
+    }
+    std::this_thread::sleep_until(frameTime);
+    *capture_handle = reinterpret_cast<k4a_capture_t>(new SimCapture{timestamp});
+    return K4A_WAIT_RESULT_SUCCEEDED;
+}
+
+k4a_buffer_result_t k4a_device_get_serialnum(k4a_device_t device_handle, char* serial_number,
+                                             size_t* serial_number_size) {
+    (void)device_handle;
+    static const char serial[] = "SIM000000001";
+    if (!serial_number || *serial_number_size < sizeof(serial)) {
+        *serial_number_size = sizeof(serial);
+        return K4A_BUFFER_RESULT_TOO_SMALL;
+    }
+    std::memcpy(serial_number, serial, sizeof(serial));
+    *serial_number_size = sizeof(serial);
+    return K4A_BUFFER_RESULT_SUCCEEDED;
+}
+
+k4a_result_t k4a_device_get_version(k4a_device_t device_handle, k4a_hardware_version_t* version) {
+    (void)device_handle;
+    std::memset(version, 0, sizeof(k4a_hardware_version_t));
+    version->rgb.major = 1;
+    version->rgb.minor = 6;
+    version->rgb.iteration = 110;
+    return K4A_RESULT_SUCCEEDED;
+}
+
+// ============================================================================
+// Captures and images
+// ============================================================================
+
+void k4a_capture_release(k4a_capture_t capture_handle) {
+    SimCapture* capture = sim<SimCapture>(capture_handle);
+    std::lock_guard<std::mutex> lock(simMutex);
+    if (--capture->references == 0) {
+        delete capture;
+    }
+}
+
+void k4a_capture_reference(k4a_capture_t capture_handle) {
+    std::lock_guard<std::mutex> lock(simMutex);
+    sim<SimCapture>(capture_handle)->references++;
+}
+
+k4a_image_t k4a_capture_get_color_image(k4a_capture_t capture_handle) {
+    (void)capture_handle;
+    return nullptr;   // Depth only
+}
+
+k4a_image_t k4a_capture_get_depth_image(k4a_capture_t capture_handle) {
+    SimImage* image = new SimImage{sim<SimCapture>(capture_handle)->timestampUsec, {}};
+    image->buffer.assign(IMAGE_WIDTH * IMAGE_HEIGHT * 2, 0);
+    return reinterpret_cast<k4a_image_t>(image);
+}
+
+int k4a_image_get_width_pixels(k4a_image_t image_handle) {
+    (void)image_handle;
+    return IMAGE_WIDTH;
+}
+
+int k4a_image_get_height_pixels(k4a_image_t image_handle) {
+    (void)image_handle;
+    return IMAGE_HEIGHT;
+}
+
+int k4a_image_get_stride_bytes(k4a_image_t image_handle) {
+    (void)image_handle;
+    return IMAGE_WIDTH * 2;
+}
+
+size_t k4a_image_get_size(k4a_image_t image_handle) {
+    return sim<SimImage>(image_handle)->buffer.size();
+}
+
+uint8_t* k4a_image_get_buffer(k4a_image_t image_handle) {
+    return sim<SimImage>(image_handle)->buffer.data();
+}
+
+uint64_t k4a_image_get_device_timestamp_usec(k4a_image_t image_handle) {
+    return sim<SimImage>(image_handle)->timestampUsec;
+}
+
+void k4a_image_release(k4a_image_t image_handle) {
+    delete sim<SimImage>(image_handle);
+}
+
+// ============================================================================
+// Body tracking
+// ============================================================================
+
+k4a_result_t k4abt_tracker_create(const k4a_calibration_t* sensor_calibration, k4abt_tracker_configuration_t config,
+                                  k4abt_tracker_t* tracker_handle) {
+    (void)sensor_calibration;
+    (void)config;
+    uint32_t modelLoadMs;
+    {
+        std::lock_guard<std::mutex> lock(simMutex);
+        modelLoadMs = settings.modelLoadMs;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(modelLoadMs));
+
+    std::lock_guard<std::mutex> lock(simMutex);
+    SimTracker* tracker = new SimTracker();
+    trackers.push_back(tracker);
+    trackersCreated++;
+    *tracker_handle = reinterpret_cast<k4abt_tracker_t>(tracker);
+    return K4A_RESULT_SUCCEEDED;
+}
+
+void k4abt_tracker_shutdown(k4abt_tracker_t tracker_handle) {
+    (void)tracker_handle;
+}
+
+void k4abt_tracker_destroy(k4abt_tracker_t tracker_handle) {
+    SimTracker* tracker = sim<SimTracker>(tracker_handle);
+    std::lock_guard<std::mutex> lock(simMutex);
+    trackers.erase(std::remove(trackers.begin(), trackers.end(), tracker), trackers.end());
+    delete tracker;
+}
+
+k4a_wait_result_t k4abt_tracker_enqueue_capture(k4abt_tracker_t tracker_handle, k4a_capture_t sensor_capture_handle,
+                                                int32_t timeout_in_ms) {
+    (void)timeout_in_ms;
+    std::lock_guard<std::mutex> lock(simMutex);
+    SimTracker* tracker = sim<SimTracker>(tracker_handle);
+    tracker->used = true;
+    if (tracker->failed) {
+        return K4A_WAIT_RESULT_FAILED;
+    }
+    if (tracker->queue.size() >= TRACKER_QUEUE_SIZE) {
+        return K4A_WAIT_RESULT_TIMEOUT;
+    }
+    tracker->queue.push_back(sim<SimCapture>(sensor_capture_handle)->timestampUsec);
+    return K4A_WAIT_RESULT_SUCCEEDED;
+}
+
+k4a_wait_result_t k4abt_tracker_pop_result(k4abt_tracker_t tracker_handle, k4abt_frame_t* body_frame_handle,
+                                           int32_t timeout_in_ms) {
+    (void)timeout_in_ms;
+    std::lock_guard<std::mutex> lock(simMutex);
+    SimTracker* tracker = sim<SimTracker>(tracker_handle);
+    if (tracker->failed) {
+        return K4A_WAIT_RESULT_FAILED;
+    }
+    if (tracker->queue.empty()) {
+        return K4A_WAIT_RESULT_TIMEOUT;
+    }
+    *body_frame_handle = reinterpret_cast<k4abt_frame_t>(new SimFrame{tracker->queue.front()});
+    tracker->queue.pop_front();
+    return K4A_WAIT_RESULT_SUCCEEDED;
+}
+
+void k4abt_frame_release(k4abt_frame_t body_frame_handle) {
+    delete sim<SimFrame>(body_frame_handle);
+}
+
+uint32_t k4abt_frame_get_num_bodies(k4abt_frame_t body_frame_handle) {
+    (void)body_frame_handle;
+    return 1;
+}
+
+uint32_t k4abt_frame_get_body_id(k4abt_frame_t body_frame_handle, uint32_t index) {
+    (void)body_frame_handle;
+    return index + 1;
+}
+
+k4a_result_t k4abt_frame_get_body_skeleton(k4abt_frame_t body_frame_handle, uint32_t index,
+                                           k4abt_skeleton_t* skeleton) {
+    (void)body_frame_handle;
+    (void)index;
+    std::memset(skeleton, 0, sizeof(k4abt_skeleton_t));
+    for (int i = 0; i < K4ABT_JOINT_COUNT; i++) {
+        skeleton->joints[i].position.xyz.z = 2500.0f;
+        skeleton->joints[i].orientation.wxyz.w = 1.0f;
+        skeleton->joints[i].confidence_level = K4ABT_JOINT_CONFIDENCE_MEDIUM;
+    }
+    return K4A_RESULT_SUCCEEDED;
+}
+
+uint64_t k4abt_frame_get_device_timestamp_usec(k4abt_frame_t body_frame_handle) {
+    return sim<SimFrame>(body_frame_handle)->timestampUsec;
+}
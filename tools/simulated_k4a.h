@@ -0,0 +1,34 @@
+// Simulated Azure Kinect and Body Tracking SDK for offline tools
+//
+// simulated_k4a.cpp defines the k4a_* and k4abt_* functions KinectDevice
+// and BodyTracker call, so a tool linked against it instead of k4a.lib and
+// k4abt.lib runs the real capture and tracking code without hardware. One
+// device streams 30 fps depth frames with one body in view; creating a
+// tracker takes as long as loading the real ONNX model.
+//
+// Faults are injected from any thread:
+//   unplug(ms)     the device drops off USB; the open handle stays dead and
+//                  the device cannot be reopened for ms (re-enumeration)
+//   failTracker()  every tracker that has been fed captures starts failing,
+//                  as after a GPU reset; unused (standby) trackers are fine
+
+#pragma once
+
+#include <cstdint>
+
+namespace simk4a {
+
+struct Settings {
+    uint32_t modelLoadMs = 2000;    // k4abt_tracker_create
+    uint32_t openMs = 50;           // k4a_device_open
+    uint32_t startCamerasMs = 80;   // k4a_device_start_cameras
+};
+
+void configure(const Settings& settings);
+
+void unplug(uint32_t reenumerateMs);
+void failTracker();
+
+uint64_t getTrackersCreated();
+
+} // namespace simk4a
@@ -0,0 +1,134 @@
+// Application startup benchmark
+//
+// Builds the same startup graph as Application::initialize, with the real
+// KinectDevice and BodyTracker running against the simulated SDK in
+// simulated_k4a.cpp. The D3D and ImGui steps are stand-ins that sleep for
+// their share of --ui ms on the main thread.
+//
+// Startup runs twice. The sequential run brings each step up in order, as
+// initialize() did before the graph, so the attract screen waits for the
+// tracker model. The graph run returns at the attract screen while the
+// device and tracker finish on worker threads. Both timelines are printed.
+//
+// Exits non-zero if the graph run takes longer than --budget ms to reach
+// the attract screen.
+//
+// Usage:
+//   startup_benchmark [--ui ms] [--model-load ms] [--budget ms]
+//
+// Defaults: 400 ms UI, 2000 ms model load, 2000 ms budget.
+
+#include "../src/core/BodyTracker.h"
+#include "../src/core/KinectDevice.h"
+#include "../src/core/StartupGraph.h"
+#include "simulated_k4a.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace kinect::core;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct Result {
+    double attractMs = 0.0;   // initialize() returned, attract screen drawable
+    double readyMs = 0.0;     // Body tracker loaded
+    bool ok = false;
+};
+
+StartupGraph::Step sleepStep(uint32_t ms) {
+    return [ms]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+        return true;
+    };
+}
+
+// sequential: every step on the main thread, each after the one before
+Result run(bool sequential, uint32_t uiMs) {
+    auto kinectAffinity = sequential ? StartupGraph::Affinity::MAIN : StartupGraph::Affinity::WORKER;
+    std::unique_ptr<KinectDevice> device;
+    std::unique_ptr<BodyTracker> tracker;
+
+    auto start = Clock::now();
+    StartupGraph startup;
+    startup.add("d3d_device", StartupGraph::Affinity::MAIN, {}, sleepStep(uiMs / 2));
+    startup.add("render_target", StartupGraph::Affinity::MAIN, {"d3d_device"}, sleepStep(uiMs / 10));
+    startup.add("imgui", StartupGraph::Affinity::MAIN, {"render_target"}, sleepStep(uiMs - uiMs / 2 - uiMs / 10));
+    startup.add("kinect_device", kinectAffinity, sequential ? std::vector<std::string>{"imgui"} : std::vector<std::string>{},
+                [&]() {
+                    device = std::make_unique<KinectDevice>();
+                    return device->initialize();
+                });
+    startup.add("body_tracker", kinectAffinity, {"kinect_device"}, [&]() {
+        tracker = std::make_unique<BodyTracker>();
+        return tracker->initialize(*device);
+    });
+
+    Result result;
+    if (sequential) {
+        result.ok = startup.wait();
+    } else {
+        result.ok = startup.runUntil("imgui");
+    }
+    result.attractMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    result.ok = startup.wait() && result.ok;
+    for (const auto& step : startup.getTimeline()) {
+        if (step.name == "body_tracker") {
+            result.readyMs = step.endMs;
+        }
+    }
+
+    std::cout << "\n" << (sequential ? "Sequential" : "Graph") << " startup\n" << startup.formatTimeline();
+
+    if (tracker) {
+        tracker->shutdown();
+    }
+    if (device) {
+        device->shutdown();
+    }
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    uint32_t uiMs = 400;
+    double budgetMs = 2000.0;
+    simk4a::Settings settings;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--ui") == 0 && i + 1 < argc) {
+            uiMs = static_cast<uint32_t>(std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--model-load") == 0 && i + 1 < argc) {
+            settings.modelLoadMs = static_cast<uint32_t>(std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--budget") == 0 && i + 1 < argc) {
+            budgetMs = std::atof(argv[++i]);
+        } else {
+            std::cerr << "Usage: startup_benchmark [--ui ms] [--model-load ms] [--budget ms]\n";
+            return 2;
+        }
+    }
+    simk4a::configure(settings);
+
+    Result sequential = run(true, uiMs);
+    Result graph = run(false, uiMs);
+
+    std::cout << "\n" << std::left << std::setw(12) << "startup" << std::right << std::setw(18) << "attract screen"
+              << std::setw(17) << "tracker ready" << "\n" << std::fixed << std::setprecision(0);
+    std::cout << std::left << std::setw(12) << "sequential" << std::right << std::setw(15) << sequential.attractMs
+              << " ms" << std::setw(14) << sequential.readyMs << " ms\n";
+    std::cout << std::left << std::setw(12) << "graph" << std::right << std::setw(15) << graph.attractMs << " ms"
+              << std::setw(14) << graph.readyMs << " ms\n";
+
+    bool ok = sequential.ok && graph.ok && graph.attractMs <= budgetMs;
+    std::cout << (ok ? "PASS" : "FAIL") << ": attract screen within " << budgetMs << " ms\n";
+    return ok ? 0 : 1;
+}
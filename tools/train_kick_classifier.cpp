@@ -0,0 +1,445 @@
+// Offline trainer for the kick-type classifier
+//
+// Reads labelled kick recordings (CSV rows "label,f0,...,f9" as written by
+// KickClassifier::formatRecordingRow), trains the small MLP used by
+// KickClassifier and writes src/motion/KickClassifierWeights.h.
+//
+// Usage:
+//   train_kick_classifier [options] recordings.csv [more.csv ...]
+//
+// Options:
+//   --out <path>        Output header (default: KickClassifierWeights.h)
+//   --epochs <n>        Training epochs (default: 300)
+//   --seed <n>          RNG seed for init/shuffle (default: 2026)
+//   --synthetic <n>     Add n samples per class drawn from biomechanical
+//                       priors (bootstraps a model before real data exists)
+//   --bench             Time the compiled-in classifier and exit
+
+#include "../src/motion/KickClassifier.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace kinect;
+using namespace kinect::motion;
+
+namespace {
+
+constexpr size_t F = KickClassifier::FEATURE_COUNT;
+constexpr size_t H = KickClassifier::HIDDEN_SIZE;
+constexpr size_t C = KickClassifier::CLASS_COUNT;
+
+struct Sample {
+    KickClassifier::Features features;
+    int label;
+};
+
+struct Model {
+    float mean[F];
+    float scale[F];
+    float w1[H][F];
+    float b1[H];
+    float w2[C][H];
+    float b2[C];
+};
+
+// ----------------------------------------------------------------------------
+// Data loading
+// ----------------------------------------------------------------------------
+
+bool loadRecording(const std::string& path, std::vector<Sample>& samples) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Cannot open " << path << "\n";
+        return false;
+    }
+
+    std::string line;
+    size_t lineNumber = 0;
+    size_t loaded = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        std::stringstream ss(line);
+        std::string field;
+        std::getline(ss, field, ',');
+
+        Sample sample;
+        sample.label = KickClassifier::classIndexFromLabel(field);
+        if (sample.label < 0) {
+            std::cerr << path << ":" << lineNumber << ": unknown label '" << field << "'\n";
+            continue;
+        }
+
+        size_t i = 0;
+        while (i < F && std::getline(ss, field, ',')) {
+            sample.features[i++] = std::strtof(field.c_str(), nullptr);
+        }
+        if (i != F) {
+            std::cerr << path << ":" << lineNumber << ": expected " << F << " features\n";
+            continue;
+        }
+
+        samples.push_back(sample);
+        ++loaded;
+    }
+
+    std::cout << "Loaded " << loaded << " kicks from " << path << "\n";
+    return true;
+}
+
+// Per-class priors: typical contact-time values for each kick technique
+void addSyntheticSamples(std::vector<Sample>& samples, size_t perClass, std::mt19937& rng) {
+    struct Prior {
+        float knee, kneeSd, speed, speedSd, lateral, lateralSd, dirY;
+        float hip, hipSd, follow, followSd, lean, leanSd, footHeight, footHeightSd;
+    };
+    const Prior priors[C] = {
+        // Instep: straight leg, fast, forward, long follow-through
+        {160.0f, 8.0f, 7.0f, 1.5f, 0.10f, 0.07f, 0.10f, 35.0f, 10.0f, 0.60f, 0.15f, 12.0f, 5.0f, -0.85f, 0.08f},
+        // Side-foot: bent knee, slower, open hips, some lateral travel
+        {115.0f, 10.0f, 3.5f, 1.0f, 0.30f, 0.10f, 0.00f, 45.0f, 10.0f, 0.35f, 0.10f, 8.0f, 4.0f, -0.85f, 0.08f},
+        // Outside: strong lateral component, little hip rotation
+        {140.0f, 10.0f, 5.0f, 1.5f, 0.60f, 0.12f, 0.05f, 20.0f, 8.0f, 0.40f, 0.15f, 15.0f, 6.0f, -0.85f, 0.08f},
+        // Toe: fast, straight through, short follow-through
+        {135.0f, 8.0f, 6.5f, 1.5f, 0.08f, 0.05f, 0.05f, 15.0f, 8.0f, 0.20f, 0.08f, 18.0f, 6.0f, -0.90f, 0.08f},
+        // Volley: foot raised at contact, more lean
+        {150.0f, 12.0f, 6.0f, 1.5f, 0.15f, 0.10f, 0.30f, 40.0f, 12.0f, 0.50f, 0.15f, 25.0f, 8.0f, -0.35f, 0.15f},
+    };
+
+    std::normal_distribution<float> n(0.0f, 1.0f);
+    std::bernoulli_distribution side(0.5);
+
+    for (size_t k = 0; k < C; ++k) {
+        const Prior& p = priors[k];
+        for (size_t s = 0; s < perClass; ++s) {
+            Sample sample;
+            sample.label = static_cast<int>(k);
+            auto& f = sample.features;
+
+            float lateral = std::min(0.95f, std::max(0.0f, p.lateral + p.lateralSd * n(rng)));
+            float dx = (side(rng) ? 1.0f : -1.0f) * lateral;
+            float dy = p.dirY + 0.1f * n(rng);
+            float dz = 1.0f - lateral;
+            float len = std::sqrt(dx * dx + dy * dy + dz * dz);
+
+            f[KickClassifier::KNEE_ANGLE] = p.knee + p.kneeSd * n(rng);
+            f[KickClassifier::PEAK_FOOT_SPEED] = std::max(0.5f, p.speed + p.speedSd * n(rng));
+            f[KickClassifier::DIRECTION_X] = dx / len;
+            f[KickClassifier::DIRECTION_Y] = dy / len;
+            f[KickClassifier::DIRECTION_Z] = dz / len;
+            f[KickClassifier::LATERAL_RATIO] = lateral;
+            f[KickClassifier::HIP_ROTATION] = std::max(0.0f, p.hip + p.hipSd * n(rng));
+            f[KickClassifier::FOLLOW_THROUGH] = std::max(0.0f, p.follow + p.followSd * n(rng));
+            f[KickClassifier::BODY_LEAN] = std::max(0.0f, p.lean + p.leanSd * n(rng));
+            f[KickClassifier::FOOT_HEIGHT] = p.footHeight + p.footHeightSd * n(rng);
+
+            samples.push_back(sample);
+        }
+    }
+
+    std::cout << "Added " << perClass * C << " synthetic kicks from priors\n";
+}
+
+// ----------------------------------------------------------------------------
+// Model
+// ----------------------------------------------------------------------------
+
+void forward(const Model& m, const KickClassifier::Features& features,
+             float* x, float* hidden, float* probs) {
+    for (size_t i = 0; i < F; ++i) {
+        x[i] = (features[i] - m.mean[i]) * m.scale[i];
+    }
+    for (size_t j = 0; j < H; ++j) {
+        float sum = m.b1[j];
+        for (size_t i = 0; i < F; ++i) sum += m.w1[j][i] * x[i];
+        hidden[j] = std::max(0.0f, sum);
+    }
+    float maxLogit = -1e30f;
+    for (size_t k = 0; k < C; ++k) {
+        float sum = m.b2[k];
+        for (size_t j = 0; j < H; ++j) sum += m.w2[k][j] * hidden[j];
+        probs[k] = sum;
+        maxLogit = std::max(maxLogit, sum);
+    }
+    float total = 0.0f;
+    for (size_t k = 0; k < C; ++k) {
+        probs[k] = std::exp(probs[k] - maxLogit);
+        total += probs[k];
+    }
+    for (size_t k = 0; k < C; ++k) probs[k] /= total;
+}
+
+int predict(const Model& m, const KickClassifier::Features& features) {
+    float x[F], hidden[H], probs[C];
+    forward(m, features, x, hidden, probs);
+    return static_cast<int>(std::max_element(probs, probs + C) - probs);
+}
+
+void fitNormalization(Model& m, const std::vector<Sample>& samples) {
+    for (size_t i = 0; i < F; ++i) {
+        double sum = 0.0, sumSq = 0.0;
+        for (const auto& s : samples) {
+            sum += s.features[i];
+            sumSq += s.features[i] * s.features[i];
+        }
+        double mean = sum / samples.size();
+        double var = std::max(1e-8, sumSq / samples.size() - mean * mean);
+        m.mean[i] = static_cast<float>(mean);
+        m.scale[i] = static_cast<float>(1.0 / std::sqrt(var));
+    }
+}
+
+void train(Model& m, std::vector<Sample>& samples, int epochs, std::mt19937& rng) {
+    // He initialisation
+    std::normal_distribution<float> init1(0.0f, std::sqrt(2.0f / F));
+    std::normal_distribution<float> init2(0.0f, std::sqrt(2.0f / H));
+    for (size_t j = 0; j < H; ++j) {
+        for (size_t i = 0; i < F; ++i) m.w1[j][i] = init1(rng);
+        m.b1[j] = 0.0f;
+    }
+    for (size_t k = 0; k < C; ++k) {
+        for (size_t j = 0; j < H; ++j) m.w2[k][j] = init2(rng);
+        m.b2[k] = 0.0f;
+    }
+
+    // Mini-batch SGD with momentum, softmax cross-entropy
+    const size_t batchSize = 32;
+    const float momentum = 0.9f;
+    const float weightDecay = 1e-4f;
+    Model velocity{};
+
+    for (int epoch = 0; epoch < epochs; ++epoch) {
+        std::shuffle(samples.begin(), samples.end(), rng);
+        float lr = 0.05f * (1.0f - 0.9f * epoch / epochs);
+        double epochLoss = 0.0;
+
+        for (size_t start = 0; start < samples.size(); start += batchSize) {
+            size_t end = std::min(samples.size(), start + batchSize);
+            Model grad{};
+
+            for (size_t n = start; n < end; ++n) {
+                float x[F], hidden[H], probs[C];
+                forward(m, samples[n].features, x, hidden, probs);
+                epochLoss -= std::log(std::max(1e-7f, probs[samples[n].label]));
+
+                float dOut[C];
+                for (size_t k = 0; k < C; ++k) {
+                    dOut[k] = probs[k] - (static_cast<int>(k) == samples[n].label ? 1.0f : 0.0f);
+                }
+
+                float dHidden[H] = {};
+                for (size_t k = 0; k < C; ++k) {
+                    grad.b2[k] += dOut[k];
+                    for (size_t j = 0; j < H; ++j) {
+                        grad.w2[k][j] += dOut[k] * hidden[j];
+                        dHidden[j] += dOut[k] * m.w2[k][j];
+                    }
+                }
+                for (size_t j = 0; j < H; ++j) {
+                    if (hidden[j] <= 0.0f) continue;
+                    grad.b1[j] += dHidden[j];
+                    for (size_t i = 0; i < F; ++i) {
+                        grad.w1[j][i] += dHidden[j] * x[i];
+                    }
+                }
+            }
+
+            float invBatch = 1.0f / static_cast<float>(end - start);
+            auto step = [&](float& param, float& vel, float g, bool decay) {
+                g = g * invBatch + (decay ? weightDecay * param : 0.0f);
+                vel = momentum * vel - lr * g;
+                param += vel;
+            };
+            for (size_t j = 0; j < H; ++j) {
+                for (size_t i = 0; i < F; ++i) step(m.w1[j][i], velocity.w1[j][i], grad.w1[j][i], true);
+                step(m.b1[j], velocity.b1[j], grad.b1[j], false);
+            }
+            for (size_t k = 0; k < C; ++k) {
+                for (size_t j = 0; j < H; ++j) step(m.w2[k][j], velocity.w2[k][j], grad.w2[k][j], true);
+                step(m.b2[k], velocity.b2[k], grad.b2[k], false);
+            }
+        }
+
+        if ((epoch + 1) % 50 == 0 || epoch == 0) {
+            std::cout << "  epoch " << std::setw(4) << epoch + 1
+                      << "  loss " << std::fixed << std::setprecision(4)
+                      << epochLoss / samples.size() << "\n";
+        }
+    }
+}
+
+void evaluate(const Model& m, const std::vector<Sample>& samples, const char* name) {
+    size_t confusion[C][C] = {};
+    size_t correct = 0;
+    for (const auto& s : samples) {
+        int p = predict(m, s.features);
+        confusion[s.label][p]++;
+        if (p == s.label) correct++;
+    }
+
+    std::cout << "\n" << name << " accuracy: " << std::fixed << std::setprecision(1)
+              << (samples.empty() ? 0.0 : 100.0 * correct / samples.size()) << "% ("
+              << correct << "/" << samples.size() << ")\n";
+    std::cout << std::setw(10) << "true\\pred";
+    for (size_t k = 0; k < C; ++k) std::cout << std::setw(10) << KickClassifier::classLabel(k);
+    std::cout << "\n";
+    for (size_t t = 0; t < C; ++t) {
+        std::cout << std::setw(10) << KickClassifier::classLabel(t);
+        for (size_t k = 0; k < C; ++k) std::cout << std::setw(10) << confusion[t][k];
+        std::cout << "\n";
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Output
+// ----------------------------------------------------------------------------
+
+void writeArray(std::ostream& out, const float* values, size_t count) {
+    out << "{";
+    for (size_t i = 0; i < count; ++i) {
+        out << (i ? ", " : "") << std::setprecision(9) << std::defaultfloat << values[i] << "f";
+    }
+    out << "}";
+}
+
+bool writeHeader(const Model& m, const std::string& path, size_t recordedCount, size_t syntheticCount) {
+    std::ofstream out(path);
+    if (!out.is_open()) {
+        std::cerr << "Cannot write " << path << "\n";
+        return false;
+    }
+
+    out << "#ifndef KINECT_FOOTBALL_KICK_CLASSIFIER_WEIGHTS_H\n"
+        << "#define KINECT_FOOTBALL_KICK_CLASSIFIER_WEIGHTS_H\n\n"
+        << "// Generated by tools/train_kick_classifier from " << recordedCount
+        << " recorded and " << syntheticCount << " synthetic labelled kicks.\n"
+        << "// Do not edit by hand; retrain instead.\n\n"
+        << "#include <cstddef>\n\n"
+        << "namespace kinect {\n"
+        << "namespace motion {\n"
+        << "namespace kick_model {\n\n"
+        << "constexpr size_t FEATURE_COUNT = " << F << ";\n"
+        << "constexpr size_t HIDDEN_SIZE = " << H << ";\n"
+        << "constexpr size_t CLASS_COUNT = " << C << ";\n\n";
+
+    out << "alignas(32) constexpr float INPUT_MEAN[FEATURE_COUNT] = ";
+    writeArray(out, m.mean, F);
+    out << ";\n\nalignas(32) constexpr float INPUT_SCALE[FEATURE_COUNT] = ";
+    writeArray(out, m.scale, F);
+    out << ";\n\nalignas(32) constexpr float HIDDEN_WEIGHTS[HIDDEN_SIZE][FEATURE_COUNT] = {\n";
+    for (size_t j = 0; j < H; ++j) {
+        out << "    ";
+        writeArray(out, m.w1[j], F);
+        out << (j + 1 < H ? ",\n" : "\n");
+    }
+    out << "};\n\nalignas(32) constexpr float HIDDEN_BIAS[HIDDEN_SIZE] = ";
+    writeArray(out, m.b1, H);
+    out << ";\n\nalignas(32) constexpr float OUTPUT_WEIGHTS[CLASS_COUNT][HIDDEN_SIZE] = {\n";
+    for (size_t k = 0; k < C; ++k) {
+        out << "    ";
+        writeArray(out, m.w2[k], H);
+        out << (k + 1 < C ? ",\n" : "\n");
+    }
+    out << "};\n\nalignas(32) constexpr float OUTPUT_BIAS[CLASS_COUNT] = ";
+    writeArray(out, m.b2, C);
+    out << ";\n\n"
+        << "} // namespace kick_model\n"
+        << "} // namespace motion\n"
+        << "} // namespace kinect\n\n"
+        << "#endif // KINECT_FOOTBALL_KICK_CLASSIFIER_WEIGHTS_H\n";
+
+    std::cout << "\nWrote " << path << "\n";
+    return true;
+}
+
+void benchmarkCompiledModel() {
+    std::mt19937 rng(1);
+    std::vector<Sample> samples;
+    addSyntheticSamples(samples, 200, rng);
+
+    const int iterations = 200000;
+    volatile int sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        sink = sink + static_cast<int>(KickClassifier::classify(samples[i % samples.size()].features));
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    double ns = std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+
+    std::cout << "Compiled-in classifier: " << std::fixed << std::setprecision(1)
+              << ns << " ns per inference (budget 50000 ns)\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string outPath = "KickClassifierWeights.h";
+    int epochs = 300;
+    unsigned seed = 2026;
+    size_t syntheticPerClass = 0;
+    std::vector<std::string> inputs;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--out" && i + 1 < argc) {
+            outPath = argv[++i];
+        } else if (arg == "--epochs" && i + 1 < argc) {
+            epochs = std::atoi(argv[++i]);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--synthetic" && i + 1 < argc) {
+            syntheticPerClass = static_cast<size_t>(std::atoi(argv[++i]));
+        } else if (arg == "--bench") {
+            benchmarkCompiledModel();
+            return 0;
+        } else {
+            inputs.push_back(arg);
+        }
+    }
+
+    std::mt19937 rng(seed);
+    std::vector<Sample> samples;
+    for (const auto& path : inputs) {
+        if (!loadRecording(path, samples)) {
+            return 1;
+        }
+    }
+    size_t recordedCount = samples.size();
+    if (syntheticPerClass > 0) {
+        addSyntheticSamples(samples, syntheticPerClass, rng);
+    }
+    if (samples.size() < C * 4) {
+        std::cerr << "Not enough labelled kicks to train (" << samples.size() << ")\n";
+        return 1;
+    }
+
+    // 80/20 train/holdout split
+    std::shuffle(samples.begin(), samples.end(), rng);
+    size_t trainCount = samples.size() * 4 / 5;
+    std::vector<Sample> trainSet(samples.begin(), samples.begin() + trainCount);
+    std::vector<Sample> holdout(samples.begin() + trainCount, samples.end());
+
+    Model model{};
+    fitNormalization(model, trainSet);
+
+    std::cout << "\nTraining " << F << "-" << H << "-" << C << " MLP on "
+              << trainSet.size() << " kicks for " << epochs << " epochs\n";
+    train(model, trainSet, epochs, rng);
+
+    evaluate(model, trainSet, "Train");
+    evaluate(model, holdout, "Holdout");
+
+    return writeHeader(model, outPath, recordedCount, samples.size() - recordedCount) ? 0 : 1;
+}